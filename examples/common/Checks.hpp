@@ -0,0 +1,80 @@
+#ifndef CHECKS_HPP
+#define CHECKS_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Config.hpp>
+#include <cstddef>
+#include <cstdlib>
+#include <iostream>
+
+
+////////////////////////////////////////////////////////////
+// Helpers of the examples that verify their own results,
+// so that they can also be run as tests
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Number of checks that failed so far
+////////////////////////////////////////////////////////////
+inline unsigned int& checkFailures()
+{
+    static unsigned int failures = 0;
+    return failures;
+}
+
+////////////////////////////////////////////////////////////
+// Report a failure if the condition is false
+////////////////////////////////////////////////////////////
+inline void check(bool condition, const char* description)
+{
+    if (!condition)
+    {
+        std::cout << "Check failed: " << description << std::endl;
+        checkFailures()++;
+    }
+}
+
+////////////////////////////////////////////////////////////
+// Print the result of all the checks, and return the exit code of the example
+////////////////////////////////////////////////////////////
+inline int reportChecks()
+{
+    if (checkFailures() > 0)
+    {
+        std::cout << checkFailures() << " checks failed" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    std::cout << "All checks passed" << std::endl;
+    return EXIT_SUCCESS;
+}
+
+////////////////////////////////////////////////////////////
+// Content of the data transferred by the examples, generated
+// from the position so that big transfers need no storage
+////////////////////////////////////////////////////////////
+inline char byteAt(sf::Uint64 position)
+{
+    return static_cast<char>((position * 7) ^ (position >> 11));
+}
+
+inline void generate(sf::Uint64 position, char* data, std::size_t size)
+{
+    for (std::size_t i = 0; i < size; ++i)
+        data[i] = byteAt(position + i);
+}
+
+inline bool matches(sf::Uint64 position, const char* data, std::size_t size)
+{
+    for (std::size_t i = 0; i < size; ++i)
+    {
+        if (data[i] != byteAt(position + i))
+            return false;
+    }
+
+    return true;
+}
+
+#endif // CHECKS_HPP
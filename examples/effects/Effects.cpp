@@ -0,0 +1,168 @@
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Audio.hpp>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+
+namespace
+{
+    const unsigned int channelCount = 2;
+    const unsigned int sampleRate   = 44100;
+    const std::size_t  blockFrames  = 4410; // 100 ms, the size of the blocks processed by a typical stream
+    const std::size_t  blockCount   = 200;
+}
+
+
+////////////////////////////////////////////////////////////
+/// Measure the processing cost of an effect
+///
+/// \param name   Name of the effect to display
+/// \param effect Effect to measure
+///
+////////////////////////////////////////////////////////////
+void measure(const std::string& name, sf::SoundEffect& effect)
+{
+    // Generate a block of white noise
+    std::vector<float> noise(blockFrames * channelCount);
+    for (std::size_t i = 0; i < noise.size(); ++i)
+        noise[i] = static_cast<float>(std::rand()) / RAND_MAX * 2.f - 1.f;
+
+    effect.reset(channelCount, sampleRate);
+
+    // Process the block many times, only the processing itself is timed
+    std::vector<float> block;
+    sf::Time elapsed;
+    for (std::size_t i = 0; i < blockCount; ++i)
+    {
+        block = noise;
+
+        sf::Clock clock;
+        effect.process(block, channelCount);
+        elapsed += clock.getElapsedTime();
+    }
+
+    // Display the cost per input sample
+    double nanoseconds = elapsed.asMicroseconds() * 1000.0 / (blockFrames * channelCount * blockCount);
+    std::cout << " " << std::left << std::setw(30) << name << std::right << std::fixed << std::setprecision(2)
+              << std::setw(8) << nanoseconds << " ns/sample" << std::endl;
+}
+
+
+////////////////////////////////////////////////////////////
+/// Measure the cost of all the built-in effects
+///
+////////////////////////////////////////////////////////////
+void runBenchmark()
+{
+    std::cout << "Processing cost of the effects (" << channelCount << " channels, "
+              << sampleRate << " Hz, blocks of " << blockFrames << " frames):" << std::endl;
+
+    sf::GainEffect gain(0.5f);
+    measure("gain", gain);
+
+    sf::BiquadFilter lowPass(sf::BiquadFilter::LowPass, 2000.f);
+    measure("low-pass filter", lowPass);
+
+    sf::BiquadFilter highPass(sf::BiquadFilter::HighPass, 100.f);
+    measure("high-pass filter", highPass);
+
+    sf::BiquadFilter peak(sf::BiquadFilter::Peak, 1000.f, 1.f, 6.f);
+    measure("peak EQ", peak);
+
+    sf::CompressorEffect compressor;
+    measure("compressor", compressor);
+
+    sf::ResamplerEffect resampler(48000);
+    measure("resampler (to 48000 Hz)", resampler);
+
+    sf::BiquadFilter low(sf::BiquadFilter::LowPass, 300.f);
+    sf::BiquadFilter high(sf::BiquadFilter::HighPass, 3000.f);
+    sf::MixerBus bus;
+    bus.add(low, 0.7f);
+    bus.add(high, 0.7f);
+    bus.setDryGain(0.f);
+    measure("mixer bus (2 filters)", bus);
+
+    sf::SoundEffectChain chain;
+    chain.add(highPass);
+    chain.add(peak);
+    chain.add(compressor);
+    chain.add(gain);
+    measure("chain (HP + EQ + comp + gain)", chain);
+
+    std::cout << std::endl;
+}
+
+
+////////////////////////////////////////////////////////////
+/// Play a music through a chain of effects
+///
+/// \param filename Path of the music to play
+///
+////////////////////////////////////////////////////////////
+void playMusic(const std::string& filename)
+{
+    sf::Music music;
+    if (!music.openFromFile(filename))
+        return;
+
+    // Build a typical mastering chain: remove the rumble, add some presence,
+    // even out the dynamics and convert to the rate of the audio device
+    sf::BiquadFilter highPass(sf::BiquadFilter::HighPass, 60.f);
+    sf::BiquadFilter presence(sf::BiquadFilter::Peak, 3000.f, 0.8f, 3.f);
+    sf::CompressorEffect compressor;
+    compressor.setThreshold(-24.f);
+    compressor.setRatio(3.f);
+    compressor.setMakeupGain(6.f);
+    sf::ResamplerEffect resampler;
+
+    sf::SoundEffectChain chain;
+    chain.add(highPass);
+    chain.add(presence);
+    chain.add(compressor);
+    chain.add(resampler);
+
+    music.setEffect(&chain);
+    music.play();
+
+    // Loop while the music is playing
+    while (music.getStatus() == sf::Music::Playing)
+    {
+        // Leave some CPU time for other processes
+        sf::sleep(sf::milliseconds(100));
+
+        // Display the playing position and the activity of the compressor
+        std::cout << "\rPlaying... " << std::fixed << std::setprecision(2) << music.getPlayingOffset().asSeconds() << " sec"
+                  << "   gain reduction: " << std::setprecision(1) << compressor.getGainReduction() << " dB   ";
+        std::cout << std::flush;
+    }
+    std::cout << std::endl;
+}
+
+
+////////////////////////////////////////////////////////////
+/// Entry point of application
+///
+/// \param argc Number of command line arguments
+/// \param argv Command line arguments: optional music file to play through the effects
+///
+/// \return Application exit code
+///
+////////////////////////////////////////////////////////////
+int main(int argc, char* argv[])
+{
+    // Measure the effects
+    runBenchmark();
+
+    // Play a music through them, if one was given
+    if (argc > 1)
+        playMusic(argv[1]);
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,293 @@
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Network.hpp>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+
+////////////////////////////////////////////////////////////
+/// Echo server: sends back everything it receives
+///
+////////////////////////////////////////////////////////////
+class Server
+{
+public :
+
+    Server(sf::EventLoop& loop) :
+    m_loop(loop)
+    {
+    }
+
+    ~Server()
+    {
+        m_loop.cancel(m_listener);
+        for (std::vector<Connection*>::iterator it = m_connections.begin(); it != m_connections.end(); ++it)
+        {
+            m_loop.cancel((*it)->socket);
+            delete *it;
+        }
+    }
+
+    bool start()
+    {
+        if (m_listener.listen(sf::Socket::AnyPort) != sf::Socket::Done)
+            return false;
+
+        accept();
+        return true;
+    }
+
+    unsigned short getPort() const
+    {
+        return m_listener.getLocalPort();
+    }
+
+private :
+
+    struct Connection
+    {
+        sf::TcpSocket socket;
+        char          buffer[256];
+    };
+
+    // Handlers
+    struct Accepted
+    {
+        Server* server;
+        void operator()(sf::Socket::Status status, std::size_t) {server->onAccepted(status);}
+    };
+
+    struct Received
+    {
+        Server* server; Connection* connection;
+        void operator()(sf::Socket::Status status, std::size_t size) {server->onReceived(connection, status, size);}
+    };
+
+    struct Sent
+    {
+        Server* server; Connection* connection;
+        void operator()(sf::Socket::Status status, std::size_t) {server->onSent(connection, status);}
+    };
+
+    void accept()
+    {
+        m_connections.push_back(new Connection);
+        Accepted handler = {this};
+        m_loop.asyncAccept(m_listener, m_connections.back()->socket, handler);
+    }
+
+    void receive(Connection* connection)
+    {
+        Received handler = {this, connection};
+        m_loop.asyncReceive(connection->socket, connection->buffer, sizeof(connection->buffer), handler);
+    }
+
+    void onAccepted(sf::Socket::Status status)
+    {
+        if (status == sf::Socket::Done)
+            receive(m_connections.back());
+
+        accept();
+    }
+
+    void onReceived(Connection* connection, sf::Socket::Status status, std::size_t size)
+    {
+        if (status == sf::Socket::Done)
+        {
+            Sent handler = {this, connection};
+            m_loop.asyncSend(connection->socket, connection->buffer, size, handler);
+        }
+    }
+
+    void onSent(Connection* connection, sf::Socket::Status status)
+    {
+        if (status == sf::Socket::Done)
+            receive(connection);
+    }
+
+    sf::EventLoop&           m_loop;
+    sf::TcpListener          m_listener;
+    std::vector<Connection*> m_connections;
+};
+
+
+////////////////////////////////////////////////////////////
+/// Client: sends a message and waits for its echo, a given
+/// number of times
+///
+////////////////////////////////////////////////////////////
+class Client
+{
+public :
+
+    Client(sf::EventLoop& loop, std::size_t& running, sf::Time& latency) :
+    m_loop    (loop),
+    m_running (running),
+    m_latency (latency),
+    m_received(0),
+    m_rounds  (0)
+    {
+        std::memset(m_message, 'x', sizeof(m_message));
+    }
+
+    ~Client()
+    {
+        m_loop.cancel(m_socket);
+    }
+
+    void start(unsigned short port, std::size_t rounds)
+    {
+        m_rounds = rounds;
+
+        Connected handler = {this};
+        m_loop.asyncConnect(m_socket, sf::IpAddress::LocalHost, port, handler);
+    }
+
+private :
+
+    // Handlers
+    struct Connected
+    {
+        Client* client;
+        void operator()(sf::Socket::Status status, std::size_t) {client->onConnected(status);}
+    };
+
+    struct Received
+    {
+        Client* client;
+        void operator()(sf::Socket::Status status, std::size_t size) {client->onReceived(status, size);}
+    };
+
+    static void ignore(sf::Socket::Status, std::size_t)
+    {
+    }
+
+    void send()
+    {
+        m_received = 0;
+        m_clock.restart();
+        m_loop.asyncSend(m_socket, m_message, sizeof(m_message), &Client::ignore);
+        receive();
+    }
+
+    void receive()
+    {
+        Received handler = {this};
+        m_loop.asyncReceive(m_socket, m_buffer + m_received, sizeof(m_buffer) - m_received, handler);
+    }
+
+    void onConnected(sf::Socket::Status status)
+    {
+        if (status == sf::Socket::Done)
+            send();
+        else
+            finish();
+    }
+
+    void onReceived(sf::Socket::Status status, std::size_t size)
+    {
+        if (status != sf::Socket::Done)
+        {
+            finish();
+            return;
+        }
+
+        // Wait until the whole echo is back
+        m_received += size;
+        if (m_received < sizeof(m_message))
+        {
+            receive();
+            return;
+        }
+
+        m_latency += m_clock.getElapsedTime();
+        if (--m_rounds > 0)
+            send();
+        else
+            finish();
+    }
+
+    void finish()
+    {
+        m_socket.disconnect();
+        if (--m_running == 0)
+            m_loop.stop();
+    }
+
+    sf::EventLoop& m_loop;
+    std::size_t&   m_running;
+    sf::Time&      m_latency;
+    sf::TcpSocket  m_socket;
+    sf::Clock      m_clock;
+    char           m_message[32];
+    char           m_buffer[32];
+    std::size_t    m_received;
+    std::size_t    m_rounds;
+};
+
+
+////////////////////////////////////////////////////////////
+/// Stop the loop if the test takes too long
+///
+////////////////////////////////////////////////////////////
+struct Timeout
+{
+    sf::EventLoop* loop;
+    void operator()() {std::cout << "Timed out" << std::endl; loop->stop();}
+};
+
+
+////////////////////////////////////////////////////////////
+/// Entry point of application
+///
+/// \param argc Number of command line arguments
+/// \param argv Values of the command line arguments: number
+///             of clients, and number of round trips per client
+///
+/// \return Application exit code
+///
+////////////////////////////////////////////////////////////
+int main(int argc, char* argv[])
+{
+    std::size_t clientCount = argc > 1 ? std::atoi(argv[1]) : 400;
+    std::size_t roundCount  = argc > 2 ? std::atoi(argv[2]) : 100;
+
+    // The server and all the clients run in this thread
+    sf::EventLoop loop;
+    Server server(loop);
+    if (!server.start())
+        return EXIT_FAILURE;
+
+    std::size_t running = clientCount;
+    sf::Time latency;
+    std::vector<Client*> clients;
+    for (std::size_t i = 0; i < clientCount; ++i)
+    {
+        clients.push_back(new Client(loop, running, latency));
+        clients.back()->start(server.getPort(), roundCount);
+    }
+
+    Timeout timeout = {&loop};
+    sf::EventLoop::Timer timer = loop.addTimer(sf::seconds(60), timeout);
+
+    sf::Clock clock;
+    loop.run();
+    sf::Time duration = clock.getElapsedTime();
+    loop.cancelTimer(timer);
+
+    std::size_t roundTrips = clientCount * roundCount;
+    std::cout << std::fixed << std::setprecision(1);
+    std::cout << clientCount << " clients, " << roundTrips << " round trips in " << duration.asSeconds() << " s" << std::endl;
+    std::cout << "Round trips per second: " << roundTrips / duration.asSeconds() << std::endl;
+    std::cout << "Average latency: " << latency.asMicroseconds() / static_cast<double>(roundTrips) << " us" << std::endl;
+
+    for (std::vector<Client*>::iterator it = clients.begin(); it != clients.end(); ++it)
+        delete *it;
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,367 @@
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include "Checks.hpp"
+#include <SFML/Network.hpp>
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+
+namespace
+{
+    const unsigned short firstPort = 50021;
+    const std::size_t    fileSize  = 64 * 1024 * 1024;
+    const char*          filename  = "ftp_benchmark.bin";
+
+    ////////////////////////////////////////////////////////////
+    // Minimal FTP server on the loopback interface, for a
+    // single client in passive mode. Its files are not stored:
+    // only their size is kept, their content being generated
+    ////////////////////////////////////////////////////////////
+    class LoopbackServer
+    {
+    public :
+
+        LoopbackServer() :
+        m_port  (0),
+        m_thread(&LoopbackServer::run, this)
+        {
+
+        }
+
+        ~LoopbackServer()
+        {
+            m_thread.wait();
+        }
+
+        bool start()
+        {
+            // The port of a previous run may not be available yet: try the next ones
+            for (m_port = firstPort; m_port < firstPort + 10; ++m_port)
+            {
+                if (m_listener.listen(m_port) == sf::Socket::Done)
+                {
+                    m_thread.launch();
+                    return true;
+                }
+            }
+
+            return false;
+        }
+
+        unsigned short getPort() const
+        {
+            return m_port;
+        }
+
+        bool getFile(const std::string& name, sf::Uint64& size, bool& valid) const
+        {
+            std::map<std::string, File>::const_iterator it = m_files.find(name);
+            if (it == m_files.end())
+                return false;
+
+            size = it->second.size;
+            valid = it->second.valid;
+            return true;
+        }
+
+    private :
+
+        struct File
+        {
+            File() : size(0), valid(true) {}
+
+            sf::Uint64 size;
+            bool       valid;
+        };
+
+        void run()
+        {
+            sf::TcpSocket control;
+            if (m_listener.accept(control) != sf::Socket::Done)
+                return;
+            m_listener.close();
+
+            reply(control, "220 Loopback FTP server ready");
+
+            std::string received;
+            sf::Uint64 restart = 0;
+            for (;;)
+            {
+                // Read the next command
+                std::string::size_type end;
+                while ((end = received.find("\r\n")) == std::string::npos)
+                {
+                    char buffer[1024];
+                    std::size_t size;
+                    if (control.receive(buffer, sizeof(buffer), size) != sf::Socket::Done)
+                        return;
+                    received.append(buffer, size);
+                }
+
+                std::string line = received.substr(0, end);
+                received.erase(0, end + 2);
+                std::string command = line.substr(0, line.find(' '));
+                std::string argument = line.size() > command.size() ? line.substr(command.size() + 1) : "";
+
+                if (command == "USER")
+                {
+                    reply(control, "331 Any password will do");
+                }
+                else if ((command == "PASS") || (command == "TYPE") || (command == "NOOP"))
+                {
+                    reply(control, "200 Ok");
+                }
+                else if (command == "PASV")
+                {
+                    m_data.listen(sf::Socket::AnyPort);
+                    std::ostringstream out;
+                    out << "227 Entering Passive Mode (127,0,0,1," << m_data.getLocalPort() / 256 << "," << m_data.getLocalPort() % 256 << ")";
+                    reply(control, out.str());
+                }
+                else if (command == "SIZE")
+                {
+                    std::map<std::string, File>::const_iterator it = m_files.find(argument);
+                    std::ostringstream out;
+                    if (it != m_files.end())
+                        out << "213 " << it->second.size;
+                    else
+                        out << "550 No such file";
+                    reply(control, out.str());
+                }
+                else if (command == "REST")
+                {
+                    std::istringstream(argument) >> restart;
+                    reply(control, "350 Restarting at " + argument);
+                }
+                else if (command == "RETR")
+                {
+                    std::map<std::string, File>::const_iterator it = m_files.find(argument);
+                    if (it == m_files.end())
+                    {
+                        reply(control, "550 No such file");
+                    }
+                    else
+                    {
+                        reply(control, "150 Opening data connection");
+                        bool complete = sendFile(it->second.size, restart);
+                        reply(control, complete ? "226 Transfer complete" : "426 Transfer aborted");
+                    }
+                    restart = 0;
+                }
+                else if ((command == "STOR") || (command == "APPE"))
+                {
+                    File& file = m_files[argument];
+                    if (command == "STOR")
+                        file = File();
+
+                    reply(control, "150 Opening data connection");
+                    receiveFile(file);
+                    reply(control, "226 Transfer complete");
+                }
+                else if (command == "QUIT")
+                {
+                    reply(control, "221 Goodbye");
+                    return;
+                }
+                else
+                {
+                    reply(control, "502 Command not implemented");
+                }
+            }
+        }
+
+        void reply(sf::TcpSocket& control, const std::string& message)
+        {
+            std::string line = message + "\r\n";
+            control.send(line.c_str(), line.size());
+        }
+
+        bool sendFile(sf::Uint64 size, sf::Uint64 position)
+        {
+            sf::TcpSocket socket;
+            if (m_data.accept(socket) != sf::Socket::Done)
+                return false;
+            m_data.close();
+
+            std::vector<char> buffer(64 * 1024);
+            while (position < size)
+            {
+                std::size_t count = static_cast<std::size_t>(std::min<sf::Uint64>(buffer.size(), size - position));
+                generate(position, &buffer[0], count);
+                if (socket.send(&buffer[0], count) != sf::Socket::Done)
+                    return false;
+                position += count;
+            }
+
+            return true;
+        }
+
+        void receiveFile(File& file)
+        {
+            sf::TcpSocket socket;
+            if (m_data.accept(socket) != sf::Socket::Done)
+                return;
+            m_data.close();
+
+            std::vector<char> buffer(64 * 1024);
+            std::size_t count;
+            while (socket.receive(&buffer[0], buffer.size(), count) == sf::Socket::Done)
+            {
+                file.valid = file.valid && matches(file.size, &buffer[0], count);
+                file.size += count;
+            }
+        }
+
+        sf::TcpListener                  m_listener;
+        sf::TcpListener                  m_data;
+        unsigned short                   m_port;
+        sf::Thread                       m_thread;
+        std::map<std::string, File>      m_files;
+    };
+
+    ////////////////////////////////////////////////////////////
+    // Local files
+    ////////////////////////////////////////////////////////////
+    void createFile()
+    {
+        std::ofstream file(filename, std::ios_base::binary | std::ios_base::trunc);
+        std::vector<char> buffer(64 * 1024);
+        for (std::size_t position = 0; position < fileSize; position += buffer.size())
+        {
+            generate(position, &buffer[0], buffer.size());
+            file.write(&buffer[0], buffer.size());
+        }
+    }
+
+    bool checkFile(const std::string& path)
+    {
+        std::ifstream file(path.c_str(), std::ios_base::binary);
+        std::vector<char> buffer(64 * 1024);
+        sf::Uint64 position = 0;
+        while (file.read(&buffer[0], buffer.size()) || (file.gcount() > 0))
+        {
+            std::size_t size = static_cast<std::size_t>(file.gcount());
+            if (!matches(position, &buffer[0], size))
+                return false;
+            position += size;
+        }
+
+        return position == fileSize;
+    }
+
+    ////////////////////////////////////////////////////////////
+    // Progress callback, which can stop the transfer
+    ////////////////////////////////////////////////////////////
+    struct Progress
+    {
+        Progress(sf::Uint64 limit, unsigned int* calls) : limit(limit), calls(calls) {}
+
+        bool operator ()(sf::Uint64 transferred, sf::Uint64 total)
+        {
+            ++*calls;
+            if ((total > 0) && (*calls % 256 == 0))
+                std::cout << "\r    " << transferred * 100 / total << "%" << std::flush;
+
+            return transferred <= limit;
+        }
+
+        sf::Uint64    limit;
+        unsigned int* calls;
+    };
+
+    void printThroughput(const char* description, sf::Uint64 size, sf::Time time)
+    {
+        std::cout << "\r  " << description << ": " << size / 1024 / 1024 << " MB in "
+                  << time.asMilliseconds() << " ms ("
+                  << static_cast<int>(size / 1024.f / 1024.f / std::max(time.asSeconds(), 0.001f)) << " MB/s)" << std::endl;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+/// Entry point of application
+///
+/// \return Application exit code
+///
+////////////////////////////////////////////////////////////
+int main()
+{
+    LoopbackServer server;
+    if (!server.start())
+    {
+        std::cout << "Failed to start the server" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    sf::Ftp ftp;
+    check(ftp.connect(sf::IpAddress::LocalHost, server.getPort()).isOk(), "connected");
+    check(ftp.login().isOk(), "logged in");
+
+    std::cout << "Transferring files of " << fileSize / 1024 / 1024 << " MB with a loopback FTP server, by chunks" << std::endl;
+    createFile();
+
+    sf::Clock clock;
+    sf::Uint64 size = 0;
+    bool valid = false;
+    unsigned int calls = 0;
+
+    // Upload the file, following the progress
+    clock.restart();
+    sf::Ftp::Response response = ftp.upload(filename, "", sf::Ftp::Binary, false, Progress(fileSize, &calls));
+    printThroughput("upload", fileSize, clock.getElapsedTime());
+    check(response.isOk(), "upload succeeded");
+    check(calls > 0, "upload progress reported");
+    check(server.getFile(filename, size, valid) && (size == fileSize) && valid, "uploaded file content");
+
+    // Stop an upload midway, then resume it
+    calls = 0;
+    response = ftp.upload(filename, "", sf::Ftp::Binary, false, Progress(fileSize / 3, &calls));
+    check(response.getStatus() == sf::Ftp::Response::TransferAborted, "stopped upload reported as aborted");
+    check(server.getFile(filename, size, valid) && (size < fileSize) && valid, "stopped upload is partial");
+
+    clock.restart();
+    response = ftp.upload(filename, "", sf::Ftp::Binary, true);
+    printThroughput("resumed upload", fileSize - size, clock.getElapsedTime());
+    check(response.isOk(), "resumed upload succeeded");
+    check(server.getFile(filename, size, valid) && (size == fileSize) && valid, "resumed upload content");
+
+    // Download the file, following the progress
+    std::remove(filename);
+    calls = 0;
+    clock.restart();
+    response = ftp.download(filename, "", sf::Ftp::Binary, false, Progress(fileSize, &calls));
+    printThroughput("download", fileSize, clock.getElapsedTime());
+    check(response.isOk(), "download succeeded");
+    check(calls > 0, "download progress reported");
+    check(checkFile(filename), "downloaded file content");
+
+    // Stop a download midway, then resume it
+    calls = 0;
+    response = ftp.download(filename, "", sf::Ftp::Binary, false, Progress(fileSize / 3, &calls));
+    check(response.getStatus() == sf::Ftp::Response::TransferAborted, "stopped download reported as aborted");
+
+    std::ifstream partial(filename, std::ios_base::binary | std::ios_base::ate);
+    sf::Uint64 partialSize = static_cast<sf::Uint64>(partial.tellg());
+    partial.close();
+    check(partialSize < fileSize, "stopped download is partial");
+
+    clock.restart();
+    response = ftp.download(filename, "", sf::Ftp::Binary, true);
+    printThroughput("resumed download", fileSize - partialSize, clock.getElapsedTime());
+    check(response.isOk(), "resumed download succeeded");
+    check(checkFile(filename), "resumed download content");
+
+    std::remove(filename);
+    ftp.disconnect();
+
+    return reportChecks();
+}
@@ -0,0 +1,395 @@
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include "Checks.hpp"
+#include <SFML/Network.hpp>
+#include <algorithm>
+#include <cctype>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <list>
+#include <sstream>
+#include <string>
+
+
+namespace
+{
+    const unsigned short firstPort    = 50080;
+    const std::size_t    resourceSize = 64 * 1024 * 1024;
+    const char*          filename     = "http_download.bin";
+
+    ////////////////////////////////////////////////////////////
+    // Minimal HTTP/1.1 server on the loopback interface:
+    // "/resource" supports partial requests, "/chunked" is
+    // sent by chunks, and connections are kept alive
+    ////////////////////////////////////////////////////////////
+    class LoopbackServer
+    {
+    public :
+
+        LoopbackServer() :
+        m_port   (0),
+        m_thread (&LoopbackServer::run, this),
+        m_running(false)
+        {
+
+        }
+
+        ~LoopbackServer()
+        {
+            stop();
+        }
+
+        bool start()
+        {
+            // The port of a previous run may not be available yet: try the next ones
+            for (m_port = firstPort; m_port < firstPort + 10; ++m_port)
+            {
+                if (m_listener.listen(m_port) == sf::Socket::Done)
+                {
+                    m_running = true;
+                    m_thread.launch();
+                    return true;
+                }
+            }
+
+            return false;
+        }
+
+        unsigned short getPort() const
+        {
+            return m_port;
+        }
+
+        void stop()
+        {
+            {
+                sf::Lock lock(m_mutex);
+                m_running = false;
+            }
+            m_thread.wait();
+        }
+
+    private :
+
+        struct Client
+        {
+            sf::TcpSocket socket;
+            std::string   received;
+        };
+
+        bool isRunning()
+        {
+            sf::Lock lock(m_mutex);
+            return m_running;
+        }
+
+        void run()
+        {
+            std::list<Client*> clients;
+            sf::SocketSelector selector;
+            selector.add(m_listener);
+
+            while (isRunning())
+            {
+                if (!selector.wait(sf::milliseconds(50)))
+                    continue;
+
+                if (selector.isReady(m_listener))
+                {
+                    Client* client = new Client;
+                    if (m_listener.accept(client->socket) == sf::Socket::Done)
+                    {
+                        selector.add(client->socket);
+                        clients.push_back(client);
+                    }
+                    else
+                    {
+                        delete client;
+                    }
+                }
+
+                for (std::list<Client*>::iterator it = clients.begin(); it != clients.end();)
+                {
+                    Client* client = *it;
+                    if (selector.isReady(client->socket) && !receive(*client))
+                    {
+                        selector.remove(client->socket);
+                        delete client;
+                        it = clients.erase(it);
+                    }
+                    else
+                    {
+                        ++it;
+                    }
+                }
+            }
+
+            for (std::list<Client*>::iterator it = clients.begin(); it != clients.end(); ++it)
+                delete *it;
+            m_listener.close();
+        }
+
+        bool receive(Client& client)
+        {
+            char buffer[4096];
+            std::size_t size;
+            if (client.socket.receive(buffer, sizeof(buffer), size) != sf::Socket::Done)
+                return false;
+
+            client.received.append(buffer, size);
+
+            // Answer all the complete requests
+            std::string::size_type end;
+            while ((end = client.received.find("\r\n\r\n")) != std::string::npos)
+            {
+                std::string header = client.received.substr(0, end);
+                client.received.erase(0, end + 4);
+                if (!answer(client.socket, header))
+                    return false;
+            }
+
+            return true;
+        }
+
+        bool answer(sf::TcpSocket& socket, const std::string& header)
+        {
+            std::string uri = header.substr(header.find(' ') + 1);
+            uri = uri.substr(0, uri.find(' '));
+
+            // Field names are case-insensitive
+            std::string fields = header;
+            for (std::string::iterator it = fields.begin(); it != fields.end(); ++it)
+                *it = static_cast<char>(std::tolower(*it));
+
+            std::size_t first = 0;
+            std::string::size_type range = fields.find("range: bytes=");
+            if (range != std::string::npos)
+                first = std::strtoul(fields.c_str() + range + 13, NULL, 10);
+
+            std::ostringstream response;
+            if (uri == "/chunked")
+            {
+                response << "HTTP/1.1 200 OK\r\nTransfer-Encoding: chunked\r\n\r\n";
+                if (!send(socket, response.str()))
+                    return false;
+
+                // Chunks of varying sizes
+                std::vector<char> data(65536);
+                std::size_t position = 0;
+                for (std::size_t size = 1; position < resourceSize; size = size * 3 % 65521)
+                {
+                    size = std::min(size, resourceSize - position);
+                    generate(position, &data[0], size);
+                    std::ostringstream chunk;
+                    chunk << std::hex << size << "\r\n";
+                    if (!send(socket, chunk.str()) || (socket.send(&data[0], size) != sf::Socket::Done) || !send(socket, "\r\n"))
+                        return false;
+                    position += size;
+                }
+
+                return send(socket, "0\r\nX-Checksum: none\r\n\r\n");
+            }
+            else if (uri == "/resource")
+            {
+                if (first >= resourceSize)
+                {
+                    response << "HTTP/1.1 416 Range Not Satisfiable\r\nContent-Range: bytes */" << resourceSize << "\r\nContent-Length: 0\r\n\r\n";
+                    return send(socket, response.str());
+                }
+
+                if (range != std::string::npos)
+                {
+                    response << "HTTP/1.1 206 Partial Content\r\nContent-Range: bytes "
+                             << first << "-" << resourceSize - 1 << "/" << resourceSize << "\r\n";
+                }
+                else
+                {
+                    response << "HTTP/1.1 200 OK\r\n";
+                }
+                response << "Accept-Ranges: bytes\r\nContent-Length: " << resourceSize - first << "\r\n\r\n";
+                if (!send(socket, response.str()))
+                    return false;
+
+                std::vector<char> data(65536);
+                for (std::size_t position = first; position < resourceSize; position += data.size())
+                {
+                    std::size_t size = std::min(data.size(), resourceSize - position);
+                    generate(position, &data[0], size);
+                    if (socket.send(&data[0], size) != sf::Socket::Done)
+                        return false;
+                }
+
+                return true;
+            }
+            else
+            {
+                response << "HTTP/1.1 404 Not Found\r\nContent-Length: 9\r\n\r\nNot found";
+                return send(socket, response.str());
+            }
+        }
+
+        bool send(sf::TcpSocket& socket, const std::string& data)
+        {
+            return socket.send(data.c_str(), data.size()) == sf::Socket::Done;
+        }
+
+        sf::TcpListener m_listener;
+        unsigned short  m_port;
+        sf::Thread      m_thread;
+        sf::Mutex       m_mutex;
+        bool            m_running;
+    };
+
+    ////////////////////////////////////////////////////////////
+    // Check the content of the downloaded file
+    ////////////////////////////////////////////////////////////
+    bool checkFile()
+    {
+        std::ifstream file(filename, std::ios_base::binary);
+        std::vector<char> data(65536);
+        std::size_t position = 0;
+        while (file.read(&data[0], data.size()) || (file.gcount() > 0))
+        {
+            std::size_t size = static_cast<std::size_t>(file.gcount());
+            if (!matches(position, &data[0], size))
+                return false;
+            position += size;
+        }
+
+        return position == resourceSize;
+    }
+
+    ////////////////////////////////////////////////////////////
+    // Body callbacks
+    ////////////////////////////////////////////////////////////
+    struct Verifier
+    {
+        Verifier(std::size_t* position, bool* valid) : position(position), valid(valid) {}
+
+        bool operator ()(const char* data, std::size_t size)
+        {
+            *valid = *valid && matches(*position, data, size);
+            *position += size;
+            return true;
+        }
+
+        std::size_t* position;
+        bool*        valid;
+    };
+
+    struct InterruptedWriter
+    {
+        InterruptedWriter(std::ofstream* file, std::size_t limit) : file(file), limit(limit) {}
+
+        bool operator ()(const char* data, std::size_t size)
+        {
+            file->write(data, size);
+            limit -= std::min(limit, size);
+            return limit > 0;
+        }
+
+        std::ofstream* file;
+        std::size_t    limit;
+    };
+
+    void printThroughput(const char* description, std::size_t size, sf::Time time)
+    {
+        std::cout << "  " << description << ": " << size / 1024 / 1024 << " MB in "
+                  << time.asMilliseconds() << " ms ("
+                  << static_cast<int>(size / 1024.f / 1024.f / std::max(time.asSeconds(), 0.001f)) << " MB/s)" << std::endl;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+/// Entry point of application
+///
+/// \return Application exit code
+///
+////////////////////////////////////////////////////////////
+int main()
+{
+    LoopbackServer server;
+    if (!server.start())
+    {
+        std::cout << "Failed to start the server" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    sf::Http http("http://127.0.0.1", server.getPort());
+    sf::Clock clock;
+
+    std::cout << "Streaming the responses of a loopback HTTP server" << std::endl;
+
+    // Download the whole resource to a file
+    std::remove(filename);
+    clock.restart();
+    sf::Http::Response response = http.download(sf::Http::Request("/resource"), filename);
+    printThroughput("download to file", resourceSize, clock.getElapsedTime());
+    check(response.getStatus() == sf::Http::Response::Ok, "download answered with Ok");
+    check(response.getBody().empty(), "downloaded body not kept in memory");
+    check(checkFile(), "downloaded file content");
+
+    // Stop a download midway, then resume it
+    {
+        std::ofstream file(filename, std::ios_base::binary | std::ios_base::trunc);
+        http.sendRequest(sf::Http::Request("/resource"), InterruptedWriter(&file, resourceSize / 3));
+    }
+    clock.restart();
+    response = http.download(sf::Http::Request("/resource"), filename, true);
+    printThroughput("resumed download", resourceSize - resourceSize / 3, clock.getElapsedTime());
+    check(response.getStatus() == sf::Http::Response::PartialContent, "resumed download answered with PartialContent");
+    check(checkFile(), "resumed file content");
+
+    // Resuming a complete download is refused by the server, and leaves the file untouched
+    response = http.download(sf::Http::Request("/resource"), filename, true);
+    check(response.getStatus() == sf::Http::Response::RangeNotSatisfiable, "complete download answered with RangeNotSatisfiable");
+    check(checkFile(), "complete file left untouched");
+    std::remove(filename);
+
+    // Errors are not written to the file
+    response = http.download(sf::Http::Request("/missing"), filename);
+    check(response.getStatus() == sf::Http::Response::NotFound, "missing resource answered with NotFound");
+    check(response.getBody() == "Not found", "error body kept in the response");
+    check(!std::ifstream(filename), "no file written for an error");
+
+    // Give a chunked body to a callback
+    std::size_t position = 0;
+    bool valid = true;
+    clock.restart();
+    response = http.sendRequest(sf::Http::Request("/chunked"), Verifier(&position, &valid));
+    printThroughput("chunked body to callback", resourceSize, clock.getElapsedTime());
+    check(valid && (position == resourceSize), "chunked body content");
+    check(response.getField("x-checksum") == "none", "chunked body trailer");
+
+    // Read the resource as an input stream, seeking in it
+    sf::HttpStream stream;
+    check(stream.open("http://127.0.0.1", "/resource", server.getPort()), "stream opened");
+    check(stream.getSize() == static_cast<sf::Int64>(resourceSize), "stream size");
+
+    std::vector<char> data(1024 * 1024);
+    check(stream.read(&data[0], 1000) == 1000 && matches(0, &data[0], 1000), "stream read from the beginning");
+    check(stream.seek(5000) == 5000 && stream.read(&data[0], 1000) == 1000 && matches(5000, &data[0], 1000), "stream seek forward");
+    check(stream.seek(resourceSize / 2) == static_cast<sf::Int64>(resourceSize / 2), "stream seek far forward");
+    check(stream.read(&data[0], 1000) == 1000 && matches(resourceSize / 2, &data[0], 1000), "stream read after seeking far forward");
+    check(stream.seek(10) == 10 && stream.read(&data[0], 1000) == 1000 && matches(10, &data[0], 1000), "stream seek backward");
+    check(stream.tell() == 1010, "stream position");
+
+    stream.seek(0);
+    std::size_t total = 0;
+    bool streamValid = true;
+    clock.restart();
+    for (sf::Int64 count; (count = stream.read(&data[0], data.size())) > 0; total += static_cast<std::size_t>(count))
+        streamValid = streamValid && matches(total, &data[0], static_cast<std::size_t>(count));
+    printThroughput("input stream", resourceSize, clock.getElapsedTime());
+    check(streamValid && (total == resourceSize), "stream content");
+    stream.close();
+
+    server.stop();
+
+    return reportChecks();
+}
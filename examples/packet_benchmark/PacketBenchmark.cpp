@@ -0,0 +1,310 @@
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Network.hpp>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+
+namespace
+{
+    const unsigned int iterations = 20000;
+    const std::size_t  arraySize  = 256;
+
+    // Numbers mostly small, like counters, identifiers or deltas
+    std::vector<sf::Uint32> numbers;
+    std::vector<sf::Int32>  deltas;
+    sf::String              text;
+
+    // Checksum of the decoded values, so that the decoding can't be optimized away
+    sf::Uint32 checksum = 0;
+
+    void printResult(const char* name, const sf::Packet& packet, sf::Time time)
+    {
+        std::cout << std::left << std::setw(36) << name
+                  << std::right << std::setw(8) << packet.getDataSize() << " bytes/op"
+                  << std::setw(10) << std::fixed << std::setprecision(1)
+                  << time.asMicroseconds() * 1000.0 / iterations << " ns/op" << std::endl;
+    }
+
+    ////////////////////////////////////////////////////////////
+    // Integer arrays
+    ////////////////////////////////////////////////////////////
+    void writeOperator(sf::Packet& packet)
+    {
+        for (std::size_t i = 0; i < arraySize; ++i)
+            packet << numbers[i];
+    }
+
+    void readOperator(sf::Packet& packet)
+    {
+        for (std::size_t i = 0; i < arraySize; ++i)
+        {
+            sf::Uint32 value;
+            packet >> value;
+            checksum += value;
+        }
+    }
+
+    void writeBulk(sf::Packet& packet)
+    {
+        packet.write(&numbers[0], arraySize);
+    }
+
+    void readBulk(sf::Packet& packet)
+    {
+        sf::Uint32 values[arraySize];
+        packet.read(values, arraySize);
+        checksum += values[arraySize - 1];
+    }
+
+    void writeVarints(sf::Packet& packet)
+    {
+        for (std::size_t i = 0; i < arraySize; ++i)
+            packet.writeVarint(numbers[i]);
+    }
+
+    void readVarints(sf::Packet& packet)
+    {
+        for (std::size_t i = 0; i < arraySize; ++i)
+        {
+            sf::Uint32 value;
+            packet.readVarint(value);
+            checksum += value;
+        }
+    }
+
+    void writeSignedOperator(sf::Packet& packet)
+    {
+        for (std::size_t i = 0; i < arraySize; ++i)
+            packet << deltas[i];
+    }
+
+    void readSignedOperator(sf::Packet& packet)
+    {
+        for (std::size_t i = 0; i < arraySize; ++i)
+        {
+            sf::Int32 value;
+            packet >> value;
+            checksum += value;
+        }
+    }
+
+    void writeZigZag(sf::Packet& packet)
+    {
+        for (std::size_t i = 0; i < arraySize; ++i)
+            packet.writeVarint(deltas[i]);
+    }
+
+    void readZigZag(sf::Packet& packet)
+    {
+        for (std::size_t i = 0; i < arraySize; ++i)
+        {
+            sf::Int32 value;
+            packet.readVarint(value);
+            checksum += value;
+        }
+    }
+
+    ////////////////////////////////////////////////////////////
+    // Strings
+    ////////////////////////////////////////////////////////////
+    void writeUtf32(sf::Packet& packet)
+    {
+        packet << text;
+    }
+
+    void readUtf32(sf::Packet& packet)
+    {
+        sf::String value;
+        packet >> value;
+        checksum += value.getSize();
+    }
+
+    void writeUtf8(sf::Packet& packet)
+    {
+        packet.writeUtf8(text);
+    }
+
+    void readUtf8(sf::Packet& packet)
+    {
+        sf::String value;
+        packet.readUtf8(value);
+        checksum += value.getSize();
+    }
+
+    ////////////////////////////////////////////////////////////
+    // Small messages, like the ones of a game
+    ////////////////////////////////////////////////////////////
+    void writeMessage(sf::Packet& packet)
+    {
+        packet << sf::Uint8(3) << sf::Uint32(1234) << 1.5f << 2.5f << sf::Uint16(100);
+    }
+
+    void readMessage(sf::Packet& packet)
+    {
+        sf::Uint8 type;
+        sf::Uint32 id;
+        float x, y;
+        sf::Uint16 health;
+        packet >> type >> id >> x >> y >> health;
+        checksum += id + health;
+    }
+
+    ////////////////////////////////////////////////////////////
+    // Measure the writing and the reading of a packet, reused or not
+    ////////////////////////////////////////////////////////////
+    void measure(const char* name, void (*write)(sf::Packet&), void (*read)(sf::Packet&))
+    {
+        sf::Packet packet;
+        sf::Clock clock;
+
+        // Writing with a new packet every time, which must allocate its storage
+        clock.restart();
+        for (unsigned int i = 0; i < iterations; ++i)
+        {
+            sf::Packet fresh;
+            write(fresh);
+        }
+        sf::Time freshTime = clock.getElapsedTime();
+
+        // Writing with the same packet, whose storage is reused
+        clock.restart();
+        for (unsigned int i = 0; i < iterations; ++i)
+        {
+            packet.clear();
+            write(packet);
+        }
+        sf::Time reusedTime = clock.getElapsedTime();
+
+        // Reading
+        sf::Packet received;
+        received.append(packet.getData(), packet.getDataSize());
+        clock.restart();
+        for (unsigned int i = 0; i < iterations; ++i)
+        {
+            sf::Packet copy(received);
+            read(copy);
+            if (!copy)
+                std::cout << "Failed to read " << name << std::endl;
+        }
+        sf::Time readTime = clock.getElapsedTime();
+
+        std::cout << name << std::endl;
+        printResult("  write (new packet)", packet, freshTime);
+        printResult("  write (reused packet)", packet, reusedTime);
+        printResult("  read", packet, readTime);
+    }
+
+    ////////////////////////////////////////////////////////////
+    // Make sure that UTF-8 strings survive the growth of the packet's
+    // storage, whatever the data that precedes them
+    ////////////////////////////////////////////////////////////
+    void checkUtf8Growth()
+    {
+        const char* strings[] = {"", "A", "AB", "Hello", "A longer string, that doesn't fit in small storage at all"};
+        for (std::size_t prefix = 0; prefix < 300; ++prefix)
+        {
+            for (std::size_t i = 0; i < sizeof(strings) / sizeof(*strings); ++i)
+            {
+                sf::Packet packet;
+                std::vector<char> data(prefix + 1, 'x');
+                packet.append(&data[0], prefix);
+                packet.writeUtf8(strings[i]);
+
+                sf::Int8 skipped;
+                for (std::size_t j = 0; j < prefix; ++j)
+                    packet >> skipped;
+
+                sf::String value;
+                packet.readUtf8(value);
+                if (!packet || (value != strings[i]))
+                    std::cout << "Failed to read a UTF-8 string after " << prefix << " bytes" << std::endl;
+            }
+        }
+    }
+
+    ////////////////////////////////////////////////////////////
+    // Compare allocating packets with taking them from a pool
+    ////////////////////////////////////////////////////////////
+    void measurePool()
+    {
+        const std::size_t inFlight = 64;
+        sf::Packet* packets[inFlight];
+        sf::Clock clock;
+
+        // New packets every time
+        clock.restart();
+        for (unsigned int i = 0; i < iterations / inFlight; ++i)
+        {
+            for (std::size_t j = 0; j < inFlight; ++j)
+            {
+                packets[j] = new sf::Packet;
+                writeBulk(*packets[j]);
+            }
+            for (std::size_t j = 0; j < inFlight; ++j)
+                delete packets[j];
+        }
+        sf::Time newTime = clock.getElapsedTime();
+
+        // Packets taken from a pool
+        sf::PacketPool pool;
+        clock.restart();
+        for (unsigned int i = 0; i < iterations / inFlight; ++i)
+        {
+            for (std::size_t j = 0; j < inFlight; ++j)
+            {
+                packets[j] = pool.acquire();
+                writeBulk(*packets[j]);
+            }
+            for (std::size_t j = 0; j < inFlight; ++j)
+                pool.release(packets[j]);
+        }
+        sf::Time poolTime = clock.getElapsedTime();
+
+        std::size_t count = iterations / inFlight * inFlight;
+        std::cout << "1 KB packets, " << inFlight << " in flight" << std::endl
+                  << "  new/delete                     " << std::setw(10) << newTime.asMicroseconds() * 1000.0 / count << " ns/op" << std::endl
+                  << "  pool acquire/release           " << std::setw(10) << poolTime.asMicroseconds() * 1000.0 / count << " ns/op" << std::endl;
+
+        sf::PacketPool::Statistics statistics = pool.getStatistics();
+        std::cout << "  pool: " << statistics.acquired << " acquired, " << statistics.allocated << " allocated, "
+                  << statistics.peakInUse << " in use at most, " << statistics.available << " available" << std::endl;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+/// Entry point of application
+///
+/// \return Application exit code
+///
+////////////////////////////////////////////////////////////
+int main()
+{
+    std::srand(42);
+    for (std::size_t i = 0; i < arraySize; ++i)
+    {
+        numbers.push_back(std::rand() % (i % 8 == 0 ? 100000 : 100));
+        deltas.push_back(std::rand() % 200 - 100);
+    }
+    text = L"Bonjour à tous, ceci est un message de discussion assez ordinaire !";
+
+    measure("256 x Uint32, operator <<", &writeOperator, &readOperator);
+    measure("256 x Uint32, write/read", &writeBulk, &readBulk);
+    measure("256 x Uint32, varint", &writeVarints, &readVarints);
+    measure("256 x Int32, operator <<", &writeSignedOperator, &readSignedOperator);
+    measure("256 x Int32, zig-zag varint", &writeZigZag, &readZigZag);
+    measure("sf::String, operator << (UTF-32)", &writeUtf32, &readUtf32);
+    measure("sf::String, writeUtf8", &writeUtf8, &readUtf8);
+    measure("Small message", &writeMessage, &readMessage);
+    measurePool();
+    checkUtf8Growth();
+
+    std::cout << "(checksum " << checksum << ")" << std::endl;
+
+    return EXIT_SUCCESS;
+}
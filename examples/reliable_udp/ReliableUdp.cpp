@@ -0,0 +1,174 @@
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Network.hpp>
+#include <cstdlib>
+#include <iostream>
+
+
+namespace
+{
+    // Channels, created in the same order on both sides
+    enum
+    {
+        Reliable,
+        Unreliable,
+        Sequenced
+    };
+
+    const unsigned int messageCount = 2000;
+    const unsigned int bigPacketSize = 200000;
+
+    void addChannels(sf::UdpHost& host)
+    {
+        host.addChannel(sf::UdpHost::ReliableOrdered);
+        host.addChannel(sf::UdpHost::Unreliable);
+        host.addChannel(sf::UdpHost::UnreliableSequenced);
+    }
+
+    void printStatistics(const char* name, const sf::UdpHost::Statistics& statistics)
+    {
+        std::cout << name << ": "
+                  << statistics.packetsSent << " packets sent, "
+                  << statistics.packetsReceived << " received, "
+                  << statistics.packetsDropped << " dropped; "
+                  << statistics.datagramsSent << " datagrams sent, "
+                  << statistics.datagramsLost << " lost, "
+                  << statistics.fragmentsResent << " fragments resent; RTT "
+                  << statistics.roundTripTime.asMilliseconds() << " ms" << std::endl;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+/// Entry point of application
+///
+/// \return Application exit code
+///
+////////////////////////////////////////////////////////////
+int main()
+{
+    // Create the server
+    sf::UdpHost server;
+    addChannels(server);
+    if (server.listen(sf::Socket::AnyPort) != sf::Socket::Done)
+        return EXIT_FAILURE;
+
+    // Create the client, on a network that loses 10% of the datagrams and adds 50 ms of latency
+    sf::UdpHost client;
+    addChannels(client);
+    client.simulateNetwork(0.1f, sf::milliseconds(50));
+    server.simulateNetwork(0.1f, sf::milliseconds(50));
+
+    sf::UdpHost::Connection connection = client.connect(sf::IpAddress::LocalHost, server.getLocalPort());
+    std::cout << "Connecting to port " << server.getLocalPort() << "..." << std::endl;
+
+    // Queue the messages: numbered reliable ones with a big packet in the middle, and unreliable ones
+    for (sf::Uint32 i = 0; i < messageCount; ++i)
+    {
+        sf::Packet packet;
+        packet << i;
+        if (i == messageCount / 2)
+        {
+            for (sf::Uint32 j = 0; j < bigPacketSize / 4; ++j)
+                packet << j;
+        }
+        client.send(connection, Reliable, packet);
+
+        sf::Packet position;
+        position << i << static_cast<float>(i) * 0.5f;
+        client.send(connection, i % 2 ? Unreliable : Sequenced, position);
+    }
+
+    // Exchange the data
+    sf::Clock clock;
+    sf::Uint32 expected = 0;
+    unsigned int unreliable = 0;
+    unsigned int sequenced = 0;
+    sf::Uint32 lastSequenced = 0;
+    bool valid = true;
+    sf::UdpHost::Connection remote = 0;
+    while ((expected < messageCount) && (clock.getElapsedTime() < sf::seconds(30)))
+    {
+        sf::UdpHost::Event event;
+        while (client.pollEvent(event))
+        {
+            if (event.type == sf::UdpHost::Event::Connected)
+                std::cout << "Client connected" << std::endl;
+        }
+
+        while (server.pollEvent(event))
+        {
+            if (event.type == sf::UdpHost::Event::Connected)
+            {
+                remote = event.connection;
+                std::cout << "Client accepted from " << server.getRemoteAddress(remote) << ":" << server.getRemotePort(remote) << std::endl;
+            }
+            else if (event.type == sf::UdpHost::Event::Received)
+            {
+                sf::Uint32 number = 0;
+                event.packet >> number;
+
+                if (event.channel == Reliable)
+                {
+                    // Reliable packets must all arrive, in order
+                    if (number != expected++)
+                        valid = false;
+
+                    if (number == messageCount / 2)
+                    {
+                        for (sf::Uint32 j = 0; j < bigPacketSize / 4; ++j)
+                        {
+                            sf::Uint32 value = 0;
+                            if (!(event.packet >> value) || (value != j))
+                                valid = false;
+                        }
+                    }
+                }
+                else if (event.channel == Sequenced)
+                {
+                    // Sequenced packets may be lost, but never arrive out of order
+                    if ((sequenced > 0) && (number <= lastSequenced))
+                        valid = false;
+
+                    lastSequenced = number;
+                    sequenced++;
+                }
+                else
+                {
+                    unreliable++;
+                }
+            }
+        }
+
+        sf::sleep(sf::milliseconds(1));
+    }
+
+    std::cout << "Received " << expected << " reliable packets in " << clock.getElapsedTime().asMilliseconds() << " ms, "
+              << sequenced << " sequenced and " << unreliable << " unreliable packets" << std::endl;
+    printStatistics("Client", client.getStatistics(connection));
+    printStatistics("Server", server.getStatistics(remote));
+
+    client.disconnect(connection);
+
+    // Wait for the server to notice
+    sf::UdpHost::Event event;
+    while (clock.getElapsedTime() < sf::seconds(32))
+    {
+        if (server.pollEvent(event) && (event.type == sf::UdpHost::Event::Disconnected))
+        {
+            std::cout << "Client disconnected" << std::endl;
+            break;
+        }
+        sf::sleep(sf::milliseconds(1));
+    }
+
+    if (!valid || (expected < messageCount))
+    {
+        std::cout << "The reliable channel failed" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,206 @@
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include "Checks.hpp"
+#include <SFML/Network.hpp>
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <map>
+#include <string>
+
+
+namespace
+{
+    const unsigned short firstPort = 50090;
+
+    ////////////////////////////////////////////////////////////
+    // Collects the results given by the resolver
+    ////////////////////////////////////////////////////////////
+    struct Collector
+    {
+        Collector(std::multimap<std::string, sf::IpAddress>* results) : m_results(results) {}
+
+        void operator ()(const std::string& host, const sf::IpAddress& address)
+        {
+            m_results->insert(std::make_pair(host, address));
+        }
+
+        std::multimap<std::string, sf::IpAddress>* m_results;
+    };
+
+    ////////////////////////////////////////////////////////////
+    // Call update() until all the callbacks are invoked,
+    // and return the longest time spent in a single call
+    ////////////////////////////////////////////////////////////
+    sf::Time waitForResults(sf::Resolver& resolver)
+    {
+        sf::Clock clock;
+        sf::Time longest = sf::Time::Zero;
+        while ((resolver.getPendingCount() > 0) && (clock.getElapsedTime() < sf::seconds(20)))
+        {
+            sf::Clock call;
+            resolver.update();
+            longest = std::max(longest, call.getElapsedTime());
+            sf::sleep(sf::milliseconds(1));
+        }
+
+        return longest;
+    }
+
+    ////////////////////////////////////////////////////////////
+    // Listen on the first free port from firstPort
+    ////////////////////////////////////////////////////////////
+    unsigned short listen(sf::TcpListener& listener, const sf::IpAddress& address)
+    {
+        for (unsigned short port = firstPort; port < firstPort + 10; ++port)
+        {
+            if (listener.listen(port, address) == sf::Socket::Done)
+                return port;
+        }
+
+        return 0;
+    }
+
+    unsigned short bind(sf::UdpSocket& socket, const sf::IpAddress& address)
+    {
+        for (unsigned short port = firstPort; port < firstPort + 10; ++port)
+        {
+            if (socket.bind(port, address) == sf::Socket::Done)
+                return port;
+        }
+
+        return 0;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+/// Entry point of application
+///
+/// \return Application exit code
+///
+////////////////////////////////////////////////////////////
+int main()
+{
+    // Parse and format addresses of both types
+    check(sf::IpAddress("192.168.1.50").toString() == "192.168.1.50", "IPv4 address round trip");
+    check(sf::IpAddress("192.168.1.50").getType() == sf::IpAddress::IPv4, "IPv4 address type");
+    check(sf::IpAddress("::1") == sf::IpAddress::LocalHostIPv6, "IPv6 loopback address");
+    check(sf::IpAddress("2001:DB8:0:0::1").toString() == "2001:db8::1", "IPv6 address formatted in canonical form");
+    check(sf::IpAddress("2001:db8::1").getType() == sf::IpAddress::IPv6, "IPv6 address type");
+    check(sf::IpAddress("2001:db8::1").toInteger() == 0, "IPv6 address has no integer form");
+    check(sf::IpAddress("::ffff:10.0.0.1") == sf::IpAddress(10, 0, 0, 1), "IPv4-mapped address is an IPv4 address");
+    check(sf::IpAddress("fe80::1::2") == sf::IpAddress::None, "invalid IPv6 address rejected");
+    check(sf::IpAddress::None != sf::IpAddress::Any, "None is not the same address as Any");
+    check(sf::IpAddress::None.toString().empty() && (sf::IpAddress::AnyIPv6.toString() == "::"), "None is not formatted as AnyIPv6");
+
+    sf::TcpSocket unconnected;
+    std::cout << "(an error is expected below)" << std::endl;
+    check(unconnected.connect(sf::IpAddress::None, 80) == sf::Socket::Error, "connecting to None fails");
+
+    sf::Uint8 bytes[16];
+    sf::IpAddress("2001:db8::42").toBytes(bytes);
+    check(sf::IpAddress(bytes) == sf::IpAddress("2001:db8::42"), "IPv6 address bytes round trip");
+
+    // Resolve names without blocking the calling thread
+    {
+        sf::Resolver resolver;
+        std::multimap<std::string, sf::IpAddress> results;
+
+        sf::Clock clock;
+        resolver.resolve("localhost", Collector(&results));
+        resolver.resolve("localhost", Collector(&results));
+        resolver.resolve("10.0.0.1", Collector(&results));
+        resolver.resolve("name.invalid", Collector(&results));
+        check(clock.getElapsedTime() < sf::milliseconds(50), "resolve returns immediately");
+        check(resolver.getPendingCount() == 4, "requests pending");
+
+        sf::Time longest = waitForResults(resolver);
+        std::cout << "Longest update call: " << longest.asMicroseconds() << " us" << std::endl;
+        check(resolver.getPendingCount() == 0, "all requests answered");
+        check(results.count("localhost") == 2, "both localhost requests answered");
+        check(results.find("localhost")->second == sf::IpAddress::LocalHost, "localhost resolved");
+        check(results.find("10.0.0.1")->second == sf::IpAddress(10, 0, 0, 1), "numeric address resolved");
+        check(results.find("name.invalid")->second == sf::IpAddress::None, "invalid name not resolved");
+
+        // The results are now in the cache
+        sf::IpAddress cached;
+        check(resolver.lookup("localhost", cached) && (cached == sf::IpAddress::LocalHost), "resolved name cached");
+        check(resolver.lookup("name.invalid", cached) && (cached == sf::IpAddress::None), "failed resolution cached");
+        check(!resolver.lookup("example.invalid", cached), "unknown name not cached");
+
+        results.clear();
+        resolver.resolve("localhost", Collector(&results));
+        check(resolver.update() == 1 && results.size() == 1, "cached name answered by the next update");
+
+        resolver.clearCache();
+        check(!resolver.lookup("localhost", cached), "cache cleared");
+    }
+
+    // Cached entries expire
+    {
+        sf::Resolver resolver(1, sf::milliseconds(50), sf::milliseconds(50));
+        std::multimap<std::string, sf::IpAddress> results;
+        resolver.resolve("localhost", Collector(&results));
+        waitForResults(resolver);
+
+        sf::IpAddress cached;
+        check(resolver.lookup("localhost", cached), "name cached before expiration");
+        sf::sleep(sf::milliseconds(100));
+        check(!resolver.lookup("localhost", cached), "name expired");
+    }
+
+    // Exchange data over IPv6; a socket bound to AnyIPv6 also talks to IPv4 peers
+    sf::TcpListener listener;
+    unsigned short port = listen(listener, sf::IpAddress::AnyIPv6);
+    if (port == 0)
+    {
+        std::cout << "IPv6 is not available, skipping the socket checks" << std::endl;
+    }
+    else
+    {
+        sf::TcpSocket client6;
+        sf::TcpSocket client4;
+        sf::TcpSocket accepted6;
+        sf::TcpSocket accepted4;
+        check(client6.connect(sf::IpAddress::LocalHostIPv6, port) == sf::Socket::Done, "TCP connection over IPv6");
+        check(listener.accept(accepted6) == sf::Socket::Done, "IPv6 connection accepted");
+        check(accepted6.getRemoteAddress() == sf::IpAddress::LocalHostIPv6, "IPv6 remote address");
+        check(client6.getRemoteAddress() == sf::IpAddress::LocalHostIPv6, "IPv6 server address");
+        check(client4.connect(sf::IpAddress::LocalHost, port) == sf::Socket::Done, "TCP connection over IPv4 to a dual-stack listener");
+        check(listener.accept(accepted4) == sf::Socket::Done, "IPv4 connection accepted");
+        check(accepted4.getRemoteAddress() == sf::IpAddress::LocalHost, "IPv4 remote address seen by a dual-stack listener");
+
+        sf::Packet packet;
+        packet << "over IPv6";
+        std::string text;
+        check(client6.send(packet) == sf::Socket::Done && accepted6.receive(packet) == sf::Socket::Done && (packet >> text) && (text == "over IPv6"), "TCP data over IPv6");
+
+        sf::UdpSocket server;
+        unsigned short udpPort = bind(server, sf::IpAddress::AnyIPv6);
+        check(udpPort != 0, "UDP socket bound to IPv6");
+
+        sf::UdpSocket sender6;
+        sf::UdpSocket sender4;
+        const char message[] = "datagram";
+        char buffer[64];
+        std::size_t received = 0;
+        sf::IpAddress sender;
+        unsigned short senderPort = 0;
+
+        check(sender6.send(message, sizeof(message), sf::IpAddress::LocalHostIPv6, udpPort) == sf::Socket::Done, "UDP datagram sent over IPv6");
+        check(server.receive(buffer, sizeof(buffer), received, sender, senderPort) == sf::Socket::Done && (received == sizeof(message)), "UDP datagram received over IPv6");
+        check(sender == sf::IpAddress::LocalHostIPv6 && senderPort == sender6.getLocalPort(), "UDP IPv6 sender");
+
+        check(sender4.send(message, sizeof(message), sf::IpAddress::LocalHost, udpPort) == sf::Socket::Done, "UDP datagram sent over IPv4");
+        check(server.receive(buffer, sizeof(buffer), received, sender, senderPort) == sf::Socket::Done && (received == sizeof(message)), "UDP datagram received over IPv4");
+        check(sender == sf::IpAddress::LocalHost && senderPort == sender4.getLocalPort(), "UDP IPv4 sender seen by a dual-stack socket");
+
+        std::cout << "(an error is expected below)" << std::endl;
+        check(sender4.send(message, sizeof(message), sf::IpAddress::LocalHostIPv6, udpPort) == sf::Socket::Error, "IPv4 socket refuses IPv6 destinations");
+    }
+
+    return reportChecks();
+}
@@ -0,0 +1,153 @@
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Network.hpp>
+#include <sys/resource.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+
+////////////////////////////////////////////////////////////
+/// Socket wrapping one end of a local socket pair
+///
+////////////////////////////////////////////////////////////
+class PairSocket : public sf::TcpSocket
+{
+public :
+
+    void open(sf::SocketHandle handle)
+    {
+        create(handle);
+    }
+};
+
+
+////////////////////////////////////////////////////////////
+/// Raise the limit of open files, so that thousands of
+/// socket pairs can be created
+///
+/// \param count Number of file descriptors needed
+///
+////////////////////////////////////////////////////////////
+void raiseFileLimit(rlim_t count)
+{
+    rlimit limit;
+    if ((getrlimit(RLIMIT_NOFILE, &limit) == 0) && (limit.rlim_cur < count))
+    {
+        limit.rlim_cur = std::min(count, limit.rlim_max);
+        setrlimit(RLIMIT_NOFILE, &limit);
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+/// Entry point of application
+///
+/// \param argc Number of command line arguments
+/// \param argv Values of the command line arguments: number
+///             of socket pairs, and number of sockets made
+///             ready for each wait
+///
+/// \return Application exit code
+///
+////////////////////////////////////////////////////////////
+int main(int argc, char* argv[])
+{
+    std::size_t pairCount   = argc > 1 ? std::atoi(argv[1]) : 10000;
+    std::size_t activeCount = argc > 2 ? std::atoi(argv[2]) : 50;
+    const int   rounds      = 200;
+
+    raiseFileLimit(pairCount * 2 + 64);
+
+    // Local sockets don't support TCP options: silence the warnings
+    sf::err().rdbuf(NULL);
+
+    // Create the socket pairs: the selector watches one end, and we write to the other
+    std::vector<PairSocket*> sockets;
+    std::vector<int> peers;
+    sf::SocketSelector selector;
+    for (std::size_t i = 0; i < pairCount; ++i)
+    {
+        int handles[2];
+        if (socketpair(AF_UNIX, SOCK_STREAM, 0, handles) != 0)
+        {
+            std::cout << "Could only create " << i << " socket pairs" << std::endl;
+            break;
+        }
+
+        PairSocket* socket = new PairSocket;
+        socket->open(handles[0]);
+        sockets.push_back(socket);
+        peers.push_back(handles[1]);
+        selector.add(*socket);
+    }
+
+    if (sockets.empty() || (activeCount == 0))
+        return EXIT_FAILURE;
+
+    std::cout << sockets.size() << " sockets, " << activeCount << " ready per wait" << std::endl;
+
+    // Make a few sockets ready, wait, then find them either by testing
+    // all the sockets (isReady) or by iterating over the ready ones
+    for (int mode = 0; mode < 2; ++mode)
+    {
+        sf::Time waitTime;
+        sf::Time scanTime;
+        std::size_t received = 0;
+
+        for (int round = 0; round < rounds; ++round)
+        {
+            for (std::size_t i = 0; i < activeCount; ++i)
+            {
+                char byte = 1;
+                if (write(peers[(round * 7919 + i * 104729) % peers.size()], &byte, 1) != 1)
+                    return EXIT_FAILURE;
+            }
+
+            sf::Clock clock;
+            if (!selector.wait(sf::seconds(1)))
+                break;
+            waitTime += clock.restart();
+
+            char data[64];
+            std::size_t size;
+            if (mode == 0)
+            {
+                for (std::vector<PairSocket*>::iterator it = sockets.begin(); it != sockets.end(); ++it)
+                {
+                    if (selector.isReady(**it))
+                    {
+                        (*it)->receive(data, sizeof(data), size);
+                        received += size;
+                    }
+                }
+            }
+            else
+            {
+                for (std::size_t i = 0; i < selector.getReadyCount(); ++i)
+                {
+                    static_cast<sf::TcpSocket&>(selector.getReadySocket(i)).receive(data, sizeof(data), size);
+                    received += size;
+                }
+            }
+            scanTime += clock.getElapsedTime();
+        }
+
+        std::cout << std::setw(16) << std::left << (mode == 0 ? "isReady scan" : "ready iteration")
+                  << " wait: " << std::setw(8) << waitTime.asMicroseconds() / rounds << " us"
+                  << " dispatch: " << std::setw(8) << scanTime.asMicroseconds() / rounds << " us"
+                  << " (" << received << " bytes)" << std::endl;
+    }
+
+    for (std::size_t i = 0; i < sockets.size(); ++i)
+    {
+        delete sockets[i];
+        close(peers[i]);
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,319 @@
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include "Checks.hpp"
+#include <SFML/Network.hpp>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+
+namespace
+{
+    ////////////////////////////////////////////////////////////
+    // State of an entity of the world
+    ////////////////////////////////////////////////////////////
+    struct Entity
+    {
+        sf::Uint32   id;
+        sf::Vector3f position;
+        float        yaw;
+        sf::Uint8    color[4];
+        sf::Uint8    health;
+        bool         alive;
+    };
+
+    // Precision of the fields
+    const float        worldSize     = 1000.f;
+    const unsigned int positionBits  = 20;     // about 2 mm in a 2 km world
+    const unsigned int yawBits       = 10;     // about 0.35 degree
+    const unsigned int idBits        = 12;
+    const unsigned int healthBits    = 7;
+    const std::size_t  entityCount   = 256;
+    const unsigned int tickCount     = 300;
+
+    float random(float min, float max)
+    {
+        return min + (max - min) * static_cast<float>(std::rand()) / RAND_MAX;
+    }
+
+    ////////////////////////////////////////////////////////////
+    // Encodings of a snapshot
+    ////////////////////////////////////////////////////////////
+    void writeFull(sf::Packet& packet, const std::vector<Entity>& entities)
+    {
+        for (std::vector<Entity>::const_iterator it = entities.begin(); it != entities.end(); ++it)
+        {
+            packet << it->id << it->position.x << it->position.y << it->position.z << it->yaw;
+            packet << it->color[0] << it->color[1] << it->color[2] << it->color[3] << it->health << it->alive;
+        }
+    }
+
+    void writeQuantized(sf::Packet& packet, const std::vector<Entity>& entities)
+    {
+        sf::BitWriter writer(packet);
+        for (std::vector<Entity>::const_iterator it = entities.begin(); it != entities.end(); ++it)
+        {
+            writer.writeBits(it->id, idBits);
+            writer.writeVector(it->position, -worldSize, worldSize, positionBits);
+            writer.writeFloat(it->yaw, 0.f, 360.f, yawBits);
+            for (int i = 0; i < 4; ++i)
+                writer.writeBits(it->color[i], 8);
+            writer.writeBits(it->health, healthBits);
+            writer.writeBool(it->alive);
+        }
+    }
+
+    void writeDelta(sf::Packet& packet, const std::vector<Entity>& entities, const std::vector<Entity>& baseline)
+    {
+        // The receiver knows the baseline, so the identifiers are implicit
+        sf::BitWriter writer(packet);
+        for (std::size_t i = 0; i < entities.size(); ++i)
+        {
+            const Entity& entity = entities[i];
+            const Entity& base = baseline[i];
+
+            // One bit for the whole entity, then one bit per field
+            sf::Uint32 color = (entity.color[0] << 24) | (entity.color[1] << 16) | (entity.color[2] << 8) | entity.color[3];
+            sf::Uint32 baseColor = (base.color[0] << 24) | (base.color[1] << 16) | (base.color[2] << 8) | base.color[3];
+            bool changed = (sf::BitWriter::quantize(entity.position.x, -worldSize, worldSize, positionBits) != sf::BitWriter::quantize(base.position.x, -worldSize, worldSize, positionBits)) ||
+                           (sf::BitWriter::quantize(entity.position.y, -worldSize, worldSize, positionBits) != sf::BitWriter::quantize(base.position.y, -worldSize, worldSize, positionBits)) ||
+                           (sf::BitWriter::quantize(entity.position.z, -worldSize, worldSize, positionBits) != sf::BitWriter::quantize(base.position.z, -worldSize, worldSize, positionBits)) ||
+                           (sf::BitWriter::quantize(entity.yaw, 0.f, 360.f, yawBits) != sf::BitWriter::quantize(base.yaw, 0.f, 360.f, yawBits)) ||
+                           (color != baseColor) || (entity.health != base.health) || (entity.alive != base.alive);
+
+            writer.writeBool(changed);
+            if (!changed)
+                continue;
+
+            writer.writeDelta(entity.position, base.position, -worldSize, worldSize, positionBits);
+            writer.writeDelta(entity.yaw, base.yaw, 0.f, 360.f, yawBits);
+            writer.writeDelta(color, baseColor, 32);
+            writer.writeDelta(entity.health, base.health, healthBits);
+            writer.writeDelta(entity.alive ? 1 : 0, base.alive ? 1 : 0, 1);
+        }
+    }
+
+    void readDelta(sf::Packet& packet, std::vector<Entity>& entities, const std::vector<Entity>& baseline)
+    {
+        sf::BitReader reader(packet);
+        for (std::size_t i = 0; i < entities.size(); ++i)
+        {
+            Entity& entity = entities[i];
+            const Entity& base = baseline[i];
+
+            entity = base;
+            if (!reader.readBool())
+                continue;
+
+            sf::Uint32 baseColor = (base.color[0] << 24) | (base.color[1] << 16) | (base.color[2] << 8) | base.color[3];
+            entity.position = reader.readDelta(base.position, -worldSize, worldSize, positionBits);
+            entity.yaw      = reader.readDelta(base.yaw, 0.f, 360.f, yawBits);
+            sf::Uint32 color = reader.readDelta(baseColor, 32);
+            for (int j = 0; j < 4; ++j)
+                entity.color[j] = static_cast<sf::Uint8>(color >> (24 - 8 * j));
+            entity.health   = static_cast<sf::Uint8>(reader.readDelta(base.health, healthBits));
+            entity.alive    = reader.readDelta(base.alive ? 1 : 0, 1) != 0;
+        }
+
+        check(reader.isValid(), "delta snapshot is complete");
+    }
+
+    ////////////////////////////////////////////////////////////
+    // Round-trip checks of the bit writer and reader
+    ////////////////////////////////////////////////////////////
+    void checkRoundTrips()
+    {
+        // Integers of every width
+        {
+            sf::Packet packet;
+            std::vector<sf::Uint32> values;
+            {
+                sf::BitWriter writer(packet);
+                for (unsigned int bits = 1; bits <= 32; ++bits)
+                {
+                    sf::Uint32 value = (static_cast<sf::Uint32>(std::rand()) << 16) ^ static_cast<sf::Uint32>(std::rand());
+                    sf::Uint32 mask = bits < 32 ? (1u << bits) - 1 : 0xFFFFFFFF;
+                    values.push_back(value & mask);
+                    writer.writeBits(value, bits);
+                }
+                check(writer.getBitCount() == 32 * 33 / 2, "bit count");
+            }
+            check(packet.getDataSize() == (32 * 33 / 2 + 7) / 8, "packet size is rounded to bytes");
+
+            sf::BitReader reader(packet);
+            for (unsigned int bits = 1; bits <= 32; ++bits)
+                check(reader.readBits(bits) == values[bits - 1], "integers of every width");
+            check(reader.isValid(), "integers are read successfully");
+        }
+
+        // Floats, booleans, and regular packet data after the bits
+        {
+            sf::Packet packet;
+            {
+                sf::BitWriter writer(packet);
+                writer.writeBool(true);
+                writer.writeFloat(3.14159f);
+                writer.writeFloat(-12.345f, -100.f, 100.f, 16);
+                writer.writeFloat(1e6f, -100.f, 100.f, 8);
+                writer.writeFloat(std::sqrt(-1.f), 0.f, 1.f, 8);
+                writer.writeVector(sf::Vector2f(1.5f, -2.5f), -10.f, 10.f, 12);
+                writer.writeBool(false);
+            }
+            packet << sf::Uint32(0xDEADBEEF);
+
+            sf::BitReader reader(packet);
+            check(reader.readBool(), "boolean true");
+            check(reader.readFloat() == 3.14159f, "float with full precision");
+            check(std::fabs(reader.readFloat(-100.f, 100.f, 16) + 12.345f) <= 200.f / 65535, "quantized float");
+            check(reader.readFloat(-100.f, 100.f, 8) == 100.f, "quantized float is clamped");
+            check(reader.readFloat(0.f, 1.f, 8) == 0.f, "NaN is quantized to the minimum");
+            sf::Vector2f vector = reader.readVector2(-10.f, 10.f, 12);
+            check((std::fabs(vector.x - 1.5f) <= 20.f / 4095) && (std::fabs(vector.y + 2.5f) <= 20.f / 4095), "quantized vector");
+            check(!reader.readBool(), "boolean false");
+
+            sf::Uint32 trailer = 0;
+            check((packet >> trailer) && (trailer == 0xDEADBEEF), "packet data after the bits");
+        }
+
+        // Deltas
+        {
+            sf::Packet packet;
+            {
+                sf::BitWriter writer(packet);
+                check(!writer.writeDelta(10u, 10u, 8), "unchanged integer is skipped");
+                check(writer.writeDelta(11u, 10u, 8), "changed integer is written");
+                check(!writer.writeDelta(1.0001f, 1.f, 0.f, 10.f, 8), "change below the precision is skipped");
+                check(writer.writeDelta(sf::Vector3f(1, 2, 3), sf::Vector3f(1, 2, 4), 0.f, 10.f, 16), "changed vector is written");
+                check(writer.getBitCount() == 1 + 9 + 1 + 1 + 48, "deltas cost one bit when unchanged");
+            }
+
+            sf::BitReader reader(packet);
+            check(reader.readDelta(10u, 8) == 10, "unchanged integer keeps the baseline");
+            check(reader.readDelta(10u, 8) == 11, "changed integer is read");
+            check(reader.readDelta(1.f, 0.f, 10.f, 8) == 1.f, "unchanged float keeps the baseline");
+            sf::Vector3f vector = reader.readDelta(sf::Vector3f(1, 2, 4), 0.f, 10.f, 16);
+            check(std::fabs(vector.z - 3.f) <= 10.f / 65535, "changed vector is read");
+        }
+
+        // Truncated packet
+        {
+            sf::Packet packet;
+            {
+                sf::BitWriter writer(packet);
+                writer.writeBits(5, 4);
+            }
+
+            sf::BitReader reader(packet);
+            reader.readBits(4);
+            check(reader.isValid(), "bits within the packet");
+            reader.readBits(8);
+            check(!reader.isValid(), "reading past the end of the packet fails");
+        }
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+/// Entry point of application
+///
+/// \return Application exit code
+///
+////////////////////////////////////////////////////////////
+int main()
+{
+    std::srand(7);
+
+    checkRoundTrips();
+
+    // Create the world
+    std::vector<Entity> world(entityCount);
+    for (std::size_t i = 0; i < entityCount; ++i)
+    {
+        Entity& entity = world[i];
+        entity.id       = static_cast<sf::Uint32>(i);
+        entity.position = sf::Vector3f(random(-500.f, 500.f), random(0.f, 50.f), random(-500.f, 500.f));
+        entity.yaw      = random(0.f, 360.f);
+        for (int j = 0; j < 4; ++j)
+            entity.color[j] = static_cast<sf::Uint8>(std::rand() % 256);
+        entity.health   = 100;
+        entity.alive    = true;
+    }
+
+    // The receiver starts with the same world, and then gets a delta at every tick
+    std::vector<Entity> received = world;
+    std::vector<Entity> baseline = world;
+
+    std::size_t fullBytes = 0;
+    std::size_t quantizedBytes = 0;
+    std::size_t deltaBytes = 0;
+    sf::Time deltaTime;
+    sf::Clock clock;
+
+    for (unsigned int tick = 0; tick < tickCount; ++tick)
+    {
+        // A quarter of the entities move, a few get hurt or change color
+        for (std::size_t i = 0; i < entityCount; ++i)
+        {
+            Entity& entity = world[i];
+            if (std::rand() % 4 == 0)
+            {
+                entity.position += sf::Vector3f(random(-1.f, 1.f), random(-0.1f, 0.1f), random(-1.f, 1.f));
+                entity.yaw = std::fmod(entity.yaw + random(0.f, 10.f), 360.f);
+            }
+            if (std::rand() % 50 == 0)
+                entity.health = static_cast<sf::Uint8>(entity.health > 10 ? entity.health - 10 : 100);
+            if (std::rand() % 200 == 0)
+                entity.color[std::rand() % 4] = static_cast<sf::Uint8>(std::rand() % 256);
+        }
+
+        sf::Packet full;
+        writeFull(full, world);
+        fullBytes += full.getDataSize();
+
+        sf::Packet quantized;
+        writeQuantized(quantized, world);
+        quantizedBytes += quantized.getDataSize();
+
+        clock.restart();
+        sf::Packet delta;
+        writeDelta(delta, world, baseline);
+        readDelta(delta, received, baseline);
+        deltaTime += clock.getElapsedTime();
+        deltaBytes += delta.getDataSize();
+
+        // Check that the receiver has the world, within the precision
+        for (std::size_t i = 0; i < entityCount; ++i)
+        {
+            const Entity& a = world[i];
+            const Entity& b = received[i];
+            float positionError = 2 * worldSize / ((1 << positionBits) - 1);
+            bool same = (std::fabs(a.position.x - b.position.x) <= positionError) &&
+                        (std::fabs(a.position.y - b.position.y) <= positionError) &&
+                        (std::fabs(a.position.z - b.position.z) <= positionError) &&
+                        (std::fabs(a.yaw - b.yaw) <= 360.f / ((1 << yawBits) - 1)) &&
+                        (a.health == b.health) && (a.alive == b.alive) &&
+                        (std::memcmp(a.color, b.color, sizeof(a.color)) == 0);
+            if (!same)
+            {
+                check(false, "receiver world matches the sender world");
+                break;
+            }
+        }
+
+        // The receiver acknowledges the snapshot, which becomes the next baseline
+        baseline = received;
+    }
+
+    std::cout << entityCount << " entities, " << tickCount << " ticks" << std::endl;
+    std::cout << "  full values:      " << std::setw(8) << fullBytes / tickCount << " bytes/tick" << std::endl;
+    std::cout << "  quantized values: " << std::setw(8) << quantizedBytes / tickCount << " bytes/tick" << std::endl;
+    std::cout << "  quantized deltas: " << std::setw(8) << deltaBytes / tickCount << " bytes/tick ("
+              << deltaTime.asMicroseconds() / tickCount << " us to write and read)" << std::endl;
+
+    return reportChecks();
+}
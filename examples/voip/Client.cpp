@@ -4,16 +4,20 @@
 ////////////////////////////////////////////////////////////
 #include <SFML/Audio.hpp>
 #include <SFML/Network.hpp>
+#include <algorithm>
 #include <iostream>
 
 
 const sf::Uint8 audioData   = 1;
 const sf::Uint8 endOfStream = 2;
 
+// Duration of the audio frames sent in each packet
+const sf::Time frameDuration = sf::milliseconds(20);
+
 
 ////////////////////////////////////////////////////////////
 /// Specialization of audio recorder for sending recorded audio
-/// data through the network
+/// data through the network, compressed with a codec
 ////////////////////////////////////////////////////////////
 class NetworkRecorder : public sf::SoundRecorder
 {
@@ -27,9 +31,27 @@ public :
     ///
     ////////////////////////////////////////////////////////////
     NetworkRecorder(const sf::IpAddress& host, unsigned short port) :
-    m_host(host),
-    m_port(port)
+    m_host      (host),
+    m_port      (port),
+    m_sequence  (0),
+    m_chunkCount(0)
+    {
+        // Each chunk of samples is a frame, small enough to keep the latency low
+        setProcessingInterval(frameDuration);
+    }
+
+    ////////////////////////////////////////////////////////////
+    /// Print the capture latency measured during the recording
+    ///
+    ////////////////////////////////////////////////////////////
+    void printLatency() const
     {
+        if (m_chunkCount > 0)
+        {
+            std::cout << "Capture latency: average " << m_totalLatency.asMilliseconds() / m_chunkCount << " ms, "
+                      << "maximum " << m_maxLatency.asMilliseconds() << " ms "
+                      << "(" << m_chunkCount << " chunks, " << getOverrunCount() << " overruns)" << std::endl;
+        }
     }
 
 private :
@@ -40,15 +62,12 @@ private :
     ////////////////////////////////////////////////////////////
     virtual bool onStart()
     {
-        if (m_socket.connect(m_host, m_port) == sf::Socket::Done)
-        {
-            std::cout << "Connected to server " << m_host << std::endl;
-            return true;
-        }
-        else
-        {
-            return false;
-        }
+        // Start a new stream
+        m_codec.reset(getChannelCount(), getSampleRate());
+        m_sequence = 0;
+
+        std::cout << "Sending audio to server " << m_host << std::endl;
+        return true;
     }
 
     ////////////////////////////////////////////////////////////
@@ -57,13 +76,23 @@ private :
     ////////////////////////////////////////////////////////////
     virtual bool onProcessSamples(const sf::Int16* samples, std::size_t sampleCount)
     {
-        // Pack the audio samples into a network packet
+        // Measure the latency of the capture
+        sf::Time latency = getLatency();
+        m_totalLatency += latency;
+        m_maxLatency = std::max(m_maxLatency, latency);
+        m_chunkCount++;
+
+        // Compress the frame
+        if (!m_codec.encode(samples, sampleCount, getChannelCount(), m_data))
+            return true;
+
+        // Pack the encoded frame into a network packet, with its sequence number
         sf::Packet packet;
-        packet << audioData;
-        packet.append(samples, sampleCount * sizeof(sf::Int16));
+        packet << audioData << m_sequence++;
+        packet.append(&m_data[0], m_data.size());
 
         // Send the audio packet to the server
-        return m_socket.send(packet) == sf::Socket::Done;
+        return m_socket.send(packet, m_host, m_port) == sf::Socket::Done;
     }
 
     ////////////////////////////////////////////////////////////
@@ -72,27 +101,31 @@ private :
     ////////////////////////////////////////////////////////////
     virtual void onStop()
     {
-        // Send a "end-of-stream" packet
+        // Send a "end-of-stream" packet (a few times, as UDP packets may be lost)
         sf::Packet packet;
         packet << endOfStream;
-        m_socket.send(packet);
-
-        // Close the socket
-        m_socket.disconnect();
+        for (int i = 0; i < 3; ++i)
+            m_socket.send(packet, m_host, m_port);
     }
 
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
-    sf::IpAddress  m_host;   ///< Address of the remote host
-    unsigned short m_port;   ///< Remote port
-    sf::TcpSocket  m_socket; ///< Socket used to communicate with the server
+    sf::IpAddress          m_host;         ///< Address of the remote host
+    unsigned short         m_port;         ///< Remote port
+    sf::UdpSocket          m_socket;       ///< Socket used to communicate with the server
+    sf::ImaAdpcmCodec      m_codec;        ///< Codec used to compress the audio frames
+    std::vector<sf::Uint8> m_data;         ///< Encoded frame
+    sf::Uint32             m_sequence;     ///< Sequence number of the next frame
+    sf::Time               m_totalLatency; ///< Sum of the capture latencies of all the chunks sent
+    sf::Time               m_maxLatency;   ///< Highest capture latency of a chunk
+    sf::Int64              m_chunkCount;   ///< Number of chunks sent
 };
 
 
 ////////////////////////////////////////////////////////////
-/// Create a client, connect it to a running server and
-/// start sending him audio data
+/// Create a client and start sending audio data to a
+/// running server
 ///
 ////////////////////////////////////////////////////////////
 void doClient(unsigned short port)
@@ -108,7 +141,7 @@ void doClient(unsigned short port)
     sf::IpAddress server;
     do
     {
-        std::cout << "Type address or name of the server to connect to : ";
+        std::cout << "Type address or name of the server to send audio to : ";
         std::cin  >> server;
     }
     while (server == sf::IpAddress::None);
@@ -126,4 +159,6 @@ void doClient(unsigned short port)
     std::cout << "Recording... press enter to stop";
     std::cin.ignore(10000, '\n');
     recorder.stop();
+
+    recorder.printLatency();
 }
@@ -30,13 +30,26 @@
 ////////////////////////////////////////////////////////////
 
 #include <SFML/System.hpp>
+#include <SFML/Audio/AudioCodec.hpp>
+#include <SFML/Audio/BiquadFilter.hpp>
+#include <SFML/Audio/CompressorEffect.hpp>
+#include <SFML/Audio/GainEffect.hpp>
+#include <SFML/Audio/ImaAdpcmCodec.hpp>
 #include <SFML/Audio/Listener.hpp>
+#include <SFML/Audio/MixerBus.hpp>
 #include <SFML/Audio/Music.hpp>
+#include <SFML/Audio/ResamplerEffect.hpp>
 #include <SFML/Audio/Sound.hpp>
 #include <SFML/Audio/SoundBuffer.hpp>
+#include <SFML/Audio/SoundBufferLoader.hpp>
 #include <SFML/Audio/SoundBufferRecorder.hpp>
+#include <SFML/Audio/SoundEffect.hpp>
+#include <SFML/Audio/SoundEffectChain.hpp>
+#include <SFML/Audio/SoundMixer.hpp>
 #include <SFML/Audio/SoundRecorder.hpp>
 #include <SFML/Audio/SoundStream.hpp>
+#include <SFML/Audio/StreamCache.hpp>
+#include <SFML/Audio/VoiceStream.hpp>
 
 
 #endif // SFML_AUDIO_HPP
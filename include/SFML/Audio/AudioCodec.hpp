@@ -0,0 +1,138 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2014 Laurent Gomila (laurent.gom@gmail.com)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_AUDIOCODEC_HPP
+#define SFML_AUDIOCODEC_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Audio/Export.hpp>
+#include <cstdlib>
+#include <vector>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+/// \brief Abstract base class for audio encoders/decoders
+///
+////////////////////////////////////////////////////////////
+class SFML_AUDIO_API AudioCodec
+{
+public :
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Virtual destructor
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual ~AudioCodec();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Reset the state of the codec
+    ///
+    /// This function is called when a new stream starts, with
+    /// the format of the samples that will be encoded or decoded.
+    /// The default implementation does nothing.
+    ///
+    /// \param channelCount Number of channels
+    /// \param sampleRate   Sample rate, in samples per second
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void reset(unsigned int channelCount, unsigned int sampleRate);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Encode a frame of audio samples
+    ///
+    /// A frame is a fixed duration of audio, which is encoded
+    /// into a block of data that can be decoded on its own
+    /// (typically, the payload of a network packet).
+    ///
+    /// \param samples      Pointer to the interleaved samples of the frame
+    /// \param sampleCount  Number of samples pointed by \a samples
+    /// \param channelCount Number of channels
+    /// \param data         Array to fill with the encoded data (its previous content is lost)
+    ///
+    /// \return True if the frame was successfully encoded
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual bool encode(const Int16* samples, std::size_t sampleCount, unsigned int channelCount, std::vector<Uint8>& data) = 0;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Decode a frame of audio samples
+    ///
+    /// \param data         Pointer to the encoded data of the frame
+    /// \param size         Size of the encoded data, in bytes
+    /// \param channelCount Number of channels
+    /// \param samples      Array to fill with the decoded interleaved samples (its previous content is lost)
+    ///
+    /// \return True if the frame was successfully decoded
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual bool decode(const void* data, std::size_t size, unsigned int channelCount, std::vector<Int16>& samples) = 0;
+};
+
+} // namespace sf
+
+
+#endif // SFML_AUDIOCODEC_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::AudioCodec
+/// \ingroup audio
+///
+/// sf::AudioCodec is the interface of the codecs used to
+/// compress audio for transmission, typically over the
+/// network. Audio is processed in frames: fixed durations
+/// of audio (usually 10 to 60 ms) that are each encoded into
+/// a block of data decodable on its own, so that a lost or
+/// late frame doesn't prevent the following ones from
+/// being decoded.
+///
+/// SFML provides a built-in lightweight codec, sf::ImaAdpcmCodec;
+/// other codecs can be plugged in by deriving from
+/// sf::AudioCodec and overriding encode and decode.
+///
+/// Usage example:
+/// \code
+/// class MyCodec : public sf::AudioCodec
+/// {
+///     virtual bool encode(const sf::Int16* samples, std::size_t sampleCount, unsigned int channelCount, std::vector<sf::Uint8>& data)
+///     {
+///         // Compress the frame into data
+///         ...
+///     }
+///
+///     virtual bool decode(const void* data, std::size_t size, unsigned int channelCount, std::vector<sf::Int16>& samples)
+///     {
+///         // Decompress data into the samples of the frame
+///         ...
+///     }
+/// };
+/// \endcode
+///
+/// \see sf::ImaAdpcmCodec, sf::VoiceStream
+///
+////////////////////////////////////////////////////////////
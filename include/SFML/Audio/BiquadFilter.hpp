@@ -0,0 +1,233 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2014 Laurent Gomila (laurent.gom@gmail.com)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_BIQUADFILTER_HPP
+#define SFML_BIQUADFILTER_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Audio/Export.hpp>
+#include <SFML/Audio/SoundEffect.hpp>
+#include <SFML/System/Mutex.hpp>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+/// \brief Second order filter, used for equalization
+///        and low/high-pass filtering
+///
+////////////////////////////////////////////////////////////
+class SFML_AUDIO_API BiquadFilter : public SoundEffect
+{
+public :
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Response of the filter
+    ///
+    ////////////////////////////////////////////////////////////
+    enum Type
+    {
+        LowPass,   ///< Removes the frequencies above the cutoff frequency
+        HighPass,  ///< Removes the frequencies below the cutoff frequency
+        BandPass,  ///< Keeps only the frequencies around the center frequency
+        Notch,     ///< Removes the frequencies around the center frequency
+        Peak,      ///< Boosts or cuts the frequencies around the center frequency
+        LowShelf,  ///< Boosts or cuts the frequencies below the corner frequency
+        HighShelf  ///< Boosts or cuts the frequencies above the corner frequency
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Construct the filter from its parameters
+    ///
+    /// \param type      Response of the filter
+    /// \param frequency Cutoff, center or corner frequency, in Hz
+    /// \param q         Quality factor (0.7071 gives the flattest low/high-pass response)
+    /// \param gain      Gain at the center frequency or of the shelf, in dB
+    ///
+    ////////////////////////////////////////////////////////////
+    BiquadFilter(Type type = LowPass, float frequency = 1000.f, float q = 0.7071f, float gain = 0.f);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Change the response of the filter
+    ///
+    /// \param type New response
+    ///
+    /// \see getType
+    ///
+    ////////////////////////////////////////////////////////////
+    void setType(Type type);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Change the frequency of the filter
+    ///
+    /// This is the cutoff frequency for low/high-pass filters,
+    /// the center frequency for band-pass, notch and peak
+    /// filters, and the corner frequency for shelving filters.
+    ///
+    /// \param frequency New frequency, in Hz
+    ///
+    /// \see getFrequency
+    ///
+    ////////////////////////////////////////////////////////////
+    void setFrequency(float frequency);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Change the quality factor of the filter
+    ///
+    /// The higher the quality factor, the narrower the band
+    /// affected by the filter (and the more resonant the
+    /// low/high-pass filters).
+    ///
+    /// \param q New quality factor
+    ///
+    /// \see getQ
+    ///
+    ////////////////////////////////////////////////////////////
+    void setQ(float q);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Change the gain of the filter
+    ///
+    /// The gain is only used by the peak and shelving filters.
+    ///
+    /// \param gain New gain, in dB
+    ///
+    /// \see getGain
+    ///
+    ////////////////////////////////////////////////////////////
+    void setGain(float gain);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the response of the filter
+    ///
+    /// \return Response of the filter
+    ///
+    /// \see setType
+    ///
+    ////////////////////////////////////////////////////////////
+    Type getType() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the frequency of the filter
+    ///
+    /// \return Frequency, in Hz
+    ///
+    /// \see setFrequency
+    ///
+    ////////////////////////////////////////////////////////////
+    float getFrequency() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the quality factor of the filter
+    ///
+    /// \return Quality factor
+    ///
+    /// \see setQ
+    ///
+    ////////////////////////////////////////////////////////////
+    float getQ() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the gain of the filter
+    ///
+    /// \return Gain, in dB
+    ///
+    /// \see setGain
+    ///
+    ////////////////////////////////////////////////////////////
+    float getGain() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Reset the state of the filter
+    ///
+    /// \param channelCount Number of channels
+    /// \param sampleRate   Sample rate of the samples given to the filter
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void reset(unsigned int channelCount, unsigned int sampleRate);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Filter a block of audio samples
+    ///
+    /// \param samples      Block of interleaved samples to process
+    /// \param channelCount Number of channels
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void process(std::vector<float>& samples, unsigned int channelCount);
+
+private :
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Compute the coefficients of the filter from its parameters
+    ///
+    ////////////////////////////////////////////////////////////
+    void computeCoefficients();
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    Type               m_type;            ///< Response of the filter
+    float              m_frequency;       ///< Cutoff, center or corner frequency
+    float              m_q;               ///< Quality factor
+    float              m_gain;            ///< Gain of peak and shelving filters, in dB
+    unsigned int       m_sampleRate;      ///< Sample rate of the filtered samples
+    bool               m_needUpdate;      ///< Do the coefficients need to be computed again?
+    float              m_coefficients[5]; ///< Normalized coefficients: b0, b1, b2, a1, a2
+    std::vector<float> m_state;           ///< Delays of the filter, for each channel
+    mutable Mutex      m_mutex;           ///< Mutex protecting the parameters
+};
+
+} // namespace sf
+
+
+#endif // SFML_BIQUADFILTER_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::BiquadFilter
+/// \ingroup audio
+///
+/// sf::BiquadFilter is a second order IIR filter, with the
+/// usual responses used to shape the spectrum of a sound:
+/// low-pass and high-pass filters, band-pass and notch
+/// filters, and the peak and shelving filters that are the
+/// bands of a parametric equalizer. Steeper slopes or
+/// multi-band equalizers are obtained by chaining several
+/// filters in a sf::SoundEffectChain.
+///
+/// Each channel is filtered independently; on processors
+/// that support SSE2, up to 4 channels are filtered at once.
+///
+/// Usage example:
+/// \code
+/// // Muffle the music, as if heard through a wall
+/// sf::BiquadFilter filter(sf::BiquadFilter::LowPass, 800.f);
+/// music.setEffect(&filter);
+/// \endcode
+///
+/// \see sf::SoundEffect, sf::SoundEffectChain
+///
+////////////////////////////////////////////////////////////
@@ -0,0 +1,251 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2014 Laurent Gomila (laurent.gom@gmail.com)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_COMPRESSOREFFECT_HPP
+#define SFML_COMPRESSOREFFECT_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Audio/Export.hpp>
+#include <SFML/Audio/SoundEffect.hpp>
+#include <SFML/System/Mutex.hpp>
+#include <SFML/System/Time.hpp>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+/// \brief Sound effect that reduces the dynamic range of the signal
+///
+////////////////////////////////////////////////////////////
+class SFML_AUDIO_API CompressorEffect : public SoundEffect
+{
+public :
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// The default settings are a threshold of -20 dB, a ratio
+    /// of 4:1, an attack time of 10 ms, a release time of
+    /// 100 ms and no makeup gain.
+    ///
+    ////////////////////////////////////////////////////////////
+    CompressorEffect();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Change the threshold of the compressor
+    ///
+    /// The signal is attenuated when its level is above the threshold.
+    ///
+    /// \param threshold New threshold, in dB (0 dB is the maximum level)
+    ///
+    /// \see getThreshold
+    ///
+    ////////////////////////////////////////////////////////////
+    void setThreshold(float threshold);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Change the compression ratio
+    ///
+    /// A ratio of N means that above the threshold, a level
+    /// increase of N dB at the input produces an increase of
+    /// 1 dB at the output. Very high ratios turn the compressor
+    /// into a limiter.
+    ///
+    /// \param ratio New compression ratio (must be at least 1)
+    ///
+    /// \see getRatio
+    ///
+    ////////////////////////////////////////////////////////////
+    void setRatio(float ratio);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Change the attack time of the compressor
+    ///
+    /// The attack time is how fast the compressor reacts when
+    /// the level rises above the threshold.
+    ///
+    /// \param attack New attack time
+    ///
+    /// \see getAttack
+    ///
+    ////////////////////////////////////////////////////////////
+    void setAttack(Time attack);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Change the release time of the compressor
+    ///
+    /// The release time is how fast the compressor recovers
+    /// when the level falls back.
+    ///
+    /// \param release New release time
+    ///
+    /// \see getRelease
+    ///
+    ////////////////////////////////////////////////////////////
+    void setRelease(Time release);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Change the makeup gain of the compressor
+    ///
+    /// The makeup gain is applied after the compression,
+    /// to compensate for the loss of loudness.
+    ///
+    /// \param gain New makeup gain, in dB
+    ///
+    /// \see getMakeupGain
+    ///
+    ////////////////////////////////////////////////////////////
+    void setMakeupGain(float gain);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the threshold of the compressor
+    ///
+    /// \return Threshold, in dB
+    ///
+    /// \see setThreshold
+    ///
+    ////////////////////////////////////////////////////////////
+    float getThreshold() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the compression ratio
+    ///
+    /// \return Compression ratio
+    ///
+    /// \see setRatio
+    ///
+    ////////////////////////////////////////////////////////////
+    float getRatio() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the attack time of the compressor
+    ///
+    /// \return Attack time
+    ///
+    /// \see setAttack
+    ///
+    ////////////////////////////////////////////////////////////
+    Time getAttack() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the release time of the compressor
+    ///
+    /// \return Release time
+    ///
+    /// \see setRelease
+    ///
+    ////////////////////////////////////////////////////////////
+    Time getRelease() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the makeup gain of the compressor
+    ///
+    /// \return Makeup gain, in dB
+    ///
+    /// \see setMakeupGain
+    ///
+    ////////////////////////////////////////////////////////////
+    float getMakeupGain() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the current gain reduction
+    ///
+    /// This value is typically displayed by a meter.
+    ///
+    /// \return Attenuation applied to the last processed samples, in dB
+    ///
+    ////////////////////////////////////////////////////////////
+    float getGainReduction() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Reset the state of the compressor
+    ///
+    /// \param channelCount Number of channels
+    /// \param sampleRate   Sample rate of the samples given to the compressor
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void reset(unsigned int channelCount, unsigned int sampleRate);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Compress a block of audio samples
+    ///
+    /// \param samples      Block of interleaved samples to process
+    /// \param channelCount Number of channels
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void process(std::vector<float>& samples, unsigned int channelCount);
+
+private :
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    float         m_threshold;     ///< Level above which the signal is compressed, in dB
+    float         m_ratio;         ///< Compression ratio
+    Time          m_attack;        ///< Attack time
+    Time          m_release;       ///< Release time
+    float         m_makeupGain;    ///< Gain applied after compression, in dB
+    unsigned int  m_sampleRate;    ///< Sample rate of the processed samples
+    float         m_envelope;      ///< Current level of the signal, as followed by the detector
+    float         m_gain;          ///< Gain applied at the end of the last processed block
+    float         m_gainReduction; ///< Last gain reduction, in dB
+    mutable Mutex m_mutex;         ///< Mutex protecting the parameters
+};
+
+} // namespace sf
+
+
+#endif // SFML_COMPRESSOREFFECT_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::CompressorEffect
+/// \ingroup audio
+///
+/// sf::CompressorEffect attenuates the signal when its level
+/// goes above a threshold, which makes quiet and loud parts
+/// closer in loudness. With a high ratio and a short attack,
+/// it can also be used as a limiter to prevent clipping at
+/// the end of a chain of effects.
+///
+/// The level is measured on the loudest channel, and the
+/// same gain is applied to all the channels so that the
+/// stereo image is preserved. The gain is computed every
+/// few samples and interpolated in between, which is
+/// inaudible and much cheaper than a per-sample computation.
+///
+/// Usage example:
+/// \code
+/// sf::CompressorEffect compressor;
+/// compressor.setThreshold(-18.f);
+/// compressor.setRatio(3.f);
+/// compressor.setMakeupGain(6.f);
+/// music.setEffect(&compressor);
+/// \endcode
+///
+/// \see sf::SoundEffect, sf::SoundEffectChain
+///
+////////////////////////////////////////////////////////////
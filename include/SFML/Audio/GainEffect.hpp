@@ -0,0 +1,128 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2014 Laurent Gomila (laurent.gom@gmail.com)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_GAINEFFECT_HPP
+#define SFML_GAINEFFECT_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Audio/Export.hpp>
+#include <SFML/Audio/SoundEffect.hpp>
+#include <SFML/System/Mutex.hpp>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+/// \brief Sound effect that changes the amplitude of the signal
+///
+////////////////////////////////////////////////////////////
+class SFML_AUDIO_API GainEffect : public SoundEffect
+{
+public :
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Construct the effect from a gain
+    ///
+    /// \param gain Linear gain to apply (1 = unchanged)
+    ///
+    ////////////////////////////////////////////////////////////
+    explicit GainEffect(float gain = 1.f);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Change the gain
+    ///
+    /// The change is smoothed over the next block of samples,
+    /// so that it doesn't produce an audible click.
+    ///
+    /// \param gain Linear gain to apply (1 = unchanged)
+    ///
+    /// \see getGain
+    ///
+    ////////////////////////////////////////////////////////////
+    void setGain(float gain);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the gain
+    ///
+    /// \return Linear gain applied
+    ///
+    /// \see setGain
+    ///
+    ////////////////////////////////////////////////////////////
+    float getGain() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Reset the state of the effect
+    ///
+    /// \param channelCount Number of channels
+    /// \param sampleRate   Sample rate of the samples given to the effect
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void reset(unsigned int channelCount, unsigned int sampleRate);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Process a block of audio samples
+    ///
+    /// \param samples      Block of interleaved samples to process
+    /// \param channelCount Number of channels
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void process(std::vector<float>& samples, unsigned int channelCount);
+
+private :
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    float         m_gain;        ///< Requested gain
+    float         m_currentGain; ///< Gain applied to the last processed sample
+    mutable Mutex m_mutex;       ///< Mutex protecting the parameters
+};
+
+} // namespace sf
+
+
+#endif // SFML_GAINEFFECT_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::GainEffect
+/// \ingroup audio
+///
+/// sf::GainEffect multiplies the samples by a gain. Unlike
+/// the volume of a sound source, the gain can be placed
+/// anywhere in a chain of effects (for example, to drive
+/// a compressor harder), and it can amplify the signal.
+///
+/// Usage example:
+/// \code
+/// sf::GainEffect boost(2.f);
+/// stream.setEffect(&boost);
+/// \endcode
+///
+/// \see sf::SoundEffect, sf::SoundEffectChain
+///
+////////////////////////////////////////////////////////////
@@ -0,0 +1,117 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2014 Laurent Gomila (laurent.gom@gmail.com)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_IMAADPCMCODEC_HPP
+#define SFML_IMAADPCMCODEC_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Audio/Export.hpp>
+#include <SFML/Audio/AudioCodec.hpp>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+/// \brief Lightweight audio codec based on IMA-ADPCM
+///
+////////////////////////////////////////////////////////////
+class SFML_AUDIO_API ImaAdpcmCodec : public AudioCodec
+{
+public :
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    ////////////////////////////////////////////////////////////
+    ImaAdpcmCodec();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Reset the state of the codec
+    ///
+    /// \param channelCount Number of channels
+    /// \param sampleRate   Sample rate, in samples per second
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void reset(unsigned int channelCount, unsigned int sampleRate);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Encode a frame of audio samples
+    ///
+    /// \param samples      Pointer to the interleaved samples of the frame
+    /// \param sampleCount  Number of samples pointed by \a samples
+    /// \param channelCount Number of channels
+    /// \param data         Array to fill with the encoded data
+    ///
+    /// \return True if the frame was successfully encoded
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual bool encode(const Int16* samples, std::size_t sampleCount, unsigned int channelCount, std::vector<Uint8>& data);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Decode a frame of audio samples
+    ///
+    /// \param data         Pointer to the encoded data of the frame
+    /// \param size         Size of the encoded data, in bytes
+    /// \param channelCount Number of channels
+    /// \param samples      Array to fill with the decoded interleaved samples
+    ///
+    /// \return True if the frame was successfully decoded
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual bool decode(const void* data, std::size_t size, unsigned int channelCount, std::vector<Int16>& samples);
+
+private :
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    std::vector<int> m_stepIndices; ///< Step index of each channel at the end of the last encoded frame
+};
+
+} // namespace sf
+
+
+#endif // SFML_IMAADPCMCODEC_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::ImaAdpcmCodec
+/// \ingroup audio
+///
+/// sf::ImaAdpcmCodec compresses 16 bits samples into 4 bits,
+/// using the IMA-ADPCM algorithm. It is very cheap to run
+/// and has no algorithmic delay, at the price of a modest
+/// compression ratio (about 4:1) and some audible noise:
+/// it is well suited for voice over a local network, or to
+/// test a network audio pipeline.
+///
+/// Each frame starts with the number of samples per channel
+/// and the state of the predictor of each channel, so that
+/// it can be decoded without the previous frames.
+///
+/// \see sf::AudioCodec, sf::VoiceStream
+///
+////////////////////////////////////////////////////////////
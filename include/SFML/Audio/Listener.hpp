@@ -194,6 +194,46 @@ public :
     ///
     ////////////////////////////////////////////////////////////
     static Vector3f getUpVector();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Enable or disable the deferred updates of sounds and musics
+    ///
+    /// By default, every change made to a sound source (volume,
+    /// position, ...) is immediately sent to the audio driver.
+    /// When updates are deferred, changes are only recorded,
+    /// and sent all at once by commitUpdates(), typically once
+    /// per frame. This is much cheaper when many sources are
+    /// modified every frame.
+    /// Disabling the deferred updates commits the pending changes.
+    ///
+    /// \param deferred True to defer the updates, false to apply them immediately
+    ///
+    /// \see isDeferringUpdates, commitUpdates
+    ///
+    ////////////////////////////////////////////////////////////
+    static void setDeferredUpdates(bool deferred);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether the updates of sounds and musics are deferred
+    ///
+    /// \return True if updates are deferred
+    ///
+    /// \see setDeferredUpdates
+    ///
+    ////////////////////////////////////////////////////////////
+    static bool isDeferringUpdates();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Send the deferred changes of all sounds and musics to the audio driver
+    ///
+    /// This function does nothing if updates are not deferred.
+    /// Note that a sound or music that is started with play()
+    /// always applies its own pending changes first.
+    ///
+    /// \see setDeferredUpdates
+    ///
+    ////////////////////////////////////////////////////////////
+    static void commitUpdates();
 };
 
 } // namespace sf
@@ -231,4 +271,19 @@ public :
 /// sf::Listener::setGlobalVolume(50);
 /// \endcode
 ///
+/// When a lot of sounds move every frame, their changes can
+/// be batched:
+/// \code
+/// sf::Listener::setDeferredUpdates(true);
+///
+/// while (window.isOpen())
+/// {
+///     for (std::size_t i = 0; i < emitters.size(); ++i)
+///         sounds[i].setPosition(emitters[i].position);
+///
+///     sf::Listener::commitUpdates();
+///     ...
+/// }
+/// \endcode
+///
 ////////////////////////////////////////////////////////////
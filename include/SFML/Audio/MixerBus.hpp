@@ -0,0 +1,184 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2014 Laurent Gomila (laurent.gom@gmail.com)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_MIXERBUS_HPP
+#define SFML_MIXERBUS_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Audio/Export.hpp>
+#include <SFML/Audio/SoundEffect.hpp>
+#include <SFML/System/Mutex.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <vector>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+/// \brief Sound effect that mixes the outputs of several
+///        effects applied in parallel
+///
+////////////////////////////////////////////////////////////
+class SFML_AUDIO_API MixerBus : public SoundEffect, NonCopyable
+{
+public :
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// The bus has no branch, and lets the unprocessed
+    /// signal through with a gain of 1.
+    ///
+    ////////////////////////////////////////////////////////////
+    MixerBus();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Add a branch to the bus
+    ///
+    /// The bus doesn't store a copy of the effect, it keeps
+    /// a reference to it. It is therefore the caller's
+    /// responsibility to keep the effect alive as long as it
+    /// is in the bus.
+    /// The effect of a branch must not change the sample rate.
+    ///
+    /// \param effect Effect applied by the branch
+    /// \param gain   Linear gain applied to the output of the branch
+    ///
+    ////////////////////////////////////////////////////////////
+    void add(SoundEffect& effect, float gain = 1.f);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Remove a branch from the bus
+    ///
+    /// \param effect Effect applied by the branch to remove
+    ///
+    ////////////////////////////////////////////////////////////
+    void remove(SoundEffect& effect);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Change the gain of a branch
+    ///
+    /// \param effect Effect applied by the branch
+    /// \param gain   New linear gain applied to the output of the branch
+    ///
+    ////////////////////////////////////////////////////////////
+    void setGain(SoundEffect& effect, float gain);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Change the gain of the unprocessed signal
+    ///
+    /// \param gain New linear gain of the unprocessed signal (0 to mute it)
+    ///
+    /// \see getDryGain
+    ///
+    ////////////////////////////////////////////////////////////
+    void setDryGain(float gain);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the gain of the unprocessed signal
+    ///
+    /// \return Linear gain of the unprocessed signal
+    ///
+    /// \see setDryGain
+    ///
+    ////////////////////////////////////////////////////////////
+    float getDryGain() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Reset the state of all the branches
+    ///
+    /// \param channelCount Number of channels
+    /// \param sampleRate   Sample rate of the samples given to the bus
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void reset(unsigned int channelCount, unsigned int sampleRate);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Process a block of audio samples through all the branches
+    ///
+    /// \param samples      Block of interleaved samples to process
+    /// \param channelCount Number of channels
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void process(std::vector<float>& samples, unsigned int channelCount);
+
+private :
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Branch of the bus
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Branch
+    {
+        SoundEffect* effect; ///< Effect applied by the branch
+        float        gain;   ///< Gain applied to the output of the branch
+    };
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    std::vector<Branch> m_branches;     ///< Branches of the bus
+    float               m_dryGain;      ///< Gain of the unprocessed signal
+    unsigned int        m_channelCount; ///< Number of channels given to the last reset (0 if not reset yet)
+    unsigned int        m_sampleRate;   ///< Sample rate given to the last reset
+    std::vector<float>  m_input;        ///< Copy of the input block
+    std::vector<float>  m_branch;       ///< Block being processed by a branch
+    mutable Mutex       m_mutex;        ///< Mutex protecting the branches
+};
+
+} // namespace sf
+
+
+#endif // SFML_MIXERBUS_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::MixerBus
+/// \ingroup audio
+///
+/// sf::MixerBus sends the same signal to several effects
+/// (its branches) and sums their outputs, each with its own
+/// gain, together with the unprocessed ("dry") signal. This
+/// is how parallel processing is built: parallel compression,
+/// multi-band processing from several band-pass filters, or
+/// a wet/dry mix. A branch that needs several effects uses a
+/// sf::SoundEffectChain.
+///
+/// Usage example:
+/// \code
+/// // Parallel compression: mix a heavily compressed copy with the original signal
+/// sf::CompressorEffect compressor;
+/// compressor.setThreshold(-40.f);
+/// compressor.setRatio(10.f);
+///
+/// sf::MixerBus bus;
+/// bus.add(compressor, 0.5f);
+/// music.setEffect(&bus);
+/// \endcode
+///
+/// \see sf::SoundEffect, sf::SoundEffectChain
+///
+////////////////////////////////////////////////////////////
@@ -44,6 +44,7 @@ namespace priv
 }
 
 class InputStream;
+class StreamCache;
 
 ////////////////////////////////////////////////////////////
 /// \brief Streamed music played from an audio file
@@ -136,6 +137,81 @@ public :
     ////////////////////////////////////////////////////////////
     Time getDuration() const;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Share the decoded samples with other streams
+    ///
+    /// Musics that use the same cache and play the same file
+    /// (opened from the same filename, or from the same data in
+    /// memory) decode it only once: the samples decoded by one
+    /// of them are reused by the others, within the memory
+    /// budget of the cache. Musics opened from a custom stream
+    /// don't use the cache.
+    /// The cache must remain alive as long as the music uses it.
+    /// By default, no cache is used.
+    ///
+    /// \param cache Cache to use, or NULL to disable caching
+    ///
+    /// \see getCache
+    ///
+    ////////////////////////////////////////////////////////////
+    void setCache(StreamCache* cache);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the cache that shares the decoded samples
+    ///
+    /// \return Cache of the music, or NULL if there is none
+    ///
+    /// \see setCache
+    ///
+    ////////////////////////////////////////////////////////////
+    StreamCache* getCache() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the part of the music that is repeated when looping
+    ///
+    /// When looping is enabled, the music plays from its
+    /// beginning to \a loopEnd, then repeats the samples
+    /// between \a loopStart and \a loopEnd: this allows to play
+    /// an intro once before a looping part. Going back to the
+    /// beginning of the loop is seamless: it is decoded in
+    /// advance, and the stream buffers keep being filled
+    /// without interruption.
+    /// If looping is disabled, the music plays until the end of
+    /// the file.
+    /// The positions are given in samples of one channel, which
+    /// allows to place them exactly. \a loopEnd is clamped to the
+    /// length of the music; if the loop is empty, an error is
+    /// printed and the loop points are not changed.
+    /// By default, the whole music is looped.
+    ///
+    /// \param loopStart Position of the beginning of the loop, in samples
+    /// \param loopEnd   Position of the end of the loop (excluded), in samples
+    ///
+    /// \see getLoopStart, getLoopEnd, setLoop
+    ///
+    ////////////////////////////////////////////////////////////
+    void setLoopPoints(Uint64 loopStart, Uint64 loopEnd);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the beginning of the loop
+    ///
+    /// \return Position of the beginning of the loop, in samples of one channel
+    ///
+    /// \see setLoopPoints
+    ///
+    ////////////////////////////////////////////////////////////
+    Uint64 getLoopStart() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the end of the loop
+    ///
+    /// \return Position of the end of the loop (excluded), in samples of one channel
+    ///
+    /// \see setLoopPoints
+    ///
+    ////////////////////////////////////////////////////////////
+    Uint64 getLoopEnd() const;
+
 protected :
 
     ////////////////////////////////////////////////////////////
@@ -151,6 +227,20 @@ protected :
     ////////////////////////////////////////////////////////////
     virtual bool onGetData(Chunk& data);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Request a new chunk of floating point audio samples
+    ///        from the stream source
+    ///
+    /// This version is used for the files that have more than
+    /// 16 bits of precision (24 bits, floating point, Vorbis...).
+    ///
+    /// \param data Chunk of data to fill
+    ///
+    /// \return True to continue playback, false to stop
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual bool onGetData(FloatChunk& data);
+
     ////////////////////////////////////////////////////////////
     /// \brief Change the current playing position in the stream source
     ///
@@ -159,6 +249,15 @@ protected :
     ////////////////////////////////////////////////////////////
     virtual void onSeek(Time timeOffset);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Change the current playing position in the stream
+    ///        source to the beginning of the loop
+    ///
+    /// \return Position of the beginning of the loop, in samples
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual Int64 onLoop();
+
 private :
 
     ////////////////////////////////////////////////////////////
@@ -167,13 +266,82 @@ private :
     ////////////////////////////////////////////////////////////
     void initialize();
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of samples to read for each chunk
+    ///
+    /// It follows the buffer duration, which may change after
+    /// the file is opened.
+    ///
+    /// \return Number of samples of a chunk
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getChunkSampleCount() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Read the next samples of the music
+    ///
+    /// The samples are read up to the end of the loop, if looping
+    /// is enabled. Only one of \a samples and \a floatSamples
+    /// must be non-null.
+    ///
+    /// \param samples      Array to fill with 16 bits samples
+    /// \param floatSamples Array to fill with floating point samples
+    /// \param sampleCount  Maximum number of samples to read
+    /// \param hasMoreData  Receives false if the end of the music (or of the loop) was reached
+    ///
+    /// \return Number of samples actually read
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t readSamples(Int16* samples, float* floatSamples, std::size_t sampleCount, bool& hasMoreData);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get decoded samples, from the cache if possible
+    ///
+    /// Only one of \a samples and \a floatSamples must be non-null.
+    ///
+    /// \param position     Position of the first sample, in samples of one channel
+    /// \param samples      Array to fill with 16 bits samples
+    /// \param floatSamples Array to fill with floating point samples
+    /// \param sampleCount  Maximum number of samples to decode
+    ///
+    /// \return Number of samples actually decoded
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t decode(Uint64 position, Int16* samples, float* floatSamples, std::size_t sampleCount);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Decode samples from the file
+    ///
+    /// Only one of \a samples and \a floatSamples must be non-null.
+    ///
+    /// \param position     Position of the first sample, in samples of one channel
+    /// \param samples      Array to fill with 16 bits samples
+    /// \param floatSamples Array to fill with floating point samples
+    /// \param sampleCount  Maximum number of samples to decode
+    ///
+    /// \return Number of samples actually decoded
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t decodeFile(Uint64 position, Int16* samples, float* floatSamples, std::size_t sampleCount);
+
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
-    priv::SoundFile*   m_file;     ///< Sound file
-    Time               m_duration; ///< Music duration
-    std::vector<Int16> m_samples;  ///< Temporary buffer of samples
-    Mutex              m_mutex;    ///< Mutex protecting the data
+    priv::SoundFile*   m_file;         ///< Sound file
+    Time               m_duration;     ///< Music duration
+    std::vector<Int16> m_samples;      ///< Temporary buffer of samples
+    std::vector<float> m_floatSamples; ///< Temporary buffer of floating point samples
+    Uint64             m_position;     ///< Position of the next sample to play, in samples of one channel
+    Uint64             m_filePosition; ///< Position of the decoder in the file, in samples of one channel
+    Uint64             m_loopStart;    ///< Beginning of the loop, in samples of one channel
+    Uint64             m_loopEnd;      ///< End of the loop, in samples of one channel
+    std::vector<float> m_loopCache;    ///< First samples of the loop, decoded in advance
+    bool               m_playCache;    ///< Must the next chunk be taken from the loop cache?
+    StreamCache*       m_cache;        ///< Cache shared with other streams (can be NULL)
+    std::string        m_source;       ///< Identifier of the file in the cache (empty if it can't be shared)
+    std::vector<float> m_block;        ///< Current block of samples taken from the cache
+    Uint64             m_blockIndex;   ///< Index of the current block in the file
+    Mutex              m_mutex;        ///< Mutex protecting the data
 };
 
 } // namespace sf
@@ -219,10 +387,13 @@ private :
 /// music.setVolume(50);         // reduce the volume
 /// music.setLoop(true);         // make it loop
 ///
+/// // Play the first 2 seconds once, then loop over the rest
+/// music.setLoopPoints(2 * music.getSampleRate(), music.getLoopEnd());
+///
 /// // Play it
 /// music.play();
 /// \endcode
 ///
-/// \see sf::Sound, sf::SoundStream
+/// \see sf::Sound, sf::SoundStream, sf::StreamCache
 ///
 ////////////////////////////////////////////////////////////
@@ -0,0 +1,141 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2014 Laurent Gomila (laurent.gom@gmail.com)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_RESAMPLEREFFECT_HPP
+#define SFML_RESAMPLEREFFECT_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Audio/Export.hpp>
+#include <SFML/Audio/SoundEffect.hpp>
+#include <SFML/System/Mutex.hpp>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+/// \brief Sound effect that converts the signal to another sample rate
+///
+////////////////////////////////////////////////////////////
+class SFML_AUDIO_API ResamplerEffect : public SoundEffect
+{
+public :
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Construct the resampler from its output rate
+    ///
+    /// \param outputRate Sample rate to convert to, 0 to use
+    ///                   the sample rate of the audio device
+    ///
+    ////////////////////////////////////////////////////////////
+    explicit ResamplerEffect(unsigned int outputRate = 0);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Change the output sample rate
+    ///
+    /// This function must only be called when the stream
+    /// that uses the resampler is stopped.
+    ///
+    /// \param outputRate Sample rate to convert to, 0 to use
+    ///                   the sample rate of the audio device
+    ///
+    ////////////////////////////////////////////////////////////
+    void setOutputRate(unsigned int outputRate);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Reset the state of the resampler
+    ///
+    /// \param channelCount Number of channels
+    /// \param sampleRate   Sample rate of the samples given to the resampler
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void reset(unsigned int channelCount, unsigned int sampleRate);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Resample a block of audio samples
+    ///
+    /// \param samples      Block of interleaved samples to process
+    /// \param channelCount Number of channels
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void process(std::vector<float>& samples, unsigned int channelCount);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the sample rate of the samples produced by the resampler
+    ///
+    /// \param sampleRate Sample rate of the samples given to the resampler
+    ///
+    /// \return Output sample rate
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual unsigned int getOutputRate(unsigned int sampleRate) const;
+
+private :
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    unsigned int       m_outputRate; ///< Requested output sample rate (0 for the device rate)
+    unsigned int       m_inputRate;  ///< Sample rate of the processed samples
+    double             m_position;   ///< Position of the next output frame, in input frames
+    std::vector<float> m_input;      ///< Last input frames, followed by the block being processed
+    std::vector<float> m_output;     ///< Block of resampled samples
+    mutable Mutex      m_mutex;      ///< Mutex protecting the parameters
+};
+
+} // namespace sf
+
+
+#endif // SFML_RESAMPLEREFFECT_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::ResamplerEffect
+/// \ingroup audio
+///
+/// sf::ResamplerEffect converts the signal to a different
+/// sample rate, with cubic interpolation. Its main use is to
+/// convert a stream to the sample rate of the audio device:
+/// the driver then plays the samples as they are, and the
+/// effects that come after the resampler in a chain work
+/// at the final rate.
+///
+/// The duration of the sound is preserved, so the playing
+/// position of the stream is not affected.
+///
+/// Usage example:
+/// \code
+/// sf::ResamplerEffect resampler; // resample to the device rate
+/// sf::CompressorEffect compressor;
+///
+/// sf::SoundEffectChain chain;
+/// chain.add(resampler);
+/// chain.add(compressor);
+/// music.setEffect(&chain);
+/// \endcode
+///
+/// \see sf::SoundEffect, sf::SoundEffectChain
+///
+////////////////////////////////////////////////////////////
@@ -216,6 +216,7 @@ private :
     // Member data
     ////////////////////////////////////////////////////////////
     const SoundBuffer* m_buffer; ///< Sound buffer bound to the source
+    bool               m_loop;   ///< Loop flag (true to loop, false to play once)
 };
 
 } // namespace sf
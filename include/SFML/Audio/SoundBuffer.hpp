@@ -140,6 +140,27 @@ public :
     ////////////////////////////////////////////////////////////
     bool loadFromSamples(const Int16* samples, std::size_t sampleCount, unsigned int channelCount, unsigned int sampleRate);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Load the sound buffer from an array of floating point audio samples
+    ///
+    /// The samples are expected in the range [-1, 1]. They are
+    /// played as they are if the audio driver supports floating
+    /// point buffers (AL_EXT_float32), and converted to 16 bits
+    /// otherwise. In both cases, getSamples() returns their
+    /// 16 bits version.
+    ///
+    /// \param samples      Pointer to the array of samples in memory
+    /// \param sampleCount  Number of samples in the array
+    /// \param channelCount Number of channels (1 = mono, 2 = stereo, ...)
+    /// \param sampleRate   Sample rate (number of samples to play per second)
+    ///
+    /// \return True if loading succeeded, false if it failed
+    ///
+    /// \see loadFromFile, loadFromMemory, saveToFile
+    ///
+    ////////////////////////////////////////////////////////////
+    bool loadFromSamples(const float* samples, std::size_t sampleCount, unsigned int channelCount, unsigned int sampleRate);
+
     ////////////////////////////////////////////////////////////
     /// \brief Save the sound buffer to an audio file
     ///
@@ -233,6 +254,7 @@ public :
 private :
 
     friend class Sound;
+    friend class SoundBufferLoader;
 
     ////////////////////////////////////////////////////////////
     /// \brief Initialize the internal state after loading a new sound
@@ -279,10 +301,11 @@ private :
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
-    unsigned int       m_buffer;   ///< OpenAL buffer identifier
-    std::vector<Int16> m_samples;  ///< Samples buffer
-    Time               m_duration; ///< Sound duration
-    mutable SoundList  m_sounds;   ///< List of sounds that are using this buffer
+    unsigned int       m_buffer;       ///< OpenAL buffer identifier
+    std::vector<Int16> m_samples;      ///< Samples buffer
+    std::vector<float> m_floatSamples; ///< Floating point samples, when the buffer was loaded from them
+    Time               m_duration;     ///< Sound duration
+    mutable SoundList  m_sounds;       ///< List of sounds that are using this buffer
 };
 
 } // namespace sf
@@ -0,0 +1,297 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2014 Laurent Gomila (laurent.gom@gmail.com)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_SOUNDBUFFERLOADER_HPP
+#define SFML_SOUNDBUFFERLOADER_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Audio/Export.hpp>
+#include <SFML/System/Mutex.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <SFML/System/Thread.hpp>
+#include <deque>
+#include <string>
+#include <vector>
+
+
+namespace sf
+{
+class SoundBuffer;
+
+////////////////////////////////////////////////////////////
+/// \brief Loads sound buffers asynchronously, on worker threads
+///
+////////////////////////////////////////////////////////////
+class SFML_AUDIO_API SoundBufferLoader : NonCopyable
+{
+public :
+
+    ////////////////////////////////////////////////////////////
+    // Types
+    ////////////////////////////////////////////////////////////
+    typedef Uint64 Request; ///< Identifier of a load request
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Special value for setSampleRate, to resample
+    ///        sounds to the sample rate of the audio device
+    ///
+    ////////////////////////////////////////////////////////////
+    static const unsigned int DeviceSampleRate = 0xFFFFFFFF;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// \param threadCount Maximum number of worker threads decoding sounds in parallel
+    ///
+    ////////////////////////////////////////////////////////////
+    SoundBufferLoader(unsigned int threadCount = 2);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    /// Cancels all the pending requests and waits until the
+    /// worker threads are finished. Sound buffers whose load
+    /// didn't complete are left unchanged.
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual ~SoundBufferLoader();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the sample rate to which sounds are resampled
+    ///
+    /// By default (0), sounds keep the sample rate of their file.
+    /// Resampling to the rate of the audio device (DeviceSampleRate)
+    /// saves the work that OpenAL would otherwise do in real time
+    /// every time the sound is played.
+    /// The new rate only applies to subsequent requests.
+    ///
+    /// \param sampleRate Target sample rate, 0 to disable resampling
+    ///
+    ////////////////////////////////////////////////////////////
+    void setSampleRate(unsigned int sampleRate);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Request to load a sound buffer from a file
+    ///
+    /// The buffer must not be used, nor destroyed, until the
+    /// request is finished (see update()).
+    ///
+    /// \param buffer   Sound buffer to fill
+    /// \param filename Path of the sound file to load
+    ///
+    /// \return Identifier of the request
+    ///
+    ////////////////////////////////////////////////////////////
+    Request loadFromFile(SoundBuffer& buffer, const std::string& filename);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Request to load a sound buffer from a file in memory
+    ///
+    /// The data is not copied, it must remain valid until the
+    /// request is finished.
+    ///
+    /// \param buffer      Sound buffer to fill
+    /// \param data        Pointer to the file data in memory
+    /// \param sizeInBytes Size of the data to load, in bytes
+    ///
+    /// \return Identifier of the request
+    ///
+    ////////////////////////////////////////////////////////////
+    Request loadFromMemory(SoundBuffer& buffer, const void* data, std::size_t sizeInBytes);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Cancel a request
+    ///
+    /// If the sound is being decoded, decoding stops at the
+    /// next chunk. The request is then finished as a failure
+    /// by the next call to update().
+    ///
+    /// \param request Identifier of the request to cancel
+    ///
+    ////////////////////////////////////////////////////////////
+    void cancel(Request request);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Cancel all the pending requests
+    ///
+    ////////////////////////////////////////////////////////////
+    void cancelAll();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Finish the requests that have been decoded
+    ///
+    /// This function uploads the decoded samples to their sound
+    /// buffer, and calls onProgress and onLoaded. It is meant to
+    /// be called regularly (typically once per frame) by the
+    /// thread that uses the sound buffers.
+    ///
+    /// \return Number of requests finished by this call
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t update();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Block until all the pending requests are finished
+    ///
+    /// This function calls update() internally.
+    ///
+    ////////////////////////////////////////////////////////////
+    void wait();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of requests that are not finished yet
+    ///
+    /// \return Number of pending requests
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getPendingCount() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the overall progress of the pending requests
+    ///
+    /// \return Progress, in range [0, 1] (1 if nothing is pending)
+    ///
+    ////////////////////////////////////////////////////////////
+    float getProgress() const;
+
+protected :
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Called when a request makes progress
+    ///
+    /// This function is called by update(), in the thread
+    /// that calls it. The default implementation does nothing.
+    ///
+    /// \param request  Identifier of the request
+    /// \param progress Decoding progress, in range [0, 1]
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void onProgress(Request request, float progress);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Called when a request is finished
+    ///
+    /// This function is called by update(), in the thread
+    /// that calls it. The default implementation does nothing.
+    ///
+    /// \param request Identifier of the request
+    /// \param buffer  Sound buffer of the request
+    /// \param success True if the buffer was loaded, false on error or cancellation
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void onLoaded(Request request, SoundBuffer& buffer, bool success);
+
+private :
+
+    struct Job;
+    struct Worker;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Queue a new job and make sure that a worker handles it
+    ///
+    /// \param job Job to queue
+    ///
+    /// \return Identifier of the request
+    ///
+    ////////////////////////////////////////////////////////////
+    Request push(Job* job);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Entry point of the worker threads
+    ///
+    /// Workers process jobs until the queue is empty, then exit.
+    ///
+    /// \param worker Worker running the function
+    ///
+    ////////////////////////////////////////////////////////////
+    static void run(Worker* worker);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Decode a job (called by the worker threads)
+    ///
+    /// \param job Job to decode
+    ///
+    /// \return True on success
+    ///
+    ////////////////////////////////////////////////////////////
+    bool decode(Job& job);
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    std::vector<Worker*> m_workers;    ///< Worker threads
+    std::deque<Job*>     m_queue;      ///< Jobs waiting for a worker
+    std::vector<Job*>    m_jobs;       ///< All the unfinished jobs
+    Request              m_nextId;     ///< Identifier of the next request
+    unsigned int         m_sampleRate; ///< Target sample rate (0 = no resampling)
+    mutable Mutex        m_mutex;      ///< Mutex protecting the jobs
+};
+
+} // namespace sf
+
+
+#endif // SFML_SOUNDBUFFERLOADER_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::SoundBufferLoader
+/// \ingroup audio
+///
+/// Loading a sound buffer with sf::SoundBuffer::loadFromFile
+/// decodes the whole file in the calling thread, which can
+/// block an application for a long time when a lot of sounds
+/// are loaded at once.
+///
+/// sf::SoundBufferLoader decodes sounds on a pool of worker
+/// threads instead, and optionally resamples them to a given
+/// sample rate. The decoded samples are uploaded to their
+/// sound buffer when update() is called, so that sound buffers
+/// are only ever modified by the thread that uses them.
+///
+/// To be notified of the progress and completion of requests,
+/// derive from sf::SoundBufferLoader and override onProgress
+/// and/or onLoaded.
+///
+/// Usage example:
+/// \code
+/// std::vector<sf::SoundBuffer> buffers(files.size());
+///
+/// sf::SoundBufferLoader loader(4);
+/// loader.setSampleRate(sf::SoundBufferLoader::DeviceSampleRate);
+/// for (std::size_t i = 0; i < files.size(); ++i)
+///     loader.loadFromFile(buffers[i], files[i]);
+///
+/// // in the main loop...
+/// while (loader.getPendingCount() > 0)
+/// {
+///     loader.update();
+///     drawLoadingScreen(loader.getProgress());
+/// }
+/// \endcode
+///
+/// \see sf::SoundBuffer
+///
+////////////////////////////////////////////////////////////
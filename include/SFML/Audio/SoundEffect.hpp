@@ -0,0 +1,144 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2014 Laurent Gomila (laurent.gom@gmail.com)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_SOUNDEFFECT_HPP
+#define SFML_SOUNDEFFECT_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Audio/Export.hpp>
+#include <vector>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+/// \brief Abstract base class for audio effects applied
+///        to sound streams
+///
+////////////////////////////////////////////////////////////
+class SFML_AUDIO_API SoundEffect
+{
+public :
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Virtual destructor
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual ~SoundEffect();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Reset the state of the effect
+    ///
+    /// This function is called when the stream starts playing
+    /// or is moved to a new position, with the format of the
+    /// samples that will be processed. Effects that keep a
+    /// history of the signal (filters, envelopes, ...) must
+    /// clear it here. The default implementation does nothing.
+    ///
+    /// \param channelCount Number of channels
+    /// \param sampleRate   Sample rate of the samples given to the effect
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void reset(unsigned int channelCount, unsigned int sampleRate);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Process a block of audio samples
+    ///
+    /// The samples are interleaved floating point numbers,
+    /// nominally in the range [-1, 1]; intermediate values
+    /// outside of this range are allowed, they are only
+    /// saturated when the stream is played.
+    /// Most effects process the block in place, but they are
+    /// allowed to change its size if they change the sample
+    /// rate (see getOutputRate).
+    /// This function is called from the streaming thread.
+    ///
+    /// \param samples      Block of interleaved samples to process
+    /// \param channelCount Number of channels
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void process(std::vector<float>& samples, unsigned int channelCount) = 0;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the sample rate of the samples produced by the effect
+    ///
+    /// The default implementation returns \a sampleRate, which
+    /// is what all the effects that don't resample do.
+    ///
+    /// \param sampleRate Sample rate of the samples given to the effect
+    ///
+    /// \return Sample rate of the processed samples
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual unsigned int getOutputRate(unsigned int sampleRate) const;
+};
+
+} // namespace sf
+
+
+#endif // SFML_SOUNDEFFECT_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::SoundEffect
+/// \ingroup audio
+///
+/// sf::SoundEffect is the interface of the effects that
+/// process the audio of a sound stream between the moment
+/// it is produced (see sf::SoundStream::onGetData) and the
+/// moment it is sent to the audio driver. An effect is
+/// attached to a stream with sf::SoundStream::setEffect;
+/// several effects are combined with sf::SoundEffectChain
+/// (in series) or sf::MixerBus (in parallel).
+///
+/// Effects process whole blocks of samples at once (a block
+/// is one buffer of the stream), so the cost of the virtual
+/// call is negligible and the processing loops can be
+/// vectorized.
+///
+/// SFML provides a few built-in effects: sf::GainEffect,
+/// sf::BiquadFilter, sf::CompressorEffect and sf::ResamplerEffect.
+/// Custom effects are written by deriving from sf::SoundEffect
+/// and overriding process (and reset, if the effect has a state).
+///
+/// Usage example:
+/// \code
+/// class Invert : public sf::SoundEffect
+/// {
+///     virtual void process(std::vector<float>& samples, unsigned int channelCount)
+///     {
+///         for (std::size_t i = 0; i < samples.size(); ++i)
+///             samples[i] = -samples[i];
+///     }
+/// };
+///
+/// Invert effect;
+/// music.setEffect(&effect);
+/// \endcode
+///
+/// \see sf::SoundEffectChain, sf::SoundStream
+///
+////////////////////////////////////////////////////////////
@@ -0,0 +1,168 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2014 Laurent Gomila (laurent.gom@gmail.com)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_SOUNDEFFECTCHAIN_HPP
+#define SFML_SOUNDEFFECTCHAIN_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Audio/Export.hpp>
+#include <SFML/Audio/SoundEffect.hpp>
+#include <SFML/System/Mutex.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <vector>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+/// \brief Sound effect that applies a sequence of effects
+///
+////////////////////////////////////////////////////////////
+class SFML_AUDIO_API SoundEffectChain : public SoundEffect, NonCopyable
+{
+public :
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    ////////////////////////////////////////////////////////////
+    SoundEffectChain();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Add an effect at the end of the chain
+    ///
+    /// The chain doesn't store a copy of the effect, it keeps
+    /// a reference to it. It is therefore the caller's
+    /// responsibility to keep the effect alive as long as it
+    /// is in the chain.
+    /// Effects can be added while the stream is playing, except
+    /// the ones that change the sample rate (see getOutputRate).
+    ///
+    /// \param effect Effect to add
+    ///
+    ////////////////////////////////////////////////////////////
+    void add(SoundEffect& effect);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Remove an effect from the chain
+    ///
+    /// \param effect Effect to remove
+    ///
+    ////////////////////////////////////////////////////////////
+    void remove(SoundEffect& effect);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Remove all the effects from the chain
+    ///
+    ////////////////////////////////////////////////////////////
+    void clear();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of effects in the chain
+    ///
+    /// \return Number of effects
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getEffectCount() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Reset the state of all the effects of the chain
+    ///
+    /// \param channelCount Number of channels
+    /// \param sampleRate   Sample rate of the samples given to the chain
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void reset(unsigned int channelCount, unsigned int sampleRate);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Process a block of audio samples through all the effects
+    ///
+    /// \param samples      Block of interleaved samples to process
+    /// \param channelCount Number of channels
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void process(std::vector<float>& samples, unsigned int channelCount);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the sample rate of the samples produced by the chain
+    ///
+    /// \param sampleRate Sample rate of the samples given to the chain
+    ///
+    /// \return Sample rate at the output of the last effect
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual unsigned int getOutputRate(unsigned int sampleRate) const;
+
+private :
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    std::vector<SoundEffect*> m_effects;      ///< Effects of the chain, in processing order
+    unsigned int              m_channelCount; ///< Number of channels given to the last reset (0 if not reset yet)
+    unsigned int              m_sampleRate;   ///< Sample rate given to the last reset
+    mutable Mutex             m_mutex;        ///< Mutex protecting the list of effects
+};
+
+} // namespace sf
+
+
+#endif // SFML_SOUNDEFFECTCHAIN_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::SoundEffectChain
+/// \ingroup audio
+///
+/// sf::SoundEffectChain connects several effects in series:
+/// each block of samples goes through all the effects, in
+/// the order in which they were added. Since a chain is
+/// itself an effect, chains can be nested, or used as
+/// branches of a sf::MixerBus.
+///
+/// The chain keeps references to its effects, it doesn't
+/// own them.
+///
+/// Usage example:
+/// \code
+/// sf::BiquadFilter lowCut(sf::BiquadFilter::HighPass, 80.f);
+/// sf::BiquadFilter presence(sf::BiquadFilter::Peak, 3000.f, 1.f, 4.f);
+/// sf::CompressorEffect compressor;
+///
+/// sf::SoundEffectChain chain;
+/// chain.add(lowCut);
+/// chain.add(presence);
+/// chain.add(compressor);
+///
+/// sf::Music music;
+/// music.openFromFile("music.ogg");
+/// music.setEffect(&chain);
+/// music.play();
+/// \endcode
+///
+/// \see sf::SoundEffect, sf::MixerBus
+///
+////////////////////////////////////////////////////////////
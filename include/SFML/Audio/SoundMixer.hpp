@@ -0,0 +1,483 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2014 Laurent Gomila (laurent.gom@gmail.com)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_SOUNDMIXER_HPP
+#define SFML_SOUNDMIXER_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Audio/Export.hpp>
+#include <SFML/System/Clock.hpp>
+#include <SFML/System/Mutex.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <SFML/System/Vector3.hpp>
+#include <map>
+#include <vector>
+
+
+namespace sf
+{
+class Sound;
+class SoundBuffer;
+
+////////////////////////////////////////////////////////////
+/// \brief Voice manager able to play more sounds than there
+///        are audio sources available
+///
+////////////////////////////////////////////////////////////
+class SFML_AUDIO_API SoundMixer : NonCopyable
+{
+public :
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Identifier of a voice played by the mixer
+    ///
+    ////////////////////////////////////////////////////////////
+    typedef Uint32 Voice;
+
+    static const Voice InvalidVoice = 0; ///< Value returned when a voice cannot be created
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// \param sourceCount Maximum number of audio sources used by the mixer
+    ///
+    ////////////////////////////////////////////////////////////
+    SoundMixer(unsigned int sourceCount = 32);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    /// All the voices are stopped.
+    ///
+    ////////////////////////////////////////////////////////////
+    ~SoundMixer();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Start playing a new voice
+    ///
+    /// The voice starts at the next call to update(). The buffer
+    /// must remain alive as long as the voice is playing.
+    ///
+    /// \param buffer   Sound buffer containing the audio data to play
+    /// \param priority Priority of the voice; voices with a higher
+    ///                 priority get an audio source first
+    ///
+    /// \return Identifier of the new voice, or InvalidVoice if the buffer is empty
+    ///
+    /// \see stop
+    ///
+    ////////////////////////////////////////////////////////////
+    Voice play(const SoundBuffer& buffer, int priority = 0);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Stop a voice
+    ///
+    /// The identifier of the voice becomes invalid.
+    ///
+    /// \param voice Voice to stop
+    ///
+    /// \see play, stopAll
+    ///
+    ////////////////////////////////////////////////////////////
+    void stop(Voice voice);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Stop all the voices
+    ///
+    /// \see stop
+    ///
+    ////////////////////////////////////////////////////////////
+    void stopAll();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether a voice is still playing
+    ///
+    /// A voice that is culled or premixed is still playing, even
+    /// if it doesn't have an audio source.
+    ///
+    /// \param voice Voice to check
+    ///
+    /// \return True if the voice exists and hasn't finished
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isPlaying(Voice voice) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Change the priority of a voice
+    ///
+    /// \param voice    Voice to modify
+    /// \param priority New priority
+    ///
+    ////////////////////////////////////////////////////////////
+    void setPriority(Voice voice, int priority);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set whether or not a voice should loop
+    ///
+    /// \param voice Voice to modify
+    /// \param loop  True to play in loop, false to play once
+    ///
+    ////////////////////////////////////////////////////////////
+    void setLoop(Voice voice, bool loop);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the volume of a voice
+    ///
+    /// \param voice  Voice to modify
+    /// \param volume Volume of the voice, in the range [0, 100]
+    ///
+    /// \see sf::SoundSource::setVolume
+    ///
+    ////////////////////////////////////////////////////////////
+    void setVolume(Voice voice, float volume);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the pitch of a voice
+    ///
+    /// \param voice Voice to modify
+    /// \param pitch New pitch to apply to the voice
+    ///
+    /// \see sf::SoundSource::setPitch
+    ///
+    ////////////////////////////////////////////////////////////
+    void setPitch(Voice voice, float pitch);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the 3D position of a voice
+    ///
+    /// \param voice    Voice to modify
+    /// \param position Position of the voice in the scene
+    ///
+    /// \see sf::SoundSource::setPosition
+    ///
+    ////////////////////////////////////////////////////////////
+    void setPosition(Voice voice, const Vector3f& position);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Make the position of a voice relative to the listener or absolute
+    ///
+    /// \param voice    Voice to modify
+    /// \param relative True to set the position relative, false to set it absolute
+    ///
+    /// \see sf::SoundSource::setRelativeToListener
+    ///
+    ////////////////////////////////////////////////////////////
+    void setRelativeToListener(Voice voice, bool relative);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the minimum distance of a voice
+    ///
+    /// \param voice    Voice to modify
+    /// \param distance New minimum distance of the voice
+    ///
+    /// \see sf::SoundSource::setMinDistance
+    ///
+    ////////////////////////////////////////////////////////////
+    void setMinDistance(Voice voice, float distance);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the attenuation factor of a voice
+    ///
+    /// \param voice       Voice to modify
+    /// \param attenuation New attenuation factor of the voice
+    ///
+    /// \see sf::SoundSource::setAttenuation
+    ///
+    ////////////////////////////////////////////////////////////
+    void setAttenuation(Voice voice, float attenuation);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Change the maximum number of audio sources used by the mixer
+    ///
+    /// The new value is taken into account at the next call to update().
+    ///
+    /// \param count Maximum number of audio sources
+    ///
+    /// \see getSourceCount
+    ///
+    ////////////////////////////////////////////////////////////
+    void setSourceCount(unsigned int count);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the maximum number of audio sources used by the mixer
+    ///
+    /// \return Maximum number of audio sources
+    ///
+    /// \see setSourceCount
+    ///
+    ////////////////////////////////////////////////////////////
+    unsigned int getSourceCount() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the audibility under which voices are culled
+    ///
+    /// The audibility of a voice is its volume, in the range
+    /// [0, 1], multiplied by its attenuation due to the distance
+    /// to the listener. Voices under the threshold never get an
+    /// audio source, they are only kept up to date so that they
+    /// resume at the right position when they become audible.
+    /// The default threshold is 0.01.
+    ///
+    /// \param threshold Audibility threshold, in the range [0, 1]
+    ///
+    ////////////////////////////////////////////////////////////
+    void setAudibilityThreshold(float threshold);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Enable or disable the software premix
+    ///
+    /// When the premix is enabled, the audible voices that don't
+    /// get an audio source and whose priority is not greater
+    /// than \a maxPriority are mixed by the CPU into a single
+    /// stream, instead of being culled. The premix stream uses
+    /// one of the audio sources of the mixer, so it is inactive
+    /// when the mixer has a single source. Only mono and stereo
+    /// voices can be premixed.
+    ///
+    /// \param enabled     True to enable the premix, false to disable it
+    /// \param maxPriority Highest priority of the voices that can be premixed
+    ///
+    ////////////////////////////////////////////////////////////
+    void setPremixEnabled(bool enabled, int maxPriority = 0);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Update the voices
+    ///
+    /// This function must be called regularly, typically once
+    /// per frame: it advances the voices that are not playing
+    /// on an audio source, applies the parameters modified since
+    /// the last update and distributes the audio sources to the
+    /// most important voices.
+    ///
+    ////////////////////////////////////////////////////////////
+    void update();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of voices currently playing
+    ///
+    /// \return Total number of voices
+    ///
+    ////////////////////////////////////////////////////////////
+    unsigned int getVoiceCount() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of voices playing on an audio source
+    ///
+    /// \return Number of voices bound to an audio source
+    ///
+    ////////////////////////////////////////////////////////////
+    unsigned int getRealVoiceCount() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of voices mixed by the software premix
+    ///
+    /// \return Number of premixed voices
+    ///
+    ////////////////////////////////////////////////////////////
+    unsigned int getPremixedVoiceCount() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of voices that are currently culled
+    ///
+    /// \return Number of silent voices
+    ///
+    ////////////////////////////////////////////////////////////
+    unsigned int getVirtualVoiceCount() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the CPU cost of the software premix
+    ///
+    /// The cost is the time spent mixing the last block of audio,
+    /// divided by the duration of this block: 0.1 means that
+    /// mixing takes 10% of a CPU core.
+    ///
+    /// \return Load of the premix, or 0 if it is not active
+    ///
+    ////////////////////////////////////////////////////////////
+    float getMixLoad() const;
+
+private :
+
+    class Premix;
+    friend class Premix;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Way a voice is currently played
+    ///
+    ////////////////////////////////////////////////////////////
+    enum Mode
+    {
+        Virtual,  ///< The voice is silent, only its position is updated
+        Real,     ///< The voice is played by an audio source
+        Premixed  ///< The voice is mixed by the CPU into the premix stream
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief State of a voice
+    ///
+    ////////////////////////////////////////////////////////////
+    struct VoiceState
+    {
+        const SoundBuffer* buffer;      ///< Sound buffer played by the voice
+        int                priority;    ///< Priority of the voice
+        bool               loop;        ///< Loop flag
+        float              volume;      ///< Volume, in the range [0, 100]
+        float              pitch;       ///< Pitch
+        Vector3f           position;    ///< 3D position
+        bool               relative;    ///< Is the position relative to the listener?
+        float              minDistance; ///< Minimum distance
+        float              attenuation; ///< Attenuation factor
+        bool               changed;     ///< Have the parameters changed since the last update?
+        Mode               mode;        ///< Current way the voice is played
+        Sound*             source;      ///< Audio source playing the voice (Real voices only)
+        double             cursor;      ///< Current playing position, in frames
+        float              audibility;  ///< Volume perceived by the listener, in the range [0, 1]
+        float              gains[2];    ///< Left and right gains used by the premix
+        bool               finished;    ///< Has the voice reached its end?
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Mix the premixed voices into a block of stereo samples
+    ///
+    /// This function is called by the premix stream, in the
+    /// streaming thread.
+    ///
+    /// \param samples    Array of samples to fill
+    /// \param frameCount Number of stereo frames to write
+    /// \param sampleRate Sample rate of the output
+    ///
+    ////////////////////////////////////////////////////////////
+    void mix(Int16* samples, std::size_t frameCount, unsigned int sampleRate);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Compute the audibility and premix gains of a voice
+    ///
+    /// \param voice Voice to update
+    ///
+    ////////////////////////////////////////////////////////////
+    void spatialize(VoiceState& voice) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Bind a voice to an audio source of the pool
+    ///
+    /// \param voice Voice to play on an audio source
+    ///
+    ////////////////////////////////////////////////////////////
+    void acquireSource(VoiceState& voice);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Return the audio source of a voice to the pool
+    ///
+    /// \param voice Voice to unbind from its audio source
+    ///
+    ////////////////////////////////////////////////////////////
+    void releaseSource(VoiceState& voice);
+
+    ////////////////////////////////////////////////////////////
+    // Types
+    ////////////////////////////////////////////////////////////
+    typedef std::map<Voice, VoiceState> VoiceTable;
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    VoiceTable          m_voices;             ///< Table of the voices, by identifier
+    Voice               m_nextVoice;          ///< Identifier of the next voice to create
+    std::vector<Sound*> m_sources;            ///< Audio sources owned by the mixer
+    std::vector<Sound*> m_freeSources;        ///< Audio sources which are not bound to a voice
+    unsigned int        m_sourceCount;        ///< Maximum number of audio sources
+    float               m_threshold;          ///< Audibility under which voices are culled
+    bool                m_premixEnabled;      ///< Is the software premix enabled?
+    int                 m_premixPriority;     ///< Highest priority of the premixed voices
+    Premix*             m_premix;             ///< Stream playing the premixed voices
+    std::vector<float>  m_mixBuffer;          ///< Accumulation buffer used by the premix
+    float               m_mixLoad;            ///< CPU load of the last premixed block
+    Vector3f            m_listenerPosition;   ///< Position of the listener at the last update
+    Vector3f            m_listenerRight;      ///< Right vector of the listener at the last update
+    Clock               m_clock;              ///< Clock measuring the time between two updates
+    mutable Mutex       m_mutex;              ///< Mutex protecting the voices against the premix thread
+};
+
+} // namespace sf
+
+
+#endif // SFML_SOUNDMIXER_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::SoundMixer
+/// \ingroup audio
+///
+/// Each sf::Sound uses an audio source, and audio drivers
+/// only provide a limited number of them (often between 32
+/// and 256). sf::SoundMixer lets you play as many sounds,
+/// called voices, as you want: it keeps the state of every
+/// voice in memory, and only gives its audio sources to
+/// the most important ones.
+///
+/// Voices are ordered by priority first, and then by
+/// audibility (their volume attenuated by their distance to
+/// the listener). Voices that don't get an audio source are
+/// culled: they keep on advancing silently, and resume at
+/// the right position as soon as a source is available again.
+/// Voices that are too quiet to be heard are always culled
+/// (see setAudibilityThreshold).
+///
+/// Optionally, low priority voices that don't get an audio
+/// source can be mixed by the CPU into a single stream,
+/// so that they remain audible (without 3D effects other than
+/// attenuation and panning). This is done by calling
+/// setPremixEnabled. The cost of this software mixing can be
+/// monitored with getMixLoad.
+///
+/// The mixer must be updated regularly, typically once per
+/// frame, so that it can redistribute its sources.
+///
+/// Usage example:
+/// \code
+/// sf::SoundBuffer buffer;
+/// buffer.loadFromFile("footstep.wav");
+///
+/// sf::SoundMixer mixer(64);
+/// mixer.setPremixEnabled(true);
+///
+/// for (int i = 0; i < 500; ++i)
+/// {
+///     sf::SoundMixer::Voice voice = mixer.play(buffer);
+///     mixer.setPosition(voice, sf::Vector3f(i * 2.f, 0, 0));
+/// }
+///
+/// while (window.isOpen())
+/// {
+///     ...
+///     mixer.update();
+///     std::cout << mixer.getRealVoiceCount() << " / " << mixer.getVoiceCount() << std::endl;
+/// }
+/// \endcode
+///
+/// \see sf::Sound, sf::SoundBuffer
+///
+////////////////////////////////////////////////////////////
@@ -29,6 +29,7 @@
 // Headers
 ////////////////////////////////////////////////////////////
 #include <SFML/Audio/Export.hpp>
+#include <SFML/System/Mutex.hpp>
 #include <SFML/System/Thread.hpp>
 #include <SFML/System/Time.hpp>
 #include <vector>
@@ -37,6 +38,11 @@
 
 namespace sf
 {
+namespace priv
+{
+    class RingBuffer;
+}
+
 ////////////////////////////////////////////////////////////
 /// \brief Abstract base class for capturing sound data
 ///
@@ -70,7 +76,7 @@ public :
     ///
     /// \return True, if start of capture was successful
     ///
-    /// \see stop, getAvailableDevices
+    /// \see stop, getAvailableDevices, setChannelCount
     ///
     ////////////////////////////////////////////////////////////
     bool start(unsigned int sampleRate = 44100);
@@ -143,6 +149,56 @@ public :
     ////////////////////////////////////////////////////////////
     const std::string& getDevice() const;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the number of channels to capture
+    ///
+    /// Captured samples of multi-channel recordings are
+    /// interleaved. Most capture devices only support 1 (mono)
+    /// or 2 (stereo) channels. The new value is taken into
+    /// account the next time the capture starts.
+    /// The default value is 1.
+    ///
+    /// \param channelCount Number of channels
+    ///
+    /// \see getChannelCount
+    ///
+    ////////////////////////////////////////////////////////////
+    void setChannelCount(unsigned int channelCount);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of channels captured
+    ///
+    /// \return Number of channels (1 = mono, 2 = stereo)
+    ///
+    /// \see setChannelCount
+    ///
+    ////////////////////////////////////////////////////////////
+    unsigned int getChannelCount() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the latency of the last chunk of recorded samples
+    ///
+    /// The latency is the time elapsed between the capture of
+    /// the first sample of a chunk and the moment it is passed
+    /// to onProcessSamples. It is measured for every chunk.
+    ///
+    /// \return Capture latency of the last chunk
+    ///
+    ////////////////////////////////////////////////////////////
+    Time getLatency() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of times captured samples were lost
+    ///
+    /// Samples are lost when the capture device buffer fills
+    /// up, which happens when onProcessSamples is too slow to
+    /// keep up with the capture for a long time.
+    ///
+    /// \return Number of overruns since the capture started
+    ///
+    ////////////////////////////////////////////////////////////
+    Uint64 getOverrunCount() const;
+
     ////////////////////////////////////////////////////////////
     /// \brief Check if the system supports audio capture
     ///
@@ -170,12 +226,14 @@ protected :
     /// \brief Set the processing interval
     ///
     /// The processing interval controls the period
-    /// between calls to the onProcessSamples function. You may
+    /// between calls to the onProcessSamples function, and
+    /// the size of the chunks passed to it: every chunk but the
+    /// last one contains exactly this duration of audio. You may
     /// want to use a small interval if you want to process the
     /// recorded data in real time, for example.
     ///
-    /// Note: this is only a hint, the actual period may vary.
-    /// So don't rely on this parameter to implement precise timing.
+    /// Note: the period may vary slightly, don't rely on this
+    /// parameter to implement precise timing.
     ///
     /// The default processing interval is 100 ms.
     ///
@@ -184,6 +242,21 @@ protected :
     ////////////////////////////////////////////////////////////
     void setProcessingInterval(sf::Time interval);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Choose the type of the samples passed to the derived class
+    ///
+    /// When enabled, the captured samples are passed to the
+    /// floating point version of onProcessSamples, in the range
+    /// [-1, 1]. If the audio driver supports it, they are
+    /// captured directly in this format, without any loss of
+    /// precision. The new value is taken into account the next
+    /// time the capture starts.
+    ///
+    /// \param enabled True to receive floating point samples
+    ///
+    ////////////////////////////////////////////////////////////
+    void setFloatCapture(bool enabled);
+
     ////////////////////////////////////////////////////////////
     /// \brief Start capturing audio data
     ///
@@ -213,6 +286,22 @@ protected :
     ////////////////////////////////////////////////////////////
     virtual bool onProcessSamples(const Int16* samples, std::size_t sampleCount) = 0;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Process a new chunk of recorded floating point samples
+    ///
+    /// This virtual function is called instead of the 16 bits
+    /// version when floating point capture is enabled (see
+    /// setFloatCapture). The default implementation converts
+    /// the samples to 16 bits and calls the other overload.
+    ///
+    /// \param samples     Pointer to the new chunk of recorded samples, in the range [-1, 1]
+    /// \param sampleCount Number of samples pointed by \a samples
+    ///
+    /// \return True to continue the capture, or false to stop it
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual bool onProcessSamples(const float* samples, std::size_t sampleCount);
+
     ////////////////////////////////////////////////////////////
     /// \brief Stop capturing audio data
     ///
@@ -229,39 +318,82 @@ private :
     ////////////////////////////////////////////////////////////
     /// \brief Function called as the entry point of the thread
     ///
-    /// This function starts the recording loop, and returns
+    /// This function starts the recording loop, which passes
+    /// the captured samples to the derived class, and returns
     /// only when the capture is stopped.
     ///
     ////////////////////////////////////////////////////////////
     void record();
 
     ////////////////////////////////////////////////////////////
-    /// \brief Get the new available audio samples and process them
+    /// \brief Function called as the entry point of the capture thread
+    ///
+    /// This function moves the captured samples from the device
+    /// to the ring buffer until the capture is stopped. It does
+    /// nothing else, so that a slow onProcessSamples never
+    /// delays the capture.
+    ///
+    ////////////////////////////////////////////////////////////
+    void capture();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Open the capture device with the current settings
+    ///
+    /// \return True if the device was successfully opened
+    ///
+    ////////////////////////////////////////////////////////////
+    bool openDevice();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Move the samples captured by the device to the ring buffer
     ///
-    /// This function is called continuously during the
-    /// capture loop. It retrieves the captured samples and
-    /// forwards them to the derived class.
+    /// \return Number of frames left in the device (if the ring buffer is full)
     ///
     ////////////////////////////////////////////////////////////
-    void processCapturedSamples();
+    std::size_t readDevice();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Pass a chunk of samples from the ring buffer to the derived class
+    ///
+    /// \param size Size of the chunk, in bytes
+    ///
+    /// \return Value returned by onProcessSamples
+    ///
+    ////////////////////////////////////////////////////////////
+    bool processChunk(std::size_t size);
 
     ////////////////////////////////////////////////////////////
     /// \brief Clean up the recorder's internal resources
     ///
     /// This function is called when the capture stops.
     ///
+    /// \param process Pass the samples left to the derived class?
+    ///
     ////////////////////////////////////////////////////////////
-    void cleanup();
+    void cleanup(bool process);
 
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
     Thread             m_thread;             ///< Thread running the background recording task
-    std::vector<Int16> m_samples;            ///< Buffer to store captured samples
+    Thread             m_captureThread;      ///< Thread moving the samples from the device to the ring buffer
+    priv::RingBuffer*  m_ringBuffer;         ///< Lock-free buffer between the capture and recording threads
+    std::vector<char>  m_deviceSamples;      ///< Buffer to store samples read from the device
+    std::vector<char>  m_chunk;              ///< Buffer to store a chunk of captured samples, in the device format
+    std::vector<Int16> m_samples;            ///< Buffer to store captured samples converted to 16 bits
+    std::vector<float> m_floatSamples;       ///< Buffer to store captured samples converted to floating point
     unsigned int       m_sampleRate;         ///< Sample rate
+    unsigned int       m_channelCount;       ///< Number of channels
+    bool               m_floatCapture;       ///< Does the derived class want floating point samples?
+    bool               m_deviceFloat;        ///< Does the device capture floating point samples?
+    std::size_t        m_frameSize;          ///< Size of a frame in the device format, in bytes
+    std::size_t        m_deviceCapacity;     ///< Capacity of the device buffer, in frames
     sf::Time           m_processingInterval; ///< Time period between calls to onProcessSamples
     bool               m_isCapturing;        ///< Capturing state
     std::string        m_deviceName;         ///< Name of the audio capture device
+    Time               m_latency;            ///< Capture latency of the last chunk
+    Uint64             m_overrunCount;       ///< Number of times the device buffer was full
+    mutable Mutex      m_statsMutex;         ///< Mutex protecting the statistics
 };
 
 } // namespace sf
@@ -294,7 +426,11 @@ private :
 /// calls, with the setProcessingInterval protected function. The default
 /// interval is chosen so that recording thread doesn't consume too much
 /// CPU, but it can be changed to a smaller value if you need to process
-/// the recorded data in real time, for example.
+/// the recorded data in real time, for example. The latency of the
+/// capture can be monitored with getLatency.
+///
+/// Multi-channel capture is enabled with setChannelCount, and
+/// floating point samples can be requested with setFloatCapture.
 ///
 /// The audio capture feature may not be supported or activated
 /// on every platform, thus it is recommended to check its
@@ -308,10 +444,12 @@ private :
 /// by calling setDevice() with the appropiate device. Otherwise
 /// the default capturing device will be used.
 ///
-/// It is important to note that the audio capture happens in a
-/// separate thread, so that it doesn't block the rest of the
-/// program. In particular, the onProcessSamples virtual function
-/// (but not onStart and not onStop) will be called
+/// It is important to note that the audio capture happens in
+/// separate threads, so that it doesn't block the rest of the
+/// program: one thread reads the samples from the device into
+/// a lock-free ring buffer, and another one passes them to the
+/// derived class. In particular, the onProcessSamples virtual
+/// function (but not onStart and not onStop) will be called
 /// from this separate thread. It is important to keep this in
 /// mind, because you may have to take care of synchronization
 /// issues if you share data between threads.
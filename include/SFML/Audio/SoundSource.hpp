@@ -34,6 +34,11 @@
 
 namespace sf
 {
+namespace priv
+{
+    class AudioDevice;
+}
+
 ////////////////////////////////////////////////////////////
 /// \brief Base class defining a sound's properties
 ///
@@ -257,10 +262,60 @@ protected :
     ////////////////////////////////////////////////////////////
     Status getStatus() const;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Send the deferred parameter changes to the audio source
+    ///
+    /// When updates are deferred (see sf::Listener::setDeferredUpdates),
+    /// derived classes call this function before starting the source,
+    /// so that it doesn't start with outdated parameters.
+    ///
+    ////////////////////////////////////////////////////////////
+    void applyChanges();
+
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
     unsigned int m_source; ///< OpenAL source identifier
+
+private :
+
+    friend class priv::AudioDevice;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Flags identifying the parameters to send to the audio source
+    ///
+    ////////////////////////////////////////////////////////////
+    enum Change
+    {
+        PitchChange       = 1 << 0,
+        VolumeChange      = 1 << 1,
+        PositionChange    = 1 << 2,
+        RelativeChange    = 1 << 3,
+        MinDistanceChange = 1 << 4,
+        AttenuationChange = 1 << 5,
+        AllChanges        = (1 << 6) - 1
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Record a parameter change
+    ///
+    /// The change is applied immediately, unless updates are deferred.
+    ///
+    /// \param change Parameter that has changed
+    ///
+    ////////////////////////////////////////////////////////////
+    void setChanged(Change change);
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    float        m_pitch;       ///< Pitch of the sound
+    float        m_volume;      ///< Volume of the sound, in the range [0, 100]
+    Vector3f     m_position;    ///< 3D position of the sound
+    bool         m_relative;    ///< Is the position relative to the listener?
+    float        m_minDistance; ///< Distance under which the sound is heard at its maximum volume
+    float        m_attenuation; ///< Attenuation factor of the sound
+    unsigned int m_changes;     ///< Combination of Change flags not applied to the audio source yet
 };
 
 } // namespace sf
@@ -280,6 +335,10 @@ protected :
 /// It defines several properties for the sound: pitch,
 /// volume, position, attenuation, etc. All of them can be
 /// changed at any time with no impact on performances.
+/// Their values are cached, so that reading them back never
+/// requires a round-trip to the audio driver. When many
+/// sources are modified every frame, changes can also be
+/// batched with sf::Listener::setDeferredUpdates.
 ///
 /// \see sf::Sound, sf::SoundStream
 ///
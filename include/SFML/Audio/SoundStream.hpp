@@ -30,13 +30,21 @@
 ////////////////////////////////////////////////////////////
 #include <SFML/Audio/Export.hpp>
 #include <SFML/Audio/SoundSource.hpp>
-#include <SFML/System/Thread.hpp>
 #include <SFML/System/Time.hpp>
 #include <cstdlib>
+#include <deque>
+#include <vector>
 
 
 namespace sf
 {
+namespace priv
+{
+    class StreamScheduler;
+}
+
+class SoundEffect;
+
 ////////////////////////////////////////////////////////////
 /// \brief Abstract base class for streamed audio sources
 ///
@@ -55,6 +63,16 @@ public :
         std::size_t  sampleCount; ///< Number of samples pointed by Samples
     };
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Structure defining a chunk of floating point audio data to stream
+    ///
+    ////////////////////////////////////////////////////////////
+    struct FloatChunk
+    {
+        const float* samples;     ///< Pointer to the audio samples, in the range [-1, 1]
+        std::size_t  sampleCount; ///< Number of samples pointed by Samples
+    };
+
     ////////////////////////////////////////////////////////////
     /// \brief Destructor
     ///
@@ -67,8 +85,10 @@ public :
     /// This function starts the stream if it was stopped, resumes
     /// it if it was paused, and restarts it from beginning if it
     /// was it already playing.
-    /// This function uses its own thread so that it doesn't block
-    /// the rest of the program while the stream is played.
+    /// The first buffers are filled immediately, then the stream
+    /// is fed by a background thread shared by all the streams,
+    /// so that it doesn't block the rest of the program while
+    /// the stream is played.
     ///
     /// \see pause, stop
     ///
@@ -175,8 +195,105 @@ public :
     ////////////////////////////////////////////////////////////
     bool getLoop() const;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the number of audio buffers queued by the stream
+    ///
+    /// More buffers make the stream more tolerant to a busy
+    /// system, at the price of more memory and latency.
+    /// The new value is taken into account the next time the
+    /// stream is started. The default value is 3.
+    ///
+    /// \param count Number of buffers (at least 2)
+    ///
+    /// \see getBufferCount
+    ///
+    ////////////////////////////////////////////////////////////
+    void setBufferCount(unsigned int count);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of audio buffers queued by the stream
+    ///
+    /// \return Number of buffers
+    ///
+    /// \see setBufferCount
+    ///
+    ////////////////////////////////////////////////////////////
+    unsigned int getBufferCount() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the preferred duration of each audio buffer
+    ///
+    /// This value is a hint for derived classes, which choose
+    /// how much data they return from onGetData; sf::Music
+    /// uses it to size its chunks. The default value is 1 second.
+    ///
+    /// \param duration Duration of a buffer
+    ///
+    /// \see getBufferDuration
+    ///
+    ////////////////////////////////////////////////////////////
+    void setBufferDuration(Time duration);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the preferred duration of each audio buffer
+    ///
+    /// \return Duration of a buffer
+    ///
+    /// \see setBufferDuration
+    ///
+    ////////////////////////////////////////////////////////////
+    Time getBufferDuration() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of buffer underruns of the stream
+    ///
+    /// An underrun happens when all the queued buffers have been
+    /// played before the stream could provide new data, which
+    /// produces an audible gap. A non-zero value means that
+    /// the buffers should be larger or more numerous.
+    ///
+    /// \return Number of underruns since the stream was created
+    ///
+    ////////////////////////////////////////////////////////////
+    Uint64 getUnderrunCount() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the effect that processes the audio of the stream
+    ///
+    /// The effect is applied to each chunk of samples before it
+    /// is played. Several effects can be combined with
+    /// sf::SoundEffectChain or sf::MixerBus.
+    /// The stream doesn't store a copy of the effect, it keeps
+    /// a pointer to it. It is therefore the caller's
+    /// responsibility to keep the effect alive as long as it
+    /// is attached to the stream.
+    /// This function must only be called when the stream is
+    /// stopped. By default, no effect is applied.
+    ///
+    /// \param effect Effect to apply, or NULL to disable effects
+    ///
+    /// \see getEffect
+    ///
+    ////////////////////////////////////////////////////////////
+    void setEffect(SoundEffect* effect);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the effect that processes the audio of the stream
+    ///
+    /// \return Effect applied to the stream, or NULL if there's none
+    ///
+    /// \see setEffect
+    ///
+    ////////////////////////////////////////////////////////////
+    SoundEffect* getEffect() const;
+
 protected :
 
+    enum
+    {
+        NoLoop = -1 ///< "Invalid" position returned by onLoop to stop the stream at its end
+    };
+
     ////////////////////////////////////////////////////////////
     /// \brief Default constructor
     ///
@@ -201,12 +318,30 @@ protected :
     ////////////////////////////////////////////////////////////
     void initialize(unsigned int channelCount, unsigned int sampleRate);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Enable or disable floating point samples
+    ///
+    /// When enabled, the stream requests its samples from the
+    /// floating point version of onGetData, which avoids
+    /// clipping and requantizing the data of high precision
+    /// sources. The samples are played as they are if the
+    /// audio driver supports floating point buffers, and
+    /// converted to 16 bits otherwise.
+    /// This function must only be called when the stream is stopped.
+    /// By default, floating point samples are disabled.
+    ///
+    /// \param enabled True to provide floating point samples
+    ///
+    ////////////////////////////////////////////////////////////
+    void setFloatSamples(bool enabled);
+
     ////////////////////////////////////////////////////////////
     /// \brief Request a new chunk of audio samples from the stream source
     ///
     /// This function must be overriden by derived classes to provide
     /// the audio samples to play. It is called continuously by the
-    /// streaming loop, in a separate thread.
+    /// streaming loop, in a separate thread (except for the first
+    /// buffers, which are requested by play()).
     /// The source can choose to stop the streaming loop at any time, by
     /// returning false to the caller.
     ///
@@ -217,6 +352,22 @@ protected :
     ////////////////////////////////////////////////////////////
     virtual bool onGetData(Chunk& data) = 0;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Request a new chunk of floating point audio samples
+    ///        from the stream source
+    ///
+    /// This function is called instead of the 16 bits version
+    /// when floating point samples are enabled (see
+    /// setFloatSamples). The default implementation requests
+    /// 16 bits samples and converts them.
+    ///
+    /// \param data Chunk of data to fill
+    ///
+    /// \return True to continue playback, false to stop
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual bool onGetData(FloatChunk& data);
+
     ////////////////////////////////////////////////////////////
     /// \brief Change the current playing position in the stream source
     ///
@@ -228,16 +379,59 @@ protected :
     ////////////////////////////////////////////////////////////
     virtual void onSeek(Time timeOffset) = 0;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Change the current playing position in the stream
+    ///        source to the beginning of the loop
+    ///
+    /// This function is called when the stream source has
+    /// returned its last chunk and looping is enabled. Derived
+    /// classes can override it to loop over a part of the
+    /// stream only; the samples they return afterwards are
+    /// queued right after the previous ones, so that the loop
+    /// is seamless.
+    /// The default implementation seeks back to the beginning
+    /// of the stream and returns 0.
+    ///
+    /// \return Position of the stream source after the loop, in
+    ///         samples (all channels included), or NoLoop to
+    ///         stop playing
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual Int64 onLoop();
+
 private :
 
+    friend class priv::StreamScheduler;
+
     ////////////////////////////////////////////////////////////
-    /// \brief Function called as the entry point of the thread
+    /// \brief Create the buffers, fill them and start playing
     ///
-    /// This function starts the streaming loop, and returns
-    /// only when the sound is stopped.
+    /// The stream is then handed to the streaming scheduler.
     ///
     ////////////////////////////////////////////////////////////
-    void streamData();
+    void startStreaming();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Stop playing and destroy the buffers
+    ///
+    /// The stream must not be serviced by the scheduler anymore.
+    ///
+    ////////////////////////////////////////////////////////////
+    void stopStreaming();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Refill the buffers that have been played
+    ///
+    /// This function is called regularly by the streaming scheduler.
+    ///
+    /// \param interval Receives the time after which the stream
+    ///                 will need to be updated again
+    ///
+    /// \return True to continue streaming, false if the stream
+    ///         is finished (it is then already stopped)
+    ///
+    ////////////////////////////////////////////////////////////
+    bool update(Time& interval);
 
     ////////////////////////////////////////////////////////////
     /// \brief Fill a new buffer with audio samples, and append
@@ -247,12 +441,13 @@ private :
     /// consumed; it fills it again and inserts it back into the
     /// playing queue.
     ///
-    /// \param buffer Number of the buffer to fill (in [0, BufferCount])
+    /// \param bufferNum  Number of the buffer to fill (in [0, buffer count - 1])
+    /// \param retryCount Number of times the stream has looped without returning any data
     ///
     /// \return True if the stream source has requested to stop, false otherwise
     ///
     ////////////////////////////////////////////////////////////
-    bool fillAndPushBuffer(unsigned int bufferNum);
+    bool fillAndPushBuffer(unsigned int bufferNum, unsigned int retryCount = 0);
 
     ////////////////////////////////////////////////////////////
     /// \brief Fill the audio buffers and put them all into the playing queue
@@ -273,23 +468,40 @@ private :
     ////////////////////////////////////////////////////////////
     void clearQueue();
 
-    enum
+    ////////////////////////////////////////////////////////////
+    /// \brief State of an audio buffer of the stream
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Buffer
     {
-        BufferCount = 3 ///< Number of audio buffers used by the streaming loop
+        unsigned int id;                  ///< OpenAL identifier of the buffer
+        std::size_t  sampleCount;         ///< Number of samples of the stream stored in the buffer
+        std::size_t  playbackSampleCount; ///< Number of samples actually played, after the effect
+        Int64        seekOffset;          ///< Position of the stream after the buffer, if it ends a loop (NoLoop otherwise)
     };
 
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
-    Thread        m_thread;                  ///< Thread running the background tasks
-    bool          m_isStreaming;             ///< Streaming state (true = playing, false = stopped)
-    unsigned int  m_buffers[BufferCount];    ///< Sound buffers used to store temporary audio data
-    unsigned int  m_channelCount;            ///< Number of channels (1 = mono, 2 = stereo, ...)
-    unsigned int  m_sampleRate;              ///< Frequency (samples / second)
-    Uint32        m_format;                  ///< Format of the internal sound buffers
-    bool          m_loop;                    ///< Loop flag (true to loop, false to play once)
-    Uint64        m_samplesProcessed;        ///< Number of buffers processed since beginning of the stream
-    bool          m_endBuffers[BufferCount]; ///< Each buffer is marked as "end buffer" or not, for proper duration calculation
+    bool                     m_isStreaming;      ///< Streaming state (true = playing, false = stopped)
+    bool                     m_requestStop;      ///< Has the stream source returned its last chunk?
+    std::vector<Buffer>      m_buffers;          ///< Sound buffers used to store temporary audio data
+    std::deque<unsigned int> m_queue;            ///< Indices of the queued buffers, in playing order
+    unsigned int             m_bufferCount;      ///< Number of buffers to use for the next playback
+    Time                     m_bufferDuration;   ///< Preferred duration of a buffer
+    unsigned int             m_channelCount;     ///< Number of channels (1 = mono, 2 = stereo, ...)
+    unsigned int             m_sampleRate;       ///< Frequency (samples / second)
+    Uint32                   m_format;           ///< Format of the internal sound buffers
+    Uint32                   m_floatFormat;      ///< Floating point format of the internal sound buffers (0 if not supported)
+    bool                     m_floatSamples;     ///< Does the derived class provide floating point samples?
+    std::vector<Int16>       m_convertedSamples; ///< Floating point samples converted for a driver that can't play them
+    std::vector<float>       m_convertedChunk;   ///< 16 bits samples converted for the default floating point onGetData
+    SoundEffect*             m_effect;           ///< Effect applied to the stream (can be NULL)
+    std::vector<float>       m_effectBlock;      ///< Samples being processed by the effect
+    unsigned int             m_playbackRate;     ///< Sample rate of the played samples (differs from m_sampleRate if the effect resamples)
+    bool                     m_loop;             ///< Loop flag (true to loop, false to play once)
+    Uint64                   m_samplesProcessed; ///< Position of the stream at the beginning of the current buffer, in samples
+    Uint64                   m_underrunCount;    ///< Number of times the queue ran dry
 };
 
 } // namespace sf
@@ -323,10 +535,23 @@ private :
 /// \li onGetData fills a new chunk of audio data to be played
 /// \li onSeek changes the current playing position in the source
 ///
-/// It is important to note that each SoundStream is played in its
-/// own separate thread, so that the streaming loop doesn't block the
-/// rest of the program. In particular, the OnGetData and OnSeek
-/// virtual functions may sometimes be called from this separate thread.
+/// Streams that loop over a part of their source only can
+/// also override onLoop.
+///
+/// The audio of a stream can be processed by effects before it
+/// is played (see setEffect and sf::SoundEffect).
+///
+/// Sources that have more than 16 bits of precision can provide
+/// floating point samples instead: they must call setFloatSamples
+/// and override the FloatChunk version of onGetData. Surround
+/// layouts (4, 6, 7 or 8 channels) are supported when the audio
+/// driver provides the AL_EXT_MCFORMATS extension.
+///
+/// It is important to note that SoundStreams are fed by a separate
+/// thread (a single one for all the streams), so that the streaming
+/// loop doesn't block the rest of the program. In particular, the
+/// OnGetData and OnSeek virtual functions may sometimes be called
+/// from this separate thread.
 /// It is important to keep this in mind, because you may have to take
 /// care of synchronization issues if you share data between threads. 
 ///
@@ -0,0 +1,267 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2014 Laurent Gomila (laurent.gom@gmail.com)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_STREAMCACHE_HPP
+#define SFML_STREAMCACHE_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Audio/Export.hpp>
+#include <SFML/System/Mutex.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <list>
+#include <map>
+#include <string>
+#include <vector>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+/// \brief Cache of decoded audio blocks, shared by streams
+///        that play the same sources
+///
+////////////////////////////////////////////////////////////
+class SFML_AUDIO_API StreamCache : NonCopyable
+{
+public :
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// \param budget    Maximum amount of memory used by the decoded blocks, in bytes
+    /// \param blockSize Number of samples of one channel stored in each block
+    ///
+    ////////////////////////////////////////////////////////////
+    StreamCache(std::size_t budget = 32 * 1024 * 1024, std::size_t blockSize = 16384);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the maximum amount of memory used by the decoded blocks
+    ///
+    /// If the blocks already in the cache exceed the new budget,
+    /// the least recently used ones are discarded.
+    ///
+    /// \param budget New budget, in bytes
+    ///
+    /// \see getBudget
+    ///
+    ////////////////////////////////////////////////////////////
+    void setBudget(std::size_t budget);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the maximum amount of memory used by the decoded blocks
+    ///
+    /// \return Budget, in bytes
+    ///
+    /// \see setBudget
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getBudget() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of samples of one channel stored in each block
+    ///
+    /// Blocks are aligned on multiples of this size: block N
+    /// starts at sample N * getBlockSize() of its source.
+    ///
+    /// \return Size of a block, in samples of one channel
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getBlockSize() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Copy a decoded block, if it is in the cache
+    ///
+    /// \param source  Identifier of the source of the block
+    /// \param block   Index of the block in its source
+    /// \param samples Receives the interleaved samples of the block
+    ///
+    /// \return True if the block was found, false otherwise
+    ///
+    ////////////////////////////////////////////////////////////
+    bool find(const std::string& source, Uint64 block, std::vector<float>& samples);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Add a decoded block to the cache
+    ///
+    /// The least recently used blocks are discarded to stay
+    /// within the budget. Blocks bigger than the whole budget
+    /// are not stored.
+    ///
+    /// \param source      Identifier of the source of the block
+    /// \param block       Index of the block in its source
+    /// \param samples     Interleaved samples of the block
+    /// \param sampleCount Number of samples (all channels included); it may
+    ///                    be smaller than a full block at the end of the source
+    ///
+    ////////////////////////////////////////////////////////////
+    void insert(const std::string& source, Uint64 block, const float* samples, std::size_t sampleCount);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Discard all the blocks of a source
+    ///
+    /// \param source Identifier of the source
+    ///
+    ////////////////////////////////////////////////////////////
+    void remove(const std::string& source);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Discard all the blocks, and reset the statistics
+    ///
+    ////////////////////////////////////////////////////////////
+    void clear();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the memory used by the decoded blocks
+    ///
+    /// \return Resident size, in bytes
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getResidentSize() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of blocks currently in the cache
+    ///
+    /// \return Number of blocks
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getBlockCount() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of blocks that were found in the cache
+    ///
+    /// \return Number of successful calls to find
+    ///
+    ////////////////////////////////////////////////////////////
+    Uint64 getHitCount() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of blocks that were not found in the cache
+    ///
+    /// \return Number of unsuccessful calls to find
+    ///
+    ////////////////////////////////////////////////////////////
+    Uint64 getMissCount() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the ratio of blocks that were found in the cache
+    ///
+    /// \return Hit ratio, in range [0, 1] (0 if nothing was requested yet)
+    ///
+    ////////////////////////////////////////////////////////////
+    float getHitRatio() const;
+
+private :
+
+    ////////////////////////////////////////////////////////////
+    // Types
+    ////////////////////////////////////////////////////////////
+    typedef std::pair<std::string, Uint64> Key;
+
+    struct Block
+    {
+        Key                key;     ///< Source and index of the block
+        std::vector<float> samples; ///< Decoded samples
+    };
+
+    typedef std::list<Block>                  BlockList;
+    typedef std::map<Key, BlockList::iterator> BlockTable;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Discard the least recently used blocks until the
+    ///        cache fits in its budget
+    ///
+    /// \param extraSize Size that must be left available, in bytes
+    ///
+    ////////////////////////////////////////////////////////////
+    void evict(std::size_t extraSize);
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    BlockList     m_blocks;       ///< Blocks, from the most to the least recently used
+    BlockTable    m_table;        ///< Blocks indexed by source and index
+    std::size_t   m_budget;       ///< Maximum memory used by the blocks, in bytes
+    std::size_t   m_blockSize;    ///< Number of samples of one channel in a block
+    std::size_t   m_residentSize; ///< Memory currently used by the blocks, in bytes
+    Uint64        m_hitCount;     ///< Number of blocks found
+    Uint64        m_missCount;    ///< Number of blocks not found
+    mutable Mutex m_mutex;        ///< Mutex protecting the blocks
+};
+
+} // namespace sf
+
+
+#endif // SFML_STREAMCACHE_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::StreamCache
+/// \ingroup audio
+///
+/// When the same music is played by several sf::Music
+/// instances (several copies of an ambient track, a jingle
+/// played on many entities, ...), each of them decodes the
+/// whole file on its own. sf::StreamCache keeps the decoded
+/// samples in blocks of a fixed size, so that streams which
+/// play the same source only decode it once.
+///
+/// Blocks are identified by their source (a string chosen by
+/// the stream: sf::Music uses the filename, or the address of
+/// the data in memory) and their index in the source. The
+/// cache has a memory budget: when it is exceeded, the least
+/// recently used blocks are discarded. The hit ratio and the
+/// resident size allow to tune the budget.
+///
+/// Streams copy the blocks they read from the cache, so a
+/// block can be discarded at any time without affecting them.
+/// The cache can be shared by streams played in different
+/// threads, and must outlive them.
+///
+/// Custom streams can use the cache too, with find and insert.
+///
+/// Usage example:
+/// \code
+/// sf::StreamCache cache(16 * 1024 * 1024);
+///
+/// std::vector<sf::Music*> musics;
+/// for (int i = 0; i < 8; ++i)
+/// {
+///     sf::Music* music = new sf::Music;
+///     music->setCache(&cache);
+///     music->openFromFile("rain.ogg");
+///     music->play();
+///     musics.push_back(music);
+/// }
+///
+/// ...
+///
+/// std::cout << "hit ratio: " << cache.getHitRatio() * 100 << "%, "
+///           << cache.getResidentSize() / 1024 << " KB" << std::endl;
+/// \endcode
+///
+/// \see sf::Music
+///
+////////////////////////////////////////////////////////////
@@ -0,0 +1,291 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2014 Laurent Gomila (laurent.gom@gmail.com)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_VOICESTREAM_HPP
+#define SFML_VOICESTREAM_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Audio/Export.hpp>
+#include <SFML/Audio/SoundStream.hpp>
+#include <SFML/System/Mutex.hpp>
+#include <map>
+#include <vector>
+
+
+namespace sf
+{
+class AudioCodec;
+
+////////////////////////////////////////////////////////////
+/// \brief Streamed audio source that plays encoded frames
+///        received from the network, through a jitter buffer
+///
+////////////////////////////////////////////////////////////
+class SFML_AUDIO_API VoiceStream : public SoundStream
+{
+public :
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Construct the stream with a codec
+    ///
+    /// The codec must remain alive as long as the stream uses it.
+    ///
+    /// \param codec Codec used to decode the frames
+    ///
+    ////////////////////////////////////////////////////////////
+    explicit VoiceStream(AudioCodec& codec);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    ////////////////////////////////////////////////////////////
+    ~VoiceStream();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the format of the decoded audio
+    ///
+    /// This function must be called before the stream is played,
+    /// with the parameters used by the sender. It discards the
+    /// frames currently buffered.
+    ///
+    /// \param channelCount  Number of channels
+    /// \param sampleRate    Sample rate, in samples per second
+    /// \param frameDuration Duration of a frame
+    ///
+    ////////////////////////////////////////////////////////////
+    void setFormat(unsigned int channelCount, unsigned int sampleRate, Time frameDuration);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the delay used to absorb the network jitter
+    ///
+    /// When the playback starts, or resumes after the buffer
+    /// ran dry, the stream waits until this duration of audio
+    /// is buffered. Larger values tolerate more jitter, at
+    /// the cost of more latency. The default value is 60 ms.
+    ///
+    /// \param delay Jitter delay
+    ///
+    /// \see setMaxDelay
+    ///
+    ////////////////////////////////////////////////////////////
+    void setJitterDelay(Time delay);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the maximum delay of the buffered frames
+    ///
+    /// When more than this duration of audio is waiting in the
+    /// buffer (after a burst of packets, for example), the
+    /// oldest frames are dropped, so that the latency remains
+    /// bounded. The default value is 200 ms.
+    ///
+    /// \param delay Maximum delay
+    ///
+    /// \see setJitterDelay
+    ///
+    ////////////////////////////////////////////////////////////
+    void setMaxDelay(Time delay);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Add a received frame to the jitter buffer
+    ///
+    /// This function is typically called from the thread that
+    /// receives the packets. Frames can be pushed in any order;
+    /// frames that arrive after their turn to be played, or too
+    /// far ahead of it, are discarded. The stream only follows a
+    /// jump of the sequence numbers once several frames in a row
+    /// confirm it.
+    ///
+    /// \param sequence Sequence number of the frame, incremented by one for each frame by the sender
+    /// \param data     Pointer to the encoded frame
+    /// \param size     Size of the encoded frame, in bytes
+    ///
+    ////////////////////////////////////////////////////////////
+    void push(Uint32 sequence, const void* data, std::size_t size);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the duration of audio waiting in the jitter buffer
+    ///
+    /// \return Buffered duration
+    ///
+    ////////////////////////////////////////////////////////////
+    Time getBufferedDuration() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of frames that were missing when they had to be played
+    ///
+    /// Missing frames are replaced by a faded copy of the last
+    /// frame, or by silence.
+    ///
+    /// \return Number of lost frames
+    ///
+    ////////////////////////////////////////////////////////////
+    Uint64 getLostFrameCount() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of frames received after their turn to be played
+    ///
+    /// \return Number of late frames (including duplicates)
+    ///
+    ////////////////////////////////////////////////////////////
+    Uint64 getLateFrameCount() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of frames dropped to bound the latency
+    ///
+    /// This includes the frames rejected because their sequence
+    /// number was too far ahead of the playback.
+    ///
+    /// \return Number of dropped frames
+    ///
+    ////////////////////////////////////////////////////////////
+    Uint64 getDroppedFrameCount() const;
+
+protected :
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Provide the next frame of audio to play
+    ///
+    /// \param data Chunk of data to fill
+    ///
+    /// \return Always true, the stream never ends
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual bool onGetData(Chunk& data);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Restart the buffering
+    ///
+    /// Seeking has no meaning for a live stream, this function
+    /// only makes the stream wait for the jitter delay again.
+    ///
+    /// \param timeOffset Ignored
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void onSeek(Time timeOffset);
+
+private :
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the maximum number of frames that can wait in the buffer
+    ///
+    /// \return Maximum number of buffered frames (at least 1)
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getMaxFrameCount() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Drop the oldest frames until the buffer fits in the maximum delay
+    ///
+    ////////////////////////////////////////////////////////////
+    void dropOldestFrames();
+
+    ////////////////////////////////////////////////////////////
+    // Types
+    ////////////////////////////////////////////////////////////
+    typedef std::map<Uint64, std::vector<Uint8> > FrameTable;
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    AudioCodec&        m_codec;         ///< Codec used to decode the frames
+    Time               m_frameDuration; ///< Duration of a frame
+    std::size_t        m_frameSamples;  ///< Number of samples in a frame
+    Time               m_jitterDelay;   ///< Duration to buffer before starting the playback
+    Time               m_maxDelay;      ///< Maximum duration of the buffered frames
+    FrameTable         m_frames;        ///< Frames waiting to be played, by sequence number
+    bool               m_hasSequence;   ///< Has the first frame been received?
+    Uint64             m_nextSequence;  ///< Sequence number of the next frame to play
+    bool               m_isBuffering;   ///< Is the stream waiting for the jitter delay?
+    std::vector<Int16> m_samples;       ///< Samples of the frame being played
+    unsigned int       m_lossCount;     ///< Number of consecutive lost frames
+    Uint64             m_lostFrames;    ///< Total number of lost frames
+    Uint64             m_lateFrames;    ///< Total number of late frames
+    Uint64             m_droppedFrames; ///< Total number of dropped frames
+    std::size_t        m_outOfWindow;   ///< Number of consecutive frames received outside the jitter window
+    mutable Mutex      m_mutex;         ///< Mutex protecting the jitter buffer
+};
+
+} // namespace sf
+
+
+#endif // SFML_VOICESTREAM_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::VoiceStream
+/// \ingroup audio
+///
+/// sf::VoiceStream plays audio received from the network,
+/// typically voice chat. The sender splits the audio into
+/// frames of a fixed duration, encodes them with an
+/// sf::AudioCodec and sends each of them with a sequence
+/// number, usually over UDP. The receiver pushes the frames
+/// into the stream as they arrive.
+///
+/// Because packets arrive irregularly, out of order or not
+/// at all, the stream contains a jitter buffer: it waits
+/// until a short duration of audio is buffered before
+/// playing (see setJitterDelay), reorders the frames, replaces
+/// the missing ones, and drops frames when too many are
+/// waiting so that the latency stays bounded (see setMaxDelay).
+///
+/// The typical pipeline is sf::SoundRecorder (with a processing
+/// interval equal to the frame duration) -> sf::AudioCodec ->
+/// sf::UdpSocket -> sf::VoiceStream.
+///
+/// Usage example:
+/// \code
+/// // Sender (in a sf::SoundRecorder subclass, with setProcessingInterval(sf::milliseconds(20)))
+/// virtual bool onProcessSamples(const sf::Int16* samples, std::size_t sampleCount)
+/// {
+///     m_codec.encode(samples, sampleCount, 1, m_data);
+///
+///     sf::Packet packet;
+///     packet << m_sequence++;
+///     packet.append(&m_data[0], m_data.size());
+///     return m_socket.send(packet, m_host, m_port) == sf::Socket::Done;
+/// }
+///
+/// // Receiver
+/// sf::ImaAdpcmCodec codec;
+/// sf::VoiceStream stream(codec);
+/// stream.setFormat(1, 44100, sf::milliseconds(20));
+/// stream.play();
+///
+/// while (receiving)
+/// {
+///     sf::Packet packet;
+///     socket.receive(packet, sender, port);
+///
+///     sf::Uint32 sequence;
+///     packet >> sequence;
+///     stream.push(sequence, static_cast<const char*>(packet.getData()) + 4, packet.getDataSize() - 4);
+/// }
+/// \endcode
+///
+/// \see sf::AudioCodec, sf::SoundRecorder
+///
+////////////////////////////////////////////////////////////
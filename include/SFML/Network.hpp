@@ -30,13 +30,20 @@
 ////////////////////////////////////////////////////////////
 
 #include <SFML/System.hpp>
+#include <SFML/Network/BitReader.hpp>
+#include <SFML/Network/BitWriter.hpp>
+#include <SFML/Network/EventLoop.hpp>
 #include <SFML/Network/Ftp.hpp>
 #include <SFML/Network/Http.hpp>
+#include <SFML/Network/HttpStream.hpp>
 #include <SFML/Network/IpAddress.hpp>
 #include <SFML/Network/Packet.hpp>
+#include <SFML/Network/PacketPool.hpp>
+#include <SFML/Network/Resolver.hpp>
 #include <SFML/Network/SocketSelector.hpp>
 #include <SFML/Network/TcpListener.hpp>
 #include <SFML/Network/TcpSocket.hpp>
+#include <SFML/Network/UdpHost.hpp>
 #include <SFML/Network/UdpSocket.hpp>
 
 
@@ -0,0 +1,233 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2014 Laurent Gomila (laurent.gom@gmail.com)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_BITREADER_HPP
+#define SFML_BITREADER_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Network/Export.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <SFML/System/Vector2.hpp>
+#include <SFML/System/Vector3.hpp>
+
+
+namespace sf
+{
+class Packet;
+
+////////////////////////////////////////////////////////////
+/// \brief Read values written into a packet by sf::BitWriter
+///
+////////////////////////////////////////////////////////////
+class SFML_NETWORK_API BitReader : NonCopyable
+{
+public :
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Construct the reader from the packet to read
+    ///
+    /// The bits are read from the current reading position
+    /// of the packet.
+    ///
+    /// \param packet Packet to read from
+    ///
+    ////////////////////////////////////////////////////////////
+    explicit BitReader(Packet& packet);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Read an unsigned integer with a given number of bits
+    ///
+    /// \param bitCount Number of bits to read, between 1 and 32
+    ///
+    /// \return Value read (0 if the packet has no more data)
+    ///
+    ////////////////////////////////////////////////////////////
+    Uint32 readBits(unsigned int bitCount);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Read a boolean value, written as a single bit
+    ///
+    /// \return Value read
+    ///
+    ////////////////////////////////////////////////////////////
+    bool readBool();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Read a float value written with full precision
+    ///
+    /// \return Value read
+    ///
+    ////////////////////////////////////////////////////////////
+    float readFloat();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Read a quantized float value
+    ///
+    /// \param min      Minimum value of the range
+    /// \param max      Maximum value of the range
+    /// \param bitCount Number of bits of the value, between 1 and 32
+    ///
+    /// \return Value read
+    ///
+    ////////////////////////////////////////////////////////////
+    float readFloat(float min, float max, unsigned int bitCount);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Read a 2D vector with quantized components
+    ///
+    /// \param min      Minimum value of the components
+    /// \param max      Maximum value of the components
+    /// \param bitCount Number of bits of each component, between 1 and 32
+    ///
+    /// \return Vector read
+    ///
+    ////////////////////////////////////////////////////////////
+    Vector2f readVector2(float min, float max, unsigned int bitCount);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Read a 3D vector with quantized components
+    ///
+    /// \param min      Minimum value of the components
+    /// \param max      Maximum value of the components
+    /// \param bitCount Number of bits of each component, between 1 and 32
+    ///
+    /// \return Vector read
+    ///
+    ////////////////////////////////////////////////////////////
+    Vector3f readVector3(float min, float max, unsigned int bitCount);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Read an unsigned integer written with
+    ///        BitWriter::writeDelta
+    ///
+    /// \param baseline Value to return if it didn't change
+    /// \param bitCount Number of bits of the value, between 1 and 32
+    ///
+    /// \return Value read, or \a baseline
+    ///
+    ////////////////////////////////////////////////////////////
+    Uint32 readDelta(Uint32 baseline, unsigned int bitCount);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Read a quantized float value written with
+    ///        BitWriter::writeDelta
+    ///
+    /// \param baseline Value to return if it didn't change
+    /// \param min      Minimum value of the range
+    /// \param max      Maximum value of the range
+    /// \param bitCount Number of bits of the value, between 1 and 32
+    ///
+    /// \return Value read, or \a baseline
+    ///
+    ////////////////////////////////////////////////////////////
+    float readDelta(float baseline, float min, float max, unsigned int bitCount);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Read a quantized 2D vector written with
+    ///        BitWriter::writeDelta
+    ///
+    /// \param baseline Vector to return if it didn't change
+    /// \param min      Minimum value of the components
+    /// \param max      Maximum value of the components
+    /// \param bitCount Number of bits of each component, between 1 and 32
+    ///
+    /// \return Vector read, or \a baseline
+    ///
+    ////////////////////////////////////////////////////////////
+    Vector2f readDelta(const Vector2f& baseline, float min, float max, unsigned int bitCount);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Read a quantized 3D vector written with
+    ///        BitWriter::writeDelta
+    ///
+    /// \param baseline Vector to return if it didn't change
+    /// \param min      Minimum value of the components
+    /// \param max      Maximum value of the components
+    /// \param bitCount Number of bits of each component, between 1 and 32
+    ///
+    /// \return Vector read, or \a baseline
+    ///
+    ////////////////////////////////////////////////////////////
+    Vector3f readDelta(const Vector3f& baseline, float min, float max, unsigned int bitCount);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell if all the reads were successful
+    ///
+    /// \return False if the packet had not enough data for one of the reads
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isValid() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Convert a quantized value back to a float value
+    ///
+    /// \param value    Quantized value
+    /// \param min      Minimum value of the range
+    /// \param max      Maximum value of the range
+    /// \param bitCount Number of bits of the quantized value, between 1 and 32
+    ///
+    /// \return Float value corresponding to \a value
+    ///
+    /// \see BitWriter::quantize
+    ///
+    ////////////////////////////////////////////////////////////
+    static float dequantize(Uint32 value, float min, float max, unsigned int bitCount);
+
+private :
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    Packet&      m_packet;      ///< Packet to read from
+    Uint64       m_scratch;     ///< Bits read from the packet but not returned yet
+    unsigned int m_scratchBits; ///< Number of bits in m_scratch
+    bool         m_isValid;     ///< Were all the reads successful?
+};
+
+} // namespace sf
+
+
+#endif // SFML_BITREADER_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::BitReader
+/// \ingroup network
+///
+/// sf::BitReader reads the values written by sf::BitWriter.
+/// They must be read in the same order, with the same number
+/// of bits, ranges and baselines as they were written.
+///
+/// Each reader consumes whole bytes of the packet: the bits
+/// left in its last byte are the padding added by the writer.
+/// If the packet doesn't contain enough data, the reader
+/// returns zeros and isValid returns false.
+///
+/// See the documentation of sf::BitWriter for an example.
+///
+/// \see sf::BitWriter, sf::Packet
+///
+////////////////////////////////////////////////////////////
@@ -0,0 +1,305 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2014 Laurent Gomila (laurent.gom@gmail.com)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_BITWRITER_HPP
+#define SFML_BITWRITER_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Network/Export.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <SFML/System/Vector2.hpp>
+#include <SFML/System/Vector3.hpp>
+#include <cstddef>
+
+
+namespace sf
+{
+class Packet;
+
+////////////////////////////////////////////////////////////
+/// \brief Write values into a packet with an arbitrary
+///        number of bits, quantized or delta-encoded
+///
+////////////////////////////////////////////////////////////
+class SFML_NETWORK_API BitWriter : NonCopyable
+{
+public :
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Construct the writer from the packet to fill
+    ///
+    /// The bits are appended to the end of the packet.
+    ///
+    /// \param packet Packet to write to
+    ///
+    ////////////////////////////////////////////////////////////
+    explicit BitWriter(Packet& packet);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    /// The bits that were not written to the packet yet are
+    /// flushed.
+    ///
+    ////////////////////////////////////////////////////////////
+    ~BitWriter();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Write an unsigned integer with a given number of bits
+    ///
+    /// Only the \a bitCount lowest bits of \a value are written.
+    ///
+    /// \param value    Value to write
+    /// \param bitCount Number of bits to write, between 1 and 32
+    ///
+    ////////////////////////////////////////////////////////////
+    void writeBits(Uint32 value, unsigned int bitCount);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Write a boolean value, as a single bit
+    ///
+    /// \param value Value to write
+    ///
+    ////////////////////////////////////////////////////////////
+    void writeBool(bool value);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Write a float value with full precision (32 bits)
+    ///
+    /// \param value Value to write
+    ///
+    ////////////////////////////////////////////////////////////
+    void writeFloat(float value);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Write a float value quantized to a given number of bits
+    ///
+    /// The value is clamped to [\a min, \a max], and this range is
+    /// divided in 2^bitCount - 1 steps; the reader gets the value
+    /// rounded to the nearest step.
+    ///
+    /// \param value    Value to write
+    /// \param min      Minimum value of the range
+    /// \param max      Maximum value of the range
+    /// \param bitCount Number of bits to write, between 1 and 32
+    ///
+    ////////////////////////////////////////////////////////////
+    void writeFloat(float value, float min, float max, unsigned int bitCount);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Write a 2D vector, each component quantized
+    ///        to a given number of bits
+    ///
+    /// \param value    Vector to write
+    /// \param min      Minimum value of the components
+    /// \param max      Maximum value of the components
+    /// \param bitCount Number of bits of each component, between 1 and 32
+    ///
+    ////////////////////////////////////////////////////////////
+    void writeVector(const Vector2f& value, float min, float max, unsigned int bitCount);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Write a 3D vector, each component quantized
+    ///        to a given number of bits
+    ///
+    /// \param value    Vector to write
+    /// \param min      Minimum value of the components
+    /// \param max      Maximum value of the components
+    /// \param bitCount Number of bits of each component, between 1 and 32
+    ///
+    ////////////////////////////////////////////////////////////
+    void writeVector(const Vector3f& value, float min, float max, unsigned int bitCount);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Write an unsigned integer only if it differs
+    ///        from the baseline known by the reader
+    ///
+    /// A single bit tells whether the value changed; the value
+    /// itself follows only in that case. The bits of all the
+    /// fields written with the delta functions form the change
+    /// mask of the snapshot.
+    ///
+    /// \param value    Value to write
+    /// \param baseline Value already known by the reader
+    /// \param bitCount Number of bits of the value, between 1 and 32
+    ///
+    /// \return True if the value was written, false if it didn't change
+    ///
+    ////////////////////////////////////////////////////////////
+    bool writeDelta(Uint32 value, Uint32 baseline, unsigned int bitCount);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Write a quantized float value only if it differs
+    ///        from the baseline known by the reader
+    ///
+    /// The values are compared after quantization, so changes
+    /// smaller than the precision are not written.
+    ///
+    /// \param value    Value to write
+    /// \param baseline Value already known by the reader
+    /// \param min      Minimum value of the range
+    /// \param max      Maximum value of the range
+    /// \param bitCount Number of bits of the value, between 1 and 32
+    ///
+    /// \return True if the value was written, false if it didn't change
+    ///
+    ////////////////////////////////////////////////////////////
+    bool writeDelta(float value, float baseline, float min, float max, unsigned int bitCount);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Write a quantized 2D vector only if it differs
+    ///        from the baseline known by the reader
+    ///
+    /// A single bit tells whether any component changed; the
+    /// whole vector follows only in that case.
+    ///
+    /// \param value    Vector to write
+    /// \param baseline Vector already known by the reader
+    /// \param min      Minimum value of the components
+    /// \param max      Maximum value of the components
+    /// \param bitCount Number of bits of each component, between 1 and 32
+    ///
+    /// \return True if the vector was written, false if it didn't change
+    ///
+    ////////////////////////////////////////////////////////////
+    bool writeDelta(const Vector2f& value, const Vector2f& baseline, float min, float max, unsigned int bitCount);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Write a quantized 3D vector only if it differs
+    ///        from the baseline known by the reader
+    ///
+    /// A single bit tells whether any component changed; the
+    /// whole vector follows only in that case.
+    ///
+    /// \param value    Vector to write
+    /// \param baseline Vector already known by the reader
+    /// \param min      Minimum value of the components
+    /// \param max      Maximum value of the components
+    /// \param bitCount Number of bits of each component, between 1 and 32
+    ///
+    /// \return True if the vector was written, false if it didn't change
+    ///
+    ////////////////////////////////////////////////////////////
+    bool writeDelta(const Vector3f& value, const Vector3f& baseline, float min, float max, unsigned int bitCount);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Write the pending bits to the packet
+    ///
+    /// The last byte is completed with zeros. Other data can
+    /// then be written to the packet with its operators.
+    ///
+    ////////////////////////////////////////////////////////////
+    void flush();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of bits written so far
+    ///
+    /// \return Number of bits written, padding excluded
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getBitCount() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Quantize a float value
+    ///
+    /// \param value    Value to quantize
+    /// \param min      Minimum value of the range
+    /// \param max      Maximum value of the range
+    /// \param bitCount Number of bits of the result, between 1 and 32
+    ///
+    /// \return Index of the step nearest to \a value
+    ///
+    /// \see BitReader::dequantize
+    ///
+    ////////////////////////////////////////////////////////////
+    static Uint32 quantize(float value, float min, float max, unsigned int bitCount);
+
+private :
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    Packet&      m_packet;      ///< Packet to write to
+    Uint64       m_scratch;     ///< Bits not written to the packet yet
+    unsigned int m_scratchBits; ///< Number of bits in m_scratch
+    std::size_t  m_bitCount;    ///< Number of bits written
+};
+
+} // namespace sf
+
+
+#endif // SFML_BITWRITER_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::BitWriter
+/// \ingroup network
+///
+/// The values written with the operators of sf::Packet occupy
+/// whole bytes, and a full float per coordinate. When the
+/// state of a world is broadcast at every tick, most of this
+/// space is wasted: booleans need a single bit, positions
+/// need a known precision in a known range, and most values
+/// didn't change since the previous state.
+///
+/// sf::BitWriter writes values with exactly the number of bits
+/// that they need:
+/// \li integers with a given number of bits
+/// \li floats and vectors quantized to a given number of bits
+/// \li values compared to a baseline, so that unchanged ones
+///     cost a single bit
+///
+/// The baseline is usually the last state that the receiver
+/// acknowledged. The bits are read back with sf::BitReader,
+/// in the same order and with the same parameters.
+///
+/// Usage example:
+/// \code
+/// // Write the changes of an entity since the last acknowledged state
+/// sf::Packet packet;
+/// {
+///     sf::BitWriter writer(packet);
+///     writer.writeBits(entity.id, 12);
+///     writer.writeDelta(entity.position, baseline.position, -1000.f, 1000.f, 20);
+///     writer.writeDelta(entity.angle, baseline.angle, 0.f, 360.f, 10);
+///     writer.writeDelta(entity.health, baseline.health, 7);
+/// } // the writer flushes its last bits when it is destroyed
+///
+/// socket.send(packet);
+///
+/// -----------------------------------------------------------------
+///
+/// // Read them on the other side
+/// sf::BitReader reader(packet);
+/// sf::Uint32 id = reader.readBits(12);
+/// entity.position = reader.readDelta(baseline.position, -1000.f, 1000.f, 20);
+/// entity.angle    = reader.readDelta(baseline.angle, 0.f, 360.f, 10);
+/// entity.health   = reader.readDelta(baseline.health, 7);
+/// \endcode
+///
+/// \see sf::BitReader, sf::Packet
+///
+////////////////////////////////////////////////////////////
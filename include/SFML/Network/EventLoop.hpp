@@ -0,0 +1,408 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2014 Laurent Gomila (laurent.gom@gmail.com)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_EVENTLOOP_HPP
+#define SFML_EVENTLOOP_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Network/Export.hpp>
+#include <SFML/Network/IpAddress.hpp>
+#include <SFML/Network/Socket.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <SFML/System/Time.hpp>
+#include <cstddef>
+
+
+namespace sf
+{
+namespace priv
+{
+    struct AsyncHandler;
+    struct TimerHandler;
+}
+
+class TcpListener;
+class TcpSocket;
+class UdpSocket;
+
+////////////////////////////////////////////////////////////
+/// \brief Single-threaded loop running asynchronous socket
+///        operations and timers
+///
+////////////////////////////////////////////////////////////
+class SFML_NETWORK_API EventLoop : NonCopyable
+{
+public :
+
+    ////////////////////////////////////////////////////////////
+    // Types
+    ////////////////////////////////////////////////////////////
+    typedef Uint64 Timer; ///< Identifier of a timer
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    ////////////////////////////////////////////////////////////
+    EventLoop();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    /// The pending operations and timers are discarded, their
+    /// handlers are not called.
+    ///
+    ////////////////////////////////////////////////////////////
+    ~EventLoop();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Start connecting a TCP socket to a remote peer
+    ///
+    /// The handler is called with the status of the connection
+    /// (and a size of 0) when it is established or has failed.
+    /// The socket is switched to non-blocking mode.
+    ///
+    /// \param socket        Socket to connect
+    /// \param remoteAddress Address of the remote peer
+    /// \param remotePort    Port of the remote peer
+    /// \param handler       Function or functor to call, with the signature
+    ///                      void(sf::Socket::Status, std::size_t)
+    ///
+    ////////////////////////////////////////////////////////////
+    template <typename F>
+    void asyncConnect(TcpSocket& socket, const IpAddress& remoteAddress, unsigned short remotePort, F handler);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Wait for a new connection on a listener
+    ///
+    /// The handler is called when \a socket is connected to
+    /// the new peer (Done), or if an error happened.
+    /// The listener is switched to non-blocking mode.
+    ///
+    /// \param listener Listener to accept the connection from
+    /// \param socket   Socket that will hold the new connection
+    /// \param handler  Function or functor to call, with the signature
+    ///                 void(sf::Socket::Status, std::size_t)
+    ///
+    ////////////////////////////////////////////////////////////
+    template <typename F>
+    void asyncAccept(TcpListener& listener, TcpSocket& socket, F handler);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Send raw data to the peer of a TCP socket
+    ///
+    /// The handler is called once all the data has been sent
+    /// (Done), or if an error happened; its second argument is
+    /// the number of bytes actually sent.
+    /// The data is not copied: it must remain valid until the
+    /// handler is called. Several sends can be queued on the
+    /// same socket, they are performed in order.
+    /// The socket is switched to non-blocking mode.
+    ///
+    /// \param socket  Socket to send the data with
+    /// \param data    Pointer to the bytes to send
+    /// \param size    Number of bytes to send
+    /// \param handler Function or functor to call, with the signature
+    ///                void(sf::Socket::Status, std::size_t)
+    ///
+    ////////////////////////////////////////////////////////////
+    template <typename F>
+    void asyncSend(TcpSocket& socket, const void* data, std::size_t size, F handler);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Receive raw data from the peer of a TCP socket
+    ///
+    /// The handler is called as soon as some data has been
+    /// received (it may be less than \a size), when the peer
+    /// disconnects, or if an error happened; its second
+    /// argument is the number of bytes received.
+    /// The buffer must remain valid until the handler is called.
+    /// The socket is switched to non-blocking mode.
+    ///
+    /// \param socket  Socket to receive the data from
+    /// \param data    Pointer to the array to fill
+    /// \param size    Maximum number of bytes to receive
+    /// \param handler Function or functor to call, with the signature
+    ///                void(sf::Socket::Status, std::size_t)
+    ///
+    ////////////////////////////////////////////////////////////
+    template <typename F>
+    void asyncReceive(TcpSocket& socket, void* data, std::size_t size, F handler);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Send a datagram with a UDP socket
+    ///
+    /// The data is not copied: it must remain valid until the
+    /// handler is called.
+    /// The socket is switched to non-blocking mode.
+    ///
+    /// \param socket        Socket to send the data with
+    /// \param data          Pointer to the bytes to send
+    /// \param size          Number of bytes to send
+    /// \param remoteAddress Address of the receiver
+    /// \param remotePort    Port of the receiver
+    /// \param handler       Function or functor to call, with the signature
+    ///                      void(sf::Socket::Status, std::size_t)
+    ///
+    ////////////////////////////////////////////////////////////
+    template <typename F>
+    void asyncSend(UdpSocket& socket, const void* data, std::size_t size, const IpAddress& remoteAddress, unsigned short remotePort, F handler);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Receive a datagram with a UDP socket
+    ///
+    /// \a remoteAddress and \a remotePort are filled with the
+    /// sender of the datagram before the handler is called.
+    /// The buffer and the variables must remain valid until
+    /// the handler is called.
+    /// The socket is switched to non-blocking mode.
+    ///
+    /// \param socket        Socket to receive the data from
+    /// \param data          Pointer to the array to fill
+    /// \param size          Maximum number of bytes to receive
+    /// \param remoteAddress Address of the sender
+    /// \param remotePort    Port of the sender
+    /// \param handler       Function or functor to call, with the signature
+    ///                      void(sf::Socket::Status, std::size_t)
+    ///
+    ////////////////////////////////////////////////////////////
+    template <typename F>
+    void asyncReceive(UdpSocket& socket, void* data, std::size_t size, IpAddress& remoteAddress, unsigned short& remotePort, F handler);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Call a function after a delay
+    ///
+    /// \param delay   Time to wait before calling the handler
+    /// \param handler Function or functor to call, with the signature void()
+    ///
+    /// \return Identifier of the timer
+    ///
+    /// \see cancelTimer
+    ///
+    ////////////////////////////////////////////////////////////
+    template <typename F>
+    Timer addTimer(Time delay, F handler);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Cancel a timer
+    ///
+    /// Its handler will not be called. This function does
+    /// nothing if the timer has already expired.
+    ///
+    /// \param timer Identifier of the timer to cancel
+    ///
+    ////////////////////////////////////////////////////////////
+    void cancelTimer(Timer timer);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Cancel all the pending operations of a socket
+    ///
+    /// Their handlers will not be called. This function must
+    /// be called before a socket with pending operations is
+    /// disconnected or destroyed.
+    ///
+    /// \param socket Socket whose operations must be cancelled
+    ///
+    ////////////////////////////////////////////////////////////
+    void cancel(Socket& socket);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Run the loop until there is nothing left to do
+    ///
+    /// The function returns when there are no more pending
+    /// operations and timers, or when stop() is called.
+    ///
+    /// \return Number of handlers called
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t run();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Wait for events, and call the handlers of the
+    ///        operations and timers that are complete
+    ///
+    /// \param timeout Maximum time to wait (use Time::Zero for infinity)
+    ///
+    /// \return Number of handlers called
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t runOnce(Time timeout = Time::Zero);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Call the handlers of the operations and timers
+    ///        that are complete, without waiting
+    ///
+    /// This function is meant to be called regularly by an
+    /// application that has its own main loop.
+    ///
+    /// \return Number of handlers called
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t poll();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Make run() return as soon as possible
+    ///
+    /// This is the only function of the class that can be
+    /// called from another thread. If the loop is not running,
+    /// the next call to run() returns immediately.
+    ///
+    ////////////////////////////////////////////////////////////
+    void stop();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of pending operations and timers
+    ///
+    /// \return Number of handlers waiting to be called
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getPendingCount() const;
+
+private :
+
+    struct EventLoopImpl;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Queue a TCP connection
+    ///
+    ////////////////////////////////////////////////////////////
+    void connect(TcpSocket& socket, const IpAddress& remoteAddress, unsigned short remotePort, priv::AsyncHandler* handler);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Queue the acceptance of a TCP connection
+    ///
+    ////////////////////////////////////////////////////////////
+    void accept(TcpListener& listener, TcpSocket& socket, priv::AsyncHandler* handler);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Queue a TCP send
+    ///
+    ////////////////////////////////////////////////////////////
+    void send(TcpSocket& socket, const void* data, std::size_t size, priv::AsyncHandler* handler);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Queue a TCP receive
+    ///
+    ////////////////////////////////////////////////////////////
+    void receive(TcpSocket& socket, void* data, std::size_t size, priv::AsyncHandler* handler);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Queue a UDP send
+    ///
+    ////////////////////////////////////////////////////////////
+    void send(UdpSocket& socket, const void* data, std::size_t size, const IpAddress& remoteAddress, unsigned short remotePort, priv::AsyncHandler* handler);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Queue a UDP receive
+    ///
+    ////////////////////////////////////////////////////////////
+    void receive(UdpSocket& socket, void* data, std::size_t size, IpAddress& remoteAddress, unsigned short& remotePort, priv::AsyncHandler* handler);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Start a timer
+    ///
+    ////////////////////////////////////////////////////////////
+    Timer startTimer(Time delay, priv::TimerHandler* handler);
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    EventLoopImpl* m_impl; ///< Opaque pointer to the implementation (which requires OS-specific types)
+};
+
+#include <SFML/Network/EventLoop.inl>
+
+} // namespace sf
+
+
+#endif // SFML_EVENTLOOP_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::EventLoop
+/// \ingroup network
+///
+/// sf::EventLoop runs socket operations asynchronously: instead
+/// of blocking until a socket is ready, or polling non-blocking
+/// sockets by hand, you start an operation (asyncConnect,
+/// asyncAccept, asyncSend, asyncReceive) with a handler, and the
+/// loop calls the handler when the operation is complete. The
+/// loop can also call handlers after a delay (addTimer).
+///
+/// All the handlers are called by the thread that runs the loop
+/// (run, runOnce or poll), never from inside the async functions.
+/// A handler can start new operations, which is the usual way to
+/// keep receiving from a socket. A single thread can serve
+/// thousands of connections: the loop uses epoll on Linux, and
+/// poll on the other systems.
+///
+/// Handlers are functions or functors taking the status of the
+/// operation and the number of bytes transferred. The loop
+/// doesn't own the sockets nor the buffers, which must remain
+/// alive until the handlers are called (or the operations are
+/// cancelled with cancel). Except for stop(), an event loop must
+/// only be used by one thread.
+///
+/// Usage example:
+/// \code
+/// // Prints what is received, and waits for more
+/// struct Printer
+/// {
+///     Printer(sf::EventLoop& loop, sf::TcpSocket& socket, char* buffer) : loop(&loop), socket(&socket), buffer(buffer) {}
+///
+///     void operator ()(sf::Socket::Status status, std::size_t size)
+///     {
+///         if (status == sf::Socket::Done)
+///         {
+///             std::cout.write(buffer, size);
+///             loop->asyncReceive(*socket, buffer, 1024, *this);
+///         }
+///     }
+///
+///     sf::EventLoop* loop;
+///     sf::TcpSocket* socket;
+///     char*          buffer;
+/// };
+///
+/// void onTimeout()
+/// {
+///     std::cout << "10 seconds elapsed" << std::endl;
+/// }
+///
+/// sf::TcpSocket socket;
+/// socket.connect("192.168.1.50", 55001);
+///
+/// char buffer[1024];
+/// sf::EventLoop loop;
+/// loop.asyncReceive(socket, buffer, sizeof(buffer), Printer(loop, socket, buffer));
+/// loop.addTimer(sf::seconds(10), &onTimeout);
+///
+/// // Runs until the connection is closed and the timer has expired
+/// loop.run();
+/// \endcode
+///
+/// \see sf::SocketSelector, sf::TcpSocket, sf::UdpSocket
+///
+////////////////////////////////////////////////////////////
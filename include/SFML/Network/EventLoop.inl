@@ -0,0 +1,115 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2014 Laurent Gomila (laurent.gom@gmail.com)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+namespace priv
+{
+// Base class for the handlers of socket operations
+struct AsyncHandler
+{
+    virtual ~AsyncHandler() {}
+    virtual void call(Socket::Status status, std::size_t size) = 0;
+};
+
+// Specialization using a functor (including free functions)
+template <typename F>
+struct AsyncFunctor : AsyncHandler
+{
+    AsyncFunctor(F functor) : m_functor(functor) {}
+    virtual void call(Socket::Status status, std::size_t size) {m_functor(status, size);}
+    F m_functor;
+};
+
+// Base class for the handlers of timers
+struct TimerHandler
+{
+    virtual ~TimerHandler() {}
+    virtual void call() = 0;
+};
+
+// Specialization using a functor (including free functions)
+template <typename F>
+struct TimerFunctor : TimerHandler
+{
+    TimerFunctor(F functor) : m_functor(functor) {}
+    virtual void call() {m_functor();}
+    F m_functor;
+};
+
+} // namespace priv
+
+
+////////////////////////////////////////////////////////////
+template <typename F>
+void EventLoop::asyncConnect(TcpSocket& socket, const IpAddress& remoteAddress, unsigned short remotePort, F handler)
+{
+    connect(socket, remoteAddress, remotePort, new priv::AsyncFunctor<F>(handler));
+}
+
+
+////////////////////////////////////////////////////////////
+template <typename F>
+void EventLoop::asyncAccept(TcpListener& listener, TcpSocket& socket, F handler)
+{
+    accept(listener, socket, new priv::AsyncFunctor<F>(handler));
+}
+
+
+////////////////////////////////////////////////////////////
+template <typename F>
+void EventLoop::asyncSend(TcpSocket& socket, const void* data, std::size_t size, F handler)
+{
+    send(socket, data, size, new priv::AsyncFunctor<F>(handler));
+}
+
+
+////////////////////////////////////////////////////////////
+template <typename F>
+void EventLoop::asyncReceive(TcpSocket& socket, void* data, std::size_t size, F handler)
+{
+    receive(socket, data, size, new priv::AsyncFunctor<F>(handler));
+}
+
+
+////////////////////////////////////////////////////////////
+template <typename F>
+void EventLoop::asyncSend(UdpSocket& socket, const void* data, std::size_t size, const IpAddress& remoteAddress, unsigned short remotePort, F handler)
+{
+    send(socket, data, size, remoteAddress, remotePort, new priv::AsyncFunctor<F>(handler));
+}
+
+
+////////////////////////////////////////////////////////////
+template <typename F>
+void EventLoop::asyncReceive(UdpSocket& socket, void* data, std::size_t size, IpAddress& remoteAddress, unsigned short& remotePort, F handler)
+{
+    receive(socket, data, size, remoteAddress, remotePort, new priv::AsyncFunctor<F>(handler));
+}
+
+
+////////////////////////////////////////////////////////////
+template <typename F>
+EventLoop::Timer EventLoop::addTimer(Time delay, F handler)
+{
+    return startTimer(delay, new priv::TimerFunctor<F>(handler));
+}
@@ -40,6 +40,11 @@ namespace sf
 {
 class IpAddress;
 
+namespace priv
+{
+    struct FtpProgressCallback;
+}
+
 ////////////////////////////////////////////////////////////
 /// \brief A FTP client
 ///
@@ -453,16 +458,51 @@ public :
     /// destination path is relative to the current directory
     /// of your application.
     ///
+    /// The file is written as it is received, by chunks of a
+    /// fixed size, so it is never entirely kept in memory.
+    /// If \a resume is true and the local file already exists,
+    /// the server is asked to send only the rest of the file
+    /// (REST command), which is appended to the local file; if
+    /// the server can't restart transfers, the whole file is
+    /// downloaded again.
+    ///
     /// \param remoteFile Filename of the distant file to download
     /// \param localPath  The directory in which to put the file on the local computer
     /// \param mode       Transfer mode
+    /// \param resume     Continue a previous, interrupted download?
     ///
     /// \return Server response to the request
     ///
     /// \see upload
     ///
     ////////////////////////////////////////////////////////////
-    Response download(const std::string& remoteFile, const std::string& localPath, TransferMode mode = Binary);
+    Response download(const std::string& remoteFile, const std::string& localPath, TransferMode mode = Binary, bool resume = false);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Download a file from the server, reporting the
+    ///        progress of the transfer
+    ///
+    /// This function works like the other overload of download,
+    /// and calls \a progress after each chunk received.
+    /// The callback can be any function or functor that takes
+    /// the number of bytes of the file received so far and the
+    /// total size of the file (both sf::Uint64; the total is 0
+    /// if the server can't tell the size of the file), and
+    /// returns a boolean: false stops the transfer.
+    ///
+    /// \param remoteFile Filename of the distant file to download
+    /// \param localPath  The directory in which to put the file on the local computer
+    /// \param mode       Transfer mode
+    /// \param resume     Continue a previous, interrupted download?
+    /// \param progress   Function to call after each chunk
+    ///
+    /// \return Server response to the request, TransferAborted if the callback stopped the transfer
+    ///
+    /// \see upload
+    ///
+    ////////////////////////////////////////////////////////////
+    template <typename F>
+    Response download(const std::string& remoteFile, const std::string& localPath, TransferMode mode, bool resume, F progress);
 
     ////////////////////////////////////////////////////////////
     /// \brief Upload a file to the server
@@ -472,16 +512,46 @@ public :
     /// remote path is relative to the current directory of the
     /// FTP server.
     ///
+    /// The file is read as it is sent, by chunks of a fixed
+    /// size, so it is never entirely kept in memory.
+    /// If \a resume is true and the file already exists on the
+    /// server, only the part of the local file that is beyond
+    /// the size of the remote one (SIZE command) is sent, and
+    /// appended to it (APPE command).
+    ///
     /// \param localFile  Path of the local file to upload
     /// \param remotePath The directory in which to put the file on the server
     /// \param mode       Transfer mode
+    /// \param resume     Continue a previous, interrupted upload?
     ///
     /// \return Server response to the request
     ///
     /// \see download
     ///
     ////////////////////////////////////////////////////////////
-    Response upload(const std::string& localFile, const std::string& remotePath, TransferMode mode = Binary);
+    Response upload(const std::string& localFile, const std::string& remotePath, TransferMode mode = Binary, bool resume = false);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Upload a file to the server, reporting the
+    ///        progress of the transfer
+    ///
+    /// This function works like the other overload of upload,
+    /// and calls \a progress after each chunk sent, with the
+    /// same arguments as for download.
+    ///
+    /// \param localFile  Path of the local file to upload
+    /// \param remotePath The directory in which to put the file on the server
+    /// \param mode       Transfer mode
+    /// \param resume     Continue a previous, interrupted upload?
+    /// \param progress   Function to call after each chunk
+    ///
+    /// \return Server response to the request, TransferAborted if the callback stopped the transfer
+    ///
+    /// \see download
+    ///
+    ////////////////////////////////////////////////////////////
+    template <typename F>
+    Response upload(const std::string& localFile, const std::string& remotePath, TransferMode mode, bool resume, F progress);
 
     ////////////////////////////////////////////////////////////
     /// \brief Send a command to the FTP server
@@ -514,6 +584,45 @@ private:
     ////////////////////////////////////////////////////////////
     Response getResponse();
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Download a file, reporting the progress to a callback
+    ///
+    /// \param remoteFile Filename of the distant file to download
+    /// \param localPath  The directory in which to put the file on the local computer
+    /// \param mode       Transfer mode
+    /// \param resume     Continue a previous, interrupted download?
+    /// \param progress   Function to call after each chunk (can be NULL)
+    ///
+    /// \return Server response to the request
+    ///
+    ////////////////////////////////////////////////////////////
+    Response performDownload(const std::string& remoteFile, const std::string& localPath, TransferMode mode, bool resume, priv::FtpProgressCallback* progress);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Upload a file, reporting the progress to a callback
+    ///
+    /// \param localFile  Path of the local file to upload
+    /// \param remotePath The directory in which to put the file on the server
+    /// \param mode       Transfer mode
+    /// \param resume     Continue a previous, interrupted upload?
+    /// \param progress   Function to call after each chunk (can be NULL)
+    ///
+    /// \return Server response to the request
+    ///
+    ////////////////////////////////////////////////////////////
+    Response performUpload(const std::string& localFile, const std::string& remotePath, TransferMode mode, bool resume, priv::FtpProgressCallback* progress);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the size of a file on the server
+    ///
+    /// \param remoteFile Filename of the distant file
+    /// \param size       Filled with the size of the file
+    ///
+    /// \return True if the server could give the size of the file
+    ///
+    ////////////////////////////////////////////////////////////
+    bool getFileSize(const std::string& remoteFile, Uint64& size);
+
     ////////////////////////////////////////////////////////////
     /// \brief Utility class for exchanging datas with the server
     ///        on the data channel
@@ -526,9 +635,12 @@ private:
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
-    TcpSocket m_commandSocket; ///< Socket holding the control connection with the server
+    TcpSocket   m_commandSocket; ///< Socket holding the control connection with the server
+    std::string m_receiveBuffer; ///< Received command data that is yet to be processed
 };
 
+#include <SFML/Network/Ftp.inl>
+
 } // namespace sf
 
 
@@ -561,7 +673,10 @@ private:
 /// All commands, especially upload and download, may take some
 /// time to complete. This is important to know if you don't want
 /// to block your application while the server is completing
-/// the task.
+/// the task. Files are transferred by chunks, so their size is
+/// not limited by the available memory; a callback can follow
+/// the progress of a transfer, for example a function declared
+/// as bool printProgress(sf::Uint64 transferred, sf::Uint64 total).
 ///
 /// Usage example:
 /// \code
@@ -593,6 +708,11 @@ private:
 /// if (response.isOk())
 ///     std::cout << "File uploaded" << std::endl;
 ///
+/// // Download a big file, continuing a previous attempt, and show the progress
+/// response = ftp.download("files/big.bin", "local-path", sf::Ftp::Binary, true, printProgress);
+/// if (response.isOk())
+///     std::cout << "File downloaded" << std::endl;
+///
 /// // Send specific commands (here: FEAT to list supported FTP features)
 /// response = ftp.sendCommand("FEAT");
 /// if (response.isOk())
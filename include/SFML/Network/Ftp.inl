@@ -0,0 +1,61 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2014 Laurent Gomila (laurent.gom@gmail.com)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+namespace priv
+{
+// Base class for the functions following the progress of a transfer
+struct FtpProgressCallback
+{
+    virtual ~FtpProgressCallback() {}
+    virtual bool call(Uint64 transferred, Uint64 total) = 0;
+};
+
+// Specialization using a functor (including free functions)
+template <typename F>
+struct FtpProgressFunctor : FtpProgressCallback
+{
+    FtpProgressFunctor(F functor) : m_functor(functor) {}
+    virtual bool call(Uint64 transferred, Uint64 total) {return m_functor(transferred, total);}
+    F m_functor;
+};
+
+} // namespace priv
+
+
+////////////////////////////////////////////////////////////
+template <typename F>
+Ftp::Response Ftp::download(const std::string& remoteFile, const std::string& localPath, TransferMode mode, bool resume, F progress)
+{
+    priv::FtpProgressFunctor<F> callback(progress);
+    return performDownload(remoteFile, localPath, mode, resume, &callback);
+}
+
+
+////////////////////////////////////////////////////////////
+template <typename F>
+Ftp::Response Ftp::upload(const std::string& localFile, const std::string& remotePath, TransferMode mode, bool resume, F progress)
+{
+    priv::FtpProgressFunctor<F> callback(progress);
+    return performUpload(localFile, remotePath, mode, resume, &callback);
+}
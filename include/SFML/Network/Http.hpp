@@ -35,10 +35,16 @@
 #include <SFML/System/Time.hpp>
 #include <map>
 #include <string>
+#include <vector>
 
 
 namespace sf
 {
+namespace priv
+{
+    struct HttpBodyCallback;
+}
+
 ////////////////////////////////////////////////////////////
 /// \brief A HTTP client
 ///
@@ -217,7 +223,7 @@ public :
             Unauthorized        = 401, ///< The requested page needs an authentification to be accessed
             Forbidden           = 403, ///< The requested page cannot be accessed at all, even with authentification
             NotFound            = 404, ///< The requested page doesn't exist
-            RangeNotSatisfiable = 407, ///< The server can't satisfy the partial GET request (with a "Range" header field)
+            RangeNotSatisfiable = 416, ///< The server can't satisfy the partial GET request (with a "Range" header field)
 
             // 5xx: server error
             InternalServerError = 500, ///< The server encountered an unexpected error
@@ -304,29 +310,26 @@ public :
     private :
 
         friend class Http;
+        friend class HttpStream;
 
         ////////////////////////////////////////////////////////////
         /// \brief Construct the header from a response string
         ///
         /// This function is used by Http to build the response
-        /// of a request.
+        /// of a request; the body is received separately.
         ///
-        /// \param data Content of the response to parse
+        /// \param header Header of the response, without the empty line that ends it
         ///
         ////////////////////////////////////////////////////////////
-        void parse(const std::string& data);
-
+        void parseHeader(const std::string& header);
 
         ////////////////////////////////////////////////////////////
-        /// \brief Read values passed in the answer header
+        /// \brief Read a field of the header or of the trailer
         ///
-        /// This function is used by Http to extract values passed
-        /// in the response.
-        ///
-        /// \param in String stream containing the header values
+        /// \param line Line containing the field
         ///
         ////////////////////////////////////////////////////////////
-        void parseFields(std::istream &in);
+        void parseField(const std::string& line);
 
         ////////////////////////////////////////////////////////////
         // Types
@@ -365,11 +368,21 @@ public :
     ////////////////////////////////////////////////////////////
     Http(const std::string& host, unsigned short port = 0);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    /// Closes the connections that are kept alive.
+    ///
+    ////////////////////////////////////////////////////////////
+    ~Http();
+
     ////////////////////////////////////////////////////////////
     /// \brief Set the target host
     ///
     /// This function just stores the host address and port, it
     /// doesn't actually connect to it until you send a request.
+    /// The host name is not resolved either: this is done when
+    /// the first request is sent, so that setHost never blocks.
     /// The port has a default value of 0, which means that the
     /// HTTP client will use the right port according to the
     /// protocol used (80 for HTTP, 443 for HTTPS). You should
@@ -402,17 +415,233 @@ public :
     ////////////////////////////////////////////////////////////
     Response sendRequest(const Request& request, Time timeout = Time::Zero);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Send a HTTP request and give the body of the
+    ///        server's response to a callback as it is received
+    ///
+    /// This function works like the other overload of sendRequest,
+    /// except that the body is not stored in the response: it is
+    /// given to \a bodyCallback, piece by piece, as soon as it is
+    /// received. This allows to process big responses without
+    /// keeping them in memory.
+    /// The callback can be any function or functor that takes
+    /// a pointer to the data (const char*) and its size
+    /// (std::size_t), and returns a boolean: false stops the
+    /// transfer and closes the connection.
+    ///
+    /// \param request      Request to send
+    /// \param bodyCallback Function to call with each piece of the body
+    /// \param timeout      Maximum time to wait
+    ///
+    /// \return Server's response, without its body
+    ///
+    ////////////////////////////////////////////////////////////
+    template <typename F>
+    Response sendRequest(const Request& request, F bodyCallback, Time timeout = Time::Zero);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Send several HTTP requests and return the server's
+    ///        responses
+    ///
+    /// When connections are kept alive, consecutive GET and
+    /// HEAD requests are pipelined: they are all sent at once
+    /// on the same connection, and then the responses are read
+    /// in the same order, which saves a round trip per request.
+    /// Other requests are sent one after the other.
+    /// If the server closes the connection before answering all
+    /// the requests, the remaining ones are sent again on a new
+    /// connection.
+    ///
+    /// \param requests Requests to send
+    /// \param timeout  Maximum time to wait for each connection
+    ///
+    /// \return Server's responses, in the same order as the requests
+    ///
+    ////////////////////////////////////////////////////////////
+    std::vector<Response> sendRequests(const std::vector<Request>& requests, Time timeout = Time::Zero);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Send a HTTP request and write the body of the
+    ///        server's response to a file
+    ///
+    /// The body is written to the file as it is received, it
+    /// is never entirely kept in memory. The file is written
+    /// only if the server answers with the Ok status (or
+    /// PartialContent when resuming); for any other status, the
+    /// body is stored in the returned response as usual, and
+    /// the file is left untouched.
+    /// If \a resume is true and the file already exists, only
+    /// the missing part of the resource is requested (with a
+    /// "Range" header field) and appended to the file. If the
+    /// server doesn't support partial requests, it sends the
+    /// whole resource and the file is overwritten.
+    ///
+    /// \param request  Request to send, usually a GET request
+    /// \param filename Path of the file to write
+    /// \param resume   Continue a previous, interrupted download?
+    /// \param timeout  Maximum time to wait
+    ///
+    /// \return Server's response, without its body if it was written to the file
+    ///
+    ////////////////////////////////////////////////////////////
+    Response download(const Request& request, const std::string& filename, bool resume = false, Time timeout = Time::Zero);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Enable or disable persistent connections
+    ///
+    /// When enabled, which is the default, the connection to
+    /// the host is kept open after a response, if the server
+    /// agrees, and reused for the next requests; this saves the
+    /// cost of connecting again. Connections to previous hosts
+    /// are kept as well, in case they are used again.
+    /// Disabling persistent connections closes the connections
+    /// that are currently kept.
+    ///
+    /// \param enabled True to keep connections alive, false to close them after each response
+    ///
+    ////////////////////////////////////////////////////////////
+    void setKeepAlive(bool enabled);
+
 private :
 
+    friend class HttpStream;
+
+    struct Connection;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief State of the body of a response being received
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Body
+    {
+        bool        chunked;    ///< Is the body sent by chunks?
+        bool        untilClose; ///< Does the body end when the connection is closed?
+        bool        started;    ///< Was the size of the first chunk read?
+        bool        finished;   ///< Was the whole body read?
+        std::size_t remaining;  ///< Size of the rest of the body, or of the current chunk
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Add the missing mandatory fields to a request
+    ///
+    /// \param request Request to complete
+    ///
+    ////////////////////////////////////////////////////////////
+    void completeRequest(Request& request) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Send requests and receive their responses
+    ///
+    /// \param requests     Requests to send
+    /// \param count        Number of requests
+    /// \param responses    Array of responses to fill
+    /// \param timeout      Maximum time to wait for each connection
+    /// \param bodyCallback Function receiving the body (can be NULL)
+    ///
+    ////////////////////////////////////////////////////////////
+    void performRequests(const Request* requests, std::size_t count, Response* responses, Time timeout, priv::HttpBodyCallback* bodyCallback);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Send a request and receive the header of its response
+    ///
+    /// The body is left in the returned connection, to be read
+    /// with readBody; the connection must then be given back
+    /// with releaseConnection.
+    ///
+    /// \param request  Request to send
+    /// \param response Response to fill
+    /// \param body     Filled with the state of the body to read
+    /// \param reusable Filled with true if the connection can be used for the next requests
+    /// \param timeout  Maximum time to wait for the connection
+    ///
+    /// \return Connection to read the body from, or NULL if no response was received
+    ///
+    ////////////////////////////////////////////////////////////
+    Connection* beginRequest(const Request& request, Response& response, Body& body, bool& reusable, Time timeout);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Receive a response
+    ///
+    /// \param connection   Connection to read
+    /// \param request      Request that the response answers
+    /// \param response     Response to fill
+    /// \param bodyCallback Function receiving the body (can be NULL)
+    /// \param reusable     Filled with true if the connection can be used for the next requests
+    ///
+    /// \return True if a complete response was received
+    ///
+    ////////////////////////////////////////////////////////////
+    bool readResponse(Connection& connection, const Request& request, Response& response, priv::HttpBodyCallback* bodyCallback, bool& reusable);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Receive the header of a response
+    ///
+    /// \param connection Connection to read
+    /// \param request    Request that the response answers
+    /// \param response   Response to fill
+    /// \param body       Filled with the state of the body to read
+    /// \param reusable   Filled with true if the connection can be used for the next requests
+    ///
+    /// \return True if a valid header was received
+    ///
+    ////////////////////////////////////////////////////////////
+    bool readHeader(Connection& connection, const Request& request, Response& response, Body& body, bool& reusable);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Receive the next piece of the body of a response
+    ///
+    /// The returned data points directly to the buffer of the
+    /// connection, it is valid until the next read.
+    ///
+    /// \param connection Connection to read
+    /// \param response   Response receiving the trailer fields
+    /// \param body       State of the body
+    /// \param maxSize    Maximum number of bytes to return
+    /// \param data       Filled with a pointer to the data
+    /// \param size       Filled with the number of bytes, 0 when the body is finished
+    ///
+    /// \return True on success, false if the connection was lost
+    ///
+    ////////////////////////////////////////////////////////////
+    bool readBody(Connection& connection, Response& response, Body& body, std::size_t maxSize, const char*& data, std::size_t& size);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get a connection to the host
+    ///
+    /// \param timeout Maximum time to wait for a new connection
+    /// \param reused  Filled with true if the connection was kept from a previous request
+    ///
+    /// \return Connection, or NULL if the connection failed
+    ///
+    ////////////////////////////////////////////////////////////
+    Connection* openConnection(Time timeout, bool& reused);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Keep a connection for the next requests, or close it
+    ///
+    /// \param connection Connection to release
+    /// \param reusable   Can the connection be used for the next requests?
+    ///
+    ////////////////////////////////////////////////////////////
+    void releaseConnection(Connection* connection, bool reusable);
+
+    ////////////////////////////////////////////////////////////
+    // Types
+    ////////////////////////////////////////////////////////////
+    typedef std::map<std::pair<std::string, unsigned short>, Connection*> ConnectionTable;
+
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
-    TcpSocket      m_connection; ///< Connection to the host
-    IpAddress      m_host;       ///< Web host address
-    std::string    m_hostName;   ///< Web host name
-    unsigned short m_port;       ///< Port used for connection with host
+    ConnectionTable m_connections; ///< Idle connections kept alive, by host name and port
+    bool            m_keepAlive;   ///< Are connections kept alive?
+    IpAddress       m_host;        ///< Web host address (None until it is resolved)
+    std::string     m_hostName;    ///< Web host name
+    unsigned short  m_port;        ///< Port used for connection with host
 };
 
+#include <SFML/Network/Http.inl>
+
 } // namespace sf
 
 
@@ -450,6 +679,11 @@ private :
 /// sf::Http::Request and return the corresponding sf::Http::Response
 /// from the server.
 ///
+/// Connections are kept alive between requests when the server
+/// allows it, several requests can be pipelined with sendRequests,
+/// and the body of big responses can be processed as it is
+/// received by giving a callback to sendRequest.
+///
 /// Usage example:
 /// \code
 /// // Create a new HTTP client
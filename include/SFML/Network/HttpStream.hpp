@@ -0,0 +1,219 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2014 Laurent Gomila (laurent.gom@gmail.com)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_HTTPSTREAM_HPP
+#define SFML_HTTPSTREAM_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Network/Export.hpp>
+#include <SFML/Network/Http.hpp>
+#include <SFML/System/InputStream.hpp>
+#include <SFML/System/NonCopyable.hpp>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+/// \brief Input stream reading a remote resource through
+///        HTTP, as it is received
+///
+////////////////////////////////////////////////////////////
+class SFML_NETWORK_API HttpStream : public InputStream, NonCopyable
+{
+public :
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    ////////////////////////////////////////////////////////////
+    HttpStream();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual ~HttpStream();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Request a resource and start reading its content
+    ///
+    /// This function sends a GET request and waits for the
+    /// header of the response; the body is then received as
+    /// it is read. The arguments are the same as sf::Http's.
+    ///
+    /// \param host    Web server to connect to
+    /// \param uri     Path of the resource on the server
+    /// \param port    Port to use for connection (0 for the default one)
+    /// \param timeout Maximum time to wait for each connection
+    ///
+    /// \return True if the server answered with the resource
+    ///
+    /// \see getResponse
+    ///
+    ////////////////////////////////////////////////////////////
+    bool open(const std::string& host, const std::string& uri, unsigned short port = 0, Time timeout = Time::Zero);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Stop reading the resource
+    ///
+    ////////////////////////////////////////////////////////////
+    void close();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the last response of the server
+    ///
+    /// If open failed, the response contains the error returned
+    /// by the server, with its body. Otherwise its body is empty,
+    /// since it is given by read.
+    ///
+    /// \return Last response of the server
+    ///
+    ////////////////////////////////////////////////////////////
+    const Http::Response& getResponse() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Read data from the stream
+    ///
+    /// This function blocks until \a size bytes are received,
+    /// or the end of the resource is reached. If the connection
+    /// is lost, the resource is requested again from the current
+    /// position when the server supports partial requests.
+    ///
+    /// \param data Buffer where to copy the read data
+    /// \param size Desired number of bytes to read
+    ///
+    /// \return The number of bytes actually read, or -1 on error
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual Int64 read(void* data, Int64 size);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Change the current reading position
+    ///
+    /// Seeking a bit forward skips the data in between. Other
+    /// positions are requested again from the server, with a
+    /// "Range" header field; this fails if the server doesn't
+    /// support partial requests.
+    ///
+    /// \param position The position to seek to, from the beginning
+    ///
+    /// \return The position actually sought to, or -1 on error
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual Int64 seek(Int64 position);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the current reading position in the stream
+    ///
+    /// \return The current position, or -1 on error.
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual Int64 tell();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Return the size of the stream
+    ///
+    /// \return The total number of bytes available in the stream, or -1 if unknown
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual Int64 getSize();
+
+private :
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Request the resource from a given position
+    ///
+    /// \param position Position of the first byte to receive
+    ///
+    /// \return True if the server sent the resource from this position
+    ///
+    ////////////////////////////////////////////////////////////
+    bool request(Int64 position);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Give the current connection back to the client
+    ///
+    ////////////////////////////////////////////////////////////
+    void releaseConnection();
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    Http              m_http;         ///< Client keeping the connections to the host
+    Http::Request     m_request;      ///< Request sent for the resource
+    Http::Response    m_response;     ///< Last response of the server
+    Http::Connection* m_connection;   ///< Connection receiving the body, or NULL
+    Http::Body        m_body;         ///< State of the body being received
+    bool              m_reusable;     ///< Can the connection be kept after the body?
+    Time              m_timeout;      ///< Maximum time to wait for each connection
+    Int64             m_position;     ///< Current reading position
+    Int64             m_size;         ///< Total size of the resource, or -1 if unknown
+    bool              m_acceptRanges; ///< Does the server support partial requests?
+};
+
+} // namespace sf
+
+
+#endif // SFML_HTTPSTREAM_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::HttpStream
+/// \ingroup network
+///
+/// sf::HttpStream reads a resource of a web server as an
+/// sf::InputStream: the body of the response is received
+/// while it is read, so that big resources can be processed
+/// without being downloaded entirely first, nor kept in
+/// memory. Any SFML class that loads from an sf::InputStream
+/// can therefore load a remote resource directly.
+///
+/// When the server supports partial requests (it answers
+/// with an "Accept-Ranges: bytes" header field), the stream
+/// can seek to any position; otherwise it can only move
+/// forward.
+///
+/// Usage example:
+/// \code
+/// sf::HttpStream stream;
+/// if (stream.open("http://www.sfml-dev.org", "/music.ogg"))
+/// {
+///     sf::Music music;
+///     if (music.openFromStream(stream))
+///         music.play();
+/// }
+/// else
+/// {
+///     std::cout << "Error " << stream.getResponse().getStatus() << std::endl;
+/// }
+/// \endcode
+///
+/// To write a resource directly to a file instead, use
+/// sf::Http::download.
+///
+/// \see sf::Http, sf::InputStream
+///
+////////////////////////////////////////////////////////////
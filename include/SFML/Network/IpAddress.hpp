@@ -38,13 +38,23 @@
 namespace sf
 {
 ////////////////////////////////////////////////////////////
-/// \brief Encapsulate an IPv4 network address
+/// \brief Encapsulate an IPv4 or IPv6 network address
 ///
 ////////////////////////////////////////////////////////////
 class SFML_NETWORK_API IpAddress
 {
 public :
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Types of addresses
+    ///
+    ////////////////////////////////////////////////////////////
+    enum Type
+    {
+        IPv4, ///< 32-bits address
+        IPv6  ///< 128-bits address
+    };
+
     ////////////////////////////////////////////////////////////
     /// \brief Default constructor
     ///
@@ -56,8 +66,13 @@ public :
     ////////////////////////////////////////////////////////////
     /// \brief Construct the address from a string
     ///
-    /// Here \a address can be either a decimal address
-    /// (ex: "192.168.1.56") or a network name (ex: "localhost").
+    /// Here \a address can be either a decimal IPv4 address
+    /// (ex: "192.168.1.56"), a hexadecimal IPv6 address
+    /// (ex: "2001:db8::1") or a network name (ex: "localhost").
+    /// Network names are resolved synchronously, which may take
+    /// a while: use sf::Resolver to resolve them without blocking.
+    /// When a network name has both IPv4 and IPv6 addresses, the
+    /// IPv4 one is chosen.
     ///
     /// \param address IP address or network name
     ///
@@ -67,8 +82,9 @@ public :
     ////////////////////////////////////////////////////////////
     /// \brief Construct the address from a string
     ///
-    /// Here \a address can be either a decimal address
-    /// (ex: "192.168.1.56") or a network name (ex: "localhost").
+    /// Here \a address can be either a decimal IPv4 address
+    /// (ex: "192.168.1.56"), a hexadecimal IPv6 address
+    /// (ex: "2001:db8::1") or a network name (ex: "localhost").
     /// This is equivalent to the constructor taking a std::string
     /// parameter, it is defined for convenience so that the
     /// implicit conversions from literal strings to IpAddress work.
@@ -108,12 +124,39 @@ public :
     ////////////////////////////////////////////////////////////
     explicit IpAddress(Uint32 address);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Construct an IPv6 address from its 16 bytes
+    ///
+    /// The bytes are in network order, the first one being the
+    /// most significant. IPv4-mapped addresses (::ffff:a.b.c.d)
+    /// are IPv4 addresses.
+    ///
+    /// \param bytes Array of 16 bytes
+    ///
+    /// \see toBytes
+    ///
+    ////////////////////////////////////////////////////////////
+    explicit IpAddress(const Uint8* bytes);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the type of the address
+    ///
+    /// The type of the invalid address sf::IpAddress::None is
+    /// meaningless, and sockets refuse to use this address.
+    ///
+    /// \return IPv4 or IPv6
+    ///
+    ////////////////////////////////////////////////////////////
+    Type getType() const;
+
     ////////////////////////////////////////////////////////////
     /// \brief Get a string representation of the address
     ///
-    /// The returned string is the decimal representation of the
-    /// IP address (like "192.168.1.56"), even if it was constructed
-    /// from a host name.
+    /// The returned string is the decimal representation of an
+    /// IPv4 address (like "192.168.1.56"), or the hexadecimal
+    /// representation of an IPv6 address (like "2001:db8::1"),
+    /// even if it was constructed from a host name.
+    /// The invalid address sf::IpAddress::None gives an empty string.
     ///
     /// \return String representation of the address
     ///
@@ -130,14 +173,31 @@ public :
     /// (like sending the address through a socket).
     /// The integer produced by this function can then be converted
     /// back to a sf::IpAddress with the proper constructor.
+    /// IPv6 addresses don't fit in an integer: their integer
+    /// representation is 0, use toBytes instead.
     ///
     /// \return 32-bits unsigned integer representation of the address
     ///
-    /// \see toString
+    /// \see toString, toBytes
     ///
     ////////////////////////////////////////////////////////////
     Uint32 toInteger() const;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the 16 bytes of the address
+    ///
+    /// The bytes are in network order. IPv4 addresses are
+    /// written as IPv4-mapped IPv6 addresses (::ffff:a.b.c.d).
+    /// The bytes can be converted back to a sf::IpAddress with
+    /// the proper constructor.
+    ///
+    /// \param bytes Array of 16 bytes to fill
+    ///
+    /// \see toInteger
+    ///
+    ////////////////////////////////////////////////////////////
+    void toBytes(Uint8* bytes) const;
+
     ////////////////////////////////////////////////////////////
     /// \brief Get the computer's local address
     ///
@@ -181,16 +241,22 @@ public :
     ////////////////////////////////////////////////////////////
     // Static member data
     ////////////////////////////////////////////////////////////
-    static const IpAddress None;      ///< Value representing an empty/invalid address
-    static const IpAddress LocalHost; ///< The "localhost" address (for connecting a computer to itself locally)
-    static const IpAddress Broadcast; ///< The "broadcast" address (for sending UDP messages to everyone on a local network)
+    static const IpAddress None;          ///< Value representing an empty/invalid address
+    static const IpAddress Any;           ///< Value representing any IPv4 address (0.0.0.0), for binding sockets
+    static const IpAddress LocalHost;     ///< The "localhost" address (for connecting a computer to itself locally)
+    static const IpAddress Broadcast;     ///< The "broadcast" address (for sending UDP messages to everyone on a local network)
+    static const IpAddress AnyIPv6;       ///< Value representing any IPv6 address (::), for binding sockets to both IPv6 and IPv4
+    static const IpAddress LocalHostIPv6; ///< The IPv6 "localhost" address (::1)
 
 private :
 
+    friend SFML_NETWORK_API bool operator <(const IpAddress& left, const IpAddress& right);
+
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
-    Uint32 m_address; ///< Address stored as an unsigned 32 bits integer
+    Uint8 m_bytes[16]; ///< Address in network byte order, IPv4 addresses being mapped to IPv6 (::ffff:a.b.c.d)
+    bool  m_valid;     ///< Is the address valid?
 };
 
 ////////////////////////////////////////////////////////////
@@ -308,9 +374,15 @@ SFML_NETWORK_API std::ostream& operator <<(std::ostream& stream, const IpAddress
 /// sf::IpAddress a7("www.google.com");                   // a distant address created from a network name
 /// sf::IpAddress a8 = sf::IpAddress::getLocalAddress();  // my address on the local network
 /// sf::IpAddress a9 = sf::IpAddress::getPublicAddress(); // my address on the internet
+/// sf::IpAddress b0("2001:db8::1");                      // a distant IPv6 address
+/// sf::IpAddress b1 = sf::IpAddress::LocalHostIPv6;      // the IPv6 local host address
 /// \endcode
 ///
-/// Note that sf::IpAddress currently doesn't support IPv6
-/// nor other types of network addresses.
+/// IPv4 and IPv6 addresses can be used with all the sockets.
+/// Sockets bound to sf::IpAddress::AnyIPv6 accept both IPv6
+/// and IPv4 peers, the latter being reported as IPv4 addresses.
+///
+/// Note that the invalid address sf::IpAddress::None is not
+/// the same as sf::IpAddress::Any (0.0.0.0).
 ///
 ////////////////////////////////////////////////////////////
@@ -30,7 +30,6 @@
 ////////////////////////////////////////////////////////////
 #include <SFML/Network/Export.hpp>
 #include <string>
-#include <vector>
 
 
 namespace sf
@@ -65,6 +64,24 @@ public :
     ////////////////////////////////////////////////////////////
     virtual ~Packet();
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Copy constructor
+    ///
+    /// \param copy Instance to copy
+    ///
+    ////////////////////////////////////////////////////////////
+    Packet(const Packet& copy);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Overload of assignment operator
+    ///
+    /// \param right Instance to assign
+    ///
+    /// \return Reference to self
+    ///
+    ////////////////////////////////////////////////////////////
+    Packet& operator =(const Packet& right);
+
     ////////////////////////////////////////////////////////////
     /// \brief Append data to the end of the packet
     ///
@@ -76,6 +93,23 @@ public :
     ////////////////////////////////////////////////////////////
     void append(const void* data, std::size_t sizeInBytes);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Reserve storage for the data of the packet
+    ///
+    /// Small packets are stored inside the packet itself, and
+    /// bigger ones grow their storage as data is appended.
+    /// Reserving the final size in advance avoids reallocating
+    /// it while the packet is built. The storage is kept when
+    /// the packet is cleared, so reusing the same packet
+    /// doesn't allocate memory either.
+    ///
+    /// \param capacity Number of bytes to reserve
+    ///
+    /// \see append, clear
+    ///
+    ////////////////////////////////////////////////////////////
+    void reserve(std::size_t capacity);
+
     ////////////////////////////////////////////////////////////
     /// \brief Clear the packet
     ///
@@ -208,10 +242,127 @@ public:
     Packet& operator <<(const std::wstring& data);
     Packet& operator <<(const String&       data);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Write an array of numbers into the packet
+    ///
+    /// The numbers are encoded like with operator <<, but all
+    /// at once. Their count is not written: it must be known
+    /// by the receiver, or written separately.
+    ///
+    /// \param data  Pointer to the numbers to write
+    /// \param count Number of numbers to write
+    ///
+    /// \return Reference to self
+    ///
+    /// \see read
+    ///
+    ////////////////////////////////////////////////////////////
+    Packet& write(const Int8*   data, std::size_t count);
+    Packet& write(const Uint8*  data, std::size_t count);
+    Packet& write(const Int16*  data, std::size_t count);
+    Packet& write(const Uint16* data, std::size_t count);
+    Packet& write(const Int32*  data, std::size_t count);
+    Packet& write(const Uint32* data, std::size_t count);
+    Packet& write(const float*  data, std::size_t count);
+    Packet& write(const double* data, std::size_t count);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Read an array of numbers from the packet
+    ///
+    /// If the packet doesn't contain \a count numbers, nothing
+    /// is read and the packet becomes invalid.
+    ///
+    /// \param data  Pointer to the array to fill
+    /// \param count Number of numbers to read
+    ///
+    /// \return Reference to self
+    ///
+    /// \see write
+    ///
+    ////////////////////////////////////////////////////////////
+    Packet& read(Int8*   data, std::size_t count);
+    Packet& read(Uint8*  data, std::size_t count);
+    Packet& read(Int16*  data, std::size_t count);
+    Packet& read(Uint16* data, std::size_t count);
+    Packet& read(Int32*  data, std::size_t count);
+    Packet& read(Uint32* data, std::size_t count);
+    Packet& read(float*  data, std::size_t count);
+    Packet& read(double* data, std::size_t count);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Write an integer with a variable-length encoding
+    ///
+    /// The integer is written 7 bits per byte (LEB128), so
+    /// small values take less space than with operator <<:
+    /// values below 128 take 1 byte, values below 16384 take
+    /// 2 bytes, etc. Signed integers are zig-zag encoded first,
+    /// so that small negative values are small as well.
+    ///
+    /// \param data Integer to write
+    ///
+    /// \return Reference to self
+    ///
+    /// \see readVarint
+    ///
+    ////////////////////////////////////////////////////////////
+    Packet& writeVarint(Int32  data);
+    Packet& writeVarint(Uint32 data);
+    Packet& writeVarint(Int64  data);
+    Packet& writeVarint(Uint64 data);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Read an integer written with writeVarint
+    ///
+    /// The packet becomes invalid if the encoded value doesn't
+    /// fit in the type of \a data.
+    ///
+    /// \param data Variable to fill
+    ///
+    /// \return Reference to self
+    ///
+    /// \see writeVarint
+    ///
+    ////////////////////////////////////////////////////////////
+    Packet& readVarint(Int32&  data);
+    Packet& readVarint(Uint32& data);
+    Packet& readVarint(Int64&  data);
+    Packet& readVarint(Uint64& data);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Write a string encoded in UTF-8
+    ///
+    /// The string is written as its size in bytes (with the
+    /// variable-length encoding of writeVarint), followed by
+    /// its UTF-8 characters. This is usually much smaller than
+    /// operator <<, which writes 4 bytes per character.
+    ///
+    /// \param data String to write
+    ///
+    /// \return Reference to self
+    ///
+    /// \see readUtf8
+    ///
+    ////////////////////////////////////////////////////////////
+    Packet& writeUtf8(const String& data);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Read a string written with writeUtf8
+    ///
+    /// \param data String to fill
+    ///
+    /// \return Reference to self
+    ///
+    /// \see writeUtf8
+    ///
+    ////////////////////////////////////////////////////////////
+    Packet& readUtf8(String& data);
+
 protected:
 
     friend class TcpSocket;
     friend class UdpSocket;
+    friend class UdpHost;
+    friend class PacketPool;
 
     ////////////////////////////////////////////////////////////
     /// \brief Called before the packet is sent over the network
@@ -273,12 +424,41 @@ private :
     ////////////////////////////////////////////////////////////
     bool checkSize(std::size_t size);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Make room for data at the end of the packet
+    ///
+    /// \param size Number of bytes to add
+    ///
+    /// \return Pointer to the added bytes
+    ///
+    ////////////////////////////////////////////////////////////
+    char* extend(std::size_t size);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Read an unsigned integer written with writeVarint
+    ///
+    /// \param data Variable to fill
+    ///
+    /// \return True if the integer was read
+    ///
+    ////////////////////////////////////////////////////////////
+    bool readVarintBits(Uint64& data);
+
+    enum
+    {
+        SmallBufferSize = 64 ///< Size of the data stored without allocating memory
+    };
+
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
-    std::vector<char> m_data;    ///< Data stored in the packet
-    std::size_t       m_readPos; ///< Current reading position in the packet
-    bool              m_isValid; ///< Reading state of the packet
+    char*       m_data;                    ///< Data stored in the packet (points to m_buffer while it is small)
+    std::size_t m_size;                    ///< Number of bytes stored in the packet
+    std::size_t m_capacity;                ///< Number of bytes that can be stored without reallocating
+    std::size_t m_readPos;                 ///< Current reading position in the packet
+    bool        m_isValid;                 ///< Reading state of the packet
+    std::size_t m_sendPos;                 ///< Number of bytes (size included) already sent by a TCP socket, in case of partial send
+    char        m_buffer[SmallBufferSize]; ///< Storage of small packets
 };
 
 } // namespace sf
@@ -345,6 +525,11 @@ private :
 /// \li floating point numbers (float, double)
 /// \li string types (char*, wchar_t*, std::string, std::wstring, sf::String)
 ///
+/// For more compact or faster encodings, arrays of numbers can be
+/// written at once with write and read, integers can be written
+/// with a variable size with writeVarint and readVarint, and
+/// strings can be written in UTF-8 with writeUtf8 and readUtf8.
+///
 /// Like standard streams, it is also possible to define your own
 /// overloads of operators >> and << in order to handle your
 /// custom types.
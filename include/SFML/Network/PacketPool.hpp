@@ -0,0 +1,204 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2014 Laurent Gomila (laurent.gom@gmail.com)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_PACKETPOOL_HPP
+#define SFML_PACKETPOOL_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Network/Export.hpp>
+#include <SFML/System/Mutex.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <cstddef>
+#include <vector>
+
+
+namespace sf
+{
+class Packet;
+
+////////////////////////////////////////////////////////////
+/// \brief Thread-safe pool of packets, to reuse them and
+///        their storage instead of allocating new ones
+///
+////////////////////////////////////////////////////////////
+class SFML_NETWORK_API PacketPool : NonCopyable
+{
+public :
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Counters describing the use of the pool
+    ///
+    ////////////////////////////////////////////////////////////
+    struct SFML_NETWORK_API Statistics
+    {
+        ////////////////////////////////////////////////////////////
+        /// \brief Default constructor
+        ///
+        ////////////////////////////////////////////////////////////
+        Statistics();
+
+        Uint64      acquired;  ///< Number of packets acquired
+        Uint64      released;  ///< Number of packets released
+        Uint64      allocated; ///< Number of packets created, because none was available
+        Uint64      discarded; ///< Number of released packets destroyed instead of being kept
+        std::size_t inUse;     ///< Number of packets currently acquired and not released
+        std::size_t peakInUse; ///< Highest number of packets acquired at the same time
+        std::size_t available; ///< Number of packets waiting in the pool
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// The limits bound the memory kept by the pool: released
+    /// packets are destroyed instead of being kept when the pool
+    /// already holds \a maxAvailable packets, or when their
+    /// storage has grown beyond \a maxPacketCapacity bytes.
+    ///
+    /// \param maxAvailable      Maximum number of packets kept in the pool
+    /// \param maxPacketCapacity Maximum storage of a packet kept in the pool, in bytes
+    ///
+    ////////////////////////////////////////////////////////////
+    explicit PacketPool(std::size_t maxAvailable = 1024, std::size_t maxPacketCapacity = 65536);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    /// All the packets acquired from the pool must have been
+    /// released before it is destroyed.
+    ///
+    ////////////////////////////////////////////////////////////
+    ~PacketPool();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Fill the pool with packets in advance
+    ///
+    /// This function creates packets until \a count of them
+    /// are available, with storage for \a capacity bytes each,
+    /// so that the first acquisitions don't allocate memory.
+    ///
+    /// \param count    Number of packets to make available
+    /// \param capacity Number of bytes to reserve in each packet
+    ///
+    ////////////////////////////////////////////////////////////
+    void reserve(std::size_t count, std::size_t capacity = 0);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get an empty packet from the pool
+    ///
+    /// A new packet is created if none is available.
+    /// The packet must be given back with release when it is
+    /// no longer used.
+    ///
+    /// \return Pointer to an empty packet
+    ///
+    /// \see release
+    ///
+    ////////////////////////////////////////////////////////////
+    Packet* acquire();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Give a packet back to the pool
+    ///
+    /// The packet is cleared, and its storage is kept for the
+    /// next acquisition. Releasing a NULL pointer does nothing.
+    ///
+    /// \param packet Packet previously returned by acquire
+    ///
+    /// \see acquire
+    ///
+    ////////////////////////////////////////////////////////////
+    void release(Packet* packet);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destroy all the packets waiting in the pool
+    ///
+    ////////////////////////////////////////////////////////////
+    void shrink();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the counters describing the use of the pool
+    ///
+    /// \return Statistics of the pool
+    ///
+    ////////////////////////////////////////////////////////////
+    Statistics getStatistics() const;
+
+private :
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    mutable Mutex        m_mutex;             ///< Mutex protecting the pool
+    std::vector<Packet*> m_available;         ///< Packets waiting to be acquired
+    std::size_t          m_maxAvailable;      ///< Maximum number of packets kept in the pool
+    std::size_t          m_maxPacketCapacity; ///< Maximum storage of a packet kept in the pool
+    Statistics           m_statistics;        ///< Counters of the pool
+};
+
+} // namespace sf
+
+
+#endif // SFML_PACKETPOOL_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::PacketPool
+/// \ingroup network
+///
+/// Creating and destroying packets at a high rate makes the
+/// memory allocator busy: each packet allocates its storage
+/// as soon as it grows beyond a few bytes. sf::PacketPool
+/// keeps released packets, with their storage, so that they
+/// can be acquired again without allocating anything.
+///
+/// Packets can be acquired and released from any thread:
+/// a packet received by a network thread can be released
+/// by the thread which processes it.
+///
+/// Sockets can directly receive into packets of a pool;
+/// the packet is only taken from the pool if something
+/// was received.
+///
+/// Usage example:
+/// \code
+/// sf::PacketPool pool;
+/// pool.reserve(64, 1024);
+///
+/// sf::Packet* packet;
+/// while (socket.receive(pool, packet) == sf::Socket::Done)
+/// {
+///     process(*packet);
+///     pool.release(packet);
+/// }
+///
+/// sf::PacketPool::Statistics statistics = pool.getStatistics();
+/// std::cout << statistics.allocated << " packets allocated for "
+///           << statistics.acquired << " acquired" << std::endl;
+/// \endcode
+///
+/// \see sf::Packet
+///
+////////////////////////////////////////////////////////////
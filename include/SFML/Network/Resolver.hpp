@@ -0,0 +1,202 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2014 Laurent Gomila (laurent.gom@gmail.com)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_RESOLVER_HPP
+#define SFML_RESOLVER_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Network/Export.hpp>
+#include <SFML/Network/IpAddress.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <SFML/System/Time.hpp>
+#include <string>
+
+
+namespace sf
+{
+namespace priv
+{
+    struct ResolverCallback;
+}
+
+////////////////////////////////////////////////////////////
+/// \brief Resolve host names in the background, with a cache
+///
+////////////////////////////////////////////////////////////
+class SFML_NETWORK_API Resolver : NonCopyable
+{
+public :
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// \param threadCount          Maximum number of names resolved at the same time
+    /// \param cacheDuration        Time during which a resolved address is kept in the cache
+    /// \param failureCacheDuration Time during which a failed resolution is kept in the cache
+    ///
+    ////////////////////////////////////////////////////////////
+    Resolver(unsigned int threadCount = 2, Time cacheDuration = seconds(300), Time failureCacheDuration = seconds(10));
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    /// The callbacks that were not invoked yet are discarded.
+    /// The destructor waits for the resolutions in progress,
+    /// which can't be interrupted.
+    ///
+    ////////////////////////////////////////////////////////////
+    ~Resolver();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Start resolving a host name
+    ///
+    /// The function returns immediately. The callback is
+    /// invoked by a later call to update(), with the signature
+    /// void(const std::string& host, const sf::IpAddress& address),
+    /// \a address being sf::IpAddress::None if the name
+    /// couldn't be resolved. It can be a free function or any
+    /// copyable functor.
+    ///
+    /// If the address is in the cache, the callback is invoked
+    /// by the next call to update(). Requests for a name that
+    /// is already being resolved share the same resolution.
+    ///
+    /// \param host     Host name or address to resolve
+    /// \param callback Function to call with the result
+    ///
+    /// \see update, lookup
+    ///
+    ////////////////////////////////////////////////////////////
+    template <typename F>
+    void resolve(const std::string& host, F callback);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Invoke the callbacks of the finished resolutions
+    ///
+    /// This function must be called regularly (for example once
+    /// per frame). The callbacks are invoked in the calling thread.
+    ///
+    /// \return Number of callbacks invoked
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t update();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Look for a host name in the cache
+    ///
+    /// This function never blocks, nor starts a resolution.
+    ///
+    /// \param host    Host name to look for
+    /// \param address Variable to fill with the cached address
+    ///
+    /// \return True if the name was in the cache (\a address
+    ///         is sf::IpAddress::None if its resolution failed)
+    ///
+    ////////////////////////////////////////////////////////////
+    bool lookup(const std::string& host, IpAddress& address) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of callbacks waiting to be invoked
+    ///
+    /// \return Number of requests that are not finished yet
+    ///         or whose callback was not invoked yet
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getPendingCount() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Remove all the addresses from the cache
+    ///
+    ////////////////////////////////////////////////////////////
+    void clearCache();
+
+private :
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Queue a request
+    ///
+    /// \param host     Host name to resolve
+    /// \param callback Callback to invoke with the result (owned by the resolver)
+    ///
+    ////////////////////////////////////////////////////////////
+    void enqueue(const std::string& host, priv::ResolverCallback* callback);
+
+    struct ResolverImpl;
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    ResolverImpl* m_impl; ///< Worker threads, requests and cache of the resolver
+};
+
+#include <SFML/Network/Resolver.inl>
+
+} // namespace sf
+
+
+#endif // SFML_RESOLVER_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::Resolver
+/// \ingroup network
+///
+/// Resolving a host name with sf::IpAddress blocks until the
+/// DNS server answers, which can take seconds. sf::Resolver
+/// resolves names in background threads instead, and gives
+/// the results back through callbacks that are invoked when
+/// update() is called, so that they run in the same thread
+/// as the rest of the program and need no synchronization.
+///
+/// Results are kept in a cache for a fixed duration (the
+/// system functions don't expose the time-to-live of DNS
+/// records), failures for a shorter one so that a name which
+/// doesn't exist isn't looked up again and again.
+///
+/// Usage example:
+/// \code
+/// void onResolved(const std::string& host, const sf::IpAddress& address)
+/// {
+///     if (address != sf::IpAddress::None)
+///         connectTo(address);
+///     else
+///         std::cout << "Failed to resolve " << host << std::endl;
+/// }
+///
+/// sf::Resolver resolver;
+/// resolver.resolve("www.sfml-dev.org", &onResolved);
+///
+/// while (running)
+/// {
+///     resolver.update();
+///
+///     // ... run the program ...
+/// }
+/// \endcode
+///
+/// \see sf::IpAddress
+///
+////////////////////////////////////////////////////////////
@@ -0,0 +1,51 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2014 Laurent Gomila (laurent.gom@gmail.com)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+namespace priv
+{
+// Base class for the functions receiving the result of a resolution
+struct ResolverCallback
+{
+    virtual ~ResolverCallback() {}
+    virtual void call(const std::string& host, const IpAddress& address) = 0;
+};
+
+// Specialization using a functor (including free functions)
+template <typename F>
+struct ResolverFunctor : ResolverCallback
+{
+    ResolverFunctor(F functor) : m_functor(functor) {}
+    virtual void call(const std::string& host, const IpAddress& address) {m_functor(host, address);}
+    F m_functor;
+};
+
+} // namespace priv
+
+
+////////////////////////////////////////////////////////////
+template <typename F>
+void Resolver::resolve(const std::string& host, F callback)
+{
+    enqueue(host, new priv::ResolverFunctor<F>(callback));
+}
@@ -29,6 +29,7 @@
 // Headers
 ////////////////////////////////////////////////////////////
 #include <SFML/Network/Export.hpp>
+#include <SFML/Network/IpAddress.hpp>
 #include <SFML/Network/SocketHandle.hpp>
 #include <SFML/System/NonCopyable.hpp>
 #include <vector>
@@ -54,6 +55,7 @@ public :
     {
         Done,         ///< The socket has sent / received the data
         NotReady,     ///< The socket is not ready to send / receive data yet
+        Partial,      ///< The socket sent a part of the data
         Disconnected, ///< The TCP socket has been disconnected
         Error         ///< An unexpected error happened
     };
@@ -138,13 +140,28 @@ protected :
     ////////////////////////////////////////////////////////////
     SocketHandle getHandle() const;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Return the type of the addresses used by the socket
+    ///
+    /// IPv6 sockets can also use IPv4 addresses.
+    /// This function can only be accessed by derived classes.
+    ///
+    /// \return IPv4 or IPv6
+    ///
+    ////////////////////////////////////////////////////////////
+    IpAddress::Type getAddressType() const;
+
     ////////////////////////////////////////////////////////////
     /// \brief Create the internal representation of the socket
     ///
+    /// Nothing happens if the socket already exists, even if
+    /// it uses another type of addresses.
     /// This function can only be accessed by derived classes.
     ///
+    /// \param addressType Type of the addresses used by the socket
+    ///
     ////////////////////////////////////////////////////////////
-    void create();
+    void create(IpAddress::Type addressType = IpAddress::IPv4);
 
     ////////////////////////////////////////////////////////////
     /// \brief Create the internal representation of the socket
@@ -165,16 +182,55 @@ protected :
     ////////////////////////////////////////////////////////////
     void close();
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Publish whether data is buffered for the next receive
+    ///
+    /// Derived classes must call this function after changing
+    /// the data that hasPendingPacket() looks at, so that the
+    /// selectors see it.
+    ///
+    ////////////////////////////////////////////////////////////
+    void updatePendingState();
+
 private :
 
     friend class SocketSelector;
+    friend class EventLoop;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether data has already been received and
+    ///        buffered for the next call to receive
+    ///
+    /// Selectors cannot see data that is no longer in the
+    /// system buffers; this state is given to them through
+    /// updatePendingState.
+    ///
+    /// \return True if a packet can be received without reading the socket
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual bool hasPendingPacket() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the handles of all the sockets that have
+    ///        buffered data waiting to be received
+    ///
+    /// Selectors use the handles rather than the sockets, so
+    /// that they never access a socket that was destroyed
+    /// without being removed from them.
+    ///
+    /// \param handles Vector to fill with the handles
+    ///
+    ////////////////////////////////////////////////////////////
+    static void getPendingHandles(std::vector<SocketHandle>& handles);
 
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
-    Type         m_type;       ///< Type of the socket (TCP or UDP)
-    SocketHandle m_socket;     ///< Socket descriptor
-    bool         m_isBlocking; ///< Current blocking mode of the socket
+    Type            m_type;        ///< Type of the socket (TCP or UDP)
+    SocketHandle    m_socket;      ///< Socket descriptor
+    bool            m_isBlocking;  ///< Current blocking mode of the socket
+    IpAddress::Type m_addressType; ///< Type of the addresses used by the socket
+    bool            m_isPending;   ///< Is the socket registered as having buffered data?
 };
 
 } // namespace sf
@@ -30,6 +30,7 @@
 ////////////////////////////////////////////////////////////
 #include <SFML/Network/Export.hpp>
 #include <SFML/System/Time.hpp>
+#include <cstddef>
 
 
 namespace sf
@@ -141,6 +142,38 @@ public :
     ////////////////////////////////////////////////////////////
     bool isReady(Socket& socket) const;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of sockets that are ready to receive data
+    ///
+    /// This function must be used after a call to wait. Together
+    /// with getReadySocket, it allows to handle the ready
+    /// sockets without testing every socket of the selector,
+    /// which matters when the selector contains a lot of them.
+    ///
+    /// \return Number of sockets that were ready after the last wait
+    ///
+    /// \see getReadySocket
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getReadyCount() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get a socket that is ready to receive data
+    ///
+    /// The ready sockets are listed in no particular order.
+    /// The socket returned is the one given to add(): like
+    /// for the other functions, a socket must be removed
+    /// from the selector before it is destroyed.
+    ///
+    /// \param index Index of the socket, in range [0, getReadyCount() - 1]
+    ///
+    /// \return Reference to the ready socket
+    ///
+    /// \see getReadyCount
+    ///
+    ////////////////////////////////////////////////////////////
+    Socket& getReadySocket(std::size_t index) const;
+
     ////////////////////////////////////////////////////////////
     /// \brief Overload of assignment operator
     ///
@@ -196,6 +229,23 @@ private :
 /// \li make it wait until there is data available on any of the sockets
 /// \li test each socket to find out which ones are ready
 ///
+/// Selectors are implemented with epoll on Linux and kqueue on
+/// FreeBSD and Mac OS X, so that waiting doesn't depend on the
+/// number of sockets; other systems use select, which is limited
+/// to FD_SETSIZE sockets. When a selector contains a lot of
+/// sockets, iterate over the ready ones with getReadyCount and
+/// getReadySocket instead of testing all of them with isReady:
+/// \code
+/// if (selector.wait())
+/// {
+///     for (std::size_t i = 0; i < selector.getReadyCount(); ++i)
+///     {
+///         sf::Socket& socket = selector.getReadySocket(i);
+///         ...
+///     }
+/// }
+/// \endcode
+///
 /// Usage example:
 /// \code
 /// // Create a socket to listen to new connections
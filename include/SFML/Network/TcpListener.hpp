@@ -29,6 +29,7 @@
 // Headers
 ////////////////////////////////////////////////////////////
 #include <SFML/Network/Export.hpp>
+#include <SFML/Network/IpAddress.hpp>
 #include <SFML/Network/Socket.hpp>
 
 
@@ -70,15 +71,20 @@ public :
     /// port, waiting for new connections.
     /// If the socket was previously listening to another port,
     /// it will be stopped first and bound to the new port.
+    /// By default the socket listens on all the IPv4 interfaces;
+    /// use IpAddress::AnyIPv6 to accept both IPv6 and IPv4
+    /// connections, or the address of an interface to listen on
+    /// this interface only.
     ///
-    /// \param port Port to listen for new connections
+    /// \param port    Port to listen for new connections
+    /// \param address Address of the interface to listen on
     ///
     /// \return Status code
     ///
     /// \see accept, close
     ///
     ////////////////////////////////////////////////////////////
-    Status listen(unsigned short port);
+    Status listen(unsigned short port, const IpAddress& address = IpAddress::Any);
 
     ////////////////////////////////////////////////////////////
     /// \brief Stop listening and close the socket
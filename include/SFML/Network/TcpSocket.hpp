@@ -38,6 +38,7 @@ namespace sf
 class TcpListener;
 class IpAddress;
 class Packet;
+class PacketPool;
 
 ////////////////////////////////////////////////////////////
 /// \brief Specialized socket using the TCP protocol
@@ -47,6 +48,14 @@ class SFML_NETWORK_API TcpSocket : public Socket
 {
 public :
 
+    ////////////////////////////////////////////////////////////
+    // Constants
+    ////////////////////////////////////////////////////////////
+    enum
+    {
+        MaxPacketSize = 0x10000000 ///< The maximum number of bytes that can be received in a single packet (256 MB)
+    };
+
     ////////////////////////////////////////////////////////////
     /// \brief Default constructor
     ///
@@ -125,6 +134,10 @@ public :
     /// \brief Send raw data to the remote peer
     ///
     /// This function will fail if the socket is not connected.
+    /// In non-blocking mode, if only a part of the data could be
+    /// sent, the function returns sf::Socket::Partial: use the
+    /// overload that returns the number of bytes sent to know
+    /// where to resume.
     ///
     /// \param data Pointer to the sequence of bytes to send
     /// \param size Number of bytes to send
@@ -136,6 +149,26 @@ public :
     ////////////////////////////////////////////////////////////
     Status send(const void* data, std::size_t size);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Send raw data to the remote peer, and get the
+    ///        number of bytes actually sent
+    ///
+    /// This function will fail if the socket is not connected.
+    /// In non-blocking mode, it returns sf::Socket::Partial when
+    /// the socket could only send a part of the data; the rest
+    /// must be sent later, starting at \a data + \a sent.
+    ///
+    /// \param data Pointer to the sequence of bytes to send
+    /// \param size Number of bytes to send
+    /// \param sent This variable is filled with the actual number of bytes sent
+    ///
+    /// \return Status code
+    ///
+    /// \see receive
+    ///
+    ////////////////////////////////////////////////////////////
+    Status send(const void* data, std::size_t size, std::size_t& sent);
+
     ////////////////////////////////////////////////////////////
     /// \brief Receive raw data from the remote peer
     ///
@@ -157,6 +190,12 @@ public :
     ////////////////////////////////////////////////////////////
     /// \brief Send a formatted packet of data to the remote peer
     ///
+    /// The size of the packet and its data are sent together,
+    /// without being copied to an intermediate buffer.
+    /// In non-blocking mode, Socket::Partial is returned if only
+    /// a part of the packet could be sent: the function must
+    /// then be called again with the same unmodified packet, so
+    /// that it sends the rest.
     /// This function will fail if the socket is not connected.
     ///
     /// \param packet Packet to send
@@ -168,12 +207,41 @@ public :
     ////////////////////////////////////////////////////////////
     Status send(Packet& packet);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Send several formatted packets of data to the remote peer
+    ///
+    /// The packets are gathered in as few system calls as
+    /// possible (usually one), which is much faster than sending
+    /// them one by one. They are received separately, in order.
+    /// In non-blocking mode, Socket::Partial is returned if only
+    /// a part of the packets could be sent: the function must
+    /// then be called again with the same unmodified packets.
+    /// This function will fail if the socket is not connected.
+    ///
+    /// \param packets Pointer to the array of packets to send
+    /// \param count   Number of packets in the array
+    ///
+    /// \return Status code
+    ///
+    /// \see receive
+    ///
+    ////////////////////////////////////////////////////////////
+    Status send(Packet* packets, std::size_t count);
+
     ////////////////////////////////////////////////////////////
     /// \brief Receive a formatted packet of data from the remote peer
     ///
     /// In blocking mode, this function will wait until the whole packet
     /// has been received.
+    /// The socket reads as much data as is available at once, so
+    /// the following packets may already be received and buffered
+    /// when the function returns: they are returned by the next
+    /// calls without reading the socket (a selector reports the
+    /// socket as ready as long as it has such packets).
     /// This function will fail if the socket is not connected.
+    /// If the peer announces a packet bigger than
+    /// TcpSocket::MaxPacketSize, the socket is disconnected and
+    /// the function fails.
     ///
     /// \param packet Packet to fill with the received data
     ///
@@ -184,27 +252,97 @@ public :
     ////////////////////////////////////////////////////////////
     Status receive(Packet& packet);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Receive all the available formatted packets of data
+    ///        from the remote peer
+    ///
+    /// This function fills the packets with all the complete
+    /// packets that have been received, up to \a maxCount;
+    /// the following packets of the array are left unchanged.
+    /// In blocking mode, it waits until at least one packet has
+    /// been received.
+    /// This function will fail if the socket is not connected.
+    ///
+    /// \param packets  Pointer to the array of packets to fill
+    /// \param maxCount Number of packets in the array
+    /// \param received This variable is filled with the number of packets received
+    ///
+    /// \return Status code (Done if at least one packet was received)
+    ///
+    /// \see send
+    ///
+    ////////////////////////////////////////////////////////////
+    Status receive(Packet* packets, std::size_t maxCount, std::size_t& received);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Receive a formatted packet of data from the remote
+    ///        peer, into a packet taken from a pool
+    ///
+    /// A packet is only acquired from \a pool when one was
+    /// received; the caller must then release it back to the
+    /// pool. Otherwise, \a packet is set to NULL.
+    /// In blocking mode, this function will wait until the whole
+    /// packet has been received.
+    ///
+    /// \param pool   Pool to take the packet from
+    /// \param packet This variable is filled with the received packet
+    ///
+    /// \return Status code
+    ///
+    /// \see send
+    ///
+    ////////////////////////////////////////////////////////////
+    Status receive(PacketPool& pool, Packet*& packet);
+
 private:
 
     friend class TcpListener;
 
     ////////////////////////////////////////////////////////////
-    /// \brief Structure holding the data of a pending packet
+    /// \brief Tell whether a complete packet has already been
+    ///        received and is waiting to be read
+    ///
+    /// \return True if a packet can be received without reading the socket
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual bool hasPendingPacket() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Read as much data as is available into the receive buffer
+    ///
+    /// \return Status code
+    ///
+    ////////////////////////////////////////////////////////////
+    Status fillReceiveBuffer();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Extract the next complete packet from the receive buffer
+    ///
+    /// \param packet Packet to fill with the received data
+    ///
+    /// \return True if a complete packet was extracted
+    ///
+    ////////////////////////////////////////////////////////////
+    bool extractPacket(Packet& packet);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Structure holding the received data that has not
+    ///        been extracted into packets yet
     ///
     ////////////////////////////////////////////////////////////
-    struct PendingPacket
+    struct ReceiveBuffer
     {
-        PendingPacket();
+        ReceiveBuffer();
 
-        Uint32            Size;         ///< Data of packet size
-        std::size_t       SizeReceived; ///< Number of size bytes received so far
-        std::vector<char> Data;         ///< Data of the packet
+        std::vector<char> data;  ///< Storage of the buffer
+        std::size_t       begin; ///< Beginning of the data that has not been extracted yet
+        std::size_t       end;   ///< End of the received data
     };
 
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
-    PendingPacket m_pendingPacket; ///< Temporary data of the packet currently being received
+    ReceiveBuffer m_receiveBuffer; ///< Data received but not returned in a packet yet
 };
 
 } // namespace sf
@@ -0,0 +1,420 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2014 Laurent Gomila (laurent.gom@gmail.com)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_UDPHOST_HPP
+#define SFML_UDPHOST_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Network/Export.hpp>
+#include <SFML/Network/IpAddress.hpp>
+#include <SFML/Network/Packet.hpp>
+#include <SFML/Network/Socket.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <SFML/System/Time.hpp>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+/// \brief Connection-oriented protocol providing reliable and
+///        unreliable channels over UDP
+///
+////////////////////////////////////////////////////////////
+class SFML_NETWORK_API UdpHost : NonCopyable
+{
+public :
+
+    ////////////////////////////////////////////////////////////
+    // Types
+    ////////////////////////////////////////////////////////////
+    typedef Uint32 Connection; ///< Identifier of a connection (0 is never a valid connection)
+
+    ////////////////////////////////////////////////////////////
+    // Constants
+    ////////////////////////////////////////////////////////////
+    enum
+    {
+        MaxChannels   = 255,    ///< Maximum number of channels
+        MaxPacketSize = 1126400 ///< Maximum size of the data of a packet (bigger packets are split in up to 1024 datagrams)
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Delivery guarantees of a channel
+    ///
+    ////////////////////////////////////////////////////////////
+    enum ChannelType
+    {
+        Unreliable,          ///< Packets may be lost or received out of order
+        UnreliableSequenced, ///< Packets may be lost, packets older than the last one received are dropped
+        ReliableOrdered      ///< All the packets are received, in the order they were sent
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Defines an event of the host
+    ///
+    ////////////////////////////////////////////////////////////
+    struct SFML_NETWORK_API Event
+    {
+        ////////////////////////////////////////////////////////////
+        /// \brief Enumeration of the different types of events
+        ///
+        ////////////////////////////////////////////////////////////
+        enum EventType
+        {
+            Connected,    ///< A connection was established
+            Disconnected, ///< A connection was closed by the peer, or timed out
+            Received      ///< A packet was received
+        };
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Default constructor
+        ///
+        ////////////////////////////////////////////////////////////
+        Event();
+
+        EventType    type;       ///< Type of the event
+        Connection   connection; ///< Connection concerned by the event
+        unsigned int channel;    ///< Channel of the received packet (Received only)
+        Packet       packet;     ///< Received packet (Received only)
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Statistics of a connection
+    ///
+    ////////////////////////////////////////////////////////////
+    struct SFML_NETWORK_API Statistics
+    {
+        ////////////////////////////////////////////////////////////
+        /// \brief Default constructor
+        ///
+        ////////////////////////////////////////////////////////////
+        Statistics();
+
+        Time        roundTripTime;      ///< Smoothed round trip time
+        Time        roundTripVariation; ///< Mean variation of the round trip time
+        Uint64      packetsSent;        ///< Number of packets sent
+        Uint64      packetsReceived;    ///< Number of packets received
+        Uint64      packetsDropped;     ///< Number of received packets dropped (out of sequence, or incomplete)
+        Uint64      fragmentsResent;    ///< Number of reliable fragments of packets sent again because they were lost
+        Uint64      datagramsSent;      ///< Number of datagrams sent
+        Uint64      datagramsReceived;  ///< Number of datagrams received
+        Uint64      datagramsLost;      ///< Number of datagrams sent that were never acknowledged
+        Uint64      bytesSent;          ///< Number of bytes sent, headers included
+        Uint64      bytesReceived;      ///< Number of bytes received, headers included
+        std::size_t bytesInFlight;      ///< Number of reliable bytes waiting to be acknowledged
+        std::size_t congestionWindow;   ///< Maximum number of reliable bytes that can wait to be acknowledged
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    ////////////////////////////////////////////////////////////
+    UdpHost();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    /// The connections are closed, without notifying the peers.
+    ///
+    ////////////////////////////////////////////////////////////
+    ~UdpHost();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Add a channel
+    ///
+    /// Channels are numbered in the order they are added,
+    /// starting from 0. Both ends of a connection must have
+    /// the same channels, which must be added before listening
+    /// or connecting.
+    ///
+    /// \param type Delivery guarantees of the channel
+    ///
+    /// \return Index of the new channel
+    ///
+    ////////////////////////////////////////////////////////////
+    unsigned int addChannel(ChannelType type);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of channels
+    ///
+    /// \return Number of channels
+    ///
+    ////////////////////////////////////////////////////////////
+    unsigned int getChannelCount() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Listen to incoming connections on a port
+    ///
+    /// Listening to IpAddress::AnyIPv6 accepts connections
+    /// from both IPv4 and IPv6 peers.
+    ///
+    /// \param port    Port to listen on (Socket::AnyPort to let the system choose one)
+    /// \param address Local address to listen on
+    ///
+    /// \return Status code
+    ///
+    /// \see getLocalPort, close
+    ///
+    ////////////////////////////////////////////////////////////
+    Socket::Status listen(unsigned short port, const IpAddress& address = IpAddress::Any);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the port to which the host is bound locally
+    ///
+    /// \return Port to which the host is bound (0 if it is not bound)
+    ///
+    ////////////////////////////////////////////////////////////
+    unsigned short getLocalPort() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Start connecting to a remote host
+    ///
+    /// The function returns immediately: a Connected event is
+    /// generated when the remote host accepts the connection,
+    /// or a Disconnected event if it doesn't answer before the
+    /// timeout. Packets can be sent to the connection right away,
+    /// they are delivered once it is established.
+    ///
+    /// If the host is not bound yet, it is bound to any port
+    /// and to the same type of address as \a remoteAddress.
+    ///
+    /// \param remoteAddress Address of the remote host
+    /// \param remotePort    Port of the remote host
+    ///
+    /// \return Identifier of the new connection (0 on error)
+    ///
+    /// \see disconnect
+    ///
+    ////////////////////////////////////////////////////////////
+    Connection connect(const IpAddress& remoteAddress, unsigned short remotePort);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Close a connection
+    ///
+    /// The peer is notified, but the packets that were not
+    /// sent or acknowledged yet are discarded. No event is
+    /// generated for this connection.
+    ///
+    /// \param connection Connection to close
+    ///
+    /// \see connect
+    ///
+    ////////////////////////////////////////////////////////////
+    void disconnect(Connection connection);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Close all the connections and unbind the host
+    ///
+    ////////////////////////////////////////////////////////////
+    void close();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether a connection exists and is established
+    ///
+    /// \param connection Connection to check
+    ///
+    /// \return True if the connection is established
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isConnected(Connection connection) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the address of the remote host of a connection
+    ///
+    /// \param connection Connection to query
+    ///
+    /// \return Address of the remote host (IpAddress::None if the connection doesn't exist)
+    ///
+    ////////////////////////////////////////////////////////////
+    IpAddress getRemoteAddress(Connection connection) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the port of the remote host of a connection
+    ///
+    /// \param connection Connection to query
+    ///
+    /// \return Port of the remote host (0 if the connection doesn't exist)
+    ///
+    ////////////////////////////////////////////////////////////
+    unsigned short getRemotePort(Connection connection) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the statistics of a connection
+    ///
+    /// \param connection Connection to query
+    ///
+    /// \return Statistics of the connection
+    ///
+    ////////////////////////////////////////////////////////////
+    Statistics getStatistics(Connection connection) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Send a packet through a channel of a connection
+    ///
+    /// The packet is queued, and actually sent by the next
+    /// call to update() or pollEvent(). Packets bigger than a
+    /// datagram are split, and put back together by the receiver.
+    ///
+    /// \param connection Connection to send the packet to
+    /// \param channel    Index of the channel to use
+    /// \param packet     Packet to send
+    ///
+    /// \return Status code (Error if the connection or the channel doesn't exist, or the packet is too big)
+    ///
+    ////////////////////////////////////////////////////////////
+    Socket::Status send(Connection connection, unsigned int channel, Packet& packet);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Exchange data with the remote hosts
+    ///
+    /// This function receives the incoming datagrams, sends the
+    /// queued packets and the acknowledgements, sends again the
+    /// reliable data that was lost, and closes the connections
+    /// that timed out. It never blocks. It is called by pollEvent
+    /// when there are no more events; it must be called
+    /// frequently (every frame, for example).
+    ///
+    ////////////////////////////////////////////////////////////
+    void update();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Pop the event on top of the event queue, if any, and return it
+    ///
+    /// When the queue is empty, update() is called first.
+    /// This function is not blocking.
+    ///
+    /// \param event Event to be returned
+    ///
+    /// \return True if an event was returned, or false if the event queue was empty
+    ///
+    ////////////////////////////////////////////////////////////
+    bool pollEvent(Event& event);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the time after which a silent connection is closed
+    ///
+    /// The default timeout is 10 seconds.
+    ///
+    /// \param timeout Timeout of the connections
+    ///
+    ////////////////////////////////////////////////////////////
+    void setTimeout(Time timeout);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Simulate a bad network on the outgoing datagrams
+    ///
+    /// This is meant for testing how a program behaves with
+    /// lost and late data, on a local network or loopback.
+    ///
+    /// \param lossRate Proportion of the outgoing datagrams to drop, in range [0, 1]
+    /// \param latency  Delay added to the outgoing datagrams
+    ///
+    ////////////////////////////////////////////////////////////
+    void simulateNetwork(float lossRate, Time latency = Time::Zero);
+
+private :
+
+    struct UdpHostImpl;
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    UdpHostImpl* m_impl; ///< Connections and socket of the host
+};
+
+} // namespace sf
+
+
+#endif // SFML_UDPHOST_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::UdpHost
+/// \ingroup network
+///
+/// sf::UdpHost implements a light protocol over UDP, for
+/// programs such as real-time games that need to send both
+/// data that must arrive and data that is only useful if it
+/// arrives quickly. With TCP, a single lost segment delays
+/// all the data that follows it (head-of-line blocking);
+/// with UDP alone, data may be lost, duplicated or reordered,
+/// and datagrams are limited in size.
+///
+/// A host manages any number of connections through a single
+/// UDP socket. Each connection has the same set of channels,
+/// and each channel has its own delivery guarantees: a lost
+/// datagram only delays the reliable channels, and only the
+/// packets that it contained or that come after them.
+///
+/// Internally, every datagram acknowledges the last 33
+/// datagrams received from the peer, and reliable data is
+/// sent again when it isn't acknowledged in time (based on the
+/// measured round trip time). The amount of reliable data
+/// waiting to be acknowledged is limited by a congestion window,
+/// which shrinks when datagrams are lost. Connections exchange
+/// datagrams regularly, so that dead peers are detected.
+///
+/// Usage example:
+/// \code
+/// // ----- The server -----
+///
+/// sf::UdpHost server;
+/// unsigned int chat = server.addChannel(sf::UdpHost::ReliableOrdered);
+/// unsigned int positions = server.addChannel(sf::UdpHost::UnreliableSequenced);
+/// server.listen(55002);
+///
+/// while (running)
+/// {
+///     sf::UdpHost::Event event;
+///     while (server.pollEvent(event))
+///     {
+///         if (event.type == sf::UdpHost::Event::Received)
+///         {
+///             if (event.channel == chat)
+///                 broadcast(event.packet);
+///             else
+///                 updatePosition(event.connection, event.packet);
+///         }
+///     }
+///
+///     // ... run the game ...
+/// }
+///
+/// // ----- The client -----
+///
+/// sf::UdpHost client;
+/// unsigned int chat = client.addChannel(sf::UdpHost::ReliableOrdered);
+/// unsigned int positions = client.addChannel(sf::UdpHost::UnreliableSequenced);
+/// sf::UdpHost::Connection server = client.connect("192.168.1.50", 55002);
+///
+/// sf::Packet packet;
+/// packet << "Hello";
+/// client.send(server, chat, packet);
+/// \endcode
+///
+/// \see sf::UdpSocket, sf::Packet
+///
+////////////////////////////////////////////////////////////
@@ -30,13 +30,14 @@
 ////////////////////////////////////////////////////////////
 #include <SFML/Network/Export.hpp>
 #include <SFML/Network/Socket.hpp>
+#include <SFML/Network/IpAddress.hpp>
 #include <vector>
 
 
 namespace sf
 {
-class IpAddress;
 class Packet;
+class PacketPool;
 
 ////////////////////////////////////////////////////////////
 /// \brief Specialized socket using the UDP protocol
@@ -54,6 +55,25 @@ public :
         MaxDatagramSize = 65507 ///< The maximum number of bytes that can be sent in a single UDP datagram
     };
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Description of a datagram sent or received in a batch
+    ///
+    ////////////////////////////////////////////////////////////
+    struct SFML_NETWORK_API Datagram
+    {
+        ////////////////////////////////////////////////////////////
+        /// \brief Default constructor
+        ///
+        ////////////////////////////////////////////////////////////
+        Datagram();
+
+        void*          data;     ///< Bytes to send, or buffer to fill when receiving
+        std::size_t    size;     ///< Number of bytes to send, or size of the buffer to fill
+        std::size_t    received; ///< Number of bytes received
+        IpAddress      address;  ///< Address of the receiver, or of the sender when receiving
+        unsigned short port;     ///< Port of the receiver, or of the sender when receiving
+    };
+
     ////////////////////////////////////////////////////////////
     /// \brief Default constructor
     ///
@@ -81,15 +101,21 @@ public :
     /// You can use the special value Socket::AnyPort to tell the
     /// system to automatically pick an available port, and then
     /// call getLocalPort to retrieve the chosen port.
+    /// By default the socket is bound to all the IPv4 interfaces;
+    /// use IpAddress::AnyIPv6 to exchange data with both IPv6 and
+    /// IPv4 hosts, or the address of an interface to bind the
+    /// socket to this interface only. A socket that is not bound
+    /// uses the type of the first address that it sends to.
     ///
-    /// \param port Port to bind the socket to
+    /// \param port    Port to bind the socket to
+    /// \param address Address of the interface to bind to
     ///
     /// \return Status code
     ///
     /// \see unbind, getLocalPort
     ///
     ////////////////////////////////////////////////////////////
-    Status bind(unsigned short port);
+    Status bind(unsigned short port, const IpAddress& address = IpAddress::Any);
 
     ////////////////////////////////////////////////////////////
     /// \brief Unbind the socket from the local port to which it is bound
@@ -180,12 +206,150 @@ public :
     ////////////////////////////////////////////////////////////
     Status receive(Packet& packet, IpAddress& remoteAddress, unsigned short& remotePort);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Send several datagrams at once
+    ///
+    /// On Linux, all the datagrams are sent with a few system
+    /// calls (sendmmsg); on other systems they are sent one by one.
+    /// The function stops at the first datagram that can't be
+    /// sent: in non-blocking mode, Socket::Partial is returned
+    /// if only the first \a sent datagrams were sent.
+    ///
+    /// \param datagrams Pointer to the array of datagrams to send
+    /// \param count     Number of datagrams in the array
+    /// \param sent      This variable is filled with the number of datagrams sent
+    ///
+    /// \return Status code
+    ///
+    /// \see receive, setSegmentationOffload
+    ///
+    ////////////////////////////////////////////////////////////
+    Status send(const Datagram* datagrams, std::size_t count, std::size_t& sent);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Receive all the available datagrams at once
+    ///
+    /// The datagrams are written directly to the buffers of the
+    /// array, and the function returns as soon as no more
+    /// datagrams are waiting (or the array is full); in blocking
+    /// mode, it first waits until at least one datagram is received.
+    /// On Linux, the datagrams are received with a few system
+    /// calls (recvmmsg); on other systems they are received one by one.
+    /// Make sure that the buffers are large enough for the
+    /// datagrams that you intend to receive: bigger datagrams
+    /// are truncated, or lost on some systems.
+    ///
+    /// \param datagrams Pointer to the array of datagrams to fill
+    /// \param count     Number of datagrams in the array
+    /// \param received  This variable is filled with the number of datagrams received
+    ///
+    /// \return Status code (Done if at least one datagram was received)
+    ///
+    /// \see send, setSegmentationOffload
+    ///
+    ////////////////////////////////////////////////////////////
+    Status receive(Datagram* datagrams, std::size_t count, std::size_t& received);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Receive a formatted packet of data from a remote
+    ///        peer, into a packet taken from a pool
+    ///
+    /// A packet is only acquired from \a pool when a datagram
+    /// was received; the caller must then release it back to
+    /// the pool. Otherwise, \a packet is set to NULL.
+    /// In blocking mode, this function will wait until the whole
+    /// packet has been received.
+    ///
+    /// \param pool          Pool to take the packet from
+    /// \param packet        This variable is filled with the received packet
+    /// \param remoteAddress Address of the peer that sent the data
+    /// \param remotePort    Port of the peer that sent the data
+    ///
+    /// \return Status code
+    ///
+    /// \see send
+    ///
+    ////////////////////////////////////////////////////////////
+    Status receive(PacketPool& pool, Packet*& packet, IpAddress& remoteAddress, unsigned short& remotePort);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Enable or disable segmentation offload
+    ///
+    /// With segmentation offload, consecutive datagrams of a
+    /// batch that have the same size and the same receiver are
+    /// passed to the system as a single buffer, which splits it
+    /// (UDP GSO), and the system coalesces received datagrams
+    /// (UDP GRO), which are split back by the socket. This
+    /// greatly reduces the cost of big streams of datagrams.
+    /// It is only available on Linux 5.0 and later; it is
+    /// disabled by default.
+    ///
+    /// \param enabled True to enable segmentation offload, false to disable it
+    ///
+    /// \return True if segmentation offload is now in the requested state
+    ///
+    /// \see isSegmentationOffloadEnabled
+    ///
+    ////////////////////////////////////////////////////////////
+    bool setSegmentationOffload(bool enabled);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether segmentation offload is enabled
+    ///
+    /// \return True if segmentation offload is enabled
+    ///
+    /// \see setSegmentationOffload
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isSegmentationOffloadEnabled() const;
+
 private:
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether coalesced datagrams are waiting to
+    ///        be split and received
+    ///
+    /// \return True if a datagram can be received without reading the socket
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual bool hasPendingPacket() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Receive datagrams that may have been coalesced by
+    ///        the system, and split them
+    ///
+    /// \param datagrams Pointer to the array of datagrams to fill
+    /// \param count     Number of datagrams in the array
+    /// \param received  This variable is filled with the number of datagrams received
+    ///
+    /// \return Status code
+    ///
+    ////////////////////////////////////////////////////////////
+    Status receiveCoalesced(Datagram* datagrams, std::size_t count, std::size_t& received);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Structure holding coalesced datagrams that have
+    ///        not been split yet
+    ///
+    ////////////////////////////////////////////////////////////
+    struct CoalescedData
+    {
+        CoalescedData();
+
+        std::vector<char> data;        ///< Coalesced datagrams
+        std::size_t       begin;       ///< Beginning of the next datagram to split
+        std::size_t       end;         ///< End of the coalesced datagrams
+        std::size_t       segmentSize; ///< Size of each datagram (except the last one, which may be smaller)
+        IpAddress         address;     ///< Address of the sender
+        unsigned short    port;        ///< Port of the sender
+    };
+
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
-    std::vector<char> m_buffer; ///< Temporary buffer holding the received data in Receive(Packet)
+    std::vector<char> m_buffer;    ///< Temporary buffer holding the received data in Receive(Packet)
+    bool              m_offload;   ///< Is segmentation offload enabled?
+    CoalescedData     m_coalesced; ///< Received datagrams waiting to be split (segmentation offload)
 };
 
 } // namespace sf
@@ -278,6 +442,25 @@ private:
 /// socket.send(message.c_str(), message.size() + 1, sender, port);
 /// \endcode
 ///
+/// Servers that handle many datagrams can send and receive
+/// them by batches, which saves most of the system calls:
+/// \code
+/// char buffers[64][1500];
+/// sf::UdpSocket::Datagram datagrams[64];
+/// for (int i = 0; i < 64; ++i)
+/// {
+///     datagrams[i].data = buffers[i];
+///     datagrams[i].size = sizeof(buffers[i]);
+/// }
+///
+/// std::size_t count = 0;
+/// if (socket.receive(datagrams, 64, count) == sf::Socket::Done)
+/// {
+///     for (std::size_t i = 0; i < count; ++i)
+///         process(datagrams[i].data, datagrams[i].received, datagrams[i].address, datagrams[i].port);
+/// }
+/// \endcode
+///
 /// \see sf::Socket, sf::TcpSocket, sf::Packet
 ///
 ////////////////////////////////////////////////////////////
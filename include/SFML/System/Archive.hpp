@@ -0,0 +1,204 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2014 Laurent Gomila (laurent.gom@gmail.com)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_ARCHIVE_HPP
+#define SFML_ARCHIVE_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Config.hpp>
+#include <SFML/System/Export.hpp>
+#include <SFML/System/ArchiveInputStream.hpp>
+#include <SFML/System/MappedFileInputStream.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <string>
+#include <vector>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+/// \brief Read-only access to the entries of a pack file
+///
+////////////////////////////////////////////////////////////
+class SFML_SYSTEM_API Archive : NonCopyable
+{
+public :
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    ////////////////////////////////////////////////////////////
+    Archive();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Open an archive file
+    ///
+    /// The archive is mapped into memory and its table of
+    /// contents is loaded; entries data is not read until
+    /// they are opened.
+    ///
+    /// \param filename Path of the archive file
+    ///
+    /// \return True if the archive was successfully opened
+    ///
+    ////////////////////////////////////////////////////////////
+    bool open(const std::string& filename);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of entries in the archive
+    ///
+    /// \return Number of entries
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getEntryCount() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the name of an entry
+    ///
+    /// Entries are not ordered alphabetically.
+    ///
+    /// \param index Index of the entry, in range [0, getEntryCount() - 1]
+    ///
+    /// \return Name of the entry
+    ///
+    ////////////////////////////////////////////////////////////
+    const std::string& getEntryName(std::size_t index) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Check if the archive contains an entry
+    ///
+    /// \param name Name of the entry, with '/' as separator
+    ///
+    /// \return True if the entry exists
+    ///
+    ////////////////////////////////////////////////////////////
+    bool contains(const std::string& name) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the uncompressed size of an entry
+    ///
+    /// \param name Name of the entry, with '/' as separator
+    ///
+    /// \return Size of the entry, in bytes, or -1 if it doesn't exist
+    ///
+    ////////////////////////////////////////////////////////////
+    Int64 getEntrySize(const std::string& name) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Open an entry of the archive for reading
+    ///
+    /// This function is thread-safe: several entries (or the
+    /// same entry) can be opened concurrently.
+    ///
+    /// \param name   Name of the entry, with '/' as separator
+    /// \param stream Stream to open on the entry
+    ///
+    /// \return True if the entry was successfully opened
+    ///
+    ////////////////////////////////////////////////////////////
+    bool openEntry(const std::string& name, ArchiveInputStream& stream) const;
+
+private :
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Entry of the table of contents
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Entry
+    {
+        Uint32      hash;        ///< Hash of the name
+        std::string name;        ///< Name of the entry
+        Uint32      compression; ///< Compression method
+        Uint64      offset;      ///< Offset of the data in the file
+        Uint64      size;        ///< Uncompressed size
+        Uint64      storedSize;  ///< Size of the data in the file
+
+        bool operator <(const Entry& right) const;
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Find an entry by its name
+    ///
+    /// \param name Name of the entry
+    ///
+    /// \return Pointer to the entry, or NULL if not found
+    ///
+    ////////////////////////////////////////////////////////////
+    const Entry* findEntry(const std::string& name) const;
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    MappedFileInputStream m_file;    ///< Memory mapping of the archive file
+    std::vector<Entry>    m_entries; ///< Table of contents, sorted by hash then by name
+};
+
+} // namespace sf
+
+
+#endif // SFML_ARCHIVE_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::Archive
+/// \ingroup system
+///
+/// sf::Archive gives read-only access to the entries of a
+/// pack file, which groups many resources (images, sounds,
+/// shaders, ...) into a single file.
+///
+/// Compared to loading every resource from its own file,
+/// this replaces one open/read/close sequence per resource
+/// with a single memory mapping: the table of contents is
+/// hashed so that looking an entry up is a binary search,
+/// and reading an entry is a plain memory access.
+/// Entries can optionally be compressed with LZ4.
+///
+/// Archives are created with the sfml-pack tool, found in
+/// the tools directory of the SDK.
+///
+/// Each entry is exposed as a sf::ArchiveInputStream, so that
+/// it can be used with every loadFromStream function of SFML.
+///
+/// Usage example:
+/// \code
+/// sf::Archive archive;
+/// if (!archive.open("resources.pak"))
+///     return -1;
+///
+/// sf::ArchiveInputStream stream;
+/// if (archive.openEntry("images/hero.png", stream))
+///     texture.loadFromStream(stream);
+///
+/// // the stream must stay alive while the music is playing
+/// sf::ArchiveInputStream musicStream;
+/// if (archive.openEntry("musics/theme.ogg", musicStream))
+///     music.openFromStream(musicStream);
+/// \endcode
+///
+/// \see sf::ArchiveInputStream
+///
+////////////////////////////////////////////////////////////
@@ -0,0 +1,145 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2014 Laurent Gomila (laurent.gom@gmail.com)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_ARCHIVEINPUTSTREAM_HPP
+#define SFML_ARCHIVEINPUTSTREAM_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Config.hpp>
+#include <SFML/System/Export.hpp>
+#include <SFML/System/MemoryInputStream.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <vector>
+
+
+namespace sf
+{
+class Archive;
+
+////////////////////////////////////////////////////////////
+/// \brief Input stream reading a single entry of an archive
+///
+////////////////////////////////////////////////////////////
+class SFML_SYSTEM_API ArchiveInputStream : public InputStream, NonCopyable
+{
+public :
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// The stream is invalid until it is opened with Archive::openEntry.
+    ///
+    ////////////////////////////////////////////////////////////
+    ArchiveInputStream();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Read data from the stream
+    ///
+    /// After reading, the stream's reading position must be
+    /// advanced by the amount of bytes read.
+    ///
+    /// \param data Buffer where to copy the read data
+    /// \param size Desired number of bytes to read
+    ///
+    /// \return The number of bytes actually read, or -1 on error
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual Int64 read(void* data, Int64 size);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Change the current reading position
+    ///
+    /// \param position The position to seek to, from the beginning
+    ///
+    /// \return The position actually sought to, or -1 on error
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual Int64 seek(Int64 position);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the current reading position in the stream
+    ///
+    /// \return The current position, or -1 on error.
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual Int64 tell();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Return the size of the stream
+    ///
+    /// \return The total number of bytes available in the stream, or -1 on error
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual Int64 getSize();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get a pointer to the whole (uncompressed) entry data
+    ///
+    /// For stored entries, this points directly into the memory
+    /// mapping of the archive. This allows to use loadFromMemory
+    /// functions instead of loadFromStream, without any copy.
+    ///
+    /// \return Pointer to the data, or NULL if the stream is not open
+    ///
+    ////////////////////////////////////////////////////////////
+    const void* getData() const;
+
+private :
+
+    friend class Archive;
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    MemoryInputStream m_memory; ///< Stream over the entry data
+    std::vector<char> m_buffer; ///< Decompressed data, for compressed entries
+};
+
+} // namespace sf
+
+
+#endif // SFML_ARCHIVEINPUTSTREAM_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::ArchiveInputStream
+/// \ingroup system
+///
+/// sf::ArchiveInputStream gives access to a single entry
+/// of a sf::Archive, through the sf::InputStream interface.
+/// It can therefore be passed to any loadFromStream or
+/// openFromStream function of SFML.
+///
+/// Stored entries are read directly from the memory mapping
+/// of the archive, so reading and seeking never involve
+/// a system call. Compressed entries are decompressed
+/// entirely when the stream is opened.
+///
+/// The stream must not outlive the archive it was opened from.
+///
+/// \see sf::Archive
+///
+////////////////////////////////////////////////////////////
@@ -0,0 +1,184 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2014 Laurent Gomila (laurent.gom@gmail.com)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_MAPPEDFILEINPUTSTREAM_HPP
+#define SFML_MAPPEDFILEINPUTSTREAM_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Config.hpp>
+#include <SFML/System/Export.hpp>
+#include <SFML/System/InputStream.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <string>
+
+
+namespace sf
+{
+namespace priv
+{
+    class MappedFileImpl;
+}
+
+////////////////////////////////////////////////////////////
+/// \brief Implementation of input stream based on a file
+///        mapped into memory
+///
+////////////////////////////////////////////////////////////
+class SFML_SYSTEM_API MappedFileInputStream : public InputStream, NonCopyable
+{
+public :
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    ////////////////////////////////////////////////////////////
+    MappedFileInputStream();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    /// The file is unmapped, which invalidates the pointer
+    /// returned by getData().
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual ~MappedFileInputStream();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Map a file into memory and open the stream on it
+    ///
+    /// The file is mapped read-only. This function fails if the
+    /// file doesn't exist, is empty, or if the OS refuses to
+    /// map it; callers can then fall back to a regular FileInputStream.
+    ///
+    /// \param filename Name of the file to map
+    ///
+    /// \return True on success, false on error
+    ///
+    ////////////////////////////////////////////////////////////
+    bool open(const std::string& filename);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Unmap the file, if any
+    ///
+    ////////////////////////////////////////////////////////////
+    void close();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Read data from the stream
+    ///
+    /// After reading, the stream's reading position must be
+    /// advanced by the amount of bytes read.
+    ///
+    /// \param data Buffer where to copy the read data
+    /// \param size Desired number of bytes to read
+    ///
+    /// \return The number of bytes actually read, or -1 on error
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual Int64 read(void* data, Int64 size);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Change the current reading position
+    ///
+    /// \param position The position to seek to, from the beginning
+    ///
+    /// \return The position actually sought to, or -1 on error
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual Int64 seek(Int64 position);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the current reading position in the stream
+    ///
+    /// \return The current position, or -1 on error.
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual Int64 tell();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Return the size of the stream
+    ///
+    /// \return The total number of bytes available in the stream, or -1 on error
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual Int64 getSize();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get a pointer to the mapped contents of the file
+    ///
+    /// The pointer stays valid until the stream is closed,
+    /// reopened or destroyed. Using it directly avoids the
+    /// copy performed by read().
+    ///
+    /// \return Pointer to the mapped data, or NULL if no file is mapped
+    ///
+    ////////////////////////////////////////////////////////////
+    const void* getData() const;
+
+private :
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    priv::MappedFileImpl* m_impl;   ///< OS-specific implementation
+    Int64                 m_offset; ///< Current reading position
+};
+
+} // namespace sf
+
+
+#endif // SFML_MAPPEDFILEINPUTSTREAM_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::MappedFileInputStream
+/// \ingroup system
+///
+/// This class is a specialization of InputStream that
+/// maps a whole file into the address space of the process
+/// (mmap on Unix, file mappings on Windows) and reads from it.
+///
+/// Compared to sf::FileInputStream, reading doesn't involve
+/// any system call once the file is mapped: pages are loaded
+/// on demand by the OS and shared with its file cache. And
+/// since the whole file is directly addressable, decoders
+/// that accept memory buffers can consume getData() without
+/// any intermediate copy. This is what SFML resource classes
+/// do internally in their loadFromFile functions.
+///
+/// Usage example:
+/// \code
+/// sf::MappedFileInputStream stream;
+/// if (stream.open("level1.dat"))
+/// {
+///     const char* data = static_cast<const char*>(stream.getData());
+///     parse(data, stream.getSize());
+/// }
+/// \endcode
+///
+/// \see sf::FileInputStream, sf::MemoryInputStream
+///
+////////////////////////////////////////////////////////////
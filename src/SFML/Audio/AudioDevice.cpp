@@ -28,13 +28,21 @@
 #include <SFML/Audio/AudioDevice.hpp>
 #include <SFML/Audio/ALCheck.hpp>
 #include <SFML/Audio/Listener.hpp>
+#include <SFML/Audio/SoundSource.hpp>
 #include <SFML/System/Err.hpp>
+#include <SFML/System/Lock.hpp>
+#include <SFML/System/Mutex.hpp>
 
 
 namespace 
 {
     ALCdevice*  audioDevice  = NULL;
     ALCcontext* audioContext = NULL;
+
+    // Sound sources with changes waiting for the next commit
+    bool                       deferredUpdates = false;
+    std::set<sf::SoundSource*> pendingSources;
+    sf::Mutex                  pendingMutex;
 }
 
 namespace sf
@@ -100,6 +108,10 @@ int AudioDevice::getFormatFromChannelCount(unsigned int channelCount)
 {
     ensureALInit();
 
+    // Surround layouts are only available through an extension
+    if ((channelCount > 2) && !isExtensionSupported("AL_EXT_MCFORMATS"))
+        return 0;
+
     // Find the good format according to the number of channels
     int format = 0;
     switch (channelCount)
@@ -120,6 +132,108 @@ int AudioDevice::getFormatFromChannelCount(unsigned int channelCount)
     return format;
 }
 
+
+////////////////////////////////////////////////////////////
+int AudioDevice::getFloatFormatFromChannelCount(unsigned int channelCount)
+{
+    ensureALInit();
+
+    // Floating point samples, and surround layouts, are only available through extensions
+    if (!isExtensionSupported("AL_EXT_float32"))
+        return 0;
+    if ((channelCount > 2) && !isExtensionSupported("AL_EXT_MCFORMATS"))
+        return 0;
+
+    // Find the good format according to the number of channels
+    int format = 0;
+    switch (channelCount)
+    {
+        case 1  : format = alGetEnumValue("AL_FORMAT_MONO_FLOAT32");   break;
+        case 2  : format = alGetEnumValue("AL_FORMAT_STEREO_FLOAT32"); break;
+        case 4  : format = alGetEnumValue("AL_FORMAT_QUAD32");         break;
+        case 6  : format = alGetEnumValue("AL_FORMAT_51CHN32");        break;
+        case 7  : format = alGetEnumValue("AL_FORMAT_61CHN32");        break;
+        case 8  : format = alGetEnumValue("AL_FORMAT_71CHN32");        break;
+        default : format = 0;                                          break;
+    }
+
+    // Fixes a bug on OS X
+    if (format == -1)
+        format = 0;
+
+    return format;
+}
+
+
+////////////////////////////////////////////////////////////
+unsigned int AudioDevice::getSampleRate()
+{
+    ensureALInit();
+
+    ALCint sampleRate = 0;
+    if (audioDevice)
+        alcGetIntegerv(audioDevice, ALC_FREQUENCY, 1, &sampleRate);
+
+    return sampleRate > 0 ? static_cast<unsigned int>(sampleRate) : 44100;
+}
+
+
+////////////////////////////////////////////////////////////
+void AudioDevice::setDeferredUpdates(bool deferred)
+{
+    deferredUpdates = deferred;
+
+    if (!deferred)
+        commitUpdates();
+}
+
+
+////////////////////////////////////////////////////////////
+bool AudioDevice::isDeferringUpdates()
+{
+    return deferredUpdates;
+}
+
+
+////////////////////////////////////////////////////////////
+void AudioDevice::addPendingSource(SoundSource* source)
+{
+    Lock lock(pendingMutex);
+
+    pendingSources.insert(source);
+}
+
+
+////////////////////////////////////////////////////////////
+void AudioDevice::removePendingSource(SoundSource* source)
+{
+    Lock lock(pendingMutex);
+
+    pendingSources.erase(source);
+}
+
+
+////////////////////////////////////////////////////////////
+void AudioDevice::commitUpdates()
+{
+    Lock lock(pendingMutex);
+
+    if (pendingSources.empty())
+        return;
+
+    // Suspend the context so that the driver processes all the changes at once
+    if (audioContext)
+        alcSuspendContext(audioContext);
+
+    for (std::set<SoundSource*>::iterator it = pendingSources.begin(); it != pendingSources.end(); ++it)
+        (*it)->applyChanges();
+
+    if (audioContext)
+        alcProcessContext(audioContext);
+
+    pendingSources.clear();
+}
+
 } // namespace priv
 
 } // namespace sf
@@ -34,6 +34,8 @@
 
 namespace sf
 {
+class SoundSource;
+
 namespace priv
 {
 ////////////////////////////////////////////////////////////
@@ -75,12 +77,81 @@ public :
     ////////////////////////////////////////////////////////////
     /// \brief Get the OpenAL format that matches the given number of channels
     ///
+    /// Layouts with more than 2 channels (quad, 5.1, 6.1 and 7.1)
+    /// require the AL_EXT_MCFORMATS extension.
+    ///
     /// \param channelCount Number of channels
     ///
-    /// \return Corresponding format
+    /// \return Corresponding format, or 0 if not supported
     ///
     ////////////////////////////////////////////////////////////
     static int getFormatFromChannelCount(unsigned int channelCount);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the OpenAL floating point format that matches
+    ///        the given number of channels
+    ///
+    /// Floating point formats require the AL_EXT_float32
+    /// extension, and AL_EXT_MCFORMATS for layouts with
+    /// more than 2 channels.
+    ///
+    /// \param channelCount Number of channels
+    ///
+    /// \return Corresponding format, or 0 if not supported
+    ///
+    ////////////////////////////////////////////////////////////
+    static int getFloatFormatFromChannelCount(unsigned int channelCount);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the output sample rate of the audio device
+    ///
+    /// \return Sample rate, in samples per second (44100 if unknown)
+    ///
+    ////////////////////////////////////////////////////////////
+    static unsigned int getSampleRate();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Enable or disable the deferred updates of the sound sources
+    ///
+    /// Disabling the deferred updates commits the pending changes.
+    ///
+    /// \param deferred True to defer the updates, false to apply them immediately
+    ///
+    ////////////////////////////////////////////////////////////
+    static void setDeferredUpdates(bool deferred);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether the updates of the sound sources are deferred
+    ///
+    /// \return True if updates are deferred
+    ///
+    ////////////////////////////////////////////////////////////
+    static bool isDeferringUpdates();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Register a sound source which has pending changes
+    ///
+    /// \param source Source to update at the next commit
+    ///
+    ////////////////////////////////////////////////////////////
+    static void addPendingSource(SoundSource* source);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Unregister a sound source (typically when it is destroyed)
+    ///
+    /// \param source Source to forget
+    ///
+    ////////////////////////////////////////////////////////////
+    static void removePendingSource(SoundSource* source);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Apply the pending changes of all the sound sources
+    ///
+    /// The context is suspended during the update, so that all
+    /// the changes are processed by the driver at once.
+    ///
+    ////////////////////////////////////////////////////////////
+    static void commitUpdates();
 };
 
 } // namespace priv
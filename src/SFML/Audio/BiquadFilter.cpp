@@ -0,0 +1,265 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2014 Laurent Gomila (laurent.gom@gmail.com)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Audio/BiquadFilter.hpp>
+#include <SFML/Audio/EffectKernels.hpp>
+#include <SFML/System/Lock.hpp>
+#include <cmath>
+
+
+namespace
+{
+    const double pi = 3.14159265358979323846;
+}
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+BiquadFilter::BiquadFilter(Type type, float frequency, float q, float gain) :
+m_type      (type),
+m_frequency (frequency),
+m_q         (q),
+m_gain      (gain),
+m_sampleRate(0),
+m_needUpdate(true)
+{
+    // Let the samples through until the sample rate is known
+    m_coefficients[0] = 1.f;
+    m_coefficients[1] = 0.f;
+    m_coefficients[2] = 0.f;
+    m_coefficients[3] = 0.f;
+    m_coefficients[4] = 0.f;
+}
+
+
+////////////////////////////////////////////////////////////
+void BiquadFilter::setType(Type type)
+{
+    Lock lock(m_mutex);
+
+    m_type = type;
+    m_needUpdate = true;
+}
+
+
+////////////////////////////////////////////////////////////
+void BiquadFilter::setFrequency(float frequency)
+{
+    Lock lock(m_mutex);
+
+    m_frequency = frequency;
+    m_needUpdate = true;
+}
+
+
+////////////////////////////////////////////////////////////
+void BiquadFilter::setQ(float q)
+{
+    Lock lock(m_mutex);
+
+    m_q = q;
+    m_needUpdate = true;
+}
+
+
+////////////////////////////////////////////////////////////
+void BiquadFilter::setGain(float gain)
+{
+    Lock lock(m_mutex);
+
+    m_gain = gain;
+    m_needUpdate = true;
+}
+
+
+////////////////////////////////////////////////////////////
+BiquadFilter::Type BiquadFilter::getType() const
+{
+    Lock lock(m_mutex);
+
+    return m_type;
+}
+
+
+////////////////////////////////////////////////////////////
+float BiquadFilter::getFrequency() const
+{
+    Lock lock(m_mutex);
+
+    return m_frequency;
+}
+
+
+////////////////////////////////////////////////////////////
+float BiquadFilter::getQ() const
+{
+    Lock lock(m_mutex);
+
+    return m_q;
+}
+
+
+////////////////////////////////////////////////////////////
+float BiquadFilter::getGain() const
+{
+    Lock lock(m_mutex);
+
+    return m_gain;
+}
+
+
+////////////////////////////////////////////////////////////
+void BiquadFilter::reset(unsigned int channelCount, unsigned int sampleRate)
+{
+    Lock lock(m_mutex);
+
+    m_sampleRate = sampleRate;
+    m_needUpdate = true;
+    m_state.assign(channelCount * 2, 0.f);
+}
+
+
+////////////////////////////////////////////////////////////
+void BiquadFilter::process(std::vector<float>& samples, unsigned int channelCount)
+{
+    Lock lock(m_mutex);
+
+    if (samples.empty() || (channelCount == 0))
+        return;
+
+    // The channel count may not have been given by reset (filter used on its own)
+    if (m_state.size() != channelCount * 2)
+        m_state.assign(channelCount * 2, 0.f);
+
+    if (m_needUpdate)
+        computeCoefficients();
+
+    priv::processBiquad(&samples[0], samples.size() / channelCount, channelCount, m_coefficients, &m_state[0]);
+}
+
+
+////////////////////////////////////////////////////////////
+void BiquadFilter::computeCoefficients()
+{
+    if (m_sampleRate == 0)
+        return;
+
+    m_needUpdate = false;
+
+    // Keep the frequency within the valid range (below the Nyquist frequency)
+    double frequency = m_frequency;
+    if (frequency < 1.0)
+        frequency = 1.0;
+    else if (frequency > m_sampleRate * 0.49)
+        frequency = m_sampleRate * 0.49;
+    double q = m_q > 0.01f ? m_q : 0.01;
+
+    // Formulas from the "Cookbook formulae for audio EQ biquad filter coefficients", by Robert Bristow-Johnson
+    double omega      = 2.0 * pi * frequency / m_sampleRate;
+    double cosine     = std::cos(omega);
+    double alpha      = std::sin(omega) / (2.0 * q);
+    double amplitude  = std::pow(10.0, m_gain / 40.0);
+    double shelfAlpha = 2.0 * std::sqrt(amplitude) * alpha;
+
+    double b0, b1, b2, a0, a1, a2;
+    switch (m_type)
+    {
+        default :
+        case LowPass :
+            b0 = (1.0 - cosine) / 2.0;
+            b1 = 1.0 - cosine;
+            b2 = (1.0 - cosine) / 2.0;
+            a0 = 1.0 + alpha;
+            a1 = -2.0 * cosine;
+            a2 = 1.0 - alpha;
+            break;
+
+        case HighPass :
+            b0 = (1.0 + cosine) / 2.0;
+            b1 = -(1.0 + cosine);
+            b2 = (1.0 + cosine) / 2.0;
+            a0 = 1.0 + alpha;
+            a1 = -2.0 * cosine;
+            a2 = 1.0 - alpha;
+            break;
+
+        case BandPass :
+            b0 = alpha;
+            b1 = 0.0;
+            b2 = -alpha;
+            a0 = 1.0 + alpha;
+            a1 = -2.0 * cosine;
+            a2 = 1.0 - alpha;
+            break;
+
+        case Notch :
+            b0 = 1.0;
+            b1 = -2.0 * cosine;
+            b2 = 1.0;
+            a0 = 1.0 + alpha;
+            a1 = -2.0 * cosine;
+            a2 = 1.0 - alpha;
+            break;
+
+        case Peak :
+            b0 = 1.0 + alpha * amplitude;
+            b1 = -2.0 * cosine;
+            b2 = 1.0 - alpha * amplitude;
+            a0 = 1.0 + alpha / amplitude;
+            a1 = -2.0 * cosine;
+            a2 = 1.0 - alpha / amplitude;
+            break;
+
+        case LowShelf :
+            b0 = amplitude * ((amplitude + 1.0) - (amplitude - 1.0) * cosine + shelfAlpha);
+            b1 = 2.0 * amplitude * ((amplitude - 1.0) - (amplitude + 1.0) * cosine);
+            b2 = amplitude * ((amplitude + 1.0) - (amplitude - 1.0) * cosine - shelfAlpha);
+            a0 = (amplitude + 1.0) + (amplitude - 1.0) * cosine + shelfAlpha;
+            a1 = -2.0 * ((amplitude - 1.0) + (amplitude + 1.0) * cosine);
+            a2 = (amplitude + 1.0) + (amplitude - 1.0) * cosine - shelfAlpha;
+            break;
+
+        case HighShelf :
+            b0 = amplitude * ((amplitude + 1.0) + (amplitude - 1.0) * cosine + shelfAlpha);
+            b1 = -2.0 * amplitude * ((amplitude - 1.0) + (amplitude + 1.0) * cosine);
+            b2 = amplitude * ((amplitude + 1.0) + (amplitude - 1.0) * cosine - shelfAlpha);
+            a0 = (amplitude + 1.0) - (amplitude - 1.0) * cosine + shelfAlpha;
+            a1 = 2.0 * ((amplitude - 1.0) - (amplitude + 1.0) * cosine);
+            a2 = (amplitude + 1.0) - (amplitude - 1.0) * cosine - shelfAlpha;
+            break;
+    }
+
+    // Normalize the coefficients so that a0 is 1
+    m_coefficients[0] = static_cast<float>(b0 / a0);
+    m_coefficients[1] = static_cast<float>(b1 / a0);
+    m_coefficients[2] = static_cast<float>(b2 / a0);
+    m_coefficients[3] = static_cast<float>(a1 / a0);
+    m_coefficients[4] = static_cast<float>(a2 / a0);
+}
+
+} // namespace sf
@@ -0,0 +1,232 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2014 Laurent Gomila (laurent.gom@gmail.com)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Audio/CompressorEffect.hpp>
+#include <SFML/Audio/EffectKernels.hpp>
+#include <SFML/System/Lock.hpp>
+#include <algorithm>
+#include <cmath>
+
+
+namespace
+{
+    // Number of frames between two computations of the gain;
+    // the gain is interpolated linearly in between
+    const std::size_t controlInterval = 32;
+
+    // Convert decibels to a linear gain
+    float fromDecibels(float decibels)
+    {
+        return std::pow(10.f, decibels / 20.f);
+    }
+
+    // Get the coefficient of a one-pole smoothing filter from its time constant
+    float getSmoothingCoefficient(sf::Time time, unsigned int sampleRate)
+    {
+        float samples = time.asSeconds() * sampleRate;
+        return samples > 1.f ? std::exp(-1.f / samples) : 0.f;
+    }
+}
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+CompressorEffect::CompressorEffect() :
+m_threshold    (-20.f),
+m_ratio        (4.f),
+m_attack       (milliseconds(10)),
+m_release      (milliseconds(100)),
+m_makeupGain   (0.f),
+m_sampleRate   (44100),
+m_envelope     (0.f),
+m_gain         (1.f),
+m_gainReduction(0.f)
+{
+
+}
+
+
+////////////////////////////////////////////////////////////
+void CompressorEffect::setThreshold(float threshold)
+{
+    Lock lock(m_mutex);
+
+    m_threshold = threshold;
+}
+
+
+////////////////////////////////////////////////////////////
+void CompressorEffect::setRatio(float ratio)
+{
+    Lock lock(m_mutex);
+
+    m_ratio = std::max(ratio, 1.f);
+}
+
+
+////////////////////////////////////////////////////////////
+void CompressorEffect::setAttack(Time attack)
+{
+    Lock lock(m_mutex);
+
+    m_attack = attack;
+}
+
+
+////////////////////////////////////////////////////////////
+void CompressorEffect::setRelease(Time release)
+{
+    Lock lock(m_mutex);
+
+    m_release = release;
+}
+
+
+////////////////////////////////////////////////////////////
+void CompressorEffect::setMakeupGain(float gain)
+{
+    Lock lock(m_mutex);
+
+    m_makeupGain = gain;
+}
+
+
+////////////////////////////////////////////////////////////
+float CompressorEffect::getThreshold() const
+{
+    Lock lock(m_mutex);
+
+    return m_threshold;
+}
+
+
+////////////////////////////////////////////////////////////
+float CompressorEffect::getRatio() const
+{
+    Lock lock(m_mutex);
+
+    return m_ratio;
+}
+
+
+////////////////////////////////////////////////////////////
+Time CompressorEffect::getAttack() const
+{
+    Lock lock(m_mutex);
+
+    return m_attack;
+}
+
+
+////////////////////////////////////////////////////////////
+Time CompressorEffect::getRelease() const
+{
+    Lock lock(m_mutex);
+
+    return m_release;
+}
+
+
+////////////////////////////////////////////////////////////
+float CompressorEffect::getMakeupGain() const
+{
+    Lock lock(m_mutex);
+
+    return m_makeupGain;
+}
+
+
+////////////////////////////////////////////////////////////
+float CompressorEffect::getGainReduction() const
+{
+    Lock lock(m_mutex);
+
+    return m_gainReduction;
+}
+
+
+////////////////////////////////////////////////////////////
+void CompressorEffect::reset(unsigned int, unsigned int sampleRate)
+{
+    Lock lock(m_mutex);
+
+    m_sampleRate    = sampleRate;
+    m_envelope      = 0.f;
+    m_gain          = fromDecibels(m_makeupGain);
+    m_gainReduction = 0.f;
+}
+
+
+////////////////////////////////////////////////////////////
+void CompressorEffect::process(std::vector<float>& samples, unsigned int channelCount)
+{
+    Lock lock(m_mutex);
+
+    if (samples.empty() || (channelCount == 0))
+        return;
+
+    const float attack    = getSmoothingCoefficient(m_attack, m_sampleRate);
+    const float release   = getSmoothingCoefficient(m_release, m_sampleRate);
+    const float threshold = fromDecibels(m_threshold);
+    const float slope     = 1.f - 1.f / m_ratio;
+    const float makeup    = fromDecibels(m_makeupGain);
+
+    std::size_t frameCount = samples.size() / channelCount;
+    float* data = &samples[0];
+    for (std::size_t start = 0; start < frameCount; start += controlInterval)
+    {
+        std::size_t count = std::min(controlInterval, frameCount - start);
+        float* block = data + start * channelCount;
+
+        // Follow the level of the loudest channel
+        const float* sample = block;
+        for (std::size_t frame = 0; frame < count; ++frame)
+        {
+            float peak = 0.f;
+            for (unsigned int channel = 0; channel < channelCount; ++channel)
+                peak = std::max(peak, std::fabs(*sample++));
+
+            float coefficient = peak > m_envelope ? attack : release;
+            m_envelope = peak + coefficient * (m_envelope - peak);
+        }
+
+        // Compute the gain at the end of this block, above the threshold
+        // the level is reduced by (level - threshold) * (1 - 1 / ratio) dB
+        float reduction = 0.f;
+        if (m_envelope > threshold)
+            reduction = 20.f * std::log10(m_envelope / threshold) * slope;
+        float gain = makeup * fromDecibels(-reduction);
+
+        // Apply it, interpolated from the previous one
+        priv::applyGainRamp(block, count, channelCount, m_gain, gain);
+        m_gain = gain;
+        m_gainReduction = reduction;
+    }
+}
+
+} // namespace sf
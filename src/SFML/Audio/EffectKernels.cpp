@@ -0,0 +1,210 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2014 Laurent Gomila (laurent.gom@gmail.com)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Audio/EffectKernels.hpp>
+#include <cmath>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+    #include <emmintrin.h>
+    #define SFML_EFFECTS_SSE2
+#endif
+
+
+namespace
+{
+    // Filter states below this magnitude are flushed to zero, so that a
+    // decaying filter doesn't end up computing with (very slow) denormals
+    const float denormalThreshold = 1e-15f;
+
+    // Flush a filter state to zero if it has become negligible
+    float flushDenormal(float value)
+    {
+        return std::fabs(value) < denormalThreshold ? 0.f : value;
+    }
+}
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+void applyGain(float* samples, std::size_t count, float gain)
+{
+    std::size_t i = 0;
+
+#ifdef SFML_EFFECTS_SSE2
+
+    const __m128 factor = _mm_set1_ps(gain);
+    for (; i + 8 <= count; i += 8)
+    {
+        _mm_storeu_ps(samples + i,     _mm_mul_ps(_mm_loadu_ps(samples + i),     factor));
+        _mm_storeu_ps(samples + i + 4, _mm_mul_ps(_mm_loadu_ps(samples + i + 4), factor));
+    }
+
+#endif
+
+    for (; i < count; ++i)
+        samples[i] *= gain;
+}
+
+
+////////////////////////////////////////////////////////////
+void applyGainRamp(float* samples, std::size_t frameCount, unsigned int channelCount, float startGain, float endGain)
+{
+    if (frameCount == 0)
+        return;
+
+    // The gain changes once per frame, so that all the channels stay balanced
+    float step = (endGain - startGain) / frameCount;
+    float gain = startGain;
+    for (std::size_t frame = 0; frame < frameCount; ++frame)
+    {
+        for (unsigned int channel = 0; channel < channelCount; ++channel)
+            *samples++ *= gain;
+        gain += step;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void mixSamples(float* output, const float* input, std::size_t count, float gain)
+{
+    std::size_t i = 0;
+
+#ifdef SFML_EFFECTS_SSE2
+
+    const __m128 factor = _mm_set1_ps(gain);
+    for (; i + 8 <= count; i += 8)
+    {
+        __m128 first  = _mm_add_ps(_mm_loadu_ps(output + i),     _mm_mul_ps(_mm_loadu_ps(input + i),     factor));
+        __m128 second = _mm_add_ps(_mm_loadu_ps(output + i + 4), _mm_mul_ps(_mm_loadu_ps(input + i + 4), factor));
+        _mm_storeu_ps(output + i,     first);
+        _mm_storeu_ps(output + i + 4, second);
+    }
+
+#endif
+
+    for (; i < count; ++i)
+        output[i] += input[i] * gain;
+}
+
+
+////////////////////////////////////////////////////////////
+void processBiquad(float* samples, std::size_t frameCount, unsigned int channelCount, const float* coefficients, float* state)
+{
+    const float b0 = coefficients[0];
+    const float b1 = coefficients[1];
+    const float b2 = coefficients[2];
+    const float a1 = coefficients[3];
+    const float a2 = coefficients[4];
+
+    float* z1 = state;
+    float* z2 = state + channelCount;
+
+    unsigned int channel = 0;
+
+#ifdef SFML_EFFECTS_SSE2
+
+    // The filter is recursive in time, so the channels are what can run in
+    // parallel: each lane of the SSE registers handles its own channel
+    const __m128 vb0 = _mm_set1_ps(b0);
+    const __m128 vb1 = _mm_set1_ps(b1);
+    const __m128 vb2 = _mm_set1_ps(b2);
+    const __m128 va1 = _mm_set1_ps(a1);
+    const __m128 va2 = _mm_set1_ps(a2);
+
+    // Groups of 4 channels
+    for (; channel + 4 <= channelCount; channel += 4)
+    {
+        __m128 s1 = _mm_loadu_ps(z1 + channel);
+        __m128 s2 = _mm_loadu_ps(z2 + channel);
+
+        float* sample = samples + channel;
+        for (std::size_t frame = 0; frame < frameCount; ++frame, sample += channelCount)
+        {
+            __m128 x = _mm_loadu_ps(sample);
+            __m128 y = _mm_add_ps(_mm_mul_ps(vb0, x), s1);
+            s1 = _mm_add_ps(_mm_sub_ps(_mm_mul_ps(vb1, x), _mm_mul_ps(va1, y)), s2);
+            s2 = _mm_sub_ps(_mm_mul_ps(vb2, x), _mm_mul_ps(va2, y));
+            _mm_storeu_ps(sample, y);
+        }
+
+        _mm_storeu_ps(z1 + channel, s1);
+        _mm_storeu_ps(z2 + channel, s2);
+    }
+
+    // Pairs of channels (typically, stereo), using the 2 lower lanes only
+    for (; channel + 2 <= channelCount; channel += 2)
+    {
+        __m128 s1 = _mm_loadl_pi(_mm_setzero_ps(), reinterpret_cast<const __m64*>(z1 + channel));
+        __m128 s2 = _mm_loadl_pi(_mm_setzero_ps(), reinterpret_cast<const __m64*>(z2 + channel));
+
+        float* sample = samples + channel;
+        for (std::size_t frame = 0; frame < frameCount; ++frame, sample += channelCount)
+        {
+            __m128 x = _mm_loadl_pi(_mm_setzero_ps(), reinterpret_cast<const __m64*>(sample));
+            __m128 y = _mm_add_ps(_mm_mul_ps(vb0, x), s1);
+            s1 = _mm_add_ps(_mm_sub_ps(_mm_mul_ps(vb1, x), _mm_mul_ps(va1, y)), s2);
+            s2 = _mm_sub_ps(_mm_mul_ps(vb2, x), _mm_mul_ps(va2, y));
+            _mm_storel_pi(reinterpret_cast<__m64*>(sample), y);
+        }
+
+        _mm_storel_pi(reinterpret_cast<__m64*>(z1 + channel), s1);
+        _mm_storel_pi(reinterpret_cast<__m64*>(z2 + channel), s2);
+    }
+
+#endif
+
+    // Remaining channels, one at a time
+    for (; channel < channelCount; ++channel)
+    {
+        float s1 = z1[channel];
+        float s2 = z2[channel];
+
+        float* sample = samples + channel;
+        for (std::size_t frame = 0; frame < frameCount; ++frame, sample += channelCount)
+        {
+            float x = *sample;
+            float y = b0 * x + s1;
+            s1 = b1 * x - a1 * y + s2;
+            s2 = b2 * x - a2 * y;
+            *sample = y;
+        }
+
+        z1[channel] = s1;
+        z2[channel] = s2;
+    }
+
+    // Don't let the filter decay into denormals
+    for (unsigned int i = 0; i < channelCount * 2; ++i)
+        state[i] = flushDenormal(state[i]);
+}
+
+} // namespace priv
+
+} // namespace sf
@@ -0,0 +1,93 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2014 Laurent Gomila (laurent.gom@gmail.com)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_EFFECTKERNELS_HPP
+#define SFML_EFFECTKERNELS_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Config.hpp>
+#include <cstdlib>
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+/// Multiply samples by a constant gain
+///
+/// \param samples Array of samples to process in place
+/// \param count   Number of samples
+/// \param gain    Gain to apply
+///
+////////////////////////////////////////////////////////////
+void applyGain(float* samples, std::size_t count, float gain);
+
+////////////////////////////////////////////////////////////
+/// Multiply samples by a gain that changes linearly
+///
+/// \param samples      Array of interleaved samples to process in place
+/// \param frameCount   Number of frames (samples per channel)
+/// \param channelCount Number of channels
+/// \param startGain    Gain applied to the first frame
+/// \param endGain      Gain reached after the last frame
+///
+////////////////////////////////////////////////////////////
+void applyGainRamp(float* samples, std::size_t frameCount, unsigned int channelCount, float startGain, float endGain);
+
+////////////////////////////////////////////////////////////
+/// Add samples multiplied by a gain to other samples
+///
+/// \param output Array of samples to add to
+/// \param input  Array of samples to add
+/// \param count  Number of samples
+/// \param gain   Gain applied to the input samples
+///
+////////////////////////////////////////////////////////////
+void mixSamples(float* output, const float* input, std::size_t count, float gain);
+
+////////////////////////////////////////////////////////////
+/// Run a biquad filter over interleaved samples
+///
+/// The filter is computed in transposed direct form II,
+/// independently for each channel.
+///
+/// \param samples      Array of interleaved samples to filter in place
+/// \param frameCount   Number of frames (samples per channel)
+/// \param channelCount Number of channels
+/// \param coefficients Normalized coefficients of the filter: b0, b1, b2, a1, a2
+/// \param state        State of the filter: 2 * channelCount values, the
+///                     first delay of every channel followed by the second ones
+///
+////////////////////////////////////////////////////////////
+void processBiquad(float* samples, std::size_t frameCount, unsigned int channelCount, const float* coefficients, float* state);
+
+} // namespace priv
+
+} // namespace sf
+
+
+#endif // SFML_EFFECTKERNELS_HPP
@@ -0,0 +1,92 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2014 Laurent Gomila (laurent.gom@gmail.com)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Audio/GainEffect.hpp>
+#include <SFML/Audio/EffectKernels.hpp>
+#include <SFML/System/Lock.hpp>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+GainEffect::GainEffect(float gain) :
+m_gain       (gain),
+m_currentGain(gain)
+{
+
+}
+
+
+////////////////////////////////////////////////////////////
+void GainEffect::setGain(float gain)
+{
+    Lock lock(m_mutex);
+
+    m_gain = gain;
+}
+
+
+////////////////////////////////////////////////////////////
+float GainEffect::getGain() const
+{
+    Lock lock(m_mutex);
+
+    return m_gain;
+}
+
+
+////////////////////////////////////////////////////////////
+void GainEffect::reset(unsigned int, unsigned int)
+{
+    Lock lock(m_mutex);
+
+    // No need to smooth the gain when the stream (re)starts
+    m_currentGain = m_gain;
+}
+
+
+////////////////////////////////////////////////////////////
+void GainEffect::process(std::vector<float>& samples, unsigned int channelCount)
+{
+    Lock lock(m_mutex);
+
+    if (samples.empty() || (channelCount == 0))
+        return;
+
+    if (m_currentGain != m_gain)
+    {
+        // Ramp to the new gain over the whole block
+        priv::applyGainRamp(&samples[0], samples.size() / channelCount, channelCount, m_currentGain, m_gain);
+        m_currentGain = m_gain;
+    }
+    else if (m_gain != 1.f)
+    {
+        priv::applyGain(&samples[0], samples.size(), m_gain);
+    }
+}
+
+} // namespace sf
@@ -0,0 +1,199 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2014 Laurent Gomila (laurent.gom@gmail.com)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Audio/ImaAdpcmCodec.hpp>
+
+
+namespace
+{
+    // Quantizer step sizes of IMA-ADPCM
+    const int stepTable[89] =
+    {
+        7, 8, 9, 10, 11, 12, 13, 14, 16, 17, 19, 21, 23, 25, 28, 31, 34, 37, 41, 45,
+        50, 55, 60, 66, 73, 80, 88, 97, 107, 118, 130, 143, 157, 173, 190, 209, 230,
+        253, 279, 307, 337, 371, 408, 449, 494, 544, 598, 658, 724, 796, 876, 963,
+        1060, 1166, 1282, 1411, 1552, 1707, 1878, 2066, 2272, 2499, 2749, 3024, 3327,
+        3660, 4026, 4428, 4871, 5358, 5894, 6484, 7132, 7845, 8630, 9493, 10442, 11487,
+        12635, 13899, 15289, 16818, 18500, 20350, 22385, 24623, 27086, 29794, 32767
+    };
+
+    // Adjustment of the step index for each 4-bits code
+    const int indexTable[16] = {-1, -1, -1, -1, 2, 4, 6, 8, -1, -1, -1, -1, 2, 4, 6, 8};
+
+    // Size of the frame header (number of samples per channel) and of the header of each channel
+    const std::size_t frameHeaderSize   = 2;
+    const std::size_t channelHeaderSize = 4;
+
+    // State of the predictor of a channel
+    struct Predictor
+    {
+        int sample;
+        int index;
+
+        // Apply a 4-bits code to the predictor
+        void update(int code)
+        {
+            int step = stepTable[index];
+            int delta = step >> 3;
+            if (code & 4) delta += step;
+            if (code & 2) delta += step >> 1;
+            if (code & 1) delta += step >> 2;
+
+            sample += (code & 8) ? -delta : delta;
+            sample = sample < -32768 ? -32768 : (sample > 32767 ? 32767 : sample);
+
+            index += indexTable[code];
+            index = index < 0 ? 0 : (index > 88 ? 88 : index);
+        }
+
+        // Find the 4-bits code that brings the predictor closest to a sample, and apply it
+        int encode(int target)
+        {
+            int step = stepTable[index];
+            int difference = target - sample;
+            int code = 0;
+            if (difference < 0)
+            {
+                code = 8;
+                difference = -difference;
+            }
+
+            if (difference >= step)        {code |= 4; difference -= step;}
+            if (difference >= (step >> 1)) {code |= 2; difference -= step >> 1;}
+            if (difference >= (step >> 2)) {code |= 1;}
+
+            update(code);
+
+            return code;
+        }
+    };
+}
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+ImaAdpcmCodec::ImaAdpcmCodec()
+{
+
+}
+
+
+////////////////////////////////////////////////////////////
+void ImaAdpcmCodec::reset(unsigned int channelCount, unsigned int)
+{
+    m_stepIndices.assign(channelCount, 0);
+}
+
+
+////////////////////////////////////////////////////////////
+bool ImaAdpcmCodec::encode(const Int16* samples, std::size_t sampleCount, unsigned int channelCount, std::vector<Uint8>& data)
+{
+    std::size_t frameCount = channelCount > 0 ? sampleCount / channelCount : 0;
+    if ((frameCount == 0) || (frameCount > 0xFFFF))
+        return false;
+
+    if (m_stepIndices.size() != channelCount)
+        m_stepIndices.assign(channelCount, 0);
+
+    // The first sample of each channel is stored in the header, the others take 4 bits each
+    std::size_t codeCount = (frameCount - 1) * channelCount;
+    data.assign(frameHeaderSize + channelCount * channelHeaderSize + (codeCount + 1) / 2, 0);
+
+    data[0] = static_cast<Uint8>(frameCount & 0xFF);
+    data[1] = static_cast<Uint8>(frameCount >> 8);
+
+    std::vector<Predictor> predictors(channelCount);
+    for (unsigned int channel = 0; channel < channelCount; ++channel)
+    {
+        // Start from the step index reached by the previous frame, for a smooth transition
+        Predictor& predictor = predictors[channel];
+        predictor.sample = samples[channel];
+        predictor.index  = m_stepIndices[channel];
+
+        Uint8* header = &data[frameHeaderSize + channel * channelHeaderSize];
+        header[0] = static_cast<Uint8>(predictor.sample & 0xFF);
+        header[1] = static_cast<Uint8>((predictor.sample >> 8) & 0xFF);
+        header[2] = static_cast<Uint8>(predictor.index);
+    }
+
+    // Encode the remaining samples, two codes per byte (low nibble first)
+    Uint8* codes = &data[frameHeaderSize + channelCount * channelHeaderSize];
+    for (std::size_t i = 0; i < codeCount; ++i)
+    {
+        int code = predictors[i % channelCount].encode(samples[channelCount + i]);
+        codes[i / 2] |= static_cast<Uint8>((i % 2) ? code << 4 : code);
+    }
+
+    for (unsigned int channel = 0; channel < channelCount; ++channel)
+        m_stepIndices[channel] = predictors[channel].index;
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+bool ImaAdpcmCodec::decode(const void* data, std::size_t size, unsigned int channelCount, std::vector<Int16>& samples)
+{
+    const Uint8* bytes = static_cast<const Uint8*>(data);
+    std::size_t headerSize = frameHeaderSize + channelCount * channelHeaderSize;
+    if ((channelCount == 0) || (size < headerSize))
+        return false;
+
+    std::size_t frameCount = bytes[0] | (bytes[1] << 8);
+    std::size_t codeCount = frameCount > 0 ? (frameCount - 1) * channelCount : 0;
+    if ((frameCount == 0) || (size < headerSize + (codeCount + 1) / 2))
+        return false;
+
+    samples.resize(frameCount * channelCount);
+
+    // Read the initial state of each channel
+    std::vector<Predictor> predictors(channelCount);
+    for (unsigned int channel = 0; channel < channelCount; ++channel)
+    {
+        const Uint8* header = bytes + frameHeaderSize + channel * channelHeaderSize;
+        Predictor& predictor = predictors[channel];
+        predictor.sample = static_cast<Int16>(header[0] | (header[1] << 8));
+        predictor.index  = header[2] > 88 ? 88 : header[2];
+
+        samples[channel] = static_cast<Int16>(predictor.sample);
+    }
+
+    // Decode the remaining samples
+    const Uint8* codes = bytes + headerSize;
+    for (std::size_t i = 0; i < codeCount; ++i)
+    {
+        int code = (i % 2) ? codes[i / 2] >> 4 : codes[i / 2] & 0x0F;
+        Predictor& predictor = predictors[i % channelCount];
+        predictor.update(code);
+        samples[channelCount + i] = static_cast<Int16>(predictor.sample);
+    }
+
+    return true;
+}
+
+} // namespace sf
@@ -26,6 +26,7 @@
 // Headers
 ////////////////////////////////////////////////////////////
 #include <SFML/Audio/Listener.hpp>
+#include <SFML/Audio/AudioDevice.hpp>
 #include <SFML/Audio/ALCheck.hpp>
 
 
@@ -142,4 +143,27 @@ Vector3f Listener::getUpVector()
     return listenerUpVector;
 }
 
+
+////////////////////////////////////////////////////////////
+void Listener::setDeferredUpdates(bool deferred)
+{
+    priv::AudioDevice::setDeferredUpdates(deferred);
+}
+
+
+////////////////////////////////////////////////////////////
+bool Listener::isDeferringUpdates()
+{
+    return priv::AudioDevice::isDeferringUpdates();
+}
+
+
+////////////////////////////////////////////////////////////
+void Listener::commitUpdates()
+{
+    priv::ensureALInit();
+
+    priv::AudioDevice::commitUpdates();
+}
+
 } // namespace sf
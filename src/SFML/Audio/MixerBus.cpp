@@ -0,0 +1,148 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2014 Laurent Gomila (laurent.gom@gmail.com)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Audio/MixerBus.hpp>
+#include <SFML/Audio/EffectKernels.hpp>
+#include <SFML/System/Lock.hpp>
+#include <algorithm>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+MixerBus::MixerBus() :
+m_dryGain     (1.f),
+m_channelCount(0),
+m_sampleRate  (0)
+{
+
+}
+
+
+////////////////////////////////////////////////////////////
+void MixerBus::add(SoundEffect& effect, float gain)
+{
+    Lock lock(m_mutex);
+
+    // If the bus is already running, bring the new effect up to date
+    if (m_channelCount > 0)
+        effect.reset(m_channelCount, m_sampleRate);
+
+    Branch branch = {&effect, gain};
+    m_branches.push_back(branch);
+}
+
+
+////////////////////////////////////////////////////////////
+void MixerBus::remove(SoundEffect& effect)
+{
+    Lock lock(m_mutex);
+
+    for (std::vector<Branch>::iterator it = m_branches.begin(); it != m_branches.end(); ++it)
+    {
+        if (it->effect == &effect)
+        {
+            m_branches.erase(it);
+            break;
+        }
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void MixerBus::setGain(SoundEffect& effect, float gain)
+{
+    Lock lock(m_mutex);
+
+    for (std::vector<Branch>::iterator it = m_branches.begin(); it != m_branches.end(); ++it)
+    {
+        if (it->effect == &effect)
+            it->gain = gain;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void MixerBus::setDryGain(float gain)
+{
+    Lock lock(m_mutex);
+
+    m_dryGain = gain;
+}
+
+
+////////////////////////////////////////////////////////////
+float MixerBus::getDryGain() const
+{
+    Lock lock(m_mutex);
+
+    return m_dryGain;
+}
+
+
+////////////////////////////////////////////////////////////
+void MixerBus::reset(unsigned int channelCount, unsigned int sampleRate)
+{
+    Lock lock(m_mutex);
+
+    m_channelCount = channelCount;
+    m_sampleRate   = sampleRate;
+
+    for (std::vector<Branch>::iterator it = m_branches.begin(); it != m_branches.end(); ++it)
+        it->effect->reset(channelCount, sampleRate);
+}
+
+
+////////////////////////////////////////////////////////////
+void MixerBus::process(std::vector<float>& samples, unsigned int channelCount)
+{
+    Lock lock(m_mutex);
+
+    if (samples.empty() || m_branches.empty())
+    {
+        if (!samples.empty() && (m_dryGain != 1.f))
+            priv::applyGain(&samples[0], samples.size(), m_dryGain);
+        return;
+    }
+
+    // Keep the input, the output block starts with the dry signal
+    m_input.assign(samples.begin(), samples.end());
+    priv::applyGain(&samples[0], samples.size(), m_dryGain);
+
+    // Run every branch on its own copy of the input, and mix its output
+    for (std::vector<Branch>::iterator it = m_branches.begin(); it != m_branches.end(); ++it)
+    {
+        m_branch.assign(m_input.begin(), m_input.end());
+        it->effect->process(m_branch, channelCount);
+
+        std::size_t count = std::min(m_branch.size(), samples.size());
+        if (count > 0)
+            priv::mixSamples(&samples[0], &m_branch[0], count, it->gain);
+    }
+}
+
+} // namespace sf
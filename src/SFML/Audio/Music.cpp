@@ -28,17 +28,28 @@
 #include <SFML/Audio/Music.hpp>
 #include <SFML/Audio/ALCheck.hpp>
 #include <SFML/Audio/SoundFile.hpp>
+#include <SFML/Audio/SampleConversion.hpp>
+#include <SFML/Audio/StreamCache.hpp>
 #include <SFML/System/Lock.hpp>
 #include <SFML/System/Err.hpp>
+#include <algorithm>
 #include <fstream>
+#include <sstream>
 
 
 namespace sf
 {
 ////////////////////////////////////////////////////////////
 Music::Music() :
-m_file    (new priv::SoundFile),
-m_duration()
+m_file        (new priv::SoundFile),
+m_duration    (),
+m_position    (0),
+m_filePosition(0),
+m_loopStart   (0),
+m_loopEnd     (0),
+m_playCache   (false),
+m_cache       (NULL),
+m_blockIndex  (0)
 {
 
 }
@@ -67,6 +78,9 @@ bool Music::openFromFile(const std::string& filename)
     // Perform common initializations
     initialize();
 
+    // Musics opened from the same file share their decoded samples
+    m_source = "file:" + filename;
+
     return true;
 }
 
@@ -84,6 +98,11 @@ bool Music::openFromMemory(const void* data, std::size_t sizeInBytes)
     // Perform common initializations
     initialize();
 
+    // Musics opened from the same data share their decoded samples
+    std::ostringstream source;
+    source << "memory:" << data << ":" << sizeInBytes;
+    m_source = source.str();
+
     return true;
 }
 
@@ -112,17 +131,105 @@ Time Music::getDuration() const
 }
 
 
+////////////////////////////////////////////////////////////
+void Music::setCache(StreamCache* cache)
+{
+    Lock lock(m_mutex);
+
+    m_cache = cache;
+    m_block.clear();
+}
+
+
+////////////////////////////////////////////////////////////
+StreamCache* Music::getCache() const
+{
+    return m_cache;
+}
+
+
+////////////////////////////////////////////////////////////
+void Music::setLoopPoints(Uint64 loopStart, Uint64 loopEnd)
+{
+    Lock lock(m_mutex);
+
+    unsigned int channelCount = m_file->getChannelCount();
+    if (channelCount == 0)
+    {
+        err() << "Failed to set the loop points of the music: no music is open" << std::endl;
+        return;
+    }
+
+    // The loop can't go past the end of the file
+    Uint64 frameCount = m_file->getSampleCount() / channelCount;
+    loopEnd = std::min(loopEnd, frameCount);
+    if (loopStart >= loopEnd)
+    {
+        err() << "Failed to set the loop points of the music: the loop is empty (start = " << loopStart
+              << ", end = " << loopEnd << ")" << std::endl;
+        return;
+    }
+
+    m_loopStart = loopStart;
+    m_loopEnd   = loopEnd;
+
+    // Decode the beginning of the loop in advance, so that going back to it never delays the stream
+    std::size_t sampleCount = static_cast<std::size_t>(std::min<Uint64>(getChunkSampleCount(), (loopEnd - loopStart) * channelCount));
+    m_loopCache.resize(sampleCount);
+    m_loopCache.resize(decode(loopStart, NULL, &m_loopCache[0], sampleCount) / channelCount * channelCount);
+    m_playCache = false;
+}
+
+
+////////////////////////////////////////////////////////////
+Uint64 Music::getLoopStart() const
+{
+    return m_loopStart;
+}
+
+
+////////////////////////////////////////////////////////////
+Uint64 Music::getLoopEnd() const
+{
+    return m_loopEnd;
+}
+
+
 ////////////////////////////////////////////////////////////
 bool Music::onGetData(SoundStream::Chunk& data)
 {
     Lock lock(m_mutex);
 
+    // Follow the buffer duration, which may have changed since the file was opened
+    std::size_t sampleCount = getChunkSampleCount();
+    if (sampleCount != m_samples.size())
+        m_samples.resize(sampleCount);
+
     // Fill the chunk parameters
+    bool hasMoreData = true;
     data.samples     = &m_samples[0];
-    data.sampleCount = m_file->read(&m_samples[0], m_samples.size());
+    data.sampleCount = readSamples(&m_samples[0], NULL, m_samples.size(), hasMoreData);
+
+    return hasMoreData;
+}
+
+
+////////////////////////////////////////////////////////////
+bool Music::onGetData(SoundStream::FloatChunk& data)
+{
+    Lock lock(m_mutex);
+
+    // Follow the buffer duration, which may have changed since the file was opened
+    std::size_t sampleCount = getChunkSampleCount();
+    if (sampleCount != m_floatSamples.size())
+        m_floatSamples.resize(sampleCount);
+
+    // Fill the chunk parameters
+    bool hasMoreData = true;
+    data.samples     = &m_floatSamples[0];
+    data.sampleCount = readSamples(NULL, &m_floatSamples[0], m_floatSamples.size(), hasMoreData);
 
-    // Check if we have reached the end of the audio file
-    return data.sampleCount == m_samples.size();
+    return hasMoreData;
 }
 
 
@@ -131,7 +238,25 @@ void Music::onSeek(Time timeOffset)
 {
     Lock lock(m_mutex);
 
-    m_file->seek(timeOffset);
+    // Round to the nearest sample, like SoundStream does for the playing position
+    Uint64 frameCount = m_file->getSampleCount() / m_file->getChannelCount();
+    Uint64 frame = (static_cast<Uint64>(std::max(timeOffset, Time::Zero).asMicroseconds()) * m_file->getSampleRate() + 500000) / 1000000;
+
+    m_position  = std::min(frame, frameCount);
+    m_playCache = false;
+}
+
+
+////////////////////////////////////////////////////////////
+Int64 Music::onLoop()
+{
+    Lock lock(m_mutex);
+
+    // Jump to the beginning of the loop; its first samples were decoded in advance
+    m_position  = m_loopStart;
+    m_playCache = !m_loopCache.empty();
+
+    return static_cast<Int64>(m_loopStart * m_file->getChannelCount());
 }
 
 
@@ -141,11 +266,165 @@ void Music::initialize()
     // Compute the music duration
     m_duration = seconds(static_cast<float>(m_file->getSampleCount()) / m_file->getSampleRate() / m_file->getChannelCount());
 
-    // Resize the internal buffer so that it can contain 1 second of audio samples
-    m_samples.resize(m_file->getSampleRate() * m_file->getChannelCount());
+    // The file was just opened: nothing is decoded yet
+    m_filePosition = 0;
+    m_source.clear();
+    m_block.clear();
+
+    // By default, the whole music loops
+    m_position  = 0;
+    m_loopStart = 0;
+    m_loopEnd   = m_file->getSampleCount() / m_file->getChannelCount();
+    m_loopCache.clear();
+    m_playCache = false;
+
+    // Read floating point samples if 16 bits integers would lose precision
+    bool floatSamples = m_file->hasExtendedPrecision();
+    setFloatSamples(floatSamples);
+
+    // Resize the internal buffer so that it can contain one stream buffer of audio samples
+    if (floatSamples)
+    {
+        m_samples.clear();
+        m_floatSamples.resize(getChunkSampleCount());
+    }
+    else
+    {
+        m_floatSamples.clear();
+        m_samples.resize(getChunkSampleCount());
+    }
 
     // Initialize the stream
     SoundStream::initialize(m_file->getChannelCount(), m_file->getSampleRate());
 }
 
+
+////////////////////////////////////////////////////////////
+std::size_t Music::getChunkSampleCount() const
+{
+    std::size_t sampleCount = static_cast<std::size_t>(getBufferDuration().asSeconds() * m_file->getSampleRate()) * m_file->getChannelCount();
+
+    return sampleCount > 0 ? sampleCount : m_file->getChannelCount();
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t Music::readSamples(Int16* samples, float* floatSamples, std::size_t sampleCount, bool& hasMoreData)
+{
+    unsigned int channelCount = m_file->getChannelCount();
+
+    // When looping, the end of the loop is the end of the music
+    // (unless it has already been passed, if looping was enabled late)
+    Uint64 end = m_file->getSampleCount() / channelCount;
+    if (getLoop() && (m_position < m_loopEnd))
+        end = m_loopEnd;
+
+    std::size_t count = 0;
+    bool truncated = false;
+    if (m_playCache)
+    {
+        // Beginning of the loop: copy the samples that were decoded in advance
+        count = std::min(m_loopCache.size(), sampleCount);
+        if (floatSamples)
+            std::copy(m_loopCache.begin(), m_loopCache.begin() + count, floatSamples);
+        else
+            priv::convertSamples(&m_loopCache[0], samples, count);
+
+        m_playCache = false;
+    }
+    else
+    {
+        // Read up to the end (of the music or of the loop)
+        std::size_t toRead = static_cast<std::size_t>(std::min<Uint64>(sampleCount, (end - std::min(m_position, end)) * channelCount));
+        if (toRead > 0)
+            count = decode(m_position, samples, floatSamples, toRead);
+        truncated = count < toRead;
+
+        // Keep the beginning of the loop, so that it never has to be decoded again
+        if ((m_position == m_loopStart) && m_loopCache.empty() && (count > 0))
+        {
+            if (floatSamples)
+            {
+                m_loopCache.assign(floatSamples, floatSamples + count);
+            }
+            else
+            {
+                m_loopCache.resize(count);
+                priv::convertSamples(samples, &m_loopCache[0], count);
+            }
+        }
+    }
+
+    m_position += count / channelCount;
+
+    // Check if we have reached the end of the audio file (or of the loop)
+    hasMoreData = !truncated && (m_position < end);
+
+    return count;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t Music::decode(Uint64 position, Int16* samples, float* floatSamples, std::size_t sampleCount)
+{
+    // Without a cache, decode the samples directly into the destination
+    if (!m_cache || m_source.empty())
+        return decodeFile(position, samples, floatSamples, sampleCount);
+
+    unsigned int channelCount = m_file->getChannelCount();
+    std::size_t blockSize = m_cache->getBlockSize();
+
+    std::size_t count = 0;
+    while (count < sampleCount)
+    {
+        // Get the block that contains the next sample, from the cache or from the file
+        Uint64 frame = position + count / channelCount;
+        Uint64 index = frame / blockSize;
+        if (m_block.empty() || (index != m_blockIndex))
+        {
+            m_blockIndex = index;
+            if (!m_cache->find(m_source, index, m_block))
+            {
+                m_block.resize(blockSize * channelCount);
+                m_block.resize(decodeFile(index * blockSize, NULL, &m_block[0], m_block.size()));
+                if (!m_block.empty())
+                    m_cache->insert(m_source, index, &m_block[0], m_block.size());
+            }
+        }
+
+        // Stop at the end of the file
+        std::size_t offset = static_cast<std::size_t>(frame - index * blockSize) * channelCount;
+        if (offset >= m_block.size())
+            break;
+
+        // Copy the samples of the block
+        std::size_t toCopy = std::min(sampleCount - count, m_block.size() - offset);
+        if (floatSamples)
+            std::copy(m_block.begin() + offset, m_block.begin() + offset + toCopy, floatSamples + count);
+        else
+            priv::convertSamples(&m_block[offset], samples + count, toCopy);
+
+        count += toCopy;
+    }
+
+    return count;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t Music::decodeFile(Uint64 position, Int16* samples, float* floatSamples, std::size_t sampleCount)
+{
+    // Seek only if the decoder is not already there
+    if (position != m_filePosition)
+    {
+        m_file->seek(position);
+        m_filePosition = position;
+    }
+
+    std::size_t count = floatSamples ? m_file->read(floatSamples, sampleCount) : m_file->read(samples, sampleCount);
+    m_filePosition += count / m_file->getChannelCount();
+
+    return count;
+}
+
 } // namespace sf
@@ -0,0 +1,131 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2014 Laurent Gomila (laurent.gom@gmail.com)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Audio/ResamplerEffect.hpp>
+#include <SFML/Audio/AudioDevice.hpp>
+#include <SFML/System/Lock.hpp>
+
+
+namespace
+{
+    // Number of input frames kept from one block to the next,
+    // the cubic interpolation needs 2 frames on each side
+    const std::size_t historyFrames = 3;
+}
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+ResamplerEffect::ResamplerEffect(unsigned int outputRate) :
+m_outputRate(outputRate),
+m_inputRate (0),
+m_position  (1.0)
+{
+
+}
+
+
+////////////////////////////////////////////////////////////
+void ResamplerEffect::setOutputRate(unsigned int outputRate)
+{
+    Lock lock(m_mutex);
+
+    m_outputRate = outputRate;
+}
+
+
+////////////////////////////////////////////////////////////
+void ResamplerEffect::reset(unsigned int channelCount, unsigned int sampleRate)
+{
+    Lock lock(m_mutex);
+
+    m_inputRate = sampleRate;
+    m_position  = 1.0;
+    m_input.assign(historyFrames * channelCount, 0.f);
+}
+
+
+////////////////////////////////////////////////////////////
+void ResamplerEffect::process(std::vector<float>& samples, unsigned int channelCount)
+{
+    Lock lock(m_mutex);
+
+    unsigned int outputRate = m_outputRate ? m_outputRate : priv::AudioDevice::getSampleRate();
+    if (samples.empty() || (channelCount == 0) || (m_inputRate == 0) || (outputRate == m_inputRate))
+        return;
+
+    // Append the new block to the frames kept from the previous one
+    if (m_input.size() != historyFrames * channelCount)
+        m_input.assign(historyFrames * channelCount, 0.f);
+    m_input.insert(m_input.end(), samples.begin(), samples.end());
+
+    std::size_t frameCount = m_input.size() / channelCount;
+    double step = static_cast<double>(m_inputRate) / outputRate;
+
+    // Produce the output frames for which all the neighbours are available
+    m_output.clear();
+    m_output.reserve(static_cast<std::size_t>(samples.size() / step) + channelCount * 2);
+    while (m_position + 2.0 < frameCount)
+    {
+        std::size_t index = static_cast<std::size_t>(m_position);
+        float t = static_cast<float>(m_position - index);
+
+        const float* p0 = &m_input[(index - 1) * channelCount];
+        const float* p1 = p0 + channelCount;
+        const float* p2 = p1 + channelCount;
+        const float* p3 = p2 + channelCount;
+        for (unsigned int channel = 0; channel < channelCount; ++channel)
+        {
+            // Catmull-Rom spline between p1 and p2
+            float c1 = 0.5f * (p2[channel] - p0[channel]);
+            float c2 = p0[channel] - 2.5f * p1[channel] + 2.f * p2[channel] - 0.5f * p3[channel];
+            float c3 = 0.5f * (p3[channel] - p0[channel]) + 1.5f * (p1[channel] - p2[channel]);
+            m_output.push_back(((c3 * t + c2) * t + c1) * t + p1[channel]);
+        }
+
+        m_position += step;
+    }
+
+    // Keep the last frames for the next block
+    std::size_t consumed = frameCount - historyFrames;
+    m_input.erase(m_input.begin(), m_input.begin() + consumed * channelCount);
+    m_position -= consumed;
+
+    samples.swap(m_output);
+}
+
+
+////////////////////////////////////////////////////////////
+unsigned int ResamplerEffect::getOutputRate(unsigned int) const
+{
+    Lock lock(m_mutex);
+
+    return m_outputRate ? m_outputRate : priv::AudioDevice::getSampleRate();
+}
+
+} // namespace sf
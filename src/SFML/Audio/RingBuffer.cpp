@@ -0,0 +1,149 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2014 Laurent Gomila (laurent.gom@gmail.com)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Audio/RingBuffer.hpp>
+#include <algorithm>
+#include <cstring>
+#if defined(_MSC_VER)
+    #include <windows.h>
+#endif
+
+
+namespace
+{
+    // Make sure that the memory accesses before the barrier are
+    // visible to the other thread before the ones after it
+    inline void memoryBarrier()
+    {
+        #if defined(_MSC_VER)
+            MemoryBarrier();
+        #else
+            __sync_synchronize();
+        #endif
+    }
+}
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+RingBuffer::RingBuffer() :
+m_readCount (0),
+m_writeCount(0)
+{
+
+}
+
+
+////////////////////////////////////////////////////////////
+void RingBuffer::resize(std::size_t capacity)
+{
+    // Use a power of two, so that positions stay right when the counters wrap around
+    std::size_t size = 1;
+    while (size < capacity)
+        size *= 2;
+
+    m_data.resize(size);
+    clear();
+}
+
+
+////////////////////////////////////////////////////////////
+void RingBuffer::clear()
+{
+    m_readCount  = 0;
+    m_writeCount = 0;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t RingBuffer::getReadSize() const
+{
+    // The counters wrap around together, so their difference is always right
+    std::size_t size = m_writeCount - m_readCount;
+    memoryBarrier();
+
+    return size;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t RingBuffer::getWriteSize() const
+{
+    std::size_t size = m_data.size() - (m_writeCount - m_readCount);
+    memoryBarrier();
+
+    return size;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t RingBuffer::write(const void* data, std::size_t size)
+{
+    size = std::min(size, getWriteSize());
+    if (size == 0)
+        return 0;
+
+    // Copy the data in at most two parts, if it wraps around the end of the storage
+    std::size_t offset = m_writeCount & (m_data.size() - 1);
+    std::size_t first = std::min(size, m_data.size() - offset);
+    std::memcpy(&m_data[offset], data, first);
+    std::memcpy(&m_data[0], static_cast<const char*>(data) + first, size - first);
+
+    // Publish the data only once it has been copied
+    memoryBarrier();
+    m_writeCount = m_writeCount + size;
+
+    return size;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t RingBuffer::read(void* data, std::size_t size)
+{
+    size = std::min(size, getReadSize());
+    if (size == 0)
+        return 0;
+
+    // Copy the data in at most two parts, if it wraps around the end of the storage
+    std::size_t offset = m_readCount & (m_data.size() - 1);
+    std::size_t first = std::min(size, m_data.size() - offset);
+    std::memcpy(data, &m_data[offset], first);
+    std::memcpy(static_cast<char*>(data) + first, &m_data[0], size - first);
+
+    // Release the space only once the data has been copied
+    memoryBarrier();
+    m_readCount = m_readCount + size;
+
+    return size;
+}
+
+} // namespace priv
+
+} // namespace sf
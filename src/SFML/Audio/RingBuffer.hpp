@@ -0,0 +1,127 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2014 Laurent Gomila (laurent.gom@gmail.com)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_RINGBUFFER_HPP
+#define SFML_RINGBUFFER_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/System/NonCopyable.hpp>
+#include <cstdlib>
+#include <vector>
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+/// \brief Lock-free circular buffer of bytes, for exactly
+///        one producer thread and one consumer thread
+///
+////////////////////////////////////////////////////////////
+class RingBuffer : NonCopyable
+{
+public :
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    ////////////////////////////////////////////////////////////
+    RingBuffer();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Change the capacity of the buffer, and empty it
+    ///
+    /// The capacity is rounded up to the next power of two.
+    /// This function must not be called while the buffer is in use.
+    ///
+    /// \param capacity Minimum capacity, in bytes
+    ///
+    ////////////////////////////////////////////////////////////
+    void resize(std::size_t capacity);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Empty the buffer
+    ///
+    /// This function must not be called while the buffer is in use.
+    ///
+    ////////////////////////////////////////////////////////////
+    void clear();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of bytes that can be read
+    ///
+    /// \return Number of bytes available to the consumer
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getReadSize() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of bytes that can be written
+    ///
+    /// \return Number of bytes available to the producer
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getWriteSize() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Copy bytes into the buffer
+    ///
+    /// \param data Bytes to write
+    /// \param size Number of bytes to write
+    ///
+    /// \return Number of bytes actually written (less than \a size if the buffer is full)
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t write(const void* data, std::size_t size);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Copy bytes out of the buffer
+    ///
+    /// \param data Destination of the bytes
+    /// \param size Number of bytes to read
+    ///
+    /// \return Number of bytes actually read
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t read(void* data, std::size_t size);
+
+private :
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    std::vector<char>    m_data;       ///< Storage of the buffer
+    volatile std::size_t m_readCount;  ///< Total number of bytes read (only written by the consumer)
+    volatile std::size_t m_writeCount; ///< Total number of bytes written (only written by the producer)
+};
+
+} // namespace priv
+
+} // namespace sf
+
+
+#endif // SFML_RINGBUFFER_HPP
@@ -0,0 +1,117 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2014 Laurent Gomila (laurent.gom@gmail.com)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Audio/SampleConversion.hpp>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+    #include <emmintrin.h>
+    #define SFML_SAMPLES_SSE2
+#endif
+
+
+namespace
+{
+    // Scale between the 16 bits and the floating point ranges
+    const float toFloat = 1.f / 32768.f;
+    const float toInt16 = 32768.f;
+
+    // Convert a single floating point sample, with saturation and rounding to nearest
+    sf::Int16 convertSample(float sample)
+    {
+        sample *= toInt16;
+        if (sample >= 32767.f)
+            return 32767;
+        else if (sample <= -32768.f)
+            return -32768;
+        else
+            return static_cast<sf::Int16>(sample >= 0.f ? sample + 0.5f : sample - 0.5f);
+    }
+}
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+void convertSamples(const Int16* input, float* output, std::size_t count)
+{
+    std::size_t i = 0;
+
+#ifdef SFML_SAMPLES_SSE2
+
+    // Convert 8 samples at a time: sign-extend them to 32 bits, then scale them
+    const __m128 scale = _mm_set1_ps(toFloat);
+    for (; i + 8 <= count; i += 8)
+    {
+        __m128i samples = _mm_loadu_si128(reinterpret_cast<const __m128i*>(input + i));
+        __m128i low  = _mm_srai_epi32(_mm_unpacklo_epi16(samples, samples), 16);
+        __m128i high = _mm_srai_epi32(_mm_unpackhi_epi16(samples, samples), 16);
+        _mm_storeu_ps(output + i,     _mm_mul_ps(_mm_cvtepi32_ps(low), scale));
+        _mm_storeu_ps(output + i + 4, _mm_mul_ps(_mm_cvtepi32_ps(high), scale));
+    }
+
+#endif
+
+    // Convert the remaining samples one by one
+    for (; i < count; ++i)
+        output[i] = input[i] * toFloat;
+}
+
+
+////////////////////////////////////////////////////////////
+void convertSamples(const float* input, Int16* output, std::size_t count)
+{
+    std::size_t i = 0;
+
+#ifdef SFML_SAMPLES_SSE2
+
+    // Convert 8 samples at a time; they are clamped before the conversion
+    // so that huge values don't overflow the 32 bits integers
+    const __m128 scale   = _mm_set1_ps(toInt16);
+    const __m128 maximum = _mm_set1_ps(32767.f);
+    const __m128 minimum = _mm_set1_ps(-32768.f);
+    for (; i + 8 <= count; i += 8)
+    {
+        __m128 low  = _mm_mul_ps(_mm_loadu_ps(input + i), scale);
+        __m128 high = _mm_mul_ps(_mm_loadu_ps(input + i + 4), scale);
+        low  = _mm_max_ps(_mm_min_ps(low, maximum), minimum);
+        high = _mm_max_ps(_mm_min_ps(high, maximum), minimum);
+        __m128i packed = _mm_packs_epi32(_mm_cvtps_epi32(low), _mm_cvtps_epi32(high));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(output + i), packed);
+    }
+
+#endif
+
+    // Convert the remaining samples one by one
+    for (; i < count; ++i)
+        output[i] = convertSample(input[i]);
+}
+
+} // namespace priv
+
+} // namespace sf
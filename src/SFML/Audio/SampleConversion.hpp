@@ -0,0 +1,69 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2014 Laurent Gomila (laurent.gom@gmail.com)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_SAMPLECONVERSION_HPP
+#define SFML_SAMPLECONVERSION_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Config.hpp>
+#include <cstdlib>
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+/// Convert 16 bits samples to floating point samples
+///
+/// The output samples are in the range [-1, 1[.
+///
+/// \param input  Array of samples to convert
+/// \param output Array receiving the converted samples
+/// \param count  Number of samples to convert
+///
+////////////////////////////////////////////////////////////
+void convertSamples(const Int16* input, float* output, std::size_t count);
+
+////////////////////////////////////////////////////////////
+/// Convert floating point samples to 16 bits samples
+///
+/// The input samples are expected in the range [-1, 1],
+/// values outside of it are saturated.
+///
+/// \param input  Array of samples to convert
+/// \param output Array receiving the converted samples
+/// \param count  Number of samples to convert
+///
+////////////////////////////////////////////////////////////
+void convertSamples(const float* input, Int16* output, std::size_t count);
+
+} // namespace priv
+
+} // namespace sf
+
+
+#endif // SFML_SAMPLECONVERSION_HPP
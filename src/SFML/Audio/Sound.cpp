@@ -34,14 +34,16 @@ namespace sf
 {
 ////////////////////////////////////////////////////////////
 Sound::Sound() :
-m_buffer(NULL)
+m_buffer(NULL),
+m_loop  (false)
 {
 }
 
 
 ////////////////////////////////////////////////////////////
 Sound::Sound(const SoundBuffer& buffer) :
-m_buffer(NULL)
+m_buffer(NULL),
+m_loop  (false)
 {
     setBuffer(buffer);
 }
@@ -50,7 +52,8 @@ m_buffer(NULL)
 ////////////////////////////////////////////////////////////
 Sound::Sound(const Sound& copy) :
 SoundSource(copy),
-m_buffer   (NULL)
+m_buffer   (NULL),
+m_loop     (false)
 {
     if (copy.m_buffer)
         setBuffer(*copy.m_buffer);
@@ -70,6 +73,7 @@ Sound::~Sound()
 ////////////////////////////////////////////////////////////
 void Sound::play()
 {
+    applyChanges();
     alCheck(alSourcePlay(m_source));
 }
 
@@ -109,6 +113,7 @@ void Sound::setBuffer(const SoundBuffer& buffer)
 void Sound::setLoop(bool loop)
 {
     alCheck(alSourcei(m_source, AL_LOOPING, loop));
+    m_loop = loop;
 }
 
 
@@ -129,10 +134,7 @@ const SoundBuffer* Sound::getBuffer() const
 ////////////////////////////////////////////////////////////
 bool Sound::getLoop() const
 {
-    ALint loop;
-    alCheck(alGetSourcei(m_source, AL_LOOPING, &loop));
-
-    return loop != 0;
+    return m_loop;
 }
 
 
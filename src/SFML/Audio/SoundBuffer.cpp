@@ -30,6 +30,7 @@
 #include <SFML/Audio/Sound.hpp>
 #include <SFML/Audio/AudioDevice.hpp>
 #include <SFML/Audio/ALCheck.hpp>
+#include <SFML/Audio/SampleConversion.hpp>
 #include <SFML/System/Err.hpp>
 #include <memory>
 
@@ -50,10 +51,11 @@ m_duration()
 
 ////////////////////////////////////////////////////////////
 SoundBuffer::SoundBuffer(const SoundBuffer& copy) :
-m_buffer  (0),
-m_samples (copy.m_samples),
-m_duration(copy.m_duration),
-m_sounds  () // don't copy the attached sounds
+m_buffer      (0),
+m_samples     (copy.m_samples),
+m_floatSamples(copy.m_floatSamples),
+m_duration    (copy.m_duration),
+m_sounds      () // don't copy the attached sounds
 {
     // Create the buffer
     alCheck(alGenBuffers(1, &m_buffer));
@@ -116,6 +118,35 @@ bool SoundBuffer::loadFromSamples(const Int16* samples, std::size_t sampleCount,
     {
         // Copy the new audio samples
         m_samples.assign(samples, samples + sampleCount);
+        m_floatSamples.clear();
+
+        // Update the internal buffer with the new samples
+        return update(channelCount, sampleRate);
+    }
+    else
+    {
+        // Error...
+        err() << "Failed to load sound buffer from samples ("
+              << "array: "      << samples      << ", "
+              << "count: "      << sampleCount  << ", "
+              << "channels: "   << channelCount << ", "
+              << "samplerate: " << sampleRate   << ")"
+              << std::endl;
+
+        return false;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+bool SoundBuffer::loadFromSamples(const float* samples, std::size_t sampleCount, unsigned int channelCount, unsigned int sampleRate)
+{
+    if (samples && sampleCount && channelCount && sampleRate)
+    {
+        // Copy the new audio samples, and keep a 16 bits version of them
+        m_floatSamples.assign(samples, samples + sampleCount);
+        m_samples.resize(sampleCount);
+        priv::convertSamples(samples, &m_samples[0], sampleCount);
 
         // Update the internal buffer with the new samples
         return update(channelCount, sampleRate);
@@ -200,10 +231,11 @@ SoundBuffer& SoundBuffer::operator =(const SoundBuffer& right)
 {
     SoundBuffer temp(right);
 
-    std::swap(m_samples,  temp.m_samples);
-    std::swap(m_buffer,   temp.m_buffer);
-    std::swap(m_duration, temp.m_duration);
-    std::swap(m_sounds,   temp.m_sounds); // swap sounds too, so that they are detached when temp is destroyed
+    std::swap(m_samples,      temp.m_samples);
+    std::swap(m_floatSamples, temp.m_floatSamples);
+    std::swap(m_buffer,       temp.m_buffer);
+    std::swap(m_duration,     temp.m_duration);
+    std::swap(m_sounds,       temp.m_sounds); // swap sounds too, so that they are detached when temp is destroyed
 
     return *this;
 }
@@ -219,6 +251,7 @@ bool SoundBuffer::initialize(priv::SoundFile& file)
 
     // Read the samples from the provided file
     m_samples.resize(sampleCount);
+    m_floatSamples.clear();
     if (file.read(&m_samples[0], sampleCount) == sampleCount)
     {
         // Update the internal buffer with the new samples
@@ -238,19 +271,33 @@ bool SoundBuffer::update(unsigned int channelCount, unsigned int sampleRate)
     if (!channelCount || !sampleRate || m_samples.empty())
         return false;
 
-    // Find the good format according to the number of channels
-    ALenum format = priv::AudioDevice::getFormatFromChannelCount(channelCount);
+    // Use the floating point samples if we have them and the driver can play them
+    ALenum floatFormat = 0;
+    if (!m_floatSamples.empty())
+        floatFormat = priv::AudioDevice::getFloatFormatFromChannelCount(channelCount);
 
-    // Check if the format is valid
-    if (format == 0)
+    if (floatFormat != 0)
     {
-        err() << "Failed to load sound buffer (unsupported number of channels: " << channelCount << ")" << std::endl;
-        return false;
+        // Fill the buffer
+        ALsizei size = static_cast<ALsizei>(m_floatSamples.size()) * sizeof(float);
+        alCheck(alBufferData(m_buffer, floatFormat, &m_floatSamples[0], size, sampleRate));
+    }
+    else
+    {
+        // Find the good format according to the number of channels
+        ALenum format = priv::AudioDevice::getFormatFromChannelCount(channelCount);
+
+        // Check if the format is valid
+        if (format == 0)
+        {
+            err() << "Failed to load sound buffer (unsupported number of channels: " << channelCount << ")" << std::endl;
+            return false;
+        }
+
+        // Fill the buffer
+        ALsizei size = static_cast<ALsizei>(m_samples.size()) * sizeof(Int16);
+        alCheck(alBufferData(m_buffer, format, &m_samples[0], size, sampleRate));
     }
-
-    // Fill the buffer
-    ALsizei size = static_cast<ALsizei>(m_samples.size()) * sizeof(Int16);
-    alCheck(alBufferData(m_buffer, format, &m_samples[0], size, sampleRate));
 
     // Compute the duration
     m_duration = seconds(static_cast<float>(m_samples.size()) / sampleRate / channelCount);
@@ -0,0 +1,448 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2014 Laurent Gomila (laurent.gom@gmail.com)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Audio/SoundBufferLoader.hpp>
+#include <SFML/Audio/SoundBuffer.hpp>
+#include <SFML/Audio/SoundFile.hpp>
+#include <SFML/Audio/AudioDevice.hpp>
+#include <SFML/System/Lock.hpp>
+#include <algorithm>
+
+
+namespace
+{
+    // Number of samples decoded between two checks for cancellation
+    const std::size_t chunkSize = 65536;
+
+    // Resample interleaved samples with linear interpolation
+    void resample(std::vector<sf::Int16>& samples, unsigned int channelCount, unsigned int sourceRate, unsigned int targetRate)
+    {
+        std::size_t sourceFrames = samples.size() / channelCount;
+        if ((sourceFrames < 2) || (sourceRate == targetRate))
+            return;
+
+        std::size_t targetFrames = static_cast<std::size_t>(static_cast<sf::Uint64>(sourceFrames) * targetRate / sourceRate);
+        std::vector<sf::Int16> result(targetFrames * channelCount);
+
+        double step = static_cast<double>(sourceRate) / targetRate;
+        for (std::size_t frame = 0; frame < targetFrames; ++frame)
+        {
+            double position = frame * step;
+            std::size_t index = static_cast<std::size_t>(position);
+            if (index >= sourceFrames - 1)
+                index = sourceFrames - 2;
+            float ratio = static_cast<float>(position - index);
+
+            const sf::Int16* first  = &samples[index * channelCount];
+            const sf::Int16* second = first + channelCount;
+            sf::Int16* output = &result[frame * channelCount];
+            for (unsigned int channel = 0; channel < channelCount; ++channel)
+                output[channel] = static_cast<sf::Int16>(first[channel] + (second[channel] - first[channel]) * ratio);
+        }
+
+        samples.swap(result);
+    }
+}
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+struct SoundBufferLoader::Job
+{
+    enum Status
+    {
+        Queued,
+        Decoding,
+        Decoded,
+        Failed
+    };
+
+    Request            id;
+    SoundBuffer*       buffer;
+    std::string        filename;
+    const void*        data;
+    std::size_t        size;
+    unsigned int       targetRate;
+    Status             status;
+    bool               canceled;
+    std::size_t        decoded;
+    std::size_t        total;
+    float              reportedProgress;
+    std::vector<Int16> samples;
+    unsigned int       channelCount;
+    unsigned int       sampleRate;
+};
+
+
+////////////////////////////////////////////////////////////
+struct SoundBufferLoader::Worker
+{
+    Worker(SoundBufferLoader* owner) :
+    loader (owner),
+    thread (&SoundBufferLoader::run, this),
+    running(false)
+    {
+    }
+
+    SoundBufferLoader* loader;
+    Thread             thread;
+    bool               running;
+};
+
+
+////////////////////////////////////////////////////////////
+SoundBufferLoader::SoundBufferLoader(unsigned int threadCount) :
+m_nextId    (1),
+m_sampleRate(0)
+{
+    if (threadCount == 0)
+        threadCount = 1;
+
+    for (unsigned int i = 0; i < threadCount; ++i)
+        m_workers.push_back(new Worker(this));
+}
+
+
+////////////////////////////////////////////////////////////
+SoundBufferLoader::~SoundBufferLoader()
+{
+    // Stop the workers as soon as possible
+    cancelAll();
+    for (std::vector<Worker*>::iterator it = m_workers.begin(); it != m_workers.end(); ++it)
+        delete *it;
+
+    // Drop the unfinished jobs, without notifying (we're being destroyed)
+    for (std::vector<Job*>::iterator it = m_jobs.begin(); it != m_jobs.end(); ++it)
+        delete *it;
+}
+
+
+////////////////////////////////////////////////////////////
+void SoundBufferLoader::setSampleRate(unsigned int sampleRate)
+{
+    m_sampleRate = sampleRate;
+}
+
+
+////////////////////////////////////////////////////////////
+SoundBufferLoader::Request SoundBufferLoader::loadFromFile(SoundBuffer& buffer, const std::string& filename)
+{
+    Job* job = new Job;
+    job->buffer   = &buffer;
+    job->filename = filename;
+    job->data     = NULL;
+    job->size     = 0;
+
+    return push(job);
+}
+
+
+////////////////////////////////////////////////////////////
+SoundBufferLoader::Request SoundBufferLoader::loadFromMemory(SoundBuffer& buffer, const void* data, std::size_t sizeInBytes)
+{
+    Job* job = new Job;
+    job->buffer = &buffer;
+    job->data   = data;
+    job->size   = sizeInBytes;
+
+    return push(job);
+}
+
+
+////////////////////////////////////////////////////////////
+void SoundBufferLoader::cancel(Request request)
+{
+    Lock lock(m_mutex);
+
+    for (std::vector<Job*>::iterator it = m_jobs.begin(); it != m_jobs.end(); ++it)
+    {
+        Job* job = *it;
+        if (job->id == request)
+        {
+            job->canceled = true;
+
+            // Jobs that are not started yet can be finished right away
+            if (job->status == Job::Queued)
+            {
+                m_queue.erase(std::find(m_queue.begin(), m_queue.end(), job));
+                job->status = Job::Failed;
+            }
+        }
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void SoundBufferLoader::cancelAll()
+{
+    Lock lock(m_mutex);
+
+    for (std::vector<Job*>::iterator it = m_jobs.begin(); it != m_jobs.end(); ++it)
+    {
+        (*it)->canceled = true;
+        if ((*it)->status == Job::Queued)
+            (*it)->status = Job::Failed;
+    }
+
+    m_queue.clear();
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t SoundBufferLoader::update()
+{
+    std::vector<Job*> finished;
+    std::vector<std::pair<Request, float> > progresses;
+
+    // Collect the finished jobs and the progress of the running ones
+    {
+        Lock lock(m_mutex);
+
+        std::vector<Job*>::iterator end = m_jobs.begin();
+        for (std::vector<Job*>::iterator it = m_jobs.begin(); it != m_jobs.end(); ++it)
+        {
+            Job* job = *it;
+            if ((job->status == Job::Decoded) || (job->status == Job::Failed))
+            {
+                finished.push_back(job);
+            }
+            else
+            {
+                if ((job->status == Job::Decoding) && (job->total > 0))
+                {
+                    float progress = static_cast<float>(job->decoded) / job->total;
+                    if (progress != job->reportedProgress)
+                    {
+                        job->reportedProgress = progress;
+                        progresses.push_back(std::make_pair(job->id, progress));
+                    }
+                }
+                *end++ = job;
+            }
+        }
+        m_jobs.erase(end, m_jobs.end());
+    }
+
+    // Notify the progress
+    for (std::vector<std::pair<Request, float> >::const_iterator it = progresses.begin(); it != progresses.end(); ++it)
+        onProgress(it->first, it->second);
+
+    // Upload the decoded samples to the sound buffers
+    for (std::vector<Job*>::iterator it = finished.begin(); it != finished.end(); ++it)
+    {
+        Job* job = *it;
+        bool success = false;
+        if ((job->status == Job::Decoded) && !job->canceled)
+        {
+            job->buffer->m_samples.swap(job->samples);
+            job->buffer->m_floatSamples.clear();
+            success = job->buffer->update(job->channelCount, job->sampleRate);
+            if (success)
+                onProgress(job->id, 1.f);
+        }
+
+        onLoaded(job->id, *job->buffer, success);
+        delete job;
+    }
+
+    return finished.size();
+}
+
+
+////////////////////////////////////////////////////////////
+void SoundBufferLoader::wait()
+{
+    // Workers exit as soon as the queue is empty, so waiting for them is enough
+    for (std::vector<Worker*>::iterator it = m_workers.begin(); it != m_workers.end(); ++it)
+        (*it)->thread.wait();
+
+    update();
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t SoundBufferLoader::getPendingCount() const
+{
+    Lock lock(m_mutex);
+
+    return m_jobs.size();
+}
+
+
+////////////////////////////////////////////////////////////
+float SoundBufferLoader::getProgress() const
+{
+    Lock lock(m_mutex);
+
+    if (m_jobs.empty())
+        return 1.f;
+
+    // Every request weighs the same, regardless of its size
+    float progress = 0.f;
+    for (std::vector<Job*>::const_iterator it = m_jobs.begin(); it != m_jobs.end(); ++it)
+    {
+        const Job* job = *it;
+        if ((job->status == Job::Decoded) || (job->status == Job::Failed))
+            progress += 1.f;
+        else if (job->total > 0)
+            progress += static_cast<float>(job->decoded) / job->total;
+    }
+
+    return progress / m_jobs.size();
+}
+
+
+////////////////////////////////////////////////////////////
+void SoundBufferLoader::onProgress(Request, float)
+{
+    // Nothing by default
+}
+
+
+////////////////////////////////////////////////////////////
+void SoundBufferLoader::onLoaded(Request, SoundBuffer&, bool)
+{
+    // Nothing by default
+}
+
+
+////////////////////////////////////////////////////////////
+SoundBufferLoader::Request SoundBufferLoader::push(Job* job)
+{
+    // Resolve the target sample rate now, in the calling thread
+    unsigned int targetRate = m_sampleRate;
+    if (targetRate == DeviceSampleRate)
+        targetRate = priv::AudioDevice::getSampleRate();
+
+    Lock lock(m_mutex);
+
+    job->id               = m_nextId++;
+    job->targetRate       = targetRate;
+    job->status           = Job::Queued;
+    job->canceled         = false;
+    job->decoded          = 0;
+    job->total            = 0;
+    job->reportedProgress = 0.f;
+    job->channelCount     = 0;
+    job->sampleRate       = 0;
+
+    m_jobs.push_back(job);
+    m_queue.push_back(job);
+
+    // Start an idle worker, if any; workers that are running will pick the job otherwise
+    for (std::vector<Worker*>::iterator it = m_workers.begin(); it != m_workers.end(); ++it)
+    {
+        Worker* worker = *it;
+        if (!worker->running)
+        {
+            worker->running = true;
+            worker->thread.launch();
+            break;
+        }
+    }
+
+    return job->id;
+}
+
+
+////////////////////////////////////////////////////////////
+void SoundBufferLoader::run(Worker* worker)
+{
+    SoundBufferLoader& loader = *worker->loader;
+
+    for (;;)
+    {
+        // Take the next job, or exit if there's none
+        Job* job = NULL;
+        {
+            Lock lock(loader.m_mutex);
+
+            if (loader.m_queue.empty())
+            {
+                worker->running = false;
+                return;
+            }
+
+            job = loader.m_queue.front();
+            loader.m_queue.pop_front();
+            job->status = Job::Decoding;
+        }
+
+        bool success = loader.decode(*job);
+
+        {
+            Lock lock(loader.m_mutex);
+            job->status = success ? Job::Decoded : Job::Failed;
+        }
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+bool SoundBufferLoader::decode(Job& job)
+{
+    priv::SoundFile file;
+    bool opened = job.data ? file.openRead(job.data, job.size) : file.openRead(job.filename);
+    if (!opened)
+        return false;
+
+    std::size_t total = file.getSampleCount();
+    job.samples.resize(total);
+    job.channelCount = file.getChannelCount();
+    job.sampleRate   = file.getSampleRate();
+    {
+        Lock lock(m_mutex);
+        job.total = total;
+    }
+
+    // Decode the file chunk by chunk, so that the request can be canceled and report its progress
+    std::size_t decoded = 0;
+    while (decoded < total)
+    {
+        std::size_t count = std::min(chunkSize, total - decoded);
+        if (file.read(&job.samples[decoded], count) != count)
+            return false;
+        decoded += count;
+
+        Lock lock(m_mutex);
+        job.decoded = decoded;
+        if (job.canceled)
+            return false;
+    }
+
+    // Resample if requested
+    if ((job.targetRate != 0) && (job.channelCount > 0) && (job.targetRate != job.sampleRate))
+    {
+        resample(job.samples, job.channelCount, job.sampleRate, job.targetRate);
+        job.sampleRate = job.targetRate;
+    }
+
+    return true;
+}
+
+} // namespace sf
@@ -0,0 +1,128 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2014 Laurent Gomila (laurent.gom@gmail.com)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Audio/SoundEffectChain.hpp>
+#include <SFML/System/Lock.hpp>
+#include <algorithm>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+SoundEffectChain::SoundEffectChain() :
+m_channelCount(0),
+m_sampleRate  (0)
+{
+
+}
+
+
+////////////////////////////////////////////////////////////
+void SoundEffectChain::add(SoundEffect& effect)
+{
+    Lock lock(m_mutex);
+
+    // If the chain is already running, bring the new effect up to date
+    if (m_channelCount > 0)
+    {
+        unsigned int sampleRate = m_sampleRate;
+        for (std::vector<SoundEffect*>::const_iterator it = m_effects.begin(); it != m_effects.end(); ++it)
+            sampleRate = (*it)->getOutputRate(sampleRate);
+
+        effect.reset(m_channelCount, sampleRate);
+    }
+
+    m_effects.push_back(&effect);
+}
+
+
+////////////////////////////////////////////////////////////
+void SoundEffectChain::remove(SoundEffect& effect)
+{
+    Lock lock(m_mutex);
+
+    m_effects.erase(std::remove(m_effects.begin(), m_effects.end(), &effect), m_effects.end());
+}
+
+
+////////////////////////////////////////////////////////////
+void SoundEffectChain::clear()
+{
+    Lock lock(m_mutex);
+
+    m_effects.clear();
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t SoundEffectChain::getEffectCount() const
+{
+    Lock lock(m_mutex);
+
+    return m_effects.size();
+}
+
+
+////////////////////////////////////////////////////////////
+void SoundEffectChain::reset(unsigned int channelCount, unsigned int sampleRate)
+{
+    Lock lock(m_mutex);
+
+    m_channelCount = channelCount;
+    m_sampleRate   = sampleRate;
+
+    // Each effect receives the samples at the rate produced by the previous one
+    for (std::vector<SoundEffect*>::iterator it = m_effects.begin(); it != m_effects.end(); ++it)
+    {
+        (*it)->reset(channelCount, sampleRate);
+        sampleRate = (*it)->getOutputRate(sampleRate);
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void SoundEffectChain::process(std::vector<float>& samples, unsigned int channelCount)
+{
+    Lock lock(m_mutex);
+
+    for (std::vector<SoundEffect*>::iterator it = m_effects.begin(); it != m_effects.end(); ++it)
+        (*it)->process(samples, channelCount);
+}
+
+
+////////////////////////////////////////////////////////////
+unsigned int SoundEffectChain::getOutputRate(unsigned int sampleRate) const
+{
+    Lock lock(m_mutex);
+
+    for (std::vector<SoundEffect*>::const_iterator it = m_effects.begin(); it != m_effects.end(); ++it)
+        sampleRate = (*it)->getOutputRate(sampleRate);
+
+    return sampleRate;
+}
+
+} // namespace sf
@@ -28,6 +28,7 @@
 #include <SFML/Audio/SoundFile.hpp>
 #include <SFML/System/InputStream.hpp>
 #include <SFML/System/Err.hpp>
+#include <algorithm>
 #include <cstring>
 #include <cctype>
 
@@ -50,10 +51,11 @@ namespace priv
 {
 ////////////////////////////////////////////////////////////
 SoundFile::SoundFile() :
-m_file        (NULL),
-m_sampleCount (0),
-m_channelCount(0),
-m_sampleRate  (0)
+m_file             (NULL),
+m_sampleCount      (0),
+m_channelCount     (0),
+m_sampleRate       (0),
+m_extendedPrecision(false)
 {
 
 }
@@ -88,17 +90,44 @@ unsigned int SoundFile::getSampleRate() const
 }
 
 
+////////////////////////////////////////////////////////////
+bool SoundFile::hasExtendedPrecision() const
+{
+    return m_extendedPrecision;
+}
+
+
 ////////////////////////////////////////////////////////////
 bool SoundFile::openRead(const std::string& filename)
 {
     // If the file is already opened, first close it
     if (m_file)
         sf_close(m_file);
+    m_mapping.close();
 
     // Open the sound file
     SF_INFO fileInfo;
     fileInfo.format = 0;
-    m_file = sf_open(filename.c_str(), SFM_READ, &fileInfo);
+    if (m_mapping.open(filename))
+    {
+        // The file could be mapped: read it through the memory callbacks
+        SF_VIRTUAL_IO io;
+        io.get_filelen = &Memory::getLength;
+        io.read        = &Memory::read;
+        io.seek        = &Memory::seek;
+        io.tell        = &Memory::tell;
+
+        m_memory.begin   = static_cast<const char*>(m_mapping.getData());
+        m_memory.current = m_memory.begin;
+        m_memory.size    = m_mapping.getSize();
+
+        m_file = sf_open_virtual(&io, SFM_READ, &fileInfo, &m_memory);
+    }
+    else
+    {
+        m_file = sf_open(filename.c_str(), SFM_READ, &fileInfo);
+    }
+
     if (!m_file)
     {
         err() << "Failed to open sound file \"" << filename << "\" (" << sf_strerror(m_file) << ")" << std::endl;
@@ -118,6 +147,7 @@ bool SoundFile::openRead(const void* data, std::size_t sizeInBytes)
     // If the file is already opened, first close it
     if (m_file)
         sf_close(m_file);
+    m_mapping.close();
 
     // Prepare the memory I/O structure
     SF_VIRTUAL_IO io;
@@ -154,6 +184,7 @@ bool SoundFile::openRead(InputStream& stream)
     // If the file is already opened, first close it
     if (m_file)
         sf_close(m_file);
+    m_mapping.close();
 
     // Prepare the memory I/O structure
     SF_VIRTUAL_IO io;
@@ -192,6 +223,7 @@ bool SoundFile::openWrite(const std::string& filename, unsigned int channelCount
     // If the file is already opened, first close it
     if (m_file)
         sf_close(m_file);
+    m_mapping.close();
 
     // Find the right format according to the file extension
     int format = getFormatFromFilename(filename);
@@ -217,9 +249,10 @@ bool SoundFile::openWrite(const std::string& filename, unsigned int channelCount
     }
 
     // Set the sound parameters
-    m_channelCount = channelCount;
-    m_sampleRate   = sampleRate;
-    m_sampleCount  = 0;
+    m_channelCount      = channelCount;
+    m_sampleRate        = sampleRate;
+    m_sampleCount       = 0;
+    m_extendedPrecision = false;
 
     return true;
 }
@@ -235,6 +268,16 @@ std::size_t SoundFile::read(Int16* data, std::size_t sampleCount)
 }
 
 
+////////////////////////////////////////////////////////////
+std::size_t SoundFile::read(float* data, std::size_t sampleCount)
+{
+    if (m_file && data && sampleCount)
+        return static_cast<std::size_t>(sf_read_float(m_file, data, sampleCount));
+    else
+        return 0;
+}
+
+
 ////////////////////////////////////////////////////////////
 void SoundFile::write(const Int16* data, std::size_t sampleCount)
 {
@@ -255,12 +298,18 @@ void SoundFile::write(const Int16* data, std::size_t sampleCount)
 
 ////////////////////////////////////////////////////////////
 void SoundFile::seek(Time timeOffset)
+{
+    // Round to the nearest sample, so that converting a sample offset to a Time and back gives the same sample
+    Uint64 frameOffset = (static_cast<Uint64>(std::max(timeOffset, Time::Zero).asMicroseconds()) * m_sampleRate + 500000) / 1000000;
+    seek(frameOffset);
+}
+
+
+////////////////////////////////////////////////////////////
+void SoundFile::seek(Uint64 frameOffset)
 {
     if (m_file)
-    {
-        sf_count_t frameOffset = static_cast<sf_count_t>(timeOffset.asSeconds() * m_sampleRate);
-        sf_seek(m_file, frameOffset, SEEK_SET);
-    }
+        sf_seek(m_file, static_cast<sf_count_t>(frameOffset), SEEK_SET);
 }
 
 
@@ -272,10 +321,22 @@ void SoundFile::initialize(SF_INFO fileInfo)
     m_sampleRate   = fileInfo.samplerate;
     m_sampleCount  = static_cast<std::size_t>(fileInfo.frames) * fileInfo.channels;
 
-    // Enable scaling for Vorbis files (float samples)
-    // @todo enable when it's faster (it currently has to iterate over the *whole* music)
-    //if (fileInfo.format & SF_FORMAT_VORBIS)
-    //    sf_command(m_file, SFC_SET_SCALE_FLOAT_INT_READ, NULL, SF_TRUE);
+    // Check if reading 16 bits samples would lose precision; floating point
+    // reads of such files are normalized by libsndfile, no extra scaling is needed
+    switch (fileInfo.format & SF_FORMAT_SUBMASK)
+    {
+        case SF_FORMAT_PCM_24 :
+        case SF_FORMAT_PCM_32 :
+        case SF_FORMAT_FLOAT :
+        case SF_FORMAT_DOUBLE :
+        case SF_FORMAT_VORBIS :
+            m_extendedPrecision = true;
+            break;
+
+        default :
+            m_extendedPrecision = false;
+            break;
+    }
 }
 
 
@@ -351,12 +412,12 @@ sf_count_t SoundFile::Memory::seek(sf_count_t offset, int whence, void* user)
     {
         case SEEK_SET : position = offset;                                   break;
         case SEEK_CUR : position = memory->current - memory->begin + offset; break;
-        case SEEK_END : position = memory->size - offset;                    break;
+        case SEEK_END : position = memory->size + offset;                    break;
         default       : position = 0;                                        break;
     }
 
-    if (position >= memory->size)
-        position = memory->size - 1;
+    if (position > memory->size)
+        position = memory->size;
     else if (position < 0)
         position = 0;
 
@@ -28,6 +28,7 @@
 ////////////////////////////////////////////////////////////
 // Headers
 ////////////////////////////////////////////////////////////
+#include <SFML/System/MappedFileInputStream.hpp>
 #include <SFML/System/NonCopyable.hpp>
 #include <SFML/System/Time.hpp>
 #include <sndfile.h>
@@ -84,9 +85,25 @@ public :
     ////////////////////////////////////////////////////////////
     unsigned int getSampleRate() const;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether the samples of the file have a better
+    ///        precision than 16 bits integers
+    ///
+    /// This is the case for 24 and 32 bits PCM, floating point
+    /// and compressed (Vorbis) files. The samples of such files
+    /// should preferably be read as floating point numbers.
+    ///
+    /// \return True if the samples have more than 16 bits of precision
+    ///
+    ////////////////////////////////////////////////////////////
+    bool hasExtendedPrecision() const;
+
     ////////////////////////////////////////////////////////////
     /// \brief Open a sound file for reading
     ///
+    /// The file is mapped into memory when possible, so that
+    /// the decoder reads it in place without any system call.
+    ///
     /// \param filename Path of the sound file to load
     ///
     /// \return True if the file was successfully opened
@@ -138,6 +155,19 @@ public :
     ////////////////////////////////////////////////////////////
     std::size_t read(Int16* data, std::size_t sampleCount);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Read floating point audio samples from the loaded sound
+    ///
+    /// The samples are normalized to the range [-1, 1].
+    ///
+    /// \param data        Pointer to the sample array to fill
+    /// \param sampleCount Number of samples to read
+    ///
+    /// \return Number of samples actually read (may be less than \a sampleCount)
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t read(float* data, std::size_t sampleCount);
+
     ////////////////////////////////////////////////////////////
     /// \brief Write audio samples to the file
     ///
@@ -155,6 +185,16 @@ public :
     ////////////////////////////////////////////////////////////
     void seek(Time timeOffset);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Change the current read position in the file, with
+    ///        the accuracy of a sample
+    ///
+    /// \param frameOffset New read position, in frames (samples of
+    ///                    one channel) from the beginning of the file
+    ///
+    ////////////////////////////////////////////////////////////
+    void seek(Uint64 frameOffset);
+
 private :
 
     ////////////////////////////////////////////////////////////
@@ -212,12 +252,14 @@ private :
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
-    SNDFILE*     m_file;         ///< File descriptor
-    Memory       m_memory;       ///< Memory reading info
-    Stream       m_stream;       ///< Stream reading info
-    std::size_t  m_sampleCount;  ///< Total number of samples in the file
-    unsigned int m_channelCount; ///< Number of channels used by the sound
-    unsigned int m_sampleRate;   ///< Number of samples per second
+    SNDFILE*              m_file;              ///< File descriptor
+    MappedFileInputStream m_mapping;           ///< Memory mapping of the file, when opened from a filename
+    Memory                m_memory;            ///< Memory reading info
+    Stream                m_stream;            ///< Stream reading info
+    std::size_t           m_sampleCount;       ///< Total number of samples in the file
+    unsigned int          m_channelCount;      ///< Number of channels used by the sound
+    unsigned int          m_sampleRate;        ///< Number of samples per second
+    bool                  m_extendedPrecision; ///< Do the samples have more than 16 bits of precision?
 };
 
 } // namespace priv
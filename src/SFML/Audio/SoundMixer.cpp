@@ -0,0 +1,712 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2014 Laurent Gomila (laurent.gom@gmail.com)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Audio/SoundMixer.hpp>
+#include <SFML/Audio/Sound.hpp>
+#include <SFML/Audio/SoundBuffer.hpp>
+#include <SFML/Audio/SoundStream.hpp>
+#include <SFML/Audio/Listener.hpp>
+#include <SFML/Audio/AudioDevice.hpp>
+#include <SFML/System/Lock.hpp>
+#include <algorithm>
+#include <cmath>
+
+
+namespace
+{
+    // Duration of the blocks mixed by the premix stream
+    const sf::Time premixBlockDuration = sf::milliseconds(20);
+
+    // Compare two voices: highest priority first, then most audible first
+    template <typename T>
+    bool isMoreImportant(const T* left, const T* right)
+    {
+        if (left->priority != right->priority)
+            return left->priority > right->priority;
+
+        return left->audibility > right->audibility;
+    }
+
+    float length(const sf::Vector3f& vector)
+    {
+        return std::sqrt(vector.x * vector.x + vector.y * vector.y + vector.z * vector.z);
+    }
+}
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+class SoundMixer::Premix : public SoundStream
+{
+public :
+
+    Premix(SoundMixer& mixer) :
+    m_mixer     (mixer),
+    m_sampleRate(priv::AudioDevice::getSampleRate())
+    {
+        m_samples.resize(static_cast<std::size_t>(premixBlockDuration.asSeconds() * m_sampleRate) * 2);
+
+        // Short buffers, so that voices moved to the premix are heard quickly
+        setBufferDuration(premixBlockDuration);
+        setBufferCount(4);
+
+        // The voices are already spatialized
+        setRelativeToListener(true);
+
+        initialize(2, m_sampleRate);
+    }
+
+    ~Premix()
+    {
+        stop();
+    }
+
+private :
+
+    virtual bool onGetData(Chunk& data)
+    {
+        m_mixer.mix(&m_samples[0], m_samples.size() / 2, m_sampleRate);
+
+        data.samples     = &m_samples[0];
+        data.sampleCount = m_samples.size();
+
+        return true;
+    }
+
+    virtual void onSeek(Time)
+    {
+        // Nothing to do, the premix is a live source
+    }
+
+    SoundMixer&        m_mixer;
+    unsigned int       m_sampleRate;
+    std::vector<Int16> m_samples;
+};
+
+
+////////////////////////////////////////////////////////////
+SoundMixer::SoundMixer(unsigned int sourceCount) :
+m_nextVoice     (InvalidVoice + 1),
+m_sourceCount   (sourceCount),
+m_threshold     (0.01f),
+m_premixEnabled (false),
+m_premixPriority(0),
+m_premix        (NULL),
+m_mixLoad       (0.f)
+{
+
+}
+
+
+////////////////////////////////////////////////////////////
+SoundMixer::~SoundMixer()
+{
+    // Stop the premix first, it uses the voices from the streaming thread
+    delete m_premix;
+
+    for (std::vector<Sound*>::iterator it = m_sources.begin(); it != m_sources.end(); ++it)
+        delete *it;
+}
+
+
+////////////////////////////////////////////////////////////
+SoundMixer::Voice SoundMixer::play(const SoundBuffer& buffer, int priority)
+{
+    if ((buffer.getSampleCount() == 0) || (buffer.getChannelCount() == 0))
+        return InvalidVoice;
+
+    Lock lock(m_mutex);
+
+    VoiceState state;
+    state.buffer      = &buffer;
+    state.priority    = priority;
+    state.loop        = false;
+    state.volume      = 100.f;
+    state.pitch       = 1.f;
+    state.position    = Vector3f(0, 0, 0);
+    state.relative    = false;
+    state.minDistance = 1.f;
+    state.attenuation = 1.f;
+    state.changed     = true;
+    state.mode        = Virtual;
+    state.source      = NULL;
+    state.cursor      = 0;
+    state.audibility  = 0.f;
+    state.gains[0]    = 0.f;
+    state.gains[1]    = 0.f;
+    state.finished    = false;
+
+    Voice voice = m_nextVoice++;
+    if (m_nextVoice == InvalidVoice)
+        m_nextVoice++;
+
+    m_voices.insert(std::make_pair(voice, state));
+
+    return voice;
+}
+
+
+////////////////////////////////////////////////////////////
+void SoundMixer::stop(Voice voice)
+{
+    Lock lock(m_mutex);
+
+    VoiceTable::iterator it = m_voices.find(voice);
+    if (it != m_voices.end())
+    {
+        releaseSource(it->second);
+        m_voices.erase(it);
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void SoundMixer::stopAll()
+{
+    Lock lock(m_mutex);
+
+    for (VoiceTable::iterator it = m_voices.begin(); it != m_voices.end(); ++it)
+        releaseSource(it->second);
+
+    m_voices.clear();
+}
+
+
+////////////////////////////////////////////////////////////
+bool SoundMixer::isPlaying(Voice voice) const
+{
+    Lock lock(m_mutex);
+
+    VoiceTable::const_iterator it = m_voices.find(voice);
+
+    return (it != m_voices.end()) && !it->second.finished;
+}
+
+
+////////////////////////////////////////////////////////////
+void SoundMixer::setPriority(Voice voice, int priority)
+{
+    Lock lock(m_mutex);
+
+    VoiceTable::iterator it = m_voices.find(voice);
+    if (it != m_voices.end())
+        it->second.priority = priority;
+}
+
+
+////////////////////////////////////////////////////////////
+void SoundMixer::setLoop(Voice voice, bool loop)
+{
+    Lock lock(m_mutex);
+
+    VoiceTable::iterator it = m_voices.find(voice);
+    if (it != m_voices.end())
+    {
+        it->second.loop    = loop;
+        it->second.changed = true;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void SoundMixer::setVolume(Voice voice, float volume)
+{
+    Lock lock(m_mutex);
+
+    VoiceTable::iterator it = m_voices.find(voice);
+    if (it != m_voices.end())
+    {
+        it->second.volume  = volume;
+        it->second.changed = true;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void SoundMixer::setPitch(Voice voice, float pitch)
+{
+    Lock lock(m_mutex);
+
+    VoiceTable::iterator it = m_voices.find(voice);
+    if (it != m_voices.end())
+    {
+        it->second.pitch   = pitch;
+        it->second.changed = true;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void SoundMixer::setPosition(Voice voice, const Vector3f& position)
+{
+    Lock lock(m_mutex);
+
+    VoiceTable::iterator it = m_voices.find(voice);
+    if (it != m_voices.end())
+    {
+        it->second.position = position;
+        it->second.changed  = true;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void SoundMixer::setRelativeToListener(Voice voice, bool relative)
+{
+    Lock lock(m_mutex);
+
+    VoiceTable::iterator it = m_voices.find(voice);
+    if (it != m_voices.end())
+    {
+        it->second.relative = relative;
+        it->second.changed  = true;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void SoundMixer::setMinDistance(Voice voice, float distance)
+{
+    Lock lock(m_mutex);
+
+    VoiceTable::iterator it = m_voices.find(voice);
+    if (it != m_voices.end())
+    {
+        it->second.minDistance = distance;
+        it->second.changed     = true;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void SoundMixer::setAttenuation(Voice voice, float attenuation)
+{
+    Lock lock(m_mutex);
+
+    VoiceTable::iterator it = m_voices.find(voice);
+    if (it != m_voices.end())
+    {
+        it->second.attenuation = attenuation;
+        it->second.changed     = true;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void SoundMixer::setSourceCount(unsigned int count)
+{
+    Lock lock(m_mutex);
+
+    m_sourceCount = count;
+}
+
+
+////////////////////////////////////////////////////////////
+unsigned int SoundMixer::getSourceCount() const
+{
+    Lock lock(m_mutex);
+
+    return m_sourceCount;
+}
+
+
+////////////////////////////////////////////////////////////
+void SoundMixer::setAudibilityThreshold(float threshold)
+{
+    Lock lock(m_mutex);
+
+    m_threshold = threshold;
+}
+
+
+////////////////////////////////////////////////////////////
+void SoundMixer::setPremixEnabled(bool enabled, int maxPriority)
+{
+    Lock lock(m_mutex);
+
+    m_premixEnabled  = enabled;
+    m_premixPriority = maxPriority;
+}
+
+
+////////////////////////////////////////////////////////////
+void SoundMixer::update()
+{
+    float elapsed = m_clock.restart().asSeconds();
+
+    // Get the listener's frame of reference, for the spatialization of the voices
+    Vector3f direction = Listener::getDirection();
+    Vector3f up = Listener::getUpVector();
+    Vector3f right(direction.y * up.z - direction.z * up.y,
+                   direction.z * up.x - direction.x * up.z,
+                   direction.x * up.y - direction.y * up.x);
+    float rightLength = length(right);
+    if (rightLength > 0.f)
+        right /= rightLength;
+
+    bool premixNeeded = false;
+    {
+        Lock lock(m_mutex);
+
+        m_listenerPosition = Listener::getPosition();
+        m_listenerRight    = right;
+
+        // Advance the voices and remove the ones that are finished
+        std::vector<VoiceState*> voices;
+        voices.reserve(m_voices.size());
+        for (VoiceTable::iterator it = m_voices.begin(); it != m_voices.end();)
+        {
+            VoiceState& voice = it->second;
+            double frameCount = static_cast<double>(voice.buffer->getSampleCount() / voice.buffer->getChannelCount());
+
+            if (voice.mode == Real)
+            {
+                // The audio source knows where the voice is
+                if (voice.source->getStatus() == Sound::Stopped)
+                    voice.finished = true;
+                else
+                    voice.cursor = voice.source->getPlayingOffset().asSeconds() * voice.buffer->getSampleRate();
+            }
+            else if (voice.mode == Virtual)
+            {
+                // Nobody plays the voice: advance it according to the elapsed time
+                voice.cursor += elapsed * voice.buffer->getSampleRate() * voice.pitch;
+                if (voice.cursor >= frameCount)
+                {
+                    if (voice.loop)
+                        voice.cursor = std::fmod(voice.cursor, frameCount);
+                    else
+                        voice.finished = true;
+                }
+            }
+
+            if (voice.finished)
+            {
+                releaseSource(voice);
+                m_voices.erase(it++);
+            }
+            else
+            {
+                spatialize(voice);
+                voices.push_back(&voice);
+                ++it;
+            }
+        }
+
+        // The premix stream uses one of the audio sources; with a single source,
+        // it is given to the most important voice and the premix is not used
+        bool premixAvailable = m_premixEnabled && (m_sourceCount > 1);
+        unsigned int realCount = premixAvailable ? m_sourceCount - 1 : m_sourceCount;
+
+        // Sort the voices by importance, and decide how each of them is played
+        std::sort(voices.begin(), voices.end(), isMoreImportant<VoiceState>);
+        std::vector<Mode> modes(voices.size(), Virtual);
+        for (std::size_t i = 0; i < voices.size(); ++i)
+        {
+            const VoiceState& voice = *voices[i];
+            if (voice.audibility < m_threshold)
+                continue;
+
+            if (realCount > 0)
+            {
+                modes[i] = Real;
+                realCount--;
+            }
+            else if (premixAvailable && (voice.priority <= m_premixPriority) && (voice.buffer->getChannelCount() <= 2))
+            {
+                modes[i] = Premixed;
+                premixNeeded = true;
+            }
+        }
+
+        // Take the audio sources from the voices that lose them first...
+        for (std::size_t i = 0; i < voices.size(); ++i)
+        {
+            if (modes[i] != Real)
+            {
+                releaseSource(*voices[i]);
+                voices[i]->mode = modes[i];
+            }
+        }
+
+        // ... so that they can be given to the voices that gain them
+        for (std::size_t i = 0; i < voices.size(); ++i)
+        {
+            VoiceState& voice = *voices[i];
+            if ((modes[i] == Real) && (voice.mode != Real))
+            {
+                acquireSource(voice);
+            }
+            else if ((voice.mode == Real) && voice.changed)
+            {
+                voice.source->setLoop(voice.loop);
+                voice.source->setVolume(voice.volume);
+                voice.source->setPitch(voice.pitch);
+                voice.source->setPosition(voice.position);
+                voice.source->setRelativeToListener(voice.relative);
+                voice.source->setMinDistance(voice.minDistance);
+                voice.source->setAttenuation(voice.attenuation);
+            }
+            voice.changed = false;
+        }
+
+        // Destroy the audio sources that exceed the maximum count
+        while ((m_sources.size() > m_sourceCount) && !m_freeSources.empty())
+        {
+            Sound* source = m_freeSources.back();
+            m_freeSources.pop_back();
+            m_sources.erase(std::find(m_sources.begin(), m_sources.end(), source));
+            delete source;
+        }
+
+        if (!premixNeeded)
+            m_mixLoad = 0.f;
+    }
+
+    // Start or stop the premix stream; this must be done without holding
+    // the mutex, because the streaming thread locks it to mix the voices
+    if (premixNeeded)
+    {
+        if (!m_premix)
+            m_premix = new Premix(*this);
+        if (m_premix->getStatus() != SoundStream::Playing)
+            m_premix->play();
+    }
+    else if (m_premix && (m_premix->getStatus() != SoundStream::Stopped))
+    {
+        m_premix->stop();
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+unsigned int SoundMixer::getVoiceCount() const
+{
+    Lock lock(m_mutex);
+
+    return static_cast<unsigned int>(m_voices.size());
+}
+
+
+////////////////////////////////////////////////////////////
+unsigned int SoundMixer::getRealVoiceCount() const
+{
+    Lock lock(m_mutex);
+
+    unsigned int count = 0;
+    for (VoiceTable::const_iterator it = m_voices.begin(); it != m_voices.end(); ++it)
+        if (it->second.mode == Real)
+            count++;
+
+    return count;
+}
+
+
+////////////////////////////////////////////////////////////
+unsigned int SoundMixer::getPremixedVoiceCount() const
+{
+    Lock lock(m_mutex);
+
+    unsigned int count = 0;
+    for (VoiceTable::const_iterator it = m_voices.begin(); it != m_voices.end(); ++it)
+        if (it->second.mode == Premixed)
+            count++;
+
+    return count;
+}
+
+
+////////////////////////////////////////////////////////////
+unsigned int SoundMixer::getVirtualVoiceCount() const
+{
+    Lock lock(m_mutex);
+
+    unsigned int count = 0;
+    for (VoiceTable::const_iterator it = m_voices.begin(); it != m_voices.end(); ++it)
+        if (it->second.mode == Virtual)
+            count++;
+
+    return count;
+}
+
+
+////////////////////////////////////////////////////////////
+float SoundMixer::getMixLoad() const
+{
+    Lock lock(m_mutex);
+
+    return m_mixLoad;
+}
+
+
+////////////////////////////////////////////////////////////
+void SoundMixer::mix(Int16* samples, std::size_t frameCount, unsigned int sampleRate)
+{
+    Lock lock(m_mutex);
+
+    Clock clock;
+
+    m_mixBuffer.assign(frameCount * 2, 0.f);
+    float* output = &m_mixBuffer[0];
+
+    for (VoiceTable::iterator it = m_voices.begin(); it != m_voices.end(); ++it)
+    {
+        VoiceState& voice = it->second;
+        if ((voice.mode != Premixed) || voice.finished)
+            continue;
+
+        const Int16* input = voice.buffer->getSamples();
+        unsigned int channelCount = voice.buffer->getChannelCount();
+        std::size_t voiceFrames = voice.buffer->getSampleCount() / channelCount;
+        double step = static_cast<double>(voice.buffer->getSampleRate()) / sampleRate * voice.pitch;
+
+        // Resample with linear interpolation, and apply the gains of the voice
+        for (std::size_t frame = 0; frame < frameCount; ++frame)
+        {
+            if (voice.cursor >= voiceFrames)
+            {
+                if (!voice.loop)
+                {
+                    voice.finished = true;
+                    break;
+                }
+                voice.cursor = std::fmod(voice.cursor, static_cast<double>(voiceFrames));
+            }
+
+            std::size_t index = static_cast<std::size_t>(voice.cursor);
+            std::size_t next = index + 1 < voiceFrames ? index + 1 : (voice.loop ? 0 : index);
+            float ratio = static_cast<float>(voice.cursor - index);
+
+            const Int16* first  = input + index * channelCount;
+            const Int16* second = input + next * channelCount;
+            float left  = first[0] + (second[0] - first[0]) * ratio;
+            float right = (channelCount == 2) ? first[1] + (second[1] - first[1]) * ratio : left;
+
+            output[frame * 2]     += left * voice.gains[0];
+            output[frame * 2 + 1] += right * voice.gains[1];
+
+            voice.cursor += step;
+        }
+    }
+
+    // Convert the accumulated samples back to 16 bits, with saturation
+    for (std::size_t i = 0; i < frameCount * 2; ++i)
+    {
+        float sample = output[i];
+        if (sample > 32767.f)
+            sample = 32767.f;
+        else if (sample < -32768.f)
+            sample = -32768.f;
+        samples[i] = static_cast<Int16>(sample);
+    }
+
+    if (frameCount > 0)
+        m_mixLoad = clock.getElapsedTime().asSeconds() * sampleRate / frameCount;
+}
+
+
+////////////////////////////////////////////////////////////
+void SoundMixer::spatialize(VoiceState& voice) const
+{
+    float volume = voice.volume / 100.f;
+
+    // Like OpenAL, only spatialize mono sounds
+    if (voice.buffer->getChannelCount() != 1)
+    {
+        voice.audibility = volume;
+        voice.gains[0]   = volume;
+        voice.gains[1]   = volume;
+        return;
+    }
+
+    Vector3f offset = voice.relative ? voice.position : voice.position - m_listenerPosition;
+    float distance = length(offset);
+
+    // Same model as OpenAL (AL_INVERSE_DISTANCE_CLAMPED)
+    float gain = 1.f;
+    if ((distance > voice.minDistance) && (voice.minDistance > 0.f))
+        gain = voice.minDistance / (voice.minDistance + voice.attenuation * (distance - voice.minDistance));
+
+    voice.audibility = volume * gain;
+
+    // Equal-power panning along the right axis of the listener
+    float pan = distance > 0.f ? (offset.x * m_listenerRight.x + offset.y * m_listenerRight.y + offset.z * m_listenerRight.z) / distance : 0.f;
+    float angle = (pan + 1.f) * 0.785398163f;
+    voice.gains[0] = voice.audibility * std::cos(angle);
+    voice.gains[1] = voice.audibility * std::sin(angle);
+}
+
+
+////////////////////////////////////////////////////////////
+void SoundMixer::acquireSource(VoiceState& voice)
+{
+    Sound* source = NULL;
+    if (!m_freeSources.empty())
+    {
+        source = m_freeSources.back();
+        m_freeSources.pop_back();
+    }
+    else if (m_sources.size() < m_sourceCount)
+    {
+        source = new Sound;
+        m_sources.push_back(source);
+    }
+    else
+    {
+        return;
+    }
+
+    source->setBuffer(*voice.buffer);
+    source->setLoop(voice.loop);
+    source->setVolume(voice.volume);
+    source->setPitch(voice.pitch);
+    source->setPosition(voice.position);
+    source->setRelativeToListener(voice.relative);
+    source->setMinDistance(voice.minDistance);
+    source->setAttenuation(voice.attenuation);
+    source->play();
+    source->setPlayingOffset(seconds(static_cast<float>(voice.cursor / voice.buffer->getSampleRate())));
+
+    voice.source = source;
+    voice.mode   = Real;
+}
+
+
+////////////////////////////////////////////////////////////
+void SoundMixer::releaseSource(VoiceState& voice)
+{
+    if (voice.source)
+    {
+        voice.source->stop();
+        m_freeSources.push_back(voice.source);
+        voice.source = NULL;
+        voice.mode   = Virtual;
+    }
+}
+
+} // namespace sf
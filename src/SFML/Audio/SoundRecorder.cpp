@@ -28,8 +28,12 @@
 #include <SFML/Audio/SoundRecorder.hpp>
 #include <SFML/Audio/AudioDevice.hpp>
 #include <SFML/Audio/ALCheck.hpp>
+#include <SFML/Audio/RingBuffer.hpp>
+#include <SFML/Audio/SampleConversion.hpp>
+#include <SFML/System/Lock.hpp>
 #include <SFML/System/Sleep.hpp>
 #include <SFML/System/Err.hpp>
+#include <algorithm>
 #include <cstring>
 
 #ifdef _MSC_VER
@@ -40,6 +44,20 @@
 namespace
 {
     ALCdevice* captureDevice = NULL;
+
+    // Shortest time the recording threads sleep between two polls
+    const sf::Time minPollInterval = sf::milliseconds(1);
+
+    // Duration of audio that the ring buffer can hold
+    const sf::Time ringBufferDuration = sf::seconds(2);
+
+    // Time to wait until a given number of frames is captured, clamped to reasonable bounds
+    sf::Time getWaitTime(std::size_t frames, unsigned int sampleRate, sf::Time maxInterval)
+    {
+        sf::Time wait = sf::microseconds(static_cast<sf::Int64>(frames) * 1000000 / sampleRate);
+
+        return std::max(minPollInterval, std::min(wait, maxInterval));
+    }
 }
 
 namespace sf
@@ -47,9 +65,18 @@ namespace sf
 ////////////////////////////////////////////////////////////
 SoundRecorder::SoundRecorder() :
 m_thread            (&SoundRecorder::record, this),
+m_captureThread     (&SoundRecorder::capture, this),
+m_ringBuffer        (new priv::RingBuffer),
 m_sampleRate        (0),
+m_channelCount      (1),
+m_floatCapture      (false),
+m_deviceFloat       (false),
+m_frameSize         (0),
+m_deviceCapacity    (0),
 m_processingInterval(milliseconds(100)),
-m_isCapturing       (false)
+m_isCapturing       (false),
+m_latency           (Time::Zero),
+m_overrunCount      (0)
 {
     priv::ensureALInit();
 
@@ -61,7 +88,13 @@ m_isCapturing       (false)
 ////////////////////////////////////////////////////////////
 SoundRecorder::~SoundRecorder()
 {
-    // Nothing to do
+    // The recording threads use the ring buffer: make sure that they are finished
+    // before destroying it, in case the derived class didn't call stop()
+    m_isCapturing = false;
+    m_thread.wait();
+    m_captureThread.wait();
+
+    delete m_ringBuffer;
 }
 
 
@@ -82,33 +115,38 @@ bool SoundRecorder::start(unsigned int sampleRate)
         return false;
     }
 
-    // Open the capture device for capturing 16 bits mono samples
-    captureDevice = alcCaptureOpenDevice(m_deviceName.c_str(), sampleRate, AL_FORMAT_MONO16, sampleRate);
-    if (!captureDevice)
-    {
-        err() << "Failed to open the audio capture device with the name: " << m_deviceName << std::endl;
-        return false;
-    }
-
-    // Clear the array of samples
-    m_samples.clear();
-
     // Store the sample rate
     m_sampleRate = sampleRate;
 
+    // Open the capture device
+    if (!openDevice())
+        return false;
+
+    // Reset the statistics
+    {
+        Lock lock(m_statsMutex);
+        m_latency = Time::Zero;
+        m_overrunCount = 0;
+    }
+
     // Notify derived class
     if (onStart())
     {
         // Start the capture
         alcCaptureStart(captureDevice);
 
-        // Start the capture in a new thread, to avoid blocking the main thread
+        // Start the capture in new threads, to avoid blocking the main thread
         m_isCapturing = true;
+        m_captureThread.launch();
         m_thread.launch();
 
         return true;
     }
 
+    // Close the device, it won't be used
+    alcCaptureCloseDevice(captureDevice);
+    captureDevice = NULL;
+
     return false;
 }
 
@@ -169,26 +207,25 @@ bool SoundRecorder::setDevice(const std::string& name)
 
     if (m_isCapturing)
     {
-        // Stop the capturing thread
+        // Stop the capturing threads
         m_isCapturing = false;
         m_thread.wait();
 
-        // Open the requested capture device for capturing 16 bits mono samples
-        captureDevice = alcCaptureOpenDevice(name.c_str(), m_sampleRate, AL_FORMAT_MONO16, m_sampleRate);
-        if (!captureDevice)
+        // Open the requested capture device
+        if (!openDevice())
         {
             // Notify derived class
             onStop();
 
-            err() << "Failed to open the audio capture device with the name: " << m_deviceName << std::endl;
             return false;
         }
 
         // Start the capture
         alcCaptureStart(captureDevice);
 
-        // Start the capture in a new thread, to avoid blocking the main thread
+        // Start the capture in new threads, to avoid blocking the main thread
         m_isCapturing = true;
+        m_captureThread.launch();
         m_thread.launch();
     }
 
@@ -203,6 +240,38 @@ const std::string& SoundRecorder::getDevice() const
 }
 
 
+////////////////////////////////////////////////////////////
+void SoundRecorder::setChannelCount(unsigned int channelCount)
+{
+    m_channelCount = channelCount;
+}
+
+
+////////////////////////////////////////////////////////////
+unsigned int SoundRecorder::getChannelCount() const
+{
+    return m_channelCount;
+}
+
+
+////////////////////////////////////////////////////////////
+Time SoundRecorder::getLatency() const
+{
+    Lock lock(m_statsMutex);
+
+    return m_latency;
+}
+
+
+////////////////////////////////////////////////////////////
+Uint64 SoundRecorder::getOverrunCount() const
+{
+    Lock lock(m_statsMutex);
+
+    return m_overrunCount;
+}
+
+
 ////////////////////////////////////////////////////////////
 bool SoundRecorder::isAvailable()
 {
@@ -218,6 +287,13 @@ void SoundRecorder::setProcessingInterval(sf::Time interval)
 }
 
 
+////////////////////////////////////////////////////////////
+void SoundRecorder::setFloatCapture(bool enabled)
+{
+    m_floatCapture = enabled;
+}
+
+
 ////////////////////////////////////////////////////////////
 bool SoundRecorder::onStart()
 {
@@ -226,6 +302,18 @@ bool SoundRecorder::onStart()
 }
 
 
+////////////////////////////////////////////////////////////
+bool SoundRecorder::onProcessSamples(const float* samples, std::size_t sampleCount)
+{
+    // Convert the samples to 16 bits
+    m_samples.resize(sampleCount);
+    if (sampleCount > 0)
+        priv::convertSamples(samples, &m_samples[0], sampleCount);
+
+    return onProcessSamples(m_samples.empty() ? NULL : &m_samples[0], sampleCount);
+}
+
+
 ////////////////////////////////////////////////////////////
 void SoundRecorder::onStop()
 {
@@ -236,55 +324,188 @@ void SoundRecorder::onStop()
 ////////////////////////////////////////////////////////////
 void SoundRecorder::record()
 {
+    std::size_t chunkFrames = std::max<std::size_t>(1, static_cast<std::size_t>(m_processingInterval.asSeconds() * m_sampleRate));
+    std::size_t chunkSize = chunkFrames * m_frameSize;
+    bool process = true;
+
     while (m_isCapturing)
     {
-        // Process available samples
-        processCapturedSamples();
+        // Process all the complete chunks
+        std::size_t available = m_ringBuffer->getReadSize();
+        while ((available >= chunkSize) && process)
+        {
+            process = processChunk(chunkSize);
+            available -= chunkSize;
+        }
 
-        // Don't bother the CPU while waiting for more captured data
-        sleep(m_processingInterval);
+        // The user wants to stop the capture
+        if (!process)
+        {
+            m_isCapturing = false;
+            break;
+        }
+
+        // Sleep until the next chunk is complete
+        sleep(getWaitTime((chunkSize - available) / m_frameSize, m_sampleRate, m_processingInterval));
     }
 
     // Capture is finished : clean up everything
-    cleanup();
+    m_captureThread.wait();
+    cleanup(process);
+}
+
+
+////////////////////////////////////////////////////////////
+void SoundRecorder::capture()
+{
+    std::size_t chunkFrames = std::max<std::size_t>(1, static_cast<std::size_t>(m_processingInterval.asSeconds() * m_sampleRate));
+
+    while (m_isCapturing)
+    {
+        std::size_t left = readDevice();
+
+        // Poll again when the device is expected to hold a full chunk; if it is
+        // more than half full (the ring buffer is full), poll as soon as possible
+        if (left > m_deviceCapacity / 2)
+            sleep(minPollInterval);
+        else
+            sleep(getWaitTime(chunkFrames > left ? chunkFrames - left : 0, m_sampleRate, m_processingInterval));
+    }
 }
 
 
 ////////////////////////////////////////////////////////////
-void SoundRecorder::processCapturedSamples()
+bool SoundRecorder::openDevice()
+{
+    // Use floating point samples if the derived class wants them and the driver supports them
+    ALenum format = 0;
+    m_deviceFloat = false;
+    if (m_floatCapture && (m_channelCount <= 2))
+    {
+        format = priv::AudioDevice::getFloatFormatFromChannelCount(m_channelCount);
+        m_deviceFloat = (format != 0);
+    }
+    if (!m_deviceFloat)
+        format = priv::AudioDevice::getFormatFromChannelCount(m_channelCount);
+
+    if (format == 0)
+    {
+        err() << "Failed to open the audio capture device: unsupported number of channels (" << m_channelCount << ")" << std::endl;
+        return false;
+    }
+
+    // Open the capture device, with room for 1 second of samples
+    captureDevice = alcCaptureOpenDevice(m_deviceName.c_str(), m_sampleRate, format, m_sampleRate);
+    if (!captureDevice)
+    {
+        err() << "Failed to open the audio capture device with the name: " << m_deviceName << std::endl;
+        return false;
+    }
+
+    // Allocate all the buffers now, so that the capture never allocates memory
+    m_frameSize = m_channelCount * (m_deviceFloat ? sizeof(float) : sizeof(Int16));
+    m_deviceCapacity = m_sampleRate;
+    m_deviceSamples.resize(m_deviceCapacity * m_frameSize);
+    m_ringBuffer->resize(static_cast<std::size_t>(ringBufferDuration.asSeconds() * m_sampleRate) * m_frameSize);
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t SoundRecorder::readDevice()
 {
     // Get the number of samples available
-    ALCint samplesAvailable;
+    ALCint samplesAvailable = 0;
     alcGetIntegerv(captureDevice, ALC_CAPTURE_SAMPLES, 1, &samplesAvailable);
 
-    if (samplesAvailable > 0)
+    std::size_t available = samplesAvailable > 0 ? static_cast<std::size_t>(samplesAvailable) : 0;
+    if (available >= m_deviceCapacity)
     {
-        // Get the recorded samples
-        m_samples.resize(samplesAvailable);
-        alcCaptureSamples(captureDevice, &m_samples[0], samplesAvailable);
+        // The device buffer is full: samples are being lost
+        Lock lock(m_statsMutex);
+        m_overrunCount++;
+    }
 
-        // Forward them to the derived class
-        if (!onProcessSamples(&m_samples[0], m_samples.size()))
-        {
-            // The user wants to stop the capture
-            m_isCapturing = false;
-        }
+    // Move as many whole frames as possible to the ring buffer
+    std::size_t frames = std::min(available, m_ringBuffer->getWriteSize() / m_frameSize);
+    if (frames > 0)
+    {
+        alcCaptureSamples(captureDevice, &m_deviceSamples[0], static_cast<ALCsizei>(frames));
+        m_ringBuffer->write(&m_deviceSamples[0], frames * m_frameSize);
+    }
+
+    return available - frames;
+}
+
+
+////////////////////////////////////////////////////////////
+bool SoundRecorder::processChunk(std::size_t size)
+{
+    m_chunk.resize(size);
+    size = m_ringBuffer->read(&m_chunk[0], size);
+
+    // Measure the age of the first sample of the chunk: the chunk itself,
+    // plus what was captured after it and is still waiting in the buffers
+    ALCint deviceFrames = 0;
+    alcGetIntegerv(captureDevice, ALC_CAPTURE_SAMPLES, 1, &deviceFrames);
+    Uint64 frames = (size + m_ringBuffer->getReadSize()) / m_frameSize + std::max(deviceFrames, 0);
+    {
+        Lock lock(m_statsMutex);
+        m_latency = microseconds(static_cast<Int64>(frames * 1000000 / m_sampleRate));
+    }
+
+    // Convert the samples if the device format is not the one wanted by the derived class
+    std::size_t sampleCount = size / m_frameSize * m_channelCount;
+    if (sampleCount == 0)
+        return true;
+
+    if (m_deviceFloat)
+    {
+        const float* samples = reinterpret_cast<const float*>(&m_chunk[0]);
+        return onProcessSamples(samples, sampleCount);
+    }
+    else if (m_floatCapture)
+    {
+        const Int16* samples = reinterpret_cast<const Int16*>(&m_chunk[0]);
+        m_floatSamples.resize(sampleCount);
+        priv::convertSamples(samples, &m_floatSamples[0], sampleCount);
+
+        return onProcessSamples(&m_floatSamples[0], sampleCount);
+    }
+    else
+    {
+        const Int16* samples = reinterpret_cast<const Int16*>(&m_chunk[0]);
+        return onProcessSamples(samples, sampleCount);
     }
 }
 
 
 ////////////////////////////////////////////////////////////
-void SoundRecorder::cleanup()
+void SoundRecorder::cleanup(bool process)
 {
     // Stop the capture
     alcCaptureStop(captureDevice);
 
-    // Get the samples left in the buffer
-    processCapturedSamples();
+    // Process the samples left in the buffers
+    if (process)
+    {
+        std::size_t left;
+        do
+        {
+            left = readDevice();
+
+            std::size_t size = m_ringBuffer->getReadSize();
+            if ((size > 0) && !processChunk(size))
+                break;
+        }
+        while (left > 0);
+    }
 
     // Close the device
     alcCaptureCloseDevice(captureDevice);
     captureDevice = NULL;
+    m_ringBuffer->clear();
 }
 
 } // namespace sf
@@ -26,13 +26,21 @@
 // Headers
 ////////////////////////////////////////////////////////////
 #include <SFML/Audio/SoundSource.hpp>
+#include <SFML/Audio/AudioDevice.hpp>
 #include <SFML/Audio/ALCheck.hpp>
 
 
 namespace sf
 {
 ////////////////////////////////////////////////////////////
-SoundSource::SoundSource()
+SoundSource::SoundSource() :
+m_pitch      (1.f),
+m_volume     (100.f),
+m_position   (0.f, 0.f, 0.f),
+m_relative   (false),
+m_minDistance(1.f),
+m_attenuation(1.f),
+m_changes    (0)
 {
     priv::ensureALInit();
 
@@ -42,25 +50,30 @@ SoundSource::SoundSource()
 
 
 ////////////////////////////////////////////////////////////
-SoundSource::SoundSource(const SoundSource& copy)
+SoundSource::SoundSource(const SoundSource& copy) :
+m_pitch      (copy.m_pitch),
+m_volume     (copy.m_volume),
+m_position   (copy.m_position),
+m_relative   (copy.m_relative),
+m_minDistance(copy.m_minDistance),
+m_attenuation(copy.m_attenuation),
+m_changes    (0)
 {
     priv::ensureALInit();
 
     alCheck(alGenSources(1, &m_source));
     alCheck(alSourcei(m_source, AL_BUFFER, 0));
 
-    setPitch(copy.getPitch());
-    setVolume(copy.getVolume());
-    setPosition(copy.getPosition());
-    setRelativeToListener(copy.isRelativeToListener());
-    setMinDistance(copy.getMinDistance());
-    setAttenuation(copy.getAttenuation());
+    setChanged(AllChanges);
 }
 
 
 ////////////////////////////////////////////////////////////
 SoundSource::~SoundSource()
 {
+    if (priv::AudioDevice::isDeferringUpdates())
+        priv::AudioDevice::removePendingSource(this);
+
     alCheck(alSourcei(m_source, AL_BUFFER, 0));
     alCheck(alDeleteSources(1, &m_source));
 }
@@ -69,108 +82,114 @@ SoundSource::~SoundSource()
 ////////////////////////////////////////////////////////////
 void SoundSource::setPitch(float pitch)
 {
-    alCheck(alSourcef(m_source, AL_PITCH, pitch));
+    if (pitch != m_pitch)
+    {
+        m_pitch = pitch;
+        setChanged(PitchChange);
+    }
 }
 
 
 ////////////////////////////////////////////////////////////
 void SoundSource::setVolume(float volume)
 {
-    alCheck(alSourcef(m_source, AL_GAIN, volume * 0.01f));
+    if (volume != m_volume)
+    {
+        m_volume = volume;
+        setChanged(VolumeChange);
+    }
 }
 
 ////////////////////////////////////////////////////////////
 void SoundSource::setPosition(float x, float y, float z)
 {
-    alCheck(alSource3f(m_source, AL_POSITION, x, y, z));
+    setPosition(Vector3f(x, y, z));
 }
 
 
 ////////////////////////////////////////////////////////////
 void SoundSource::setPosition(const Vector3f& position)
 {
-    setPosition(position.x, position.y, position.z);
+    if (position != m_position)
+    {
+        m_position = position;
+        setChanged(PositionChange);
+    }
 }
 
 
 ////////////////////////////////////////////////////////////
 void SoundSource::setRelativeToListener(bool relative)
 {
-    alCheck(alSourcei(m_source, AL_SOURCE_RELATIVE, relative));
+    if (relative != m_relative)
+    {
+        m_relative = relative;
+        setChanged(RelativeChange);
+    }
 }
 
 
 ////////////////////////////////////////////////////////////
 void SoundSource::setMinDistance(float distance)
 {
-    alCheck(alSourcef(m_source, AL_REFERENCE_DISTANCE, distance));
+    if (distance != m_minDistance)
+    {
+        m_minDistance = distance;
+        setChanged(MinDistanceChange);
+    }
 }
 
 
 ////////////////////////////////////////////////////////////
 void SoundSource::setAttenuation(float attenuation)
 {
-    alCheck(alSourcef(m_source, AL_ROLLOFF_FACTOR, attenuation));
+    if (attenuation != m_attenuation)
+    {
+        m_attenuation = attenuation;
+        setChanged(AttenuationChange);
+    }
 }
 
 
 ////////////////////////////////////////////////////////////
 float SoundSource::getPitch() const
 {
-    ALfloat pitch;
-    alCheck(alGetSourcef(m_source, AL_PITCH, &pitch));
-
-    return pitch;
+    return m_pitch;
 }
 
 
 ////////////////////////////////////////////////////////////
 float SoundSource::getVolume() const
 {
-    ALfloat gain;
-    alCheck(alGetSourcef(m_source, AL_GAIN, &gain));
-
-    return gain * 100.f;
+    return m_volume;
 }
 
 
 ////////////////////////////////////////////////////////////
 Vector3f SoundSource::getPosition() const
 {
-    Vector3f position;
-    alCheck(alGetSource3f(m_source, AL_POSITION, &position.x, &position.y, &position.z));
-
-    return position;
+    return m_position;
 }
 
 
 ////////////////////////////////////////////////////////////
 bool SoundSource::isRelativeToListener() const
 {
-    ALint relative;
-    alCheck(alGetSourcei(m_source, AL_SOURCE_RELATIVE, &relative));
-
-    return relative != 0;
+    return m_relative;
 }
 
 
 ////////////////////////////////////////////////////////////
 float SoundSource::getMinDistance() const
 {
-    ALfloat distance;
-    alCheck(alGetSourcef(m_source, AL_REFERENCE_DISTANCE, &distance));
-
-    return distance;
+    return m_minDistance;
 }
 
 
 ////////////////////////////////////////////////////////////
 float SoundSource::getAttenuation() const
 {
-    ALfloat attenuation;
-    alCheck(alGetSourcef(m_source, AL_ROLLOFF_FACTOR, &attenuation));
-
-    return attenuation;
+    return m_attenuation;
 }
 
 
@@ -191,4 +210,50 @@ SoundSource::Status SoundSource::getStatus() const
     return Stopped;
 }
 
+
+////////////////////////////////////////////////////////////
+void SoundSource::applyChanges()
+{
+    if (m_changes == 0)
+        return;
+
+    if (m_changes & PitchChange)
+        alCheck(alSourcef(m_source, AL_PITCH, m_pitch));
+
+    if (m_changes & VolumeChange)
+        alCheck(alSourcef(m_source, AL_GAIN, m_volume * 0.01f));
+
+    if (m_changes & PositionChange)
+        alCheck(alSource3f(m_source, AL_POSITION, m_position.x, m_position.y, m_position.z));
+
+    if (m_changes & RelativeChange)
+        alCheck(alSourcei(m_source, AL_SOURCE_RELATIVE, m_relative));
+
+    if (m_changes & MinDistanceChange)
+        alCheck(alSourcef(m_source, AL_REFERENCE_DISTANCE, m_minDistance));
+
+    if (m_changes & AttenuationChange)
+        alCheck(alSourcef(m_source, AL_ROLLOFF_FACTOR, m_attenuation));
+
+    m_changes = 0;
+}
+
+
+////////////////////////////////////////////////////////////
+void SoundSource::setChanged(Change change)
+{
+    // Apply the change now, unless it must wait for the next commit
+    if (priv::AudioDevice::isDeferringUpdates())
+    {
+        if (m_changes == 0)
+            priv::AudioDevice::addPendingSource(this);
+        m_changes |= change;
+    }
+    else
+    {
+        m_changes |= change;
+        applyChanges();
+    }
+}
+
 } // namespace sf
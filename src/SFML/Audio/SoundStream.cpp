@@ -26,27 +26,33 @@
 // Headers
 ////////////////////////////////////////////////////////////
 #include <SFML/Audio/SoundStream.hpp>
+#include <SFML/Audio/SoundEffect.hpp>
+#include <SFML/Audio/StreamScheduler.hpp>
 #include <SFML/Audio/AudioDevice.hpp>
 #include <SFML/Audio/ALCheck.hpp>
-#include <SFML/System/Sleep.hpp>
+#include <SFML/Audio/SampleConversion.hpp>
 #include <SFML/System/Err.hpp>
-
-#ifdef _MSC_VER
-    #pragma warning(disable : 4355) // 'this' used in base member initializer list
-#endif
+#include <algorithm>
 
 
 namespace sf
 {
 ////////////////////////////////////////////////////////////
 SoundStream::SoundStream() :
-m_thread          (&SoundStream::streamData, this),
 m_isStreaming     (false),
+m_requestStop     (false),
+m_bufferCount     (3),
+m_bufferDuration  (seconds(1)),
 m_channelCount    (0),
 m_sampleRate      (0),
 m_format          (0),
+m_floatFormat     (0),
+m_floatSamples    (false),
+m_effect          (NULL),
+m_playbackRate    (0),
 m_loop            (false),
-m_samplesProcessed(0)
+m_samplesProcessed(0),
+m_underrunCount   (0)
 {
 
 }
@@ -66,8 +72,9 @@ void SoundStream::initialize(unsigned int channelCount, unsigned int sampleRate)
     m_channelCount = channelCount;
     m_sampleRate   = sampleRate;
 
-    // Deduce the format from the number of channels
-    m_format = priv::AudioDevice::getFormatFromChannelCount(channelCount);
+    // Deduce the formats from the number of channels
+    m_format      = priv::AudioDevice::getFormatFromChannelCount(channelCount);
+    m_floatFormat = priv::AudioDevice::getFloatFormatFromChannelCount(channelCount);
 
     // Check if the format is valid
     if (m_format == 0)
@@ -79,6 +86,14 @@ void SoundStream::initialize(unsigned int channelCount, unsigned int sampleRate)
 }
 
 
+////////////////////////////////////////////////////////////
+void SoundStream::setFloatSamples(bool enabled)
+{
+    m_floatSamples = enabled;
+}
+
+
+
 ////////////////////////////////////////////////////////////
 void SoundStream::play()
 {
@@ -89,6 +104,9 @@ void SoundStream::play()
         return;
     }
 
+    // Send the deferred parameters before the source starts
+    applyChanges();
+
     // If the sound is already playing (probably paused), just resume it
     if (m_isStreaming)
     {
@@ -99,10 +117,9 @@ void SoundStream::play()
     // Move to the beginning
     onSeek(Time::Zero);
 
-    // Start updating the stream in a separate thread to avoid blocking the application
+    // Start streaming; the queue is then kept filled by the streaming scheduler
     m_samplesProcessed = 0;
-    m_isStreaming = true;
-    m_thread.launch();
+    startStreaming();
 }
 
 
@@ -116,9 +133,9 @@ void SoundStream::pause()
 ////////////////////////////////////////////////////////////
 void SoundStream::stop()
 {
-    // Wait for the thread to terminate
-    m_isStreaming = false;
-    m_thread.wait();
+    // If the scheduler had already finished with the stream, it is already stopped
+    if (priv::StreamScheduler::remove(this))
+        stopStreaming();
 }
 
 
@@ -141,7 +158,7 @@ SoundStream::Status SoundStream::getStatus() const
 {
     Status status = SoundSource::getStatus();
 
-    // To compensate for the lag between play() and alSourceplay()
+    // To compensate for the lag between an underrun and its recovery
     if ((status == Stopped) && m_isStreaming)
         status = Playing;
 
@@ -158,10 +175,11 @@ void SoundStream::setPlayingOffset(Time timeOffset)
     // Let the derived class update the current position
     onSeek(timeOffset);
 
-    // Restart streaming
-    m_samplesProcessed = static_cast<Uint64>(timeOffset.asSeconds() * m_sampleRate * m_channelCount);
-    m_isStreaming = true;
-    m_thread.launch();
+    // Restart streaming; the position is rounded to the nearest sample, so that
+    // converting a sample offset to a Time and back gives exactly the same sample
+    Uint64 frame = (static_cast<Uint64>(std::max(timeOffset, Time::Zero).asMicroseconds()) * m_sampleRate + 500000) / 1000000;
+    m_samplesProcessed = frame * m_channelCount;
+    startStreaming();
 }
 
 
@@ -170,10 +188,15 @@ Time SoundStream::getPlayingOffset() const
 {
     if (m_sampleRate && m_channelCount)
     {
-        ALfloat secs = 0.f;
-        alCheck(alGetSourcef(m_source, AL_SEC_OFFSET, &secs));
+        ALint offset = 0;
+        alCheck(alGetSourcei(m_source, AL_SAMPLE_OFFSET, &offset));
+
+        // The offset in the current buffer is at the rate of the played samples
+        // (which differs from the rate of the stream if the effect resamples)
+        Uint64 playbackRate = m_playbackRate ? m_playbackRate : m_sampleRate;
+        Uint64 frames = m_samplesProcessed / m_channelCount + static_cast<Uint64>(offset) * m_sampleRate / playbackRate;
 
-        return seconds(secs + static_cast<float>(m_samplesProcessed) / m_sampleRate / m_channelCount);
+        return microseconds(static_cast<Int64>(frames * 1000000 / m_sampleRate));
     }
     else
     {
@@ -197,98 +220,123 @@ bool SoundStream::getLoop() const
 
 
 ////////////////////////////////////////////////////////////
-void SoundStream::streamData()
+void SoundStream::setBufferCount(unsigned int count)
 {
-    // Create the buffers
-    alCheck(alGenBuffers(BufferCount, m_buffers));
-    for (int i = 0; i < BufferCount; ++i)
-        m_endBuffers[i] = false;
+    m_bufferCount = std::max(count, 2u);
+}
 
-    // Fill the queue
-    bool requestStop = fillQueue();
 
-    // Play the sound
-    alCheck(alSourcePlay(m_source));
+////////////////////////////////////////////////////////////
+unsigned int SoundStream::getBufferCount() const
+{
+    return m_bufferCount;
+}
+
+
+////////////////////////////////////////////////////////////
+void SoundStream::setBufferDuration(Time duration)
+{
+    m_bufferDuration = std::max(duration, milliseconds(1));
+}
+
+
+////////////////////////////////////////////////////////////
+Time SoundStream::getBufferDuration() const
+{
+    return m_bufferDuration;
+}
+
+
+////////////////////////////////////////////////////////////
+Uint64 SoundStream::getUnderrunCount() const
+{
+    return m_underrunCount;
+}
+
+
+////////////////////////////////////////////////////////////
+void SoundStream::setEffect(SoundEffect* effect)
+{
+    m_effect = effect;
+}
+
 
-    while (m_isStreaming)
+////////////////////////////////////////////////////////////
+SoundEffect* SoundStream::getEffect() const
+{
+    return m_effect;
+}
+
+
+////////////////////////////////////////////////////////////
+bool SoundStream::onGetData(FloatChunk& data)
+{
+    // Request 16 bits samples and convert them
+    Chunk chunk = {NULL, 0};
+    bool result = onGetData(chunk);
+
+    if (chunk.samples && chunk.sampleCount)
     {
-        // The stream has been interrupted!
-        if (SoundSource::getStatus() == Stopped)
-        {
-            if (!requestStop)
-            {
-                // Just continue
-                alCheck(alSourcePlay(m_source));
-            }
-            else
-            {
-                // End streaming
-                m_isStreaming = false;
-            }
-        }
+        m_convertedChunk.resize(chunk.sampleCount);
+        priv::convertSamples(chunk.samples, &m_convertedChunk[0], chunk.sampleCount);
 
-        // Get the number of buffers that have been processed (ie. ready for reuse)
-        ALint nbProcessed = 0;
-        alCheck(alGetSourcei(m_source, AL_BUFFERS_PROCESSED, &nbProcessed));
+        data.samples     = &m_convertedChunk[0];
+        data.sampleCount = chunk.sampleCount;
+    }
 
-        while (nbProcessed--)
-        {
-            // Pop the first unused buffer from the queue
-            ALuint buffer;
-            alCheck(alSourceUnqueueBuffers(m_source, 1, &buffer));
-
-            // Find its number
-            unsigned int bufferNum = 0;
-            for (int i = 0; i < BufferCount; ++i)
-                if (m_buffers[i] == buffer)
-                {
-                    bufferNum = i;
-                    break;
-                }
-
-            // Retrieve its size and add it to the samples count
-            if (m_endBuffers[bufferNum])
-            {
-                // This was the last buffer: reset the sample count
-                m_samplesProcessed = 0;
-                m_endBuffers[bufferNum] = false;
-            }
-            else
-            {
-                ALint size, bits;
-                alCheck(alGetBufferi(buffer, AL_SIZE, &size));
-                alCheck(alGetBufferi(buffer, AL_BITS, &bits));
-
-                // Bits can be 0 if the format or parameters are corrupt, avoid division by zero
-                if (bits == 0)
-                {
-                    err() << "Bits in sound stream are 0: make sure that the audio format is not corrupt "
-                          << "and initialize() has been called correctly" << std::endl;
-
-                    // Abort streaming (exit main loop)
-                    m_isStreaming = false;
-                    requestStop = true;
-                    break;
-                }
-                else
-                {
-                    m_samplesProcessed += size / (bits / 8);
-                }
-            }
+    return result;
+}
 
-            // Fill it and push it back into the playing queue
-            if (!requestStop)
-            {
-                if (fillAndPushBuffer(bufferNum))
-                    requestStop = true;
-            }
-        }
 
-        // Leave some time for the other threads if the stream is still playing
-        if (SoundSource::getStatus() != Stopped)
-            sleep(milliseconds(10));
+////////////////////////////////////////////////////////////
+Int64 SoundStream::onLoop()
+{
+    // Return to the beginning of the stream source
+    onSeek(Time::Zero);
+
+    return 0;
+}
+
+
+////////////////////////////////////////////////////////////
+void SoundStream::startStreaming()
+{
+    // Create the buffers
+    std::vector<ALuint> identifiers(m_bufferCount);
+    alCheck(alGenBuffers(static_cast<ALsizei>(m_bufferCount), &identifiers[0]));
+
+    m_buffers.resize(m_bufferCount);
+    for (unsigned int i = 0; i < m_bufferCount; ++i)
+    {
+        m_buffers[i].id                  = identifiers[i];
+        m_buffers[i].sampleCount         = 0;
+        m_buffers[i].playbackSampleCount = 0;
+        m_buffers[i].seekOffset          = NoLoop;
     }
 
+    // Prepare the effect, and find the rate at which the processed samples are played
+    m_playbackRate = m_sampleRate;
+    if (m_effect)
+    {
+        m_effect->reset(m_channelCount, m_sampleRate);
+        m_playbackRate = m_effect->getOutputRate(m_sampleRate);
+    }
+
+    // Fill the queue right away, so that the sound starts without waiting for the scheduler
+    m_requestStop = fillQueue();
+
+    // Play the sound
+    alCheck(alSourcePlay(m_source));
+
+    // Let the scheduler refill the buffers as they get played
+    m_isStreaming = true;
+    priv::StreamScheduler::add(this);
+}
+
+
+////////////////////////////////////////////////////////////
+void SoundStream::stopStreaming()
+{
     // Stop the playback
     alCheck(alSourceStop(m_source));
 
@@ -297,52 +345,191 @@ void SoundStream::streamData()
 
     // Delete the buffers
     alCheck(alSourcei(m_source, AL_BUFFER, 0));
-    alCheck(alDeleteBuffers(BufferCount, m_buffers));
+    for (std::vector<Buffer>::iterator it = m_buffers.begin(); it != m_buffers.end(); ++it)
+        alCheck(alDeleteBuffers(1, &it->id));
+    m_buffers.clear();
+
+    m_isStreaming = false;
+}
+
+
+////////////////////////////////////////////////////////////
+bool SoundStream::update(Time& interval)
+{
+    // The stream has been interrupted!
+    if (SoundSource::getStatus() == Stopped)
+    {
+        if (m_requestStop)
+        {
+            // End streaming, and return to the beginning of the stream
+            stopStreaming();
+            m_samplesProcessed = 0;
+            return false;
+        }
+
+        // All the queued buffers were played before new data could be pushed
+        ++m_underrunCount;
+    }
+
+    // Get the number of buffers that have been processed (ie. ready for reuse)
+    ALint nbProcessed = 0;
+    alCheck(alGetSourcei(m_source, AL_BUFFERS_PROCESSED, &nbProcessed));
+
+    while ((nbProcessed-- > 0) && !m_queue.empty())
+    {
+        // Pop the first unused buffer from the queue
+        unsigned int bufferNum = m_queue.front();
+        Buffer& buffer = m_buffers[bufferNum];
+        m_queue.pop_front();
+        alCheck(alSourceUnqueueBuffers(m_source, 1, &buffer.id));
+
+        // Move the playing position to the end of the buffer, or to the
+        // beginning of the loop if the buffer was the last one before it
+        if (buffer.seekOffset != NoLoop)
+        {
+            m_samplesProcessed = static_cast<Uint64>(buffer.seekOffset);
+            buffer.seekOffset = NoLoop;
+        }
+        else
+        {
+            m_samplesProcessed += buffer.sampleCount;
+        }
+
+        // Fill it and push it back into the playing queue
+        if (!m_requestStop)
+        {
+            if (fillAndPushBuffer(bufferNum))
+                m_requestStop = true;
+        }
+    }
+
+    // Restart the source if it starved (it plays whatever has been pushed meanwhile)
+    if ((SoundSource::getStatus() == Stopped) && !m_queue.empty())
+        alCheck(alSourcePlay(m_source));
+
+    // The next update is due when the buffer currently playing is finished
+    if (!m_queue.empty() && m_sampleRate && m_channelCount)
+    {
+        ALint offset = 0;
+        alCheck(alGetSourcei(m_source, AL_SAMPLE_OFFSET, &offset));
+
+        Int64 remaining = static_cast<Int64>(m_buffers[m_queue.front()].playbackSampleCount / m_channelCount) - offset;
+        if (remaining > 0)
+            interval = std::min(interval, microseconds(remaining * 1000000 / m_playbackRate));
+        else
+            interval = Time::Zero;
+    }
+
+    return true;
 }
 
 
 ////////////////////////////////////////////////////////////
-bool SoundStream::fillAndPushBuffer(unsigned int bufferNum)
+bool SoundStream::fillAndPushBuffer(unsigned int bufferNum, unsigned int retryCount)
 {
     bool requestStop = false;
 
-    // Acquire audio data
-    Chunk data = {NULL, 0};
-    if (!onGetData(data))
+    // Acquire audio data, in the sample format provided by the derived class
+    // (effects always work on floating point samples)
+    bool floatData = m_floatSamples || m_effect;
+    const void* samples = NULL;
+    std::size_t sampleCount = 0;
+    bool hasMoreData;
+    if (floatData)
     {
-        // Mark the buffer as the last one (so that we know when to reset the playing position)
-        m_endBuffers[bufferNum] = true;
+        FloatChunk data = {NULL, 0};
+        hasMoreData = onGetData(data);
+        samples     = data.samples;
+        sampleCount = data.sampleCount;
+    }
+    else
+    {
+        Chunk data = {NULL, 0};
+        hasMoreData = onGetData(data);
+        samples     = data.samples;
+        sampleCount = data.sampleCount;
+    }
 
-        // Check if the stream must loop or stop
+    // Check if the stream must loop or stop
+    Int64 seekOffset = NoLoop;
+    if (!hasMoreData)
+    {
         if (m_loop)
+            seekOffset = onLoop();
+
+        if (seekOffset == NoLoop)
+            requestStop = true;
+    }
+
+    // Fill the buffer if some data was returned
+    Buffer& buffer = m_buffers[bufferNum];
+    bool pushed = false;
+    if (samples && sampleCount)
+    {
+
+        // Run the effect on our own copy of the samples, which belong to the derived class
+        std::size_t dataCount = sampleCount;
+        if (m_effect)
         {
-            // Return to the beginning of the stream source
-            onSeek(Time::Zero);
+            const float* floatSamples = static_cast<const float*>(samples);
+            m_effectBlock.assign(floatSamples, floatSamples + sampleCount);
+            m_effect->process(m_effectBlock, m_channelCount);
 
-            // If we previously had no data, try to fill the buffer once again
-            if (!data.samples || (data.sampleCount == 0))
-            {
-                return fillAndPushBuffer(bufferNum);
-            }
+            samples   = m_effectBlock.empty() ? NULL : &m_effectBlock[0];
+            dataCount = m_effectBlock.size();
         }
-        else
+
+        if (dataCount > 0)
         {
-            // Not looping: request stop
-            requestStop = true;
+            // Fill the buffer; floating point samples are converted if the driver can't play them
+            if (!floatData)
+            {
+                ALsizei size = static_cast<ALsizei>(dataCount) * sizeof(Int16);
+                alCheck(alBufferData(buffer.id, m_format, samples, size, m_playbackRate));
+            }
+            else if (m_floatFormat != 0)
+            {
+                ALsizei size = static_cast<ALsizei>(dataCount) * sizeof(float);
+                alCheck(alBufferData(buffer.id, m_floatFormat, samples, size, m_playbackRate));
+            }
+            else
+            {
+                m_convertedSamples.resize(dataCount);
+                priv::convertSamples(static_cast<const float*>(samples), &m_convertedSamples[0], dataCount);
+
+                ALsizei size = static_cast<ALsizei>(dataCount) * sizeof(Int16);
+                alCheck(alBufferData(buffer.id, m_format, &m_convertedSamples[0], size, m_playbackRate));
+            }
+
+            // The sample count of the buffer is the one of the stream, before the effect
+            buffer.sampleCount         = sampleCount;
+            buffer.playbackSampleCount = dataCount;
+
+            // Push it into the sound queue
+            alCheck(alSourceQueueBuffers(m_source, 1, &buffer.id));
+            m_queue.push_back(bufferNum);
+            pushed = true;
         }
     }
 
-    // Fill the buffer if some data was returned
-    if (data.samples && data.sampleCount)
+    if (pushed)
     {
-        unsigned int buffer = m_buffers[bufferNum];
-
-        // Fill the buffer
-        ALsizei size = static_cast<ALsizei>(data.sampleCount) * sizeof(Int16);
-        alCheck(alBufferData(buffer, m_format, data.samples, size, m_sampleRate));
+        // The playing position jumps to the loop once this buffer is played
+        buffer.seekOffset = seekOffset;
+    }
+    else if (seekOffset != NoLoop)
+    {
+        // Nothing was played before the loop: the jump happens after the previous buffer
+        if (!m_queue.empty())
+            m_buffers[m_queue.back()].seekOffset = seekOffset;
+        else
+            m_samplesProcessed = static_cast<Uint64>(seekOffset);
 
-        // Push it into the sound queue
-        alCheck(alSourceQueueBuffers(m_source, 1, &buffer));
+        // Try to fill the buffer once again, unless the loop itself is empty
+        if (retryCount < 2)
+            return fillAndPushBuffer(bufferNum, retryCount + 1);
+        else
+            requestStop = true;
     }
 
     return requestStop;
@@ -354,7 +541,7 @@ bool SoundStream::fillQueue()
 {
     // Fill and enqueue all the available buffers
     bool requestStop = false;
-    for (int i = 0; (i < BufferCount) && !requestStop; ++i)
+    for (unsigned int i = 0; (i < m_buffers.size()) && !requestStop; ++i)
     {
         if (fillAndPushBuffer(i))
             requestStop = true;
@@ -375,6 +562,7 @@ void SoundStream::clearQueue()
     ALuint buffer;
     for (ALint i = 0; i < nbQueued; ++i)
         alCheck(alSourceUnqueueBuffers(m_source, 1, &buffer));
+    m_queue.clear();
 }
 
 } // namespace sf
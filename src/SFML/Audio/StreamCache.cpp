@@ -0,0 +1,207 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2014 Laurent Gomila (laurent.gom@gmail.com)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Audio/StreamCache.hpp>
+#include <SFML/System/Lock.hpp>
+#include <algorithm>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+StreamCache::StreamCache(std::size_t budget, std::size_t blockSize) :
+m_budget      (budget),
+m_blockSize   (std::max(blockSize, static_cast<std::size_t>(1))),
+m_residentSize(0),
+m_hitCount    (0),
+m_missCount   (0)
+{
+
+}
+
+
+////////////////////////////////////////////////////////////
+void StreamCache::setBudget(std::size_t budget)
+{
+    Lock lock(m_mutex);
+
+    m_budget = budget;
+    evict(0);
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t StreamCache::getBudget() const
+{
+    Lock lock(m_mutex);
+
+    return m_budget;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t StreamCache::getBlockSize() const
+{
+    return m_blockSize;
+}
+
+
+////////////////////////////////////////////////////////////
+bool StreamCache::find(const std::string& source, Uint64 block, std::vector<float>& samples)
+{
+    Lock lock(m_mutex);
+
+    BlockTable::iterator it = m_table.find(Key(source, block));
+    if (it == m_table.end())
+    {
+        ++m_missCount;
+        return false;
+    }
+
+    // Move the block to the front of the list, it is now the most recently used
+    m_blocks.splice(m_blocks.begin(), m_blocks, it->second);
+
+    samples = it->second->samples;
+    ++m_hitCount;
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+void StreamCache::insert(const std::string& source, Uint64 block, const float* samples, std::size_t sampleCount)
+{
+    Lock lock(m_mutex);
+
+    std::size_t size = sampleCount * sizeof(float);
+    if (size > m_budget)
+        return;
+
+    // Another stream may have decoded the same block meanwhile
+    Key key(source, block);
+    if (m_table.find(key) != m_table.end())
+        return;
+
+    // Make room for the new block
+    evict(size);
+
+    m_blocks.push_front(Block());
+    m_blocks.front().key = key;
+    m_blocks.front().samples.assign(samples, samples + sampleCount);
+    m_table[key] = m_blocks.begin();
+    m_residentSize += size;
+}
+
+
+////////////////////////////////////////////////////////////
+void StreamCache::remove(const std::string& source)
+{
+    Lock lock(m_mutex);
+
+    BlockTable::iterator it = m_table.lower_bound(Key(source, 0));
+    while ((it != m_table.end()) && (it->first.first == source))
+    {
+        m_residentSize -= it->second->samples.size() * sizeof(float);
+        m_blocks.erase(it->second);
+        m_table.erase(it++);
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void StreamCache::clear()
+{
+    Lock lock(m_mutex);
+
+    m_blocks.clear();
+    m_table.clear();
+    m_residentSize = 0;
+    m_hitCount     = 0;
+    m_missCount    = 0;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t StreamCache::getResidentSize() const
+{
+    Lock lock(m_mutex);
+
+    return m_residentSize;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t StreamCache::getBlockCount() const
+{
+    Lock lock(m_mutex);
+
+    return m_blocks.size();
+}
+
+
+////////////////////////////////////////////////////////////
+Uint64 StreamCache::getHitCount() const
+{
+    Lock lock(m_mutex);
+
+    return m_hitCount;
+}
+
+
+////////////////////////////////////////////////////////////
+Uint64 StreamCache::getMissCount() const
+{
+    Lock lock(m_mutex);
+
+    return m_missCount;
+}
+
+
+////////////////////////////////////////////////////////////
+float StreamCache::getHitRatio() const
+{
+    Lock lock(m_mutex);
+
+    Uint64 total = m_hitCount + m_missCount;
+
+    return total > 0 ? static_cast<float>(m_hitCount) / total : 0.f;
+}
+
+
+////////////////////////////////////////////////////////////
+void StreamCache::evict(std::size_t extraSize)
+{
+    while (!m_blocks.empty() && (m_residentSize + extraSize > m_budget))
+    {
+        Block& block = m_blocks.back();
+        m_residentSize -= block.samples.size() * sizeof(float);
+        m_table.erase(block.key);
+        m_blocks.pop_back();
+    }
+}
+
+} // namespace sf
@@ -0,0 +1,190 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2014 Laurent Gomila (laurent.gom@gmail.com)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Audio/StreamScheduler.hpp>
+#include <SFML/Audio/SoundStream.hpp>
+#include <SFML/System/Lock.hpp>
+#include <SFML/System/Sleep.hpp>
+#include <algorithm>
+
+#ifdef _MSC_VER
+    #pragma warning(disable : 4355) // 'this' used in base member initializer list
+#endif
+
+
+namespace
+{
+    // Bounds of the time the scheduler sleeps between two updates: the upper bound
+    // is what newly added or resumed streams may have to wait before being serviced
+    const sf::Time minInterval = sf::milliseconds(1);
+    const sf::Time maxInterval = sf::milliseconds(50);
+}
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+void StreamScheduler::add(SoundStream* stream)
+{
+    StreamScheduler& scheduler = getInstance();
+    Lock lock(scheduler.m_mutex);
+
+    Entry* entry = new Entry;
+    entry->stream = stream;
+    entry->active = true;
+    scheduler.m_streams.push_back(entry);
+
+    // Start the thread if it was idle
+    if (!scheduler.m_isRunning)
+    {
+        scheduler.m_isRunning = true;
+        scheduler.m_thread.launch();
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+bool StreamScheduler::remove(SoundStream* stream)
+{
+    StreamScheduler& scheduler = getInstance();
+    Lock lock(scheduler.m_mutex);
+
+    // Only the entries of this stream are locked, so that we wait for its
+    // update if it is in progress, but not for the updates of other streams
+    for (std::vector<Entry*>::iterator it = scheduler.m_streams.begin(); it != scheduler.m_streams.end(); ++it)
+    {
+        if ((*it)->stream == stream)
+        {
+            Lock entryLock((*it)->mutex);
+            if ((*it)->active)
+            {
+                // The entry is deleted by the thread, which may still hold a pointer to it
+                (*it)->active = false;
+                return true;
+            }
+        }
+    }
+
+    return false;
+}
+
+
+////////////////////////////////////////////////////////////
+StreamScheduler::StreamScheduler() :
+m_thread   (&StreamScheduler::run, this),
+m_isRunning(false)
+{
+
+}
+
+
+////////////////////////////////////////////////////////////
+StreamScheduler::~StreamScheduler()
+{
+    // Streams still playing at this point are abandoned, so that the thread can exit
+    {
+        Lock lock(m_mutex);
+        for (std::vector<Entry*>::iterator it = m_streams.begin(); it != m_streams.end(); ++it)
+        {
+            Lock entryLock((*it)->mutex);
+            (*it)->active = false;
+        }
+    }
+
+    m_thread.wait();
+
+    for (std::vector<Entry*>::iterator it = m_streams.begin(); it != m_streams.end(); ++it)
+        delete *it;
+}
+
+
+////////////////////////////////////////////////////////////
+StreamScheduler& StreamScheduler::getInstance()
+{
+    static StreamScheduler instance;
+
+    return instance;
+}
+
+
+////////////////////////////////////////////////////////////
+void StreamScheduler::run()
+{
+    for (;;)
+    {
+        Time interval = maxInterval;
+        std::vector<Entry*> entries;
+
+        {
+            Lock lock(m_mutex);
+
+            // Forget the streams that are finished or removed; only this thread
+            // deletes entries, and remove() doesn't touch them without the lock
+            std::vector<Entry*>::iterator end = m_streams.begin();
+            for (std::vector<Entry*>::iterator it = m_streams.begin(); it != m_streams.end(); ++it)
+            {
+                if ((*it)->active)
+                    *end++ = *it;
+                else
+                    delete *it;
+            }
+            m_streams.erase(end, m_streams.end());
+
+            // Nothing left to stream: exit, the thread is restarted by the next call to add()
+            if (m_streams.empty())
+            {
+                m_isRunning = false;
+                return;
+            }
+
+            entries = m_streams;
+        }
+
+        // Update all the streams without holding the list, so that add() and remove()
+        // don't wait for the decoding, and find out when the next one will need new data
+        for (std::vector<Entry*>::iterator it = entries.begin(); it != entries.end(); ++it)
+        {
+            Lock entryLock((*it)->mutex);
+            if (!(*it)->active)
+                continue;
+
+            Time streamInterval = maxInterval;
+            if ((*it)->stream->update(streamInterval))
+                interval = std::min(interval, streamInterval);
+            else
+                (*it)->active = false;
+        }
+
+        sleep(std::max(interval, minInterval));
+    }
+}
+
+} // namespace priv
+
+} // namespace sf
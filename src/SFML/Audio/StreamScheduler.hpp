@@ -0,0 +1,137 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2014 Laurent Gomila (laurent.gom@gmail.com)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_STREAMSCHEDULER_HPP
+#define SFML_STREAMSCHEDULER_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/System/Mutex.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <SFML/System/Thread.hpp>
+#include <SFML/System/Time.hpp>
+#include <vector>
+
+
+namespace sf
+{
+class SoundStream;
+
+namespace priv
+{
+////////////////////////////////////////////////////////////
+/// \brief Single thread that keeps all the playing
+///        sound streams fed with audio data
+///
+////////////////////////////////////////////////////////////
+class StreamScheduler : NonCopyable
+{
+public :
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Start servicing a stream
+    ///
+    /// The stream must already have its queue filled and its
+    /// source playing; the scheduler then calls its update
+    /// function until it returns false, or until remove() is called.
+    ///
+    /// \param stream Stream to service
+    ///
+    ////////////////////////////////////////////////////////////
+    static void add(SoundStream* stream);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Stop servicing a stream
+    ///
+    /// If the scheduler is currently updating this stream, this
+    /// function blocks until it is done, so that the stream is
+    /// guaranteed not to be accessed by the scheduler anymore
+    /// when it returns. The updates of the other streams don't
+    /// block it.
+    ///
+    /// \param stream Stream to remove
+    ///
+    /// \return True if the stream was being serviced, false if it
+    ///         was not (never added, or already finished)
+    ///
+    ////////////////////////////////////////////////////////////
+    static bool remove(SoundStream* stream);
+
+private :
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    ////////////////////////////////////////////////////////////
+    StreamScheduler();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    ////////////////////////////////////////////////////////////
+    ~StreamScheduler();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the unique instance of the class
+    ///
+    /// \return Reference to the scheduler
+    ///
+    ////////////////////////////////////////////////////////////
+    static StreamScheduler& getInstance();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Entry point of the scheduler thread
+    ///
+    /// The thread runs as long as there are streams to service.
+    ///
+    ////////////////////////////////////////////////////////////
+    void run();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief A stream serviced by the scheduler
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Entry
+    {
+        SoundStream* stream; ///< Stream to update
+        Mutex        mutex;  ///< Mutex held while the stream is updated or removed
+        bool         active; ///< Is the stream still serviced? (entries are deleted by the thread)
+    };
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    Thread              m_thread;    ///< Thread servicing the streams
+    Mutex               m_mutex;     ///< Mutex protecting the list of streams
+    std::vector<Entry*> m_streams;   ///< Streams being serviced
+    bool                m_isRunning; ///< Is the thread running?
+};
+
+} // namespace priv
+
+} // namespace sf
+
+
+#endif // SFML_STREAMSCHEDULER_HPP
@@ -0,0 +1,286 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2014 Laurent Gomila (laurent.gom@gmail.com)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Audio/VoiceStream.hpp>
+#include <SFML/Audio/AudioCodec.hpp>
+#include <SFML/System/Lock.hpp>
+#include <algorithm>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+VoiceStream::VoiceStream(AudioCodec& codec) :
+m_codec        (codec),
+m_frameDuration(milliseconds(20)),
+m_frameSamples (0),
+m_jitterDelay  (milliseconds(60)),
+m_maxDelay     (milliseconds(200)),
+m_hasSequence  (false),
+m_nextSequence (0),
+m_isBuffering  (true),
+m_lossCount    (0),
+m_lostFrames   (0),
+m_lateFrames   (0),
+m_droppedFrames(0),
+m_outOfWindow  (0)
+{
+
+}
+
+
+////////////////////////////////////////////////////////////
+VoiceStream::~VoiceStream()
+{
+    // The streaming thread calls onGetData, stop it before the members are destroyed
+    stop();
+}
+
+
+////////////////////////////////////////////////////////////
+void VoiceStream::setFormat(unsigned int channelCount, unsigned int sampleRate, Time frameDuration)
+{
+    stop();
+
+    Lock lock(m_mutex);
+
+    m_frameDuration = frameDuration;
+    m_frameSamples  = static_cast<std::size_t>(frameDuration.asSeconds() * sampleRate) * channelCount;
+    m_frames.clear();
+    m_hasSequence   = false;
+    m_isBuffering   = true;
+    m_lossCount     = 0;
+    m_outOfWindow   = 0;
+    m_codec.reset(channelCount, sampleRate);
+
+    // Each buffer of the stream holds exactly one frame
+    setBufferDuration(frameDuration);
+    initialize(channelCount, sampleRate);
+}
+
+
+////////////////////////////////////////////////////////////
+void VoiceStream::setJitterDelay(Time delay)
+{
+    Lock lock(m_mutex);
+
+    m_jitterDelay = delay;
+}
+
+
+////////////////////////////////////////////////////////////
+void VoiceStream::setMaxDelay(Time delay)
+{
+    Lock lock(m_mutex);
+
+    m_maxDelay = delay;
+}
+
+
+////////////////////////////////////////////////////////////
+void VoiceStream::push(Uint32 sequence, const void* data, std::size_t size)
+{
+    Lock lock(m_mutex);
+
+    // The first frame received gives the starting point of the sequence
+    if (!m_hasSequence)
+    {
+        m_nextSequence = sequence;
+        m_hasSequence  = true;
+    }
+
+    // Extend the 32 bits sequence number to 64 bits, relatively to the next frame to play
+    Int32 distance = static_cast<Int32>(sequence - static_cast<Uint32>(m_nextSequence));
+    Uint64 key = m_nextSequence + distance;
+
+    // Frames too late to be played or too far ahead are rejected, so that a single garbled
+    // sequence number can't move the playback; but if many of them arrive in a row, the
+    // sender has really restarted or jumped, and we start again from its sequence
+    std::size_t maxFrames = getMaxFrameCount();
+    if ((distance < 0) || (static_cast<std::size_t>(distance) > 2 * maxFrames))
+    {
+        if (++m_outOfWindow <= maxFrames)
+        {
+            if (distance < 0)
+                m_lateFrames++;
+            else
+                m_droppedFrames++;
+            return;
+        }
+
+        m_droppedFrames += m_frames.size();
+        m_frames.clear();
+        m_nextSequence = sequence;
+        m_isBuffering  = true;
+        key = sequence;
+    }
+    else if (m_frames.find(key) != m_frames.end())
+    {
+        // Already received
+        m_lateFrames++;
+        return;
+    }
+
+    m_outOfWindow = 0;
+
+    const Uint8* bytes = static_cast<const Uint8*>(data);
+    m_frames[key].assign(bytes, bytes + size);
+
+    // Bound the memory and the latency even when the stream is not playing
+    dropOldestFrames();
+}
+
+
+////////////////////////////////////////////////////////////
+Time VoiceStream::getBufferedDuration() const
+{
+    Lock lock(m_mutex);
+
+    return m_frameDuration * static_cast<Int64>(m_frames.size());
+}
+
+
+////////////////////////////////////////////////////////////
+Uint64 VoiceStream::getLostFrameCount() const
+{
+    Lock lock(m_mutex);
+
+    return m_lostFrames;
+}
+
+
+////////////////////////////////////////////////////////////
+Uint64 VoiceStream::getLateFrameCount() const
+{
+    Lock lock(m_mutex);
+
+    return m_lateFrames;
+}
+
+
+////////////////////////////////////////////////////////////
+Uint64 VoiceStream::getDroppedFrameCount() const
+{
+    Lock lock(m_mutex);
+
+    return m_droppedFrames;
+}
+
+
+////////////////////////////////////////////////////////////
+bool VoiceStream::onGetData(Chunk& data)
+{
+    Lock lock(m_mutex);
+
+    std::size_t frameCount = m_frames.size();
+    Time buffered = m_frameDuration * static_cast<Int64>(frameCount);
+
+    // Wait until enough frames are buffered to absorb the jitter
+    if (m_isBuffering && (buffered >= m_jitterDelay) && (frameCount > 0))
+    {
+        m_isBuffering  = false;
+        m_nextSequence = m_frames.begin()->first;
+    }
+
+    if (m_isBuffering)
+    {
+        m_samples.assign(m_frameSamples, 0);
+    }
+    else
+    {
+        // Drop the oldest frames if too many are waiting (the maximum delay may have changed)
+        dropOldestFrames();
+
+        FrameTable::iterator frame = m_frames.begin();
+        if ((frame != m_frames.end()) && (frame->first == m_nextSequence) &&
+            m_codec.decode(frame->second.empty() ? NULL : &frame->second[0], frame->second.size(), getChannelCount(), m_samples))
+        {
+            m_lossCount = 0;
+        }
+        else
+        {
+            // The frame is missing (or corrupt): repeat the previous one, fading it out
+            m_lossCount++;
+            m_lostFrames++;
+            if (m_samples.size() != m_frameSamples)
+                m_samples.assign(m_frameSamples, 0);
+            for (std::vector<Int16>::iterator it = m_samples.begin(); it != m_samples.end(); ++it)
+                *it = static_cast<Int16>(*it / 2);
+        }
+
+        if ((frame != m_frames.end()) && (frame->first == m_nextSequence))
+            m_frames.erase(frame);
+        m_nextSequence++;
+
+        // Nothing left to play: buffer again, instead of playing a series of lost frames
+        if (m_frames.empty())
+            m_isBuffering = true;
+    }
+
+    // Make sure that the chunk always contains exactly one frame
+    m_samples.resize(m_frameSamples, 0);
+
+    data.samples     = m_samples.empty() ? NULL : &m_samples[0];
+    data.sampleCount = m_samples.size();
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+void VoiceStream::onSeek(Time)
+{
+    Lock lock(m_mutex);
+
+    m_isBuffering = true;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t VoiceStream::getMaxFrameCount() const
+{
+    // The buffer must at least be able to hold the jitter delay, or the playback would never start
+    Int64 delay = std::max(m_maxDelay, m_jitterDelay).asMicroseconds();
+    Int64 frame = std::max(m_frameDuration.asMicroseconds(), static_cast<Int64>(1));
+
+    return static_cast<std::size_t>(std::max(delay / frame, static_cast<Int64>(1)));
+}
+
+
+////////////////////////////////////////////////////////////
+void VoiceStream::dropOldestFrames()
+{
+    std::size_t maxFrames = getMaxFrameCount();
+    while (m_frames.size() > maxFrames)
+    {
+        m_frames.erase(m_frames.begin());
+        m_nextSequence = m_frames.begin()->first;
+        m_droppedFrames++;
+    }
+}
+
+} // namespace sf
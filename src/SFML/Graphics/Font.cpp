@@ -28,6 +28,7 @@
 #include <SFML/Graphics/Font.hpp>
 #include <SFML/Graphics/GLCheck.hpp>
 #include <SFML/System/InputStream.hpp>
+#include <SFML/System/MappedFileInputStream.hpp>
 #include <SFML/System/Err.hpp>
 #include <ft2build.h>
 #include FT_FREETYPE_H
@@ -64,11 +65,12 @@ namespace sf
 {
 ////////////////////////////////////////////////////////////
 Font::Font() :
-m_library  (NULL),
-m_face     (NULL),
-m_streamRec(NULL),
-m_refCount (NULL),
-m_info     ()
+m_library   (NULL),
+m_face      (NULL),
+m_streamRec (NULL),
+m_mappedFile(NULL),
+m_refCount  (NULL),
+m_info      ()
 {
 
 }
@@ -79,6 +81,7 @@ Font::Font(const Font& copy) :
 m_library    (copy.m_library),
 m_face       (copy.m_face),
 m_streamRec  (copy.m_streamRec),
+m_mappedFile (copy.m_mappedFile),
 m_refCount   (copy.m_refCount),
 m_info       (copy.m_info),
 m_pages      (copy.m_pages),
@@ -117,11 +120,27 @@ bool Font::loadFromFile(const std::string& filename)
     }
     m_library = library;
 
-    // Load the new font face from the specified file
+    // Load the new font face from the specified file; map it into memory if possible,
+    // so that FreeType reads the glyphs in place instead of going through stdio
     FT_Face face;
-    if (FT_New_Face(static_cast<FT_Library>(m_library), filename.c_str(), 0, &face) != 0)
+    FT_Error error;
+    MappedFileInputStream* file = new MappedFileInputStream;
+    if (file->open(filename))
+    {
+        const FT_Byte* data = static_cast<const FT_Byte*>(file->getData());
+        error = FT_New_Memory_Face(static_cast<FT_Library>(m_library), data, static_cast<FT_Long>(file->getSize()), 0, &face);
+    }
+    else
+    {
+        delete file;
+        file = NULL;
+        error = FT_New_Face(static_cast<FT_Library>(m_library), filename.c_str(), 0, &face);
+    }
+
+    if (error != 0)
     {
         err() << "Failed to load font \"" << filename << "\" (failed to create the font face)" << std::endl;
+        delete file;
         return false;
     }
 
@@ -130,11 +149,13 @@ bool Font::loadFromFile(const std::string& filename)
     {
         err() << "Failed to load font \"" << filename << "\" (failed to set the Unicode character set)" << std::endl;
         FT_Done_Face(face);
+        delete file;
         return false;
     }
 
     // Store the loaded font in our ugly void* :)
     m_face = face;
+    m_mappedFile = file;
 
     // Store the font information
     m_info.family = face->family_name ? face->family_name : std::string();
@@ -346,6 +367,7 @@ Font& Font::operator =(const Font& right)
     std::swap(m_library,     temp.m_library);
     std::swap(m_face,        temp.m_face);
     std::swap(m_streamRec,   temp.m_streamRec);
+    std::swap(m_mappedFile,  temp.m_mappedFile);
     std::swap(m_refCount,    temp.m_refCount);
     std::swap(m_info,        temp.m_info);
     std::swap(m_pages,       temp.m_pages);
@@ -378,6 +400,9 @@ void Font::cleanup()
             if (m_streamRec)
                 delete static_cast<FT_StreamRec*>(m_streamRec);
 
+            // Unmap the font file, if any (must be done after FT_Done_Face too)
+            delete m_mappedFile;
+
             // Close the library
             if (m_library)
                 FT_Done_FreeType(static_cast<FT_Library>(m_library));
@@ -385,10 +410,11 @@ void Font::cleanup()
     }
 
     // Reset members
-    m_library   = NULL;
-    m_face      = NULL;
-    m_streamRec = NULL;
-    m_refCount  = NULL;
+    m_library    = NULL;
+    m_face       = NULL;
+    m_streamRec  = NULL;
+    m_mappedFile = NULL;
+    m_refCount   = NULL;
     m_pages.clear();
     m_pixelBuffer.clear();
 }
@@ -27,6 +27,7 @@
 ////////////////////////////////////////////////////////////
 #include <SFML/Graphics/ImageLoader.hpp>
 #include <SFML/System/InputStream.hpp>
+#include <SFML/System/MappedFileInputStream.hpp>
 #include <SFML/System/Err.hpp>
 #include <SFML/Graphics/stb_image/stb_image.h>
 #define STB_IMAGE_WRITE_IMPLEMENTATION
@@ -101,9 +102,20 @@ bool ImageLoader::loadImageFromFile(const std::string& filename, std::vector<Uin
     // Clear the array (just in case)
     pixels.clear();
 
-    // Load the image and get a pointer to the pixels in memory
+    // Load the image and get a pointer to the pixels in memory;
+    // the file is mapped if possible, so that stb_image decodes it in place
     int width, height, channels;
-    unsigned char* ptr = stbi_load(filename.c_str(), &width, &height, &channels, STBI_rgb_alpha);
+    unsigned char* ptr = NULL;
+    MappedFileInputStream file;
+    if (file.open(filename))
+    {
+        const unsigned char* buffer = static_cast<const unsigned char*>(file.getData());
+        ptr = stbi_load_from_memory(buffer, static_cast<int>(file.getSize()), &width, &height, &channels, STBI_rgb_alpha);
+    }
+    else
+    {
+        ptr = stbi_load(filename.c_str(), &width, &height, &channels, STBI_rgb_alpha);
+    }
 
     if (ptr && width && height)
     {
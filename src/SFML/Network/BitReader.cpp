@@ -0,0 +1,167 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2014 Laurent Gomila (laurent.gom@gmail.com)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Network/BitReader.hpp>
+#include <SFML/Network/Packet.hpp>
+#include <cstring>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+BitReader::BitReader(Packet& packet) :
+m_packet     (packet),
+m_scratch    (0),
+m_scratchBits(0),
+m_isValid    (true)
+{
+
+}
+
+
+////////////////////////////////////////////////////////////
+Uint32 BitReader::readBits(unsigned int bitCount)
+{
+    if ((bitCount == 0) || (bitCount > 32))
+        return 0;
+
+    // Read bytes from the packet until there are enough bits
+    while (m_scratchBits < bitCount)
+    {
+        Uint8 byte = 0;
+        if (!(m_packet >> byte))
+        {
+            m_isValid = false;
+            return 0;
+        }
+
+        m_scratch |= static_cast<Uint64>(byte) << m_scratchBits;
+        m_scratchBits += 8;
+    }
+
+    Uint64 mask = (static_cast<Uint64>(1) << bitCount) - 1;
+    Uint32 value = static_cast<Uint32>(m_scratch & mask);
+    m_scratch >>= bitCount;
+    m_scratchBits -= bitCount;
+
+    return value;
+}
+
+
+////////////////////////////////////////////////////////////
+bool BitReader::readBool()
+{
+    return readBits(1) != 0;
+}
+
+
+////////////////////////////////////////////////////////////
+float BitReader::readFloat()
+{
+    Uint32 bits = readBits(32);
+    float value;
+    std::memcpy(&value, &bits, sizeof(value));
+
+    return value;
+}
+
+
+////////////////////////////////////////////////////////////
+float BitReader::readFloat(float min, float max, unsigned int bitCount)
+{
+    return dequantize(readBits(bitCount), min, max, bitCount);
+}
+
+
+////////////////////////////////////////////////////////////
+Vector2f BitReader::readVector2(float min, float max, unsigned int bitCount)
+{
+    float x = readFloat(min, max, bitCount);
+    float y = readFloat(min, max, bitCount);
+
+    return Vector2f(x, y);
+}
+
+
+////////////////////////////////////////////////////////////
+Vector3f BitReader::readVector3(float min, float max, unsigned int bitCount)
+{
+    float x = readFloat(min, max, bitCount);
+    float y = readFloat(min, max, bitCount);
+    float z = readFloat(min, max, bitCount);
+
+    return Vector3f(x, y, z);
+}
+
+
+////////////////////////////////////////////////////////////
+Uint32 BitReader::readDelta(Uint32 baseline, unsigned int bitCount)
+{
+    return readBool() ? readBits(bitCount) : baseline;
+}
+
+
+////////////////////////////////////////////////////////////
+float BitReader::readDelta(float baseline, float min, float max, unsigned int bitCount)
+{
+    return readBool() ? readFloat(min, max, bitCount) : baseline;
+}
+
+
+////////////////////////////////////////////////////////////
+Vector2f BitReader::readDelta(const Vector2f& baseline, float min, float max, unsigned int bitCount)
+{
+    return readBool() ? readVector2(min, max, bitCount) : baseline;
+}
+
+
+////////////////////////////////////////////////////////////
+Vector3f BitReader::readDelta(const Vector3f& baseline, float min, float max, unsigned int bitCount)
+{
+    return readBool() ? readVector3(min, max, bitCount) : baseline;
+}
+
+
+////////////////////////////////////////////////////////////
+bool BitReader::isValid() const
+{
+    return m_isValid;
+}
+
+
+////////////////////////////////////////////////////////////
+float BitReader::dequantize(Uint32 value, float min, float max, unsigned int bitCount)
+{
+    if ((bitCount == 0) || (bitCount > 32))
+        return min;
+
+    double steps = bitCount < 32 ? static_cast<double>((1u << bitCount) - 1) : 4294967295.0;
+
+    return static_cast<float>(min + (static_cast<double>(max) - min) * value / steps);
+}
+
+} // namespace sf
@@ -0,0 +1,216 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2014 Laurent Gomila (laurent.gom@gmail.com)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Network/BitWriter.hpp>
+#include <SFML/Network/Packet.hpp>
+#include <cstring>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+BitWriter::BitWriter(Packet& packet) :
+m_packet     (packet),
+m_scratch    (0),
+m_scratchBits(0),
+m_bitCount   (0)
+{
+
+}
+
+
+////////////////////////////////////////////////////////////
+BitWriter::~BitWriter()
+{
+    flush();
+}
+
+
+////////////////////////////////////////////////////////////
+void BitWriter::writeBits(Uint32 value, unsigned int bitCount)
+{
+    if ((bitCount == 0) || (bitCount > 32))
+        return;
+
+    Uint64 mask = (static_cast<Uint64>(1) << bitCount) - 1;
+    m_scratch |= (value & mask) << m_scratchBits;
+    m_scratchBits += bitCount;
+    m_bitCount += bitCount;
+
+    // Append the bits to the packet by groups of 32, lowest bits first
+    if (m_scratchBits >= 32)
+    {
+        char bytes[4];
+        for (int i = 0; i < 4; ++i)
+            bytes[i] = static_cast<char>((m_scratch >> (i * 8)) & 0xFF);
+
+        m_packet.append(bytes, sizeof(bytes));
+        m_scratch >>= 32;
+        m_scratchBits -= 32;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void BitWriter::writeBool(bool value)
+{
+    writeBits(value ? 1 : 0, 1);
+}
+
+
+////////////////////////////////////////////////////////////
+void BitWriter::writeFloat(float value)
+{
+    Uint32 bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    writeBits(bits, 32);
+}
+
+
+////////////////////////////////////////////////////////////
+void BitWriter::writeFloat(float value, float min, float max, unsigned int bitCount)
+{
+    writeBits(quantize(value, min, max, bitCount), bitCount);
+}
+
+
+////////////////////////////////////////////////////////////
+void BitWriter::writeVector(const Vector2f& value, float min, float max, unsigned int bitCount)
+{
+    writeFloat(value.x, min, max, bitCount);
+    writeFloat(value.y, min, max, bitCount);
+}
+
+
+////////////////////////////////////////////////////////////
+void BitWriter::writeVector(const Vector3f& value, float min, float max, unsigned int bitCount)
+{
+    writeFloat(value.x, min, max, bitCount);
+    writeFloat(value.y, min, max, bitCount);
+    writeFloat(value.z, min, max, bitCount);
+}
+
+
+////////////////////////////////////////////////////////////
+bool BitWriter::writeDelta(Uint32 value, Uint32 baseline, unsigned int bitCount)
+{
+    Uint32 mask = bitCount < 32 ? (1u << bitCount) - 1 : 0xFFFFFFFF;
+    bool changed = (value & mask) != (baseline & mask);
+
+    writeBool(changed);
+    if (changed)
+        writeBits(value, bitCount);
+
+    return changed;
+}
+
+
+////////////////////////////////////////////////////////////
+bool BitWriter::writeDelta(float value, float baseline, float min, float max, unsigned int bitCount)
+{
+    Uint32 quantized = quantize(value, min, max, bitCount);
+    bool changed = quantized != quantize(baseline, min, max, bitCount);
+
+    writeBool(changed);
+    if (changed)
+        writeBits(quantized, bitCount);
+
+    return changed;
+}
+
+
+////////////////////////////////////////////////////////////
+bool BitWriter::writeDelta(const Vector2f& value, const Vector2f& baseline, float min, float max, unsigned int bitCount)
+{
+    bool changed = (quantize(value.x, min, max, bitCount) != quantize(baseline.x, min, max, bitCount)) ||
+                   (quantize(value.y, min, max, bitCount) != quantize(baseline.y, min, max, bitCount));
+
+    writeBool(changed);
+    if (changed)
+        writeVector(value, min, max, bitCount);
+
+    return changed;
+}
+
+
+////////////////////////////////////////////////////////////
+bool BitWriter::writeDelta(const Vector3f& value, const Vector3f& baseline, float min, float max, unsigned int bitCount)
+{
+    bool changed = (quantize(value.x, min, max, bitCount) != quantize(baseline.x, min, max, bitCount)) ||
+                   (quantize(value.y, min, max, bitCount) != quantize(baseline.y, min, max, bitCount)) ||
+                   (quantize(value.z, min, max, bitCount) != quantize(baseline.z, min, max, bitCount));
+
+    writeBool(changed);
+    if (changed)
+        writeVector(value, min, max, bitCount);
+
+    return changed;
+}
+
+
+////////////////////////////////////////////////////////////
+void BitWriter::flush()
+{
+    // Append the remaining bytes, the last one completed with zeros
+    while (m_scratchBits > 0)
+    {
+        char byte = static_cast<char>(m_scratch & 0xFF);
+        m_packet.append(&byte, 1);
+        m_scratch >>= 8;
+        m_scratchBits = m_scratchBits > 8 ? m_scratchBits - 8 : 0;
+    }
+
+    m_scratch = 0;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t BitWriter::getBitCount() const
+{
+    return m_bitCount;
+}
+
+
+////////////////////////////////////////////////////////////
+Uint32 BitWriter::quantize(float value, float min, float max, unsigned int bitCount)
+{
+    if ((bitCount == 0) || !(max > min))
+        return 0;
+
+    double steps = bitCount < 32 ? static_cast<double>((1u << bitCount) - 1) : 4294967295.0;
+    double ratio = (static_cast<double>(value) - min) / (static_cast<double>(max) - min);
+
+    // Clamp to the range (NaN included)
+    if (!(ratio > 0.0))
+        ratio = 0.0;
+    else if (ratio > 1.0)
+        ratio = 1.0;
+
+    return static_cast<Uint32>(ratio * steps + 0.5);
+}
+
+} // namespace sf
@@ -0,0 +1,763 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2014 Laurent Gomila (laurent.gom@gmail.com)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Network/EventLoop.hpp>
+#include <SFML/Network/SocketImpl.hpp>
+#include <SFML/Network/TcpListener.hpp>
+#include <SFML/Network/TcpSocket.hpp>
+#include <SFML/Network/UdpSocket.hpp>
+#include <SFML/System/Clock.hpp>
+#include <SFML/System/Err.hpp>
+#include <SFML/System/Lock.hpp>
+#include <SFML/System/Mutex.hpp>
+#include <algorithm>
+#include <deque>
+#include <map>
+#include <vector>
+
+// Use epoll on Linux, so that waiting doesn't depend on the number of sockets;
+// the other systems use poll, which at least has no limit on the number of sockets
+#if defined(SFML_SYSTEM_LINUX)
+    #include <sys/epoll.h>
+    #define SFML_EVENTLOOP_EPOLL
+#elif defined(SFML_SYSTEM_WINDOWS)
+    #define SFML_EVENTLOOP_POLL WSAPoll
+#else
+    #include <poll.h>
+    #define SFML_EVENTLOOP_POLL ::poll
+#endif
+
+
+namespace
+{
+    // Types of asynchronous operations
+    enum OperationType
+    {
+        Connect,
+        Accept,
+        TcpSend,
+        TcpReceive,
+        UdpSend,
+        UdpReceive
+    };
+
+    // Events that a socket can wait for
+    enum
+    {
+        Readable = 1,
+        Writable = 2
+    };
+}
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+struct EventLoop::EventLoopImpl
+{
+    ////////////////////////////////////////////////////////////
+    struct Operation
+    {
+        OperationType       type;          ///< Type of the operation
+        Socket*             socket;        ///< Socket performing the operation
+        TcpSocket*          client;        ///< Socket receiving the new connection (Accept)
+        const char*         input;         ///< Data to send (TcpSend, UdpSend)
+        char*               output;        ///< Buffer to fill (TcpReceive, UdpReceive)
+        std::size_t         size;          ///< Size of the data or of the buffer
+        std::size_t         done;          ///< Number of bytes transferred so far
+        IpAddress           address;       ///< Address of the receiver (UdpSend)
+        unsigned short      port;          ///< Port of the receiver (UdpSend)
+        IpAddress*          remoteAddress; ///< Receives the address of the sender (UdpReceive)
+        unsigned short*     remotePort;    ///< Receives the port of the sender (UdpReceive)
+        priv::AsyncHandler* handler;       ///< Handler to call when the operation is complete
+    };
+
+    ////////////////////////////////////////////////////////////
+    struct Watch
+    {
+        std::deque<Operation> reads;  ///< Operations waiting for the socket to be readable, in order
+        std::deque<Operation> writes; ///< Operations waiting for the socket to be writable, in order
+        int                   events; ///< Events currently registered for the socket
+    };
+
+    ////////////////////////////////////////////////////////////
+    struct Completion
+    {
+        Socket*             socket;  ///< Socket of the operation (NULL for timers)
+        priv::AsyncHandler* handler; ///< Handler of the operation (NULL for timers)
+        priv::TimerHandler* timer;   ///< Handler of the timer (NULL for operations)
+        Socket::Status      status;  ///< Result of the operation
+        std::size_t         size;    ///< Number of bytes transferred
+    };
+
+    typedef std::map<SocketHandle, Watch>                          WatchTable;
+    typedef std::map<std::pair<Int64, Timer>, priv::TimerHandler*> TimerQueue;
+    typedef std::map<Timer, Int64>                                 DeadlineTable;
+
+    ////////////////////////////////////////////////////////////
+    EventLoopImpl() :
+    nextTimer(1),
+    wakerPort(0),
+    stopped  (false)
+    {
+        open();
+
+        // The waker receives a datagram when stop() is called from another thread; it only
+        // listens on the loopback interface, so that other hosts can't wake the loop up
+        if (waker.bind(Socket::AnyPort, IpAddress::LocalHost) == Socket::Done)
+        {
+            waker.setBlocking(false);
+            wakerPort = waker.getLocalPort();
+            watch(waker.getHandle(), 0, Readable);
+        }
+        else
+        {
+            err() << "Failed to create the wake-up socket of the event loop, stop() will only be handled after the next event" << std::endl;
+        }
+    }
+
+    ////////////////////////////////////////////////////////////
+    ~EventLoopImpl()
+    {
+        for (WatchTable::iterator it = watches.begin(); it != watches.end(); ++it)
+        {
+            discard(it->second.reads);
+            discard(it->second.writes);
+        }
+
+        for (TimerQueue::iterator it = timers.begin(); it != timers.end(); ++it)
+            delete it->second;
+
+        for (std::deque<Completion>::iterator it = completions.begin(); it != completions.end(); ++it)
+        {
+            delete it->handler;
+            delete it->timer;
+        }
+
+        close();
+    }
+
+    ////////////////////////////////////////////////////////////
+    void discard(std::deque<Operation>& operations)
+    {
+        for (std::deque<Operation>::iterator it = operations.begin(); it != operations.end(); ++it)
+            delete it->handler;
+        operations.clear();
+    }
+
+    ////////////////////////////////////////////////////////////
+    Operation createOperation(OperationType type, Socket& socket, priv::AsyncHandler* handler)
+    {
+        Operation operation;
+        operation.type          = type;
+        operation.socket        = &socket;
+        operation.client        = NULL;
+        operation.input         = NULL;
+        operation.output        = NULL;
+        operation.size          = 0;
+        operation.done          = 0;
+        operation.port          = 0;
+        operation.remoteAddress = NULL;
+        operation.remotePort    = NULL;
+        operation.handler       = handler;
+
+        return operation;
+    }
+
+    ////////////////////////////////////////////////////////////
+    void complete(const Operation& operation, Socket::Status status)
+    {
+        Completion completion = {operation.socket, operation.handler, NULL, status, operation.done};
+        completions.push_back(completion);
+    }
+
+    ////////////////////////////////////////////////////////////
+    void push(const Operation& operation)
+    {
+        SocketHandle handle = operation.socket->getHandle();
+        if (handle == priv::SocketImpl::invalidSocket())
+        {
+            err() << "Cannot start an asynchronous operation on an invalid socket" << std::endl;
+            complete(operation, Socket::Error);
+            return;
+        }
+
+        bool write = (operation.type == Connect) || (operation.type == TcpSend) || (operation.type == UdpSend);
+
+        Watch& watch = watches[handle];
+        if (write)
+            watch.writes.push_back(operation);
+        else
+            watch.reads.push_back(operation);
+
+        update(handle);
+    }
+
+    ////////////////////////////////////////////////////////////
+    void update(SocketHandle handle)
+    {
+        WatchTable::iterator it = watches.find(handle);
+        if (it == watches.end())
+            return;
+
+        Watch& watch = it->second;
+        int events = (watch.reads.empty() ? 0 : Readable) | (watch.writes.empty() ? 0 : Writable);
+        if (events == watch.events)
+            return;
+
+        // Only wait for the events that pending operations need
+        if (events != 0)
+        {
+            this->watch(handle, watch.events, events);
+            watch.events = events;
+        }
+        else
+        {
+            unwatch(handle);
+            watches.erase(it);
+        }
+    }
+
+    ////////////////////////////////////////////////////////////
+    Socket::Status perform(Operation& operation)
+    {
+        switch (operation.type)
+        {
+            case Connect :
+            {
+                // The socket is writable once the connection has either succeeded or failed
+                TcpSocket* socket = static_cast<TcpSocket*>(operation.socket);
+                return socket->getRemoteAddress() != IpAddress::None ? Socket::Done : Socket::Error;
+            }
+
+            case Accept :
+            {
+                return static_cast<TcpListener*>(operation.socket)->accept(*operation.client);
+            }
+
+            case TcpSend :
+            {
+                std::size_t sent = 0;
+                Socket::Status status = static_cast<TcpSocket*>(operation.socket)->send(operation.input + operation.done, operation.size - operation.done, sent);
+                operation.done += sent;
+
+                // Keep sending the rest when the socket is writable again
+                return status == Socket::Partial ? Socket::NotReady : status;
+            }
+
+            case TcpReceive :
+            {
+                return static_cast<TcpSocket*>(operation.socket)->receive(operation.output, operation.size, operation.done);
+            }
+
+            case UdpSend :
+            {
+                Socket::Status status = static_cast<UdpSocket*>(operation.socket)->send(operation.input, operation.size, operation.address, operation.port);
+                if (status == Socket::Done)
+                    operation.done = operation.size;
+
+                return status;
+            }
+
+            case UdpReceive :
+            {
+                UdpSocket* socket = static_cast<UdpSocket*>(operation.socket);
+                return socket->receive(operation.output, operation.size, operation.done, *operation.remoteAddress, *operation.remotePort);
+            }
+        }
+
+        return Socket::Error;
+    }
+
+    ////////////////////////////////////////////////////////////
+    void process(std::deque<Operation>& operations)
+    {
+        // Perform the operations in order, until one would block
+        while (!operations.empty())
+        {
+            Socket::Status status = perform(operations.front());
+            if (status == Socket::NotReady)
+                break;
+
+            complete(operations.front(), status);
+            operations.pop_front();
+        }
+    }
+
+    ////////////////////////////////////////////////////////////
+    void process(SocketHandle handle, int events)
+    {
+        if (handle == waker.getHandle())
+        {
+            // Drain the wake-up datagrams
+            char data[16];
+            std::size_t received;
+            IpAddress sender;
+            unsigned short port;
+            while (waker.receive(data, sizeof(data), received, sender, port) == Socket::Done)
+                ;
+
+            return;
+        }
+
+        WatchTable::iterator it = watches.find(handle);
+        if (it == watches.end())
+            return;
+
+        if (events & Readable)
+            process(it->second.reads);
+        if (events & Writable)
+            process(it->second.writes);
+
+        update(handle);
+    }
+
+    ////////////////////////////////////////////////////////////
+    void cancel(SocketHandle handle, Socket* socket)
+    {
+        WatchTable::iterator it = watches.find(handle);
+        if (it != watches.end())
+        {
+            discard(it->second.reads);
+            discard(it->second.writes);
+            unwatch(handle);
+            watches.erase(it);
+        }
+
+        // Forget the operations that are complete but whose handler was not called yet
+        std::deque<Completion>::iterator completion = completions.begin();
+        while (completion != completions.end())
+        {
+            if (completion->socket == socket)
+            {
+                delete completion->handler;
+                completion = completions.erase(completion);
+            }
+            else
+            {
+                ++completion;
+            }
+        }
+    }
+
+    ////////////////////////////////////////////////////////////
+    std::size_t step(Int64 timeout)
+    {
+        // Don't wait if some handlers can already be called, nor after the next timer
+        if (!completions.empty())
+            timeout = 0;
+
+        if (!timers.empty())
+        {
+            Int64 untilTimer = std::max<Int64>(timers.begin()->first.first - timeline.getElapsedTime().asMicroseconds(), 0);
+            timeout = timeout < 0 ? untilTimer : std::min(timeout, untilTimer);
+        }
+
+        // Perform the operations of the ready sockets
+        wait(timeout);
+
+        // Expire the timers
+        Int64 now = timeline.getElapsedTime().asMicroseconds();
+        while (!timers.empty() && (timers.begin()->first.first <= now))
+        {
+            Completion completion = {NULL, NULL, timers.begin()->second, Socket::Done, 0};
+            completions.push_back(completion);
+
+            deadlines.erase(timers.begin()->first.second);
+            timers.erase(timers.begin());
+        }
+
+        // Call the handlers; the ones of the operations that they start are called on the next step
+        std::size_t count = 0;
+        for (std::size_t remaining = completions.size(); (remaining > 0) && !completions.empty(); --remaining)
+        {
+            Completion completion = completions.front();
+            completions.pop_front();
+
+            if (completion.handler)
+            {
+                completion.handler->call(completion.status, completion.size);
+                delete completion.handler;
+            }
+            else
+            {
+                completion.timer->call();
+                delete completion.timer;
+            }
+
+            ++count;
+        }
+
+        return count;
+    }
+
+    ////////////////////////////////////////////////////////////
+    bool hasWork() const
+    {
+        return !watches.empty() || !timers.empty() || !completions.empty();
+    }
+
+#if defined(SFML_EVENTLOOP_EPOLL)
+
+    ////////////////////////////////////////////////////////////
+    void open()
+    {
+        queue = epoll_create(64);
+        if (queue < 0)
+            err() << "Failed to create the event loop (epoll_create failed)" << std::endl;
+    }
+
+    ////////////////////////////////////////////////////////////
+    void close()
+    {
+        if (queue >= 0)
+            ::close(queue);
+    }
+
+    ////////////////////////////////////////////////////////////
+    void watch(SocketHandle handle, int previousEvents, int events)
+    {
+        epoll_event event = epoll_event();
+        event.events  = ((events & Readable) ? EPOLLIN : 0u) | ((events & Writable) ? EPOLLOUT : 0u);
+        event.data.fd = handle;
+
+        if (epoll_ctl(queue, previousEvents ? EPOLL_CTL_MOD : EPOLL_CTL_ADD, handle, &event) < 0)
+        {
+            // The socket may have been closed and replaced without being cancelled
+            if (epoll_ctl(queue, previousEvents ? EPOLL_CTL_ADD : EPOLL_CTL_MOD, handle, &event) < 0)
+                err() << "Failed to watch a socket in the event loop (epoll_ctl failed)" << std::endl;
+        }
+    }
+
+    ////////////////////////////////////////////////////////////
+    void unwatch(SocketHandle handle)
+    {
+        epoll_event event = epoll_event();
+        epoll_ctl(queue, EPOLL_CTL_DEL, handle, &event);
+    }
+
+    ////////////////////////////////////////////////////////////
+    void wait(Int64 timeout)
+    {
+        readyEvents.resize(watches.size() + 1);
+
+        int milliseconds = timeout >= 0 ? static_cast<int>((timeout + 999) / 1000) : -1;
+        int count = epoll_wait(queue, &readyEvents[0], static_cast<int>(readyEvents.size()), milliseconds);
+
+        for (int i = 0; i < count; ++i)
+        {
+            // Errors and hang-ups are reported to all the pending operations
+            Uint32 flags = readyEvents[i].events;
+            int events = ((flags & EPOLLIN) ? Readable : 0) | ((flags & EPOLLOUT) ? Writable : 0);
+            if (flags & (EPOLLERR | EPOLLHUP))
+                events = Readable | Writable;
+
+            process(readyEvents[i].data.fd, events);
+        }
+    }
+
+    int                      queue;       ///< epoll instance
+    std::vector<epoll_event> readyEvents; ///< Events returned by epoll_wait
+
+#else
+
+    ////////////////////////////////////////////////////////////
+    void open()
+    {
+    }
+
+    ////////////////////////////////////////////////////////////
+    void close()
+    {
+    }
+
+    ////////////////////////////////////////////////////////////
+    void watch(SocketHandle, int, int)
+    {
+        // The set of descriptors is built from the watches on every wait
+    }
+
+    ////////////////////////////////////////////////////////////
+    void unwatch(SocketHandle)
+    {
+    }
+
+    ////////////////////////////////////////////////////////////
+    void wait(Int64 timeout)
+    {
+        descriptors.clear();
+
+        pollfd wakerDescriptor = {waker.getHandle(), POLLIN, 0};
+        if (wakerPort != 0)
+            descriptors.push_back(wakerDescriptor);
+
+        for (WatchTable::const_iterator it = watches.begin(); it != watches.end(); ++it)
+        {
+            pollfd descriptor = {it->first, 0, 0};
+            descriptor.events = ((it->second.events & Readable) ? POLLIN : 0) | ((it->second.events & Writable) ? POLLOUT : 0);
+            descriptors.push_back(descriptor);
+        }
+
+        if (descriptors.empty())
+            return;
+
+        int milliseconds = timeout >= 0 ? static_cast<int>((timeout + 999) / 1000) : -1;
+        if (SFML_EVENTLOOP_POLL(&descriptors[0], static_cast<unsigned long>(descriptors.size()), milliseconds) <= 0)
+            return;
+
+        for (std::vector<pollfd>::const_iterator it = descriptors.begin(); it != descriptors.end(); ++it)
+        {
+            // Errors and hang-ups are reported to all the pending operations
+            int events = ((it->revents & POLLIN) ? Readable : 0) | ((it->revents & POLLOUT) ? Writable : 0);
+            if (it->revents & (POLLERR | POLLHUP | POLLNVAL))
+                events = Readable | Writable;
+
+            if (events)
+                process(it->fd, events);
+        }
+    }
+
+    std::vector<pollfd> descriptors; ///< Descriptors passed to poll
+
+#endif
+
+    WatchTable             watches;     ///< Sockets that have pending operations
+    TimerQueue             timers;      ///< Pending timers, sorted by deadline
+    DeadlineTable          deadlines;   ///< Deadline of each pending timer
+    Timer                  nextTimer;   ///< Identifier of the next timer
+    std::deque<Completion> completions; ///< Handlers ready to be called
+    Clock                  timeline;    ///< Time reference of the timers
+    UdpSocket              waker;       ///< Socket that wakes the loop up when it is stopped
+    unsigned short         wakerPort;   ///< Port of the waker socket (0 if it couldn't be bound)
+    bool                   stopped;     ///< Has stop() been called?
+    Mutex                  stopMutex;   ///< Mutex protecting the stopped flag
+};
+
+
+////////////////////////////////////////////////////////////
+EventLoop::EventLoop() :
+m_impl(new EventLoopImpl)
+{
+
+}
+
+
+////////////////////////////////////////////////////////////
+EventLoop::~EventLoop()
+{
+    delete m_impl;
+}
+
+
+////////////////////////////////////////////////////////////
+void EventLoop::cancelTimer(Timer timer)
+{
+    EventLoopImpl::DeadlineTable::iterator it = m_impl->deadlines.find(timer);
+    if (it != m_impl->deadlines.end())
+    {
+        EventLoopImpl::TimerQueue::iterator entry = m_impl->timers.find(std::make_pair(it->second, timer));
+        delete entry->second;
+        m_impl->timers.erase(entry);
+        m_impl->deadlines.erase(it);
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void EventLoop::cancel(Socket& socket)
+{
+    m_impl->cancel(socket.getHandle(), &socket);
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t EventLoop::run()
+{
+    std::size_t count = 0;
+    while (m_impl->hasWork())
+    {
+        {
+            Lock lock(m_impl->stopMutex);
+            if (m_impl->stopped)
+                break;
+        }
+
+        count += m_impl->step(-1);
+    }
+
+    // The next call to run() starts again
+    Lock lock(m_impl->stopMutex);
+    m_impl->stopped = false;
+
+    return count;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t EventLoop::runOnce(Time timeout)
+{
+    return m_impl->step(timeout != Time::Zero ? std::max<Int64>(timeout.asMicroseconds(), 0) : -1);
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t EventLoop::poll()
+{
+    return m_impl->step(0);
+}
+
+
+////////////////////////////////////////////////////////////
+void EventLoop::stop()
+{
+    Lock lock(m_impl->stopMutex);
+    m_impl->stopped = true;
+
+    // Interrupt the wait of the loop
+    if (m_impl->wakerPort != 0)
+    {
+        char data = 0;
+        m_impl->waker.send(&data, sizeof(data), IpAddress::LocalHost, m_impl->wakerPort);
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t EventLoop::getPendingCount() const
+{
+    std::size_t count = m_impl->timers.size() + m_impl->completions.size();
+    for (EventLoopImpl::WatchTable::const_iterator it = m_impl->watches.begin(); it != m_impl->watches.end(); ++it)
+        count += it->second.reads.size() + it->second.writes.size();
+
+    return count;
+}
+
+
+////////////////////////////////////////////////////////////
+void EventLoop::connect(TcpSocket& socket, const IpAddress& remoteAddress, unsigned short remotePort, priv::AsyncHandler* handler)
+{
+    EventLoopImpl::Operation operation = m_impl->createOperation(Connect, socket, handler);
+
+    // Start connecting; unless it fails or succeeds right away, the socket becomes writable once it's done
+    socket.setBlocking(false);
+    Socket::Status status = socket.connect(remoteAddress, remotePort);
+    if (status == Socket::NotReady)
+        m_impl->push(operation);
+    else
+        m_impl->complete(operation, status);
+}
+
+
+////////////////////////////////////////////////////////////
+void EventLoop::accept(TcpListener& listener, TcpSocket& socket, priv::AsyncHandler* handler)
+{
+    EventLoopImpl::Operation operation = m_impl->createOperation(Accept, listener, handler);
+    operation.client = &socket;
+
+    listener.setBlocking(false);
+    m_impl->push(operation);
+}
+
+
+////////////////////////////////////////////////////////////
+void EventLoop::send(TcpSocket& socket, const void* data, std::size_t size, priv::AsyncHandler* handler)
+{
+    EventLoopImpl::Operation operation = m_impl->createOperation(TcpSend, socket, handler);
+    operation.input = static_cast<const char*>(data);
+    operation.size  = size;
+
+    socket.setBlocking(false);
+
+    // If no other send is pending, try to send right away: it usually succeeds and saves a wait
+    EventLoopImpl::WatchTable::iterator it = m_impl->watches.find(socket.getHandle());
+    if ((it == m_impl->watches.end()) || it->second.writes.empty())
+    {
+        Socket::Status status = m_impl->perform(operation);
+        if (status != Socket::NotReady)
+        {
+            m_impl->complete(operation, status);
+            return;
+        }
+    }
+
+    m_impl->push(operation);
+}
+
+
+////////////////////////////////////////////////////////////
+void EventLoop::receive(TcpSocket& socket, void* data, std::size_t size, priv::AsyncHandler* handler)
+{
+    EventLoopImpl::Operation operation = m_impl->createOperation(TcpReceive, socket, handler);
+    operation.output = static_cast<char*>(data);
+    operation.size   = size;
+
+    socket.setBlocking(false);
+    m_impl->push(operation);
+}
+
+
+////////////////////////////////////////////////////////////
+void EventLoop::send(UdpSocket& socket, const void* data, std::size_t size, const IpAddress& remoteAddress, unsigned short remotePort, priv::AsyncHandler* handler)
+{
+    EventLoopImpl::Operation operation = m_impl->createOperation(UdpSend, socket, handler);
+    operation.input   = static_cast<const char*>(data);
+    operation.size    = size;
+    operation.address = remoteAddress;
+    operation.port    = remotePort;
+
+    socket.setBlocking(false);
+    m_impl->push(operation);
+}
+
+
+////////////////////////////////////////////////////////////
+void EventLoop::receive(UdpSocket& socket, void* data, std::size_t size, IpAddress& remoteAddress, unsigned short& remotePort, priv::AsyncHandler* handler)
+{
+    EventLoopImpl::Operation operation = m_impl->createOperation(UdpReceive, socket, handler);
+    operation.output        = static_cast<char*>(data);
+    operation.size          = size;
+    operation.remoteAddress = &remoteAddress;
+    operation.remotePort    = &remotePort;
+
+    socket.setBlocking(false);
+    m_impl->push(operation);
+}
+
+
+////////////////////////////////////////////////////////////
+EventLoop::Timer EventLoop::startTimer(Time delay, priv::TimerHandler* handler)
+{
+    Timer timer = m_impl->nextTimer++;
+    Int64 deadline = m_impl->timeline.getElapsedTime().asMicroseconds() + std::max<Int64>(delay.asMicroseconds(), 0);
+
+    m_impl->timers.insert(std::make_pair(std::make_pair(deadline, timer), handler));
+    m_impl->deadlines.insert(std::make_pair(timer, deadline));
+
+    return timer;
+}
+
+} // namespace sf
@@ -33,6 +33,32 @@
 #include <sstream>
 
 
+namespace
+{
+    // Size of the chunks of data read from (or written to) files during transfers
+    const std::size_t chunkSize = 64 * 1024;
+
+    // Extract the filename from a file path
+    std::string getFilename(const std::string& path)
+    {
+        std::string::size_type pos = path.find_last_of("/\\");
+        if (pos != std::string::npos)
+            return path.substr(pos + 1);
+        else
+            return path;
+    }
+
+    // Make sure that a directory path ends with a slash
+    std::string getDirectory(const std::string& path)
+    {
+        if (!path.empty() && (path[path.size() - 1] != '\\') && (path[path.size() - 1] != '/'))
+            return path + "/";
+        else
+            return path;
+    }
+}
+
+
 namespace sf
 {
 ////////////////////////////////////////////////////////////
@@ -47,10 +73,10 @@ public :
     Ftp::Response open(Ftp::TransferMode mode);
 
     ////////////////////////////////////////////////////////////
-    void send(const std::vector<char>& data);
+    bool send(std::istream& stream, Uint64 offset, Uint64 total, priv::FtpProgressCallback* progress);
 
     ////////////////////////////////////////////////////////////
-    void receive(std::vector<char>& data);
+    bool receive(std::ostream& stream, Uint64 offset, Uint64 total, priv::FtpProgressCallback* progress);
 
 private :
 
@@ -148,6 +174,9 @@ Ftp::~Ftp()
 ////////////////////////////////////////////////////////////
 Ftp::Response Ftp::connect(const IpAddress& server, unsigned short port, Time timeout)
 {
+    // Forget the replies left over from a previous session
+    m_receiveBuffer.clear();
+
     // Connect to the server
     if (m_commandSocket.connect(server, port, timeout) != Socket::Done)
         return Response(Response::ConnectionFailed);
@@ -181,7 +210,10 @@ Ftp::Response Ftp::disconnect()
     // Send the exit command
     Response response = sendCommand("QUIT");
     if (response.isOk())
+    {
         m_commandSocket.disconnect();
+        m_receiveBuffer.clear();
+    }
 
     return response;
 }
@@ -205,7 +237,7 @@ Ftp::DirectoryResponse Ftp::getWorkingDirectory()
 Ftp::ListingResponse Ftp::getDirectoryListing(const std::string& directory)
 {
     // Open a data channel on default port (20) using ASCII transfer mode
-    std::vector<char> directoryData;
+    std::ostringstream directoryData;
     DataChannel data(*this);
     Response response = data.open(Ascii);
     if (response.isOk())
@@ -215,14 +247,15 @@ Ftp::ListingResponse Ftp::getDirectoryListing(const std::string& directory)
         if (response.isOk())
         {
             // Receive the listing
-            data.receive(directoryData);
+            data.receive(directoryData, 0, 0, NULL);
 
             // Get the response from the server
             response = getResponse();
         }
     }
 
-    return ListingResponse(response, directoryData);
+    std::string listing = directoryData.str();
+    return ListingResponse(response, std::vector<char>(listing.begin(), listing.end()));
 }
 
 
@@ -273,95 +306,16 @@ Ftp::Response Ftp::deleteFile(const std::string& name)
 
 
 ////////////////////////////////////////////////////////////
-Ftp::Response Ftp::download(const std::string& remoteFile, const std::string& localPath, TransferMode mode)
+Ftp::Response Ftp::download(const std::string& remoteFile, const std::string& localPath, TransferMode mode, bool resume)
 {
-    // Open a data channel using the given transfer mode
-    DataChannel data(*this);
-    Response response = data.open(mode);
-    if (response.isOk())
-    {
-        // Tell the server to start the transfer
-        response = sendCommand("RETR", remoteFile);
-        if (response.isOk())
-        {
-            // Receive the file data
-            std::vector<char> fileData;
-            data.receive(fileData);
-
-            // Get the response from the server
-            response = getResponse();
-            if (response.isOk())
-            {
-                // Extract the filename from the file path
-                std::string filename = remoteFile;
-                std::string::size_type pos = filename.find_last_of("/\\");
-                if (pos != std::string::npos)
-                    filename = filename.substr(pos + 1);
-
-                // Make sure the destination path ends with a slash
-                std::string path = localPath;
-                if (!path.empty() && (path[path.size() - 1] != '\\') && (path[path.size() - 1] != '/'))
-                    path += "/";
-
-                // Create the file and copy the received data into it
-                std::ofstream file((path + filename).c_str(), std::ios_base::binary);
-                if (!file)
-                    return Response(Response::InvalidFile);
-
-                if (!fileData.empty())
-                    file.write(&fileData[0], static_cast<std::streamsize>(fileData.size()));
-            }
-        }
-    }
-
-    return response;
+    return performDownload(remoteFile, localPath, mode, resume, NULL);
 }
 
 
 ////////////////////////////////////////////////////////////
-Ftp::Response Ftp::upload(const std::string& localFile, const std::string& remotePath, TransferMode mode)
+Ftp::Response Ftp::upload(const std::string& localFile, const std::string& remotePath, TransferMode mode, bool resume)
 {
-    // Get the contents of the file to send
-    std::ifstream file(localFile.c_str(), std::ios_base::binary);
-    if (!file)
-        return Response(Response::InvalidFile);
-
-    file.seekg(0, std::ios::end);
-    std::size_t length = static_cast<std::size_t>(file.tellg());
-    file.seekg(0, std::ios::beg);
-    std::vector<char> fileData(length);
-    if (length > 0)
-        file.read(&fileData[0], static_cast<std::streamsize>(length));
-
-    // Extract the filename from the file path
-    std::string filename = localFile;
-    std::string::size_type pos = filename.find_last_of("/\\");
-    if (pos != std::string::npos)
-        filename = filename.substr(pos + 1);
-
-    // Make sure the destination path ends with a slash
-    std::string path = remotePath;
-    if (!path.empty() && (path[path.size() - 1] != '\\') && (path[path.size() - 1] != '/'))
-        path += "/";
-
-    // Open a data channel using the given transfer mode
-    DataChannel data(*this);
-    Response response = data.open(mode);
-    if (response.isOk())
-    {
-        // Tell the server to start the transfer
-        response = sendCommand("STOR", path + filename);
-        if (response.isOk())
-        {
-            // Send the file data
-            data.send(fileData);
-
-            // Get the response from the server
-            response = getResponse();
-        }
-    }
-
-    return response;
+    return performUpload(localFile, remotePath, mode, resume, NULL);
 }
 
 
@@ -396,11 +350,20 @@ Ftp::Response Ftp::getResponse()
 
     for (;;)
     {
-        // Receive the response from the server
+        // Receive the response from the server, unless some data was left from the previous one
         char buffer[1024];
         std::size_t length;
-        if (m_commandSocket.receive(buffer, sizeof(buffer), length) != Socket::Done)
-            return Response(Response::ConnectionClosed);
+        if (m_receiveBuffer.empty())
+        {
+            if (m_commandSocket.receive(buffer, sizeof(buffer), length) != Socket::Done)
+                return Response(Response::ConnectionClosed);
+        }
+        else
+        {
+            length = std::min(m_receiveBuffer.size(), sizeof(buffer));
+            std::copy(m_receiveBuffer.begin(), m_receiveBuffer.begin() + length, buffer);
+            m_receiveBuffer.erase(0, length);
+        }
 
         // There can be several lines inside the received buffer, extract them all
         std::istringstream in(std::string(buffer, length), std::ios_base::binary);
@@ -459,6 +422,10 @@ Ftp::Response Ftp::getResponse()
                             message = separator + line;
                         }
 
+                        // Keep the data that follows the response for the next one
+                        std::string remaining((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+                        m_receiveBuffer.insert(0, remaining);
+
                         // Return the response code and message
                         return Response(static_cast<Response::Status>(code), message);
                     }
@@ -516,6 +483,120 @@ Ftp::Response Ftp::getResponse()
 }
 
 
+////////////////////////////////////////////////////////////
+Ftp::Response Ftp::performDownload(const std::string& remoteFile, const std::string& localPath, TransferMode mode, bool resume, priv::FtpProgressCallback* progress)
+{
+    std::string localFile = getDirectory(localPath) + getFilename(remoteFile);
+
+    // Find how much of the file was already downloaded
+    Uint64 offset = 0;
+    if (resume)
+    {
+        std::ifstream file(localFile.c_str(), std::ios_base::binary | std::ios_base::ate);
+        if (file)
+            offset = static_cast<Uint64>(file.tellg());
+    }
+
+    // Get the size of the file, to report the progress
+    Uint64 total = 0;
+    if (progress && !getFileSize(remoteFile, total))
+        total = 0;
+
+    // Open a data channel using the given transfer mode
+    DataChannel data(*this);
+    Response response = data.open(mode);
+    if (response.isOk())
+    {
+        // Ask the server to start the transfer where the local file ends (or from the beginning if it can't)
+        if (offset > 0)
+        {
+            std::ostringstream position;
+            position << offset;
+            if (!sendCommand("REST", position.str()).isOk())
+                offset = 0;
+        }
+
+        // Tell the server to start the transfer
+        response = sendCommand("RETR", remoteFile);
+        if (response.isOk())
+        {
+            // Create the file (or complete it) and write the data into it as it is received;
+            // if the file can't be written, the transfer stops at the first chunk
+            std::ofstream file(localFile.c_str(), std::ios_base::binary | (offset > 0 ? std::ios_base::app : std::ios_base::trunc));
+            bool complete = data.receive(file, offset, total, progress);
+
+            // Get the response from the server
+            response = getResponse();
+            if (!file)
+                response = Response(Response::InvalidFile);
+            else if (!complete && response.isOk())
+                response = Response(Response::TransferAborted);
+        }
+    }
+
+    return response;
+}
+
+
+////////////////////////////////////////////////////////////
+Ftp::Response Ftp::performUpload(const std::string& localFile, const std::string& remotePath, TransferMode mode, bool resume, priv::FtpProgressCallback* progress)
+{
+    // Open the file to send
+    std::ifstream file(localFile.c_str(), std::ios_base::binary);
+    if (!file)
+        return Response(Response::InvalidFile);
+
+    file.seekg(0, std::ios::end);
+    Uint64 total = static_cast<Uint64>(file.tellg());
+
+    std::string remoteFile = getDirectory(remotePath) + getFilename(localFile);
+
+    // Find how much of the file the server already has
+    Uint64 offset = 0;
+    if (resume && !getFileSize(remoteFile, offset))
+        offset = 0;
+
+    offset = std::min(offset, total);
+    file.seekg(static_cast<std::streamoff>(offset), std::ios::beg);
+
+    // Open a data channel using the given transfer mode
+    DataChannel data(*this);
+    Response response = data.open(mode);
+    if (response.isOk())
+    {
+        // Tell the server to start the transfer, appending to the remote file if it's partially there
+        response = sendCommand(offset > 0 ? "APPE" : "STOR", remoteFile);
+        if (response.isOk())
+        {
+            // Send the file data as it is read
+            bool complete = data.send(file, offset, total, progress);
+
+            // Get the response from the server
+            response = getResponse();
+            if (!complete && response.isOk())
+                response = Response(Response::TransferAborted);
+        }
+    }
+
+    return response;
+}
+
+
+////////////////////////////////////////////////////////////
+bool Ftp::getFileSize(const std::string& remoteFile, Uint64& size)
+{
+    // The response to the SIZE command is "213 <size>"
+    Response response = sendCommand("SIZE", remoteFile);
+    if (response.getStatus() != Response::FileStatus)
+        return false;
+
+    std::istringstream in(response.getMessage());
+    in >> size;
+
+    return !in.fail();
+}
+
+
 ////////////////////////////////////////////////////////////
 Ftp::DataChannel::DataChannel(Ftp& owner) :
 m_ftp(owner)
@@ -586,31 +667,65 @@ Ftp::Response Ftp::DataChannel::open(Ftp::TransferMode mode)
 
 
 ////////////////////////////////////////////////////////////
-void Ftp::DataChannel::receive(std::vector<char>& data)
+bool Ftp::DataChannel::receive(std::ostream& stream, Uint64 offset, Uint64 total, priv::FtpProgressCallback* progress)
 {
-    // Receive data
-    data.clear();
-    char buffer[1024];
+    // Receive data by chunks, and write them to the stream as they arrive
+    std::vector<char> buffer(chunkSize);
     std::size_t received;
-    while (m_dataSocket.receive(buffer, sizeof(buffer), received) == Socket::Done)
+    bool complete = true;
+    while (m_dataSocket.receive(&buffer[0], buffer.size(), received) == Socket::Done)
     {
-        std::copy(buffer, buffer + received, std::back_inserter(data));
+        stream.write(&buffer[0], static_cast<std::streamsize>(received));
+        offset += received;
+
+        if (!stream || (progress && !progress->call(offset, total)))
+        {
+            complete = false;
+            break;
+        }
     }
 
     // Close the data socket
     m_dataSocket.disconnect();
+
+    return complete;
 }
 
 
 ////////////////////////////////////////////////////////////
-void Ftp::DataChannel::send(const std::vector<char>& data)
+bool Ftp::DataChannel::send(std::istream& stream, Uint64 offset, Uint64 total, priv::FtpProgressCallback* progress)
 {
-    // Send data
-    if (!data.empty())
-        m_dataSocket.send(&data[0], data.size());
+    // Read data by chunks, and send them as they are read
+    std::vector<char> buffer(chunkSize);
+    bool complete = true;
+    for (;;)
+    {
+        stream.read(&buffer[0], static_cast<std::streamsize>(buffer.size()));
+        std::size_t count = static_cast<std::size_t>(stream.gcount());
+        if (count == 0)
+        {
+            complete = stream.eof();
+            break;
+        }
+
+        if (m_dataSocket.send(&buffer[0], count) != Socket::Done)
+        {
+            complete = false;
+            break;
+        }
+
+        offset += count;
+        if (progress && !progress->call(offset, total))
+        {
+            complete = false;
+            break;
+        }
+    }
 
     // Close the data socket
     m_dataSocket.disconnect();
+
+    return complete;
 }
 
 } // namespace sf
@@ -27,15 +27,19 @@
 ////////////////////////////////////////////////////////////
 #include <SFML/Network/Http.hpp>
 #include <SFML/System/Err.hpp>
-#include <cctype>
 #include <algorithm>
-#include <iterator>
-#include <sstream>
+#include <cctype>
+#include <cstdlib>
+#include <fstream>
 #include <limits>
+#include <sstream>
 
 
 namespace
 {
+    // Largest part of a body that is reserved up front, so that a bogus Content-Length can't exhaust the memory
+    const std::size_t maxBodyReserve = 1024 * 1024;
+
     // Convert a string to lower case
     std::string toLower(std::string str)
     {
@@ -43,6 +47,36 @@ namespace
             *i = static_cast<char>(std::tolower(*i));
         return str;
     }
+
+    // Write the body of a response to a file, appending to it if the response is partial
+    struct FileSink : sf::priv::HttpBodyCallback
+    {
+        FileSink(const std::string& filename) : filename(filename), offset(0), failed(false) {}
+
+        virtual bool accept(const sf::Http::Response& response)
+        {
+            if (response.getStatus() == sf::Http::Response::PartialContent)
+                file.open(filename.c_str(), std::ios_base::binary | std::ios_base::app);
+            else if (response.getStatus() == sf::Http::Response::Ok)
+                file.open(filename.c_str(), std::ios_base::binary | std::ios_base::trunc);
+            else
+                return false;
+
+            failed = !file;
+            return !failed;
+        }
+
+        virtual bool call(const char* data, std::size_t size)
+        {
+            failed = !file.write(data, static_cast<std::streamsize>(size));
+            return !failed;
+        }
+
+        std::string    filename;
+        std::ofstream  file;
+        std::streamoff offset;
+        bool           failed;
+    };
 }
 
 
@@ -195,125 +229,166 @@ const std::string& Http::Response::getBody() const
 
 
 ////////////////////////////////////////////////////////////
-void Http::Response::parse(const std::string& data)
+void Http::Response::parseHeader(const std::string& header)
 {
-    std::istringstream in(data);
-
     // Extract the HTTP version from the first line
-    std::string version;
-    if (in >> version)
+    std::string::size_type lineEnd = header.find('\n');
+    std::string line = header.substr(0, lineEnd);
+    std::string::size_type space = line.find(' ');
+    std::string version = line.substr(0, space);
+    if ((version.size() >= 8) && (version[6] == '.') &&
+        (toLower(version.substr(0, 5)) == "http/")   &&
+         isdigit(version[5]) && isdigit(version[7]))
     {
-        if ((version.size() >= 8) && (version[6] == '.') &&
-            (toLower(version.substr(0, 5)) == "http/")   &&
-             isdigit(version[5]) && isdigit(version[7]))
-        {
-            m_majorVersion = version[5] - '0';
-            m_minorVersion = version[7] - '0';
-        }
-        else
-        {
-            // Invalid HTTP version
-            m_status = InvalidResponse;
-            return;
-        }
+        m_majorVersion = version[5] - '0';
+        m_minorVersion = version[7] - '0';
     }
-
-    // Extract the status code from the first line
-    int status;
-    if (in >> status)
+    else
     {
-        m_status = static_cast<Status>(status);
+        // Invalid HTTP version
+        m_status = InvalidResponse;
+        return;
     }
-    else
+
+    // Extract the status code from the first line
+    std::string::size_type codeBegin = line.find_first_not_of(' ', space);
+    if ((codeBegin == std::string::npos) || !isdigit(line[codeBegin]))
     {
         // Invalid status code
         m_status = InvalidResponse;
         return;
     }
-
-    // Ignore the end of the first line
-    in.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+    m_status = static_cast<Status>(std::atoi(line.c_str() + codeBegin));
 
     // Parse the other lines, which contain fields, one by one
-    parseFields(in);
+    while (lineEnd != std::string::npos)
+    {
+        std::string::size_type lineBegin = lineEnd + 1;
+        lineEnd = header.find('\n', lineBegin);
+        parseField(header.substr(lineBegin, lineEnd == std::string::npos ? std::string::npos : lineEnd - lineBegin));
+    }
+}
 
-    m_body.clear();
 
-    // Determine whether the transfer is chunked
-    if (toLower(getField("transfer-encoding")) != "chunked")
+////////////////////////////////////////////////////////////
+void Http::Response::parseField(const std::string& line)
+{
+    std::string::size_type pos = line.find(':');
+    if (pos != std::string::npos)
     {
-        // Not chunked - just read everything at once
-        std::copy(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>(), std::back_inserter(m_body));
+        // Extract the field name and its value, without the surrounding spaces and \r
+        std::string field = line.substr(0, pos);
+        std::string::size_type valueBegin = line.find_first_not_of(" \t", pos + 1);
+        std::string::size_type valueEnd = line.find_last_not_of(" \t\r");
+        std::string value;
+        if ((valueBegin != std::string::npos) && (valueEnd >= valueBegin))
+            value = line.substr(valueBegin, valueEnd - valueBegin + 1);
+
+        // Add the field
+        m_fields[toLower(field)] = value;
     }
-    else
+}
+
+
+////////////////////////////////////////////////////////////
+struct Http::Connection
+{
+    Connection() :
+    begin   (0),
+    end     (0),
+    received(0)
     {
-        // Chunked - have to read chunk by chunk
-        std::size_t length;
+    }
 
-        // Read all chunks, identified by a chunk-size not being 0
-        while (in >> std::hex >> length)
+    ////////////////////////////////////////////////////////////
+    // Receive more data from the server
+    ////////////////////////////////////////////////////////////
+    bool fill()
+    {
+        // Move the unread data to the front, and grow the buffer if it's full
+        if (begin > 0)
         {
-            // Drop the rest of the line (chunk-extension)
-            in.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
-
-            // Copy the actual content data
-            std::istreambuf_iterator<char> it(in);
-            for (std::size_t i = 0; i < length; i++)
-                m_body.push_back(*it++);
+            std::copy(buffer.begin() + begin, buffer.begin() + end, buffer.begin());
+            end -= begin;
+            begin = 0;
         }
 
-        // Drop the rest of the line (chunk-extension)
-        in.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+        if (end == buffer.size())
+            buffer.resize(std::max<std::size_t>(buffer.size() * 2, 16384));
 
-        // Read all trailers (if present)
-        parseFields(in);
-    }
-}
+        std::size_t size = 0;
+        if (socket.receive(&buffer[end], buffer.size() - end, size) != Socket::Done)
+            return false;
 
+        end += size;
+        received += size;
 
-////////////////////////////////////////////////////////////
-void Http::Response::parseFields(std::istream &in)
-{
-    std::string line;
-    while (std::getline(in, line) && (line.size() > 2))
+        return true;
+    }
+
+    ////////////////////////////////////////////////////////////
+    // Read a line, without its \r\n
+    ////////////////////////////////////////////////////////////
+    bool readLine(std::string& line)
     {
-        std::string::size_type pos = line.find(": ");
-        if (pos != std::string::npos)
+        for (;;)
         {
-            // Extract the field name and its value
-            std::string field = line.substr(0, pos);
-            std::string value = line.substr(pos + 2);
+            std::vector<char>::iterator first = buffer.begin() + begin;
+            std::vector<char>::iterator last = buffer.begin() + end;
+            std::vector<char>::iterator newLine = std::find(first, last, '\n');
+            if (newLine != last)
+            {
+                line.assign(first, newLine);
+                if (!line.empty() && (*line.rbegin() == '\r'))
+                    line.erase(line.size() - 1);
 
-            // Remove any trailing \r
-            if (!value.empty() && (*value.rbegin() == '\r'))
-                value.erase(value.size() - 1);
+                begin += newLine - first + 1;
+                return true;
+            }
 
-            // Add the field
-            m_fields[toLower(field)] = value;
+            if (!fill())
+                return false;
         }
     }
-}
+
+    TcpSocket         socket;   ///< Socket connected to the host
+    std::vector<char> buffer;   ///< Data received from the host
+    std::size_t       begin;    ///< Beginning of the data not read yet
+    std::size_t       end;      ///< End of the data received
+    std::size_t       received; ///< Number of bytes received for the current response
+};
 
 
 ////////////////////////////////////////////////////////////
 Http::Http() :
-m_host(),
-m_port(0)
+m_keepAlive(true),
+m_host     (),
+m_port     (0)
 {
 
 }
 
 
 ////////////////////////////////////////////////////////////
-Http::Http(const std::string& host, unsigned short port)
+Http::Http(const std::string& host, unsigned short port) :
+m_keepAlive(true)
 {
     setHost(host, port);
 }
 
 
+////////////////////////////////////////////////////////////
+Http::~Http()
+{
+    setKeepAlive(false);
+}
+
+
 ////////////////////////////////////////////////////////////
 void Http::setHost(const std::string& host, unsigned short port)
 {
+    std::string previousHostName = m_hostName;
+
     // Check the protocol
     if (toLower(host.substr(0, 7)) == "http://")
     {
@@ -339,75 +414,475 @@ void Http::setHost(const std::string& host, unsigned short port)
     if (!m_hostName.empty() && (*m_hostName.rbegin() == '/'))
         m_hostName.erase(m_hostName.size() - 1);
 
-    m_host = IpAddress(m_hostName);
+    // The host name is resolved when it is needed, unless it didn't change
+    if (m_hostName != previousHostName)
+        m_host = IpAddress::None;
 }
 
 
 ////////////////////////////////////////////////////////////
 Http::Response Http::sendRequest(const Http::Request& request, Time timeout)
 {
-    // First make sure that the request is valid -- add missing mandatory fields
+    Response response;
+    performRequests(&request, 1, &response, timeout, NULL);
+
+    return response;
+}
+
+
+////////////////////////////////////////////////////////////
+std::vector<Http::Response> Http::sendRequests(const std::vector<Request>& requests, Time timeout)
+{
+    std::vector<Response> responses(requests.size());
+    if (!requests.empty())
+        performRequests(&requests[0], requests.size(), &responses[0], timeout, NULL);
+
+    return responses;
+}
+
+
+////////////////////////////////////////////////////////////
+void Http::setKeepAlive(bool enabled)
+{
+    m_keepAlive = enabled;
+
+    if (!enabled)
+    {
+        for (ConnectionTable::iterator it = m_connections.begin(); it != m_connections.end(); ++it)
+        {
+            it->second->socket.disconnect();
+            delete it->second;
+        }
+        m_connections.clear();
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+Http::Response Http::download(const Request& request, const std::string& filename, bool resume, Time timeout)
+{
+    FileSink sink(filename);
+
+    // Only ask for the missing part of the file, if some of it is already there
     Request toSend(request);
-    if (!toSend.hasField("From"))
+    if (resume)
+    {
+        std::ifstream existing(filename.c_str(), std::ios_base::binary | std::ios_base::ate);
+        if (existing)
+            sink.offset = existing.tellg();
+
+        if (sink.offset > 0)
+        {
+            std::ostringstream range;
+            range << "bytes=" << sink.offset << "-";
+            toSend.setField("Range", range.str());
+        }
+    }
+
+    Response response;
+    performRequests(&toSend, 1, &response, timeout, &sink);
+
+    if (sink.failed)
+    {
+        err() << "Failed to write the HTTP response to \"" << filename << "\"" << std::endl;
+        response.m_status = Response::ConnectionFailed;
+    }
+
+    return response;
+}
+
+
+////////////////////////////////////////////////////////////
+void Http::completeRequest(Request& request) const
+{
+    if (!request.hasField("From"))
     {
-        toSend.setField("From", "user@sfml-dev.org");
+        request.setField("From", "user@sfml-dev.org");
     }
-    if (!toSend.hasField("User-Agent"))
+    if (!request.hasField("User-Agent"))
     {
-        toSend.setField("User-Agent", "libsfml-network/2.x");
+        request.setField("User-Agent", "libsfml-network/2.x");
     }
-    if (!toSend.hasField("Host"))
+    if (!request.hasField("Host"))
     {
-        toSend.setField("Host", m_hostName);
+        request.setField("Host", m_hostName);
     }
-    if (!toSend.hasField("Content-Length"))
+    if (!request.hasField("Content-Length"))
     {
         std::ostringstream out;
-        out << toSend.m_body.size();
-        toSend.setField("Content-Length", out.str());
+        out << request.m_body.size();
+        request.setField("Content-Length", out.str());
     }
-    if ((toSend.m_method == Request::Post) && !toSend.hasField("Content-Type"))
+    if ((request.m_method == Request::Post) && !request.hasField("Content-Type"))
     {
-        toSend.setField("Content-Type", "application/x-www-form-urlencoded");
+        request.setField("Content-Type", "application/x-www-form-urlencoded");
     }
-    if ((toSend.m_majorVersion * 10 + toSend.m_minorVersion >= 11) && !toSend.hasField("Connection"))
+    if (!request.hasField("Connection"))
     {
-        toSend.setField("Connection", "close");
+        if (m_keepAlive)
+            request.setField("Connection", "keep-alive");
+        else if (request.m_majorVersion * 10 + request.m_minorVersion >= 11)
+            request.setField("Connection", "close");
     }
+}
 
-    // Prepare the response
-    Response received;
 
-    // Connect the socket to the host
-    if (m_connection.connect(m_host, m_port, timeout) == Socket::Done)
+////////////////////////////////////////////////////////////
+void Http::performRequests(const Request* requests, std::size_t count, Response* responses, Time timeout, priv::HttpBodyCallback* bodyCallback)
+{
+    // First make sure that the requests are valid -- add missing mandatory fields
+    std::vector<Request> toSend(requests, requests + count);
+    for (std::vector<Request>::iterator it = toSend.begin(); it != toSend.end(); ++it)
+        completeRequest(*it);
+
+    std::string data;
+    std::size_t next = 0;
+    bool retried = false;
+    while (next < count)
     {
-        // Convert the request to string and send it through the connected socket
-        std::string requestStr = toSend.prepare();
+        // Connect the socket to the host, or reuse the previous connection
+        bool reused = false;
+        Connection* connection = openConnection(timeout, reused);
+        if (!connection)
+            break;
+
+        // Pipeline consecutive requests that can safely be sent again if the connection is lost
+        std::size_t last = next + 1;
+        if (m_keepAlive && (toSend[next].m_method != Request::Post))
+        {
+            while ((last < count) && (toSend[last].m_method != Request::Post))
+                ++last;
+        }
+
+        // Convert the requests to string and send them through the connected socket
+        data.clear();
+        for (std::size_t i = next; i < last; ++i)
+            data += toSend[i].prepare();
+
+        bool success = connection->socket.send(data.c_str(), data.size()) == Socket::Done;
+
+        // Wait for the server's responses
+        std::size_t answered = next;
+        bool reusable = success;
+        while (success && reusable && (answered < last))
+        {
+            connection->received = 0;
+            responses[answered] = Response();
+            success = readResponse(*connection, toSend[answered], responses[answered], bodyCallback, reusable);
+            if (success)
+                ++answered;
+        }
 
-        if (!requestStr.empty())
+        // A connection kept alive may have been closed by the server in the meantime: try again with a new one
+        bool receivedNothing = connection->received == 0;
+        bool closedByServer = reused && (answered == next) && receivedNothing;
+        releaseConnection(connection, success && reusable && (answered == last));
+
+        if (closedByServer && !retried)
         {
-            // Send it through the socket
-            if (m_connection.send(requestStr.c_str(), requestStr.size()) == Socket::Done)
+            responses[next] = Response();
+            retried = true;
+            continue;
+        }
+
+        // If the first request failed on a new connection, give up on it and continue with the next ones
+        if (answered == next)
+        {
+            if (!receivedNothing)
+                responses[next].m_status = Response::InvalidResponse;
+            ++answered;
+        }
+
+        next = answered;
+        retried = false;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+Http::Connection* Http::beginRequest(const Request& request, Response& response, Body& body, bool& reusable, Time timeout)
+{
+    Request toSend(request);
+    completeRequest(toSend);
+    std::string data = toSend.prepare();
+
+    for (int attempt = 0; attempt < 2; ++attempt)
+    {
+        bool reused = false;
+        Connection* connection = openConnection(timeout, reused);
+        if (!connection)
+            break;
+
+        connection->received = 0;
+        response = Response();
+        if ((connection->socket.send(data.c_str(), data.size()) == Socket::Done) &&
+            readHeader(*connection, toSend, response, body, reusable))
+            return connection;
+
+        // A connection kept alive may have been closed by the server in the meantime: try again with a new one
+        bool closedByServer = reused && (connection->received == 0);
+        if (!closedByServer && (connection->received > 0))
+            response.m_status = Response::InvalidResponse;
+
+        releaseConnection(connection, false);
+        if (!closedByServer)
+            break;
+    }
+
+    return NULL;
+}
+
+
+////////////////////////////////////////////////////////////
+bool Http::readResponse(Connection& connection, const Request& request, Response& response, priv::HttpBodyCallback* bodyCallback, bool& reusable)
+{
+    Body body;
+    if (!readHeader(connection, request, response, body, reusable))
+        return false;
+
+    // Give the body to the callback if it accepts this response, or store it in the response
+    if (bodyCallback && !bodyCallback->accept(response))
+        bodyCallback = NULL;
+
+    if (!bodyCallback && !body.chunked && !body.untilClose)
+        response.m_body.reserve(std::min(body.remaining, maxBodyReserve));
+
+    for (;;)
+    {
+        const char* data = NULL;
+        std::size_t size = 0;
+        if (!readBody(connection, response, body, std::numeric_limits<std::size_t>::max(), data, size))
+            return false;
+
+        if (size == 0)
+            break;
+
+        if (!bodyCallback)
+        {
+            response.m_body.append(data, size);
+        }
+        else if (!bodyCallback->call(data, size))
+        {
+            // The transfer was stopped by the callback: the connection can't be used anymore
+            reusable = false;
+            break;
+        }
+    }
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+bool Http::readHeader(Connection& connection, const Request& request, Response& response, Body& body, bool& reusable)
+{
+    // Read the header, skipping the informational responses (1xx)
+    do
+    {
+        std::string header;
+        std::string line;
+        do
+        {
+            if (!connection.readLine(line))
+                return false;
+
+            header += line;
+            header += '\n';
+        }
+        while (!line.empty());
+
+        response = Response();
+        response.parseHeader(header);
+        if (response.m_status == Response::InvalidResponse)
+            return false;
+    }
+    while ((response.m_status >= 100) && (response.m_status < 200));
+
+    // Determine whether the connection can be kept alive after this response
+    std::string connectionField = toLower(response.getField("connection"));
+    if (response.m_majorVersion * 10 + response.m_minorVersion >= 11)
+        reusable = connectionField.find("close") == std::string::npos;
+    else
+        reusable = connectionField.find("keep-alive") != std::string::npos;
+
+    std::map<std::string, std::string>::const_iterator requested = request.m_fields.find("connection");
+    if ((requested != request.m_fields.end()) && (toLower(requested->second).find("close") != std::string::npos))
+        reusable = false;
+
+    // Determine how the end of the body will be found
+    body.chunked    = false;
+    body.untilClose = false;
+    body.started    = false;
+    body.finished   = false;
+    body.remaining  = 0;
+
+    const std::string& contentLength = response.getField("content-length");
+    if ((request.m_method == Request::Head) || (response.m_status == Response::NoContent) || (response.m_status == Response::NotModified))
+    {
+        // No body
+        body.finished = true;
+    }
+    else if (toLower(response.getField("transfer-encoding")).find("chunked") != std::string::npos)
+    {
+        // Chunked - read chunk by chunk, each preceded by its size
+        body.chunked = true;
+    }
+    else if (!contentLength.empty())
+    {
+        // Known size, which must be a plain decimal number
+        char* end = NULL;
+        unsigned long length = std::strtoul(contentLength.c_str(), &end, 10);
+        if (!std::isdigit(static_cast<unsigned char>(contentLength[0])) || (*end != '\0') ||
+            (length == std::numeric_limits<unsigned long>::max()) || (length > std::numeric_limits<std::size_t>::max()))
+        {
+            response.m_status = Response::InvalidResponse;
+            return false;
+        }
+
+        body.remaining = static_cast<std::size_t>(length);
+    }
+    else
+    {
+        // Unknown size - read until the server closes the connection
+        body.untilClose = true;
+        reusable = false;
+    }
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+bool Http::readBody(Connection& connection, Response& response, Body& body, std::size_t maxSize, const char*& data, std::size_t& size)
+{
+    size = 0;
+
+    for (;;)
+    {
+        if (body.finished)
+            return true;
+
+        if (!body.untilClose && (body.remaining == 0))
+        {
+            if (!body.chunked)
+            {
+                body.finished = true;
+                continue;
+            }
+
+            // End of a chunk: read the size of the next one, the last one being empty
+            std::string line;
+            if (body.started && (!connection.readLine(line) || !line.empty()))
+                return false;
+
+            if (!connection.readLine(line) || !isxdigit(line.c_str()[0]))
+                return false;
+
+            body.started = true;
+            body.remaining = std::strtoul(line.c_str(), NULL, 16);
+            if (body.remaining == 0)
             {
-                // Wait for the server's response
-                std::string receivedStr;
-                std::size_t size = 0;
-                char buffer[1024];
-                while (m_connection.receive(buffer, sizeof(buffer), size) == Socket::Done)
+                // Read all trailers (if present)
+                do
                 {
-                    receivedStr.append(buffer, buffer + size);
+                    if (!connection.readLine(line))
+                        return false;
+
+                    response.parseField(line);
                 }
+                while (!line.empty());
 
-                // Build the Response object from the received data
-                received.parse(receivedStr);
+                body.finished = true;
             }
+            continue;
         }
 
-        // Close the connection
-        m_connection.disconnect();
+        if (connection.begin == connection.end)
+        {
+            if (!connection.fill())
+            {
+                if (!body.untilClose)
+                    return false;
+
+                body.finished = true;
+            }
+            continue;
+        }
+
+        // Return the data that is already received, up to the end of the body (or chunk)
+        size = std::min(connection.end - connection.begin, maxSize);
+        if (!body.untilClose)
+            size = std::min(size, body.remaining);
+
+        data = &connection.buffer[connection.begin];
+        connection.begin += size;
+        if (!body.untilClose)
+            body.remaining -= size;
+
+        return true;
     }
+}
+
 
-    return received;
+////////////////////////////////////////////////////////////
+Http::Connection* Http::openConnection(Time timeout, bool& reused)
+{
+    // Reuse the connection kept alive for the host, if any
+    ConnectionTable::iterator it = m_connections.find(std::make_pair(m_hostName, m_port));
+    if (it != m_connections.end())
+    {
+        Connection* connection = it->second;
+        m_connections.erase(it);
+        reused = true;
+
+        return connection;
+    }
+
+    // Resolve the host name if it is not done yet
+    if (m_host == IpAddress::None)
+    {
+        // IPv6 addresses are enclosed in brackets in URLs
+        if ((m_hostName.size() > 2) && (m_hostName[0] == '[') && (*m_hostName.rbegin() == ']'))
+            m_host = IpAddress(m_hostName.substr(1, m_hostName.size() - 2));
+        else
+            m_host = IpAddress(m_hostName);
+    }
+
+    // Otherwise connect to the host
+    reused = false;
+    Connection* connection = new Connection;
+    if (connection->socket.connect(m_host, m_port, timeout) != Socket::Done)
+    {
+        delete connection;
+        return NULL;
+    }
+
+    return connection;
+}
+
+
+////////////////////////////////////////////////////////////
+void Http::releaseConnection(Connection* connection, bool reusable)
+{
+    if (reusable && m_keepAlive)
+    {
+        // Keep the connection for the next requests to the same host
+        Connection*& kept = m_connections[std::make_pair(m_hostName, m_port)];
+        if (kept)
+        {
+            kept->socket.disconnect();
+            delete kept;
+        }
+
+        connection->begin = connection->end = 0;
+        kept = connection;
+    }
+    else
+    {
+        // Close the connection
+        connection->socket.disconnect();
+        delete connection;
+    }
 }
 
 } // namespace sf
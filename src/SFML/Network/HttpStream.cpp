@@ -0,0 +1,278 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2014 Laurent Gomila (laurent.gom@gmail.com)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Network/HttpStream.hpp>
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <sstream>
+
+
+namespace
+{
+    // Seeking forward by less than this is done by skipping the data, rather than requesting it again
+    const sf::Int64 maxSkip = 64 * 1024;
+}
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+HttpStream::HttpStream() :
+m_connection  (NULL),
+m_reusable    (false),
+m_timeout     (Time::Zero),
+m_position    (-1),
+m_size        (-1),
+m_acceptRanges(false)
+{
+
+}
+
+
+////////////////////////////////////////////////////////////
+HttpStream::~HttpStream()
+{
+    close();
+}
+
+
+////////////////////////////////////////////////////////////
+bool HttpStream::open(const std::string& host, const std::string& uri, unsigned short port, Time timeout)
+{
+    close();
+
+    m_http.setHost(host, port);
+    m_request = Http::Request(uri);
+    m_timeout = timeout;
+
+    return request(0);
+}
+
+
+////////////////////////////////////////////////////////////
+void HttpStream::close()
+{
+    m_reusable = false;
+    releaseConnection();
+
+    m_position = -1;
+    m_size = -1;
+    m_acceptRanges = false;
+}
+
+
+////////////////////////////////////////////////////////////
+const Http::Response& HttpStream::getResponse() const
+{
+    return m_response;
+}
+
+
+////////////////////////////////////////////////////////////
+Int64 HttpStream::read(void* data, Int64 size)
+{
+    if (m_position < 0)
+        return -1;
+
+    char* buffer = static_cast<char*>(data);
+    Int64 count = 0;
+    while (m_connection && (count < size))
+    {
+        const char* piece = NULL;
+        std::size_t pieceSize = 0;
+        std::size_t maxSize = static_cast<std::size_t>(std::min<Uint64>(size - count, std::numeric_limits<std::size_t>::max()));
+        if (!m_http.readBody(*m_connection, m_response, m_body, maxSize, piece, pieceSize))
+        {
+            // The connection was lost: continue on a new one if possible
+            m_reusable = false;
+            releaseConnection();
+
+            Int64 position = m_position + count;
+            if (!m_acceptRanges || !request(position) || (m_position != position))
+            {
+                close();
+                return -1;
+            }
+
+            m_position -= count;
+            continue;
+        }
+
+        // The end of the body was reached: the connection can be used for other requests
+        if (pieceSize == 0)
+        {
+            releaseConnection();
+            break;
+        }
+
+        std::memcpy(buffer + count, piece, pieceSize);
+        count += pieceSize;
+    }
+
+    m_position += count;
+
+    return count;
+}
+
+
+////////////////////////////////////////////////////////////
+Int64 HttpStream::seek(Int64 position)
+{
+    if ((m_position < 0) || (position < 0))
+        return -1;
+
+    if (m_size >= 0)
+        position = std::min(position, m_size);
+
+    // Request the resource again from the new position, unless it's a bit forward
+    bool skip = (position >= m_position) && ((position - m_position <= maxSkip) || !m_acceptRanges);
+    if (!skip)
+    {
+        if (!m_acceptRanges)
+            return -1;
+
+        if (!request(position))
+        {
+            close();
+            return -1;
+        }
+    }
+
+    // Skip the data until the new position (the server may have sent the resource from the beginning)
+    char buffer[4096];
+    while (m_position < position)
+    {
+        Int64 count = read(buffer, std::min<Int64>(position - m_position, sizeof(buffer)));
+        if (count < 0)
+            return -1;
+        if (count == 0)
+            break;
+    }
+
+    return m_position;
+}
+
+
+////////////////////////////////////////////////////////////
+Int64 HttpStream::tell()
+{
+    return m_position;
+}
+
+
+////////////////////////////////////////////////////////////
+Int64 HttpStream::getSize()
+{
+    return m_size;
+}
+
+
+////////////////////////////////////////////////////////////
+bool HttpStream::request(Int64 position)
+{
+    m_reusable = false;
+    releaseConnection();
+
+    Http::Request request(m_request);
+    if (position > 0)
+    {
+        std::ostringstream range;
+        range << "bytes=" << position << "-";
+        request.setField("Range", range.str());
+    }
+
+    m_connection = m_http.beginRequest(request, m_response, m_body, m_reusable, m_timeout);
+    if (!m_connection)
+        return false;
+
+    Http::Response::Status status = m_response.getStatus();
+    if ((status == Http::Response::PartialContent) && (position > 0))
+    {
+        // Partial content: "Content-Range: bytes <first>-<last>/<size>"
+        const std::string& contentRange = m_response.getField("content-range");
+        std::istringstream in(contentRange.substr(std::min(contentRange.find(' '), contentRange.size())));
+        Int64 first = -1;
+        Int64 last = -1;
+        Int64 size = -1;
+        char separator;
+        in >> first >> separator >> last >> separator;
+        if (!(in >> size))
+            size = -1;
+
+        if (first != position)
+        {
+            m_reusable = false;
+            releaseConnection();
+            return false;
+        }
+
+        m_position = first;
+        m_acceptRanges = true;
+        if (size >= 0)
+            m_size = size;
+    }
+    else if (status == Http::Response::Ok)
+    {
+        // Whole resource: its size is known if it's not sent by chunks
+        m_position = 0;
+        if (!m_body.chunked && !m_body.untilClose)
+            m_size = static_cast<Int64>(m_body.remaining);
+
+        m_acceptRanges = m_response.getField("accept-ranges").find("bytes") != std::string::npos;
+    }
+    else
+    {
+        // Error: keep the body of the response, it may describe the error
+        const char* piece = NULL;
+        std::size_t pieceSize = 0;
+        while (m_http.readBody(*m_connection, m_response, m_body, std::numeric_limits<std::size_t>::max(), piece, pieceSize) && (pieceSize > 0))
+            m_response.m_body.append(piece, pieceSize);
+
+        releaseConnection();
+        return false;
+    }
+
+    // An empty body may already be finished
+    if (m_body.finished)
+        releaseConnection();
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+void HttpStream::releaseConnection()
+{
+    if (m_connection)
+    {
+        m_http.releaseConnection(m_connection, m_reusable && m_body.finished);
+        m_connection = NULL;
+    }
+}
+
+} // namespace sf
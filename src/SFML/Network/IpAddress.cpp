@@ -33,39 +33,69 @@
 
 namespace
 {
-    sf::Uint32 resolve(const std::string& address)
+    // Prefix of the IPv4-mapped IPv6 addresses (::ffff:a.b.c.d)
+    const sf::Uint8 ipv4Prefix[12] = {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0xFF, 0xFF};
+
+    // Bytes of the special IPv6 addresses
+    const sf::Uint8 anyIPv6[16]       = {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0};
+    const sf::Uint8 localHostIPv6[16] = {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1};
+
+    void setIPv4(sf::Uint8* bytes, sf::Uint32 address)
+    {
+        std::memcpy(bytes, ipv4Prefix, sizeof(ipv4Prefix));
+        bytes[12] = static_cast<sf::Uint8>(address >> 24);
+        bytes[13] = static_cast<sf::Uint8>(address >> 16);
+        bytes[14] = static_cast<sf::Uint8>(address >> 8);
+        bytes[15] = static_cast<sf::Uint8>(address);
+    }
+
+    bool resolve(const std::string& address, sf::Uint8* bytes)
     {
         if (address == "255.255.255.255")
         {
             // The broadcast address needs to be handled explicitely,
             // because it is also the value returned by inet_addr on error
-            return INADDR_BROADCAST;
+            setIPv4(bytes, INADDR_BROADCAST);
+            return true;
         }
-        else
+
+        // Try to convert the address as a byte representation ("xxx.xxx.xxx.xxx")
+        sf::Uint32 ip = inet_addr(address.c_str());
+        if (ip != INADDR_NONE)
         {
-            // Try to convert the address as a byte representation ("xxx.xxx.xxx.xxx")
-            sf::Uint32 ip = inet_addr(address.c_str());
-            if (ip != INADDR_NONE)
-                return ip;
-
-            // Not a valid address, try to convert it as a host name
-            addrinfo hints;
-            std::memset(&hints, 0, sizeof(hints));
-            hints.ai_family = AF_INET;
-            addrinfo* result = NULL;
-            if (getaddrinfo(address.c_str(), NULL, &hints, &result) == 0)
-            {
-                if (result)
-                {
-                    ip = reinterpret_cast<sockaddr_in*>(result->ai_addr)->sin_addr.s_addr;
-                    freeaddrinfo(result);
-                    return ip;
-                }
-            }
-
-            // Not a valid address nor a host name
-            return 0;
+            setIPv4(bytes, ntohl(ip));
+            return true;
         }
+
+        // Not a valid IPv4 address, try to convert it as an IPv6 address or as a host name
+        if (address.empty())
+            return false;
+
+        addrinfo hints;
+        std::memset(&hints, 0, sizeof(hints));
+        hints.ai_family = AF_UNSPEC;
+        addrinfo* result = NULL;
+        if (getaddrinfo(address.c_str(), NULL, &hints, &result) != 0)
+            return false;
+
+        // Prefer IPv4, which all the networks support
+        const addrinfo* chosen = NULL;
+        for (const addrinfo* info = result; info; info = info->ai_next)
+        {
+            if ((info->ai_family == AF_INET) || ((info->ai_family == AF_INET6) && !chosen))
+                chosen = info;
+            if (chosen && (chosen->ai_family == AF_INET))
+                break;
+        }
+
+        if (chosen && (chosen->ai_family == AF_INET))
+            setIPv4(bytes, ntohl(reinterpret_cast<const sockaddr_in*>(chosen->ai_addr)->sin_addr.s_addr));
+        else if (chosen)
+            std::memcpy(bytes, &reinterpret_cast<const sockaddr_in6*>(chosen->ai_addr)->sin6_addr, 16);
+
+        freeaddrinfo(result);
+
+        return chosen != NULL;
     }
 }
 
@@ -74,62 +104,113 @@ namespace sf
 {
 ////////////////////////////////////////////////////////////
 const IpAddress IpAddress::None;
+const IpAddress IpAddress::Any(0, 0, 0, 0);
 const IpAddress IpAddress::LocalHost(127, 0, 0, 1);
 const IpAddress IpAddress::Broadcast(255, 255, 255, 255);
+const IpAddress IpAddress::AnyIPv6(anyIPv6);
+const IpAddress IpAddress::LocalHostIPv6(localHostIPv6);
 
 
 ////////////////////////////////////////////////////////////
 IpAddress::IpAddress() :
-m_address(0)
+m_valid(false)
 {
-    // We're using 0 (INADDR_ANY) instead of INADDR_NONE to represent the invalid address,
-    // because the latter is also the broadcast address (255.255.255.255); it's ok because
-    // SFML doesn't publicly use INADDR_ANY (it is always used implicitely)
+    std::memset(m_bytes, 0, sizeof(m_bytes));
 }
 
 
 ////////////////////////////////////////////////////////////
 IpAddress::IpAddress(const std::string& address) :
-m_address(resolve(address))
+m_valid(false)
 {
+    std::memset(m_bytes, 0, sizeof(m_bytes));
+    m_valid = resolve(address, m_bytes);
 }
 
 
 ////////////////////////////////////////////////////////////
 IpAddress::IpAddress(const char* address) :
-m_address(resolve(address))
+m_valid(false)
 {
+    std::memset(m_bytes, 0, sizeof(m_bytes));
+    m_valid = resolve(address, m_bytes);
 }
 
 
 ////////////////////////////////////////////////////////////
 IpAddress::IpAddress(Uint8 byte0, Uint8 byte1, Uint8 byte2, Uint8 byte3) :
-m_address(htonl((byte0 << 24) | (byte1 << 16) | (byte2 << 8) | byte3))
+m_valid(true)
 {
+    setIPv4(m_bytes, (static_cast<Uint32>(byte0) << 24) | (byte1 << 16) | (byte2 << 8) | byte3);
 }
 
 
 ////////////////////////////////////////////////////////////
 IpAddress::IpAddress(Uint32 address) :
-m_address(htonl(address))
+m_valid(true)
+{
+    setIPv4(m_bytes, address);
+}
+
+
+////////////////////////////////////////////////////////////
+IpAddress::IpAddress(const Uint8* bytes) :
+m_valid(true)
 {
+    std::memcpy(m_bytes, bytes, sizeof(m_bytes));
+}
+
+
+////////////////////////////////////////////////////////////
+IpAddress::Type IpAddress::getType() const
+{
+    return std::memcmp(m_bytes, ipv4Prefix, sizeof(ipv4Prefix)) == 0 ? IPv4 : IPv6;
 }
 
 
 ////////////////////////////////////////////////////////////
 std::string IpAddress::toString() const
 {
-    in_addr address;
-    address.s_addr = m_address;
+    // The invalid address has no representation, it must not be mistaken for "::"
+    if (!m_valid)
+        return "";
+
+    if (getType() == IPv4)
+    {
+        in_addr address;
+        address.s_addr = htonl(toInteger());
+
+        return inet_ntoa(address);
+    }
 
-    return inet_ntoa(address);
+    // Let the system write the IPv6 address, with the usual abbreviations
+    sockaddr_in6 address;
+    std::memset(&address, 0, sizeof(address));
+    address.sin6_family = AF_INET6;
+    std::memcpy(&address.sin6_addr, m_bytes, sizeof(m_bytes));
+
+    char buffer[64];
+    if (getnameinfo(reinterpret_cast<sockaddr*>(&address), sizeof(address), buffer, sizeof(buffer), NULL, 0, NI_NUMERICHOST) != 0)
+        return "::";
+
+    return buffer;
 }
 
 
 ////////////////////////////////////////////////////////////
 Uint32 IpAddress::toInteger() const
 {
-    return ntohl(m_address);
+    if (getType() != IPv4)
+        return 0;
+
+    return (static_cast<Uint32>(m_bytes[12]) << 24) | (m_bytes[13] << 16) | (m_bytes[14] << 8) | m_bytes[15];
+}
+
+
+////////////////////////////////////////////////////////////
+void IpAddress::toBytes(Uint8* bytes) const
+{
+    std::memcpy(bytes, m_bytes, sizeof(m_bytes));
 }
 
 
@@ -196,7 +277,7 @@ IpAddress IpAddress::getPublicAddress(Time timeout)
 ////////////////////////////////////////////////////////////
 bool operator ==(const IpAddress& left, const IpAddress& right)
 {
-    return left.toInteger() == right.toInteger();
+    return !(left < right) && !(right < left);
 }
 
 
@@ -210,7 +291,10 @@ bool operator !=(const IpAddress& left, const IpAddress& right)
 ////////////////////////////////////////////////////////////
 bool operator <(const IpAddress& left, const IpAddress& right)
 {
-    return left.toInteger() < right.toInteger();
+    if (left.m_valid != right.m_valid)
+        return !left.m_valid;
+
+    return std::memcmp(left.m_bytes, right.m_bytes, sizeof(left.m_bytes)) < 0;
 }
 
 
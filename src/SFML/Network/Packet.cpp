@@ -28,16 +28,64 @@
 #include <SFML/Network/Packet.hpp>
 #include <SFML/Network/SocketImpl.hpp>
 #include <SFML/System/String.hpp>
+#include <SFML/System/Utf.hpp>
+#include <algorithm>
 #include <cstring>
 #include <cwchar>
 
 
+namespace
+{
+    // Convert integers between host and network byte order (the conversion is its own inverse)
+    sf::Uint16 swapBytes(sf::Uint16 value) {return htons(value);}
+    sf::Uint32 swapBytes(sf::Uint32 value) {return htonl(value);}
+
+    // Copy an array of integers to a buffer, in network byte order
+    template <typename Unsigned, typename T>
+    void writeIntegers(char* destination, const T* source, std::size_t count)
+    {
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            Unsigned value = swapBytes(static_cast<Unsigned>(source[i]));
+            std::memcpy(destination + i * sizeof(value), &value, sizeof(value));
+        }
+    }
+
+    // Copy an array of integers from a buffer, in host byte order
+    template <typename Unsigned, typename T>
+    void readIntegers(T* destination, const char* source, std::size_t count)
+    {
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            Unsigned value;
+            std::memcpy(&value, source + i * sizeof(value), sizeof(value));
+            destination[i] = static_cast<T>(swapBytes(value));
+        }
+    }
+
+    // Map signed integers to unsigned ones, so that small negative values stay small
+    sf::Uint64 zigZagEncode(sf::Int64 value)
+    {
+        return (static_cast<sf::Uint64>(value) << 1) ^ static_cast<sf::Uint64>(value >> 63);
+    }
+
+    sf::Int64 zigZagDecode(sf::Uint64 value)
+    {
+        return static_cast<sf::Int64>(value >> 1) ^ -static_cast<sf::Int64>(value & 1);
+    }
+}
+
+
 namespace sf
 {
 ////////////////////////////////////////////////////////////
 Packet::Packet() :
-m_readPos(0),
-m_isValid(true)
+m_data    (m_buffer),
+m_size    (0),
+m_capacity(SmallBufferSize),
+m_readPos (0),
+m_isValid (true),
+m_sendPos (0)
 {
 
 }
@@ -46,7 +94,37 @@ m_isValid(true)
 ////////////////////////////////////////////////////////////
 Packet::~Packet()
 {
+    if (m_data != m_buffer)
+        delete[] m_data;
+}
+
+
+////////////////////////////////////////////////////////////
+Packet::Packet(const Packet& copy) :
+m_data    (m_buffer),
+m_size    (0),
+m_capacity(SmallBufferSize),
+m_readPos (copy.m_readPos),
+m_isValid (copy.m_isValid),
+m_sendPos (copy.m_sendPos)
+{
+    append(copy.m_data, copy.m_size);
+}
+
+
+////////////////////////////////////////////////////////////
+Packet& Packet::operator =(const Packet& right)
+{
+    if (&right != this)
+    {
+        m_size = 0;
+        append(right.m_data, right.m_size);
+        m_readPos = right.m_readPos;
+        m_isValid = right.m_isValid;
+        m_sendPos = right.m_sendPos;
+    }
 
+    return *this;
 }
 
 
@@ -54,10 +132,24 @@ Packet::~Packet()
 void Packet::append(const void* data, std::size_t sizeInBytes)
 {
     if (data && (sizeInBytes > 0))
+        std::memcpy(extend(sizeInBytes), data, sizeInBytes);
+}
+
+
+////////////////////////////////////////////////////////////
+void Packet::reserve(std::size_t capacity)
+{
+    if (capacity > m_capacity)
     {
-        std::size_t start = m_data.size();
-        m_data.resize(start + sizeInBytes);
-        std::memcpy(&m_data[start], data, sizeInBytes);
+        char* data = new char[capacity];
+        if (m_size > 0)
+            std::memcpy(data, m_data, m_size);
+
+        if (m_data != m_buffer)
+            delete[] m_data;
+
+        m_data     = data;
+        m_capacity = capacity;
     }
 }
 
@@ -65,30 +157,31 @@ void Packet::append(const void* data, std::size_t sizeInBytes)
 ////////////////////////////////////////////////////////////
 void Packet::clear()
 {
-    m_data.clear();
+    m_size = 0;
     m_readPos = 0;
     m_isValid = true;
+    m_sendPos = 0;
 }
 
 
 ////////////////////////////////////////////////////////////
 const void* Packet::getData() const
 {
-    return !m_data.empty() ? &m_data[0] : NULL;
+    return m_size > 0 ? m_data : NULL;
 }
 
 
 ////////////////////////////////////////////////////////////
 std::size_t Packet::getDataSize() const
 {
-    return m_data.size();
+    return m_size;
 }
 
 
 ////////////////////////////////////////////////////////////
 bool Packet::endOfPacket() const
 {
-    return m_readPos >= m_data.size();
+    return m_readPos >= m_size;
 }
 
 
@@ -481,15 +574,357 @@ Packet& Packet::operator <<(const String& data)
 }
 
 
+////////////////////////////////////////////////////////////
+Packet& Packet::write(const Int8* data, std::size_t count)
+{
+    append(data, count);
+    return *this;
+}
+
+
+////////////////////////////////////////////////////////////
+Packet& Packet::write(const Uint8* data, std::size_t count)
+{
+    append(data, count);
+    return *this;
+}
+
+
+////////////////////////////////////////////////////////////
+Packet& Packet::write(const Int16* data, std::size_t count)
+{
+    writeIntegers<Uint16>(extend(count * sizeof(*data)), data, count);
+    return *this;
+}
+
+
+////////////////////////////////////////////////////////////
+Packet& Packet::write(const Uint16* data, std::size_t count)
+{
+    writeIntegers<Uint16>(extend(count * sizeof(*data)), data, count);
+    return *this;
+}
+
+
+////////////////////////////////////////////////////////////
+Packet& Packet::write(const Int32* data, std::size_t count)
+{
+    writeIntegers<Uint32>(extend(count * sizeof(*data)), data, count);
+    return *this;
+}
+
+
+////////////////////////////////////////////////////////////
+Packet& Packet::write(const Uint32* data, std::size_t count)
+{
+    writeIntegers<Uint32>(extend(count * sizeof(*data)), data, count);
+    return *this;
+}
+
+
+////////////////////////////////////////////////////////////
+Packet& Packet::write(const float* data, std::size_t count)
+{
+    append(data, count * sizeof(*data));
+    return *this;
+}
+
+
+////////////////////////////////////////////////////////////
+Packet& Packet::write(const double* data, std::size_t count)
+{
+    append(data, count * sizeof(*data));
+    return *this;
+}
+
+
+////////////////////////////////////////////////////////////
+Packet& Packet::read(Int8* data, std::size_t count)
+{
+    if (checkSize(count))
+    {
+        std::memcpy(data, m_data + m_readPos, count);
+        m_readPos += count;
+    }
+
+    return *this;
+}
+
+
+////////////////////////////////////////////////////////////
+Packet& Packet::read(Uint8* data, std::size_t count)
+{
+    if (checkSize(count))
+    {
+        std::memcpy(data, m_data + m_readPos, count);
+        m_readPos += count;
+    }
+
+    return *this;
+}
+
+
+////////////////////////////////////////////////////////////
+Packet& Packet::read(Int16* data, std::size_t count)
+{
+    if (checkSize(count * sizeof(*data)))
+    {
+        readIntegers<Uint16>(data, m_data + m_readPos, count);
+        m_readPos += count * sizeof(*data);
+    }
+
+    return *this;
+}
+
+
+////////////////////////////////////////////////////////////
+Packet& Packet::read(Uint16* data, std::size_t count)
+{
+    if (checkSize(count * sizeof(*data)))
+    {
+        readIntegers<Uint16>(data, m_data + m_readPos, count);
+        m_readPos += count * sizeof(*data);
+    }
+
+    return *this;
+}
+
+
+////////////////////////////////////////////////////////////
+Packet& Packet::read(Int32* data, std::size_t count)
+{
+    if (checkSize(count * sizeof(*data)))
+    {
+        readIntegers<Uint32>(data, m_data + m_readPos, count);
+        m_readPos += count * sizeof(*data);
+    }
+
+    return *this;
+}
+
+
+////////////////////////////////////////////////////////////
+Packet& Packet::read(Uint32* data, std::size_t count)
+{
+    if (checkSize(count * sizeof(*data)))
+    {
+        readIntegers<Uint32>(data, m_data + m_readPos, count);
+        m_readPos += count * sizeof(*data);
+    }
+
+    return *this;
+}
+
+
+////////////////////////////////////////////////////////////
+Packet& Packet::read(float* data, std::size_t count)
+{
+    if (checkSize(count * sizeof(*data)))
+    {
+        std::memcpy(data, m_data + m_readPos, count * sizeof(*data));
+        m_readPos += count * sizeof(*data);
+    }
+
+    return *this;
+}
+
+
+////////////////////////////////////////////////////////////
+Packet& Packet::read(double* data, std::size_t count)
+{
+    if (checkSize(count * sizeof(*data)))
+    {
+        std::memcpy(data, m_data + m_readPos, count * sizeof(*data));
+        m_readPos += count * sizeof(*data);
+    }
+
+    return *this;
+}
+
+
+////////////////////////////////////////////////////////////
+Packet& Packet::writeVarint(Int32 data)
+{
+    return writeVarint(zigZagEncode(data));
+}
+
+
+////////////////////////////////////////////////////////////
+Packet& Packet::writeVarint(Uint32 data)
+{
+    return writeVarint(static_cast<Uint64>(data));
+}
+
+
+////////////////////////////////////////////////////////////
+Packet& Packet::writeVarint(Int64 data)
+{
+    return writeVarint(zigZagEncode(data));
+}
+
+
+////////////////////////////////////////////////////////////
+Packet& Packet::writeVarint(Uint64 data)
+{
+    // 7 bits per byte, the highest bit tells if more bytes follow;
+    // room is made for the longest encoding, and the unused bytes are given back
+    const std::size_t maxSize = 10;
+    char* bytes = extend(maxSize);
+    std::size_t size = 0;
+    while (data >= 0x80)
+    {
+        bytes[size++] = static_cast<char>((data & 0x7F) | 0x80);
+        data >>= 7;
+    }
+    bytes[size++] = static_cast<char>(data);
+
+    m_size -= maxSize - size;
+    return *this;
+}
+
+
+////////////////////////////////////////////////////////////
+Packet& Packet::readVarint(Int32& data)
+{
+    Uint64 value;
+    if (readVarintBits(value))
+    {
+        Int64 decoded = zigZagDecode(value);
+        if ((decoded >= -2147483647 - 1) && (decoded <= 2147483647))
+            data = static_cast<Int32>(decoded);
+        else
+            m_isValid = false;
+    }
+
+    return *this;
+}
+
+
+////////////////////////////////////////////////////////////
+Packet& Packet::readVarint(Uint32& data)
+{
+    Uint64 value;
+    if (readVarintBits(value))
+    {
+        if (value <= 0xFFFFFFFF)
+            data = static_cast<Uint32>(value);
+        else
+            m_isValid = false;
+    }
+
+    return *this;
+}
+
+
+////////////////////////////////////////////////////////////
+Packet& Packet::readVarint(Int64& data)
+{
+    Uint64 value;
+    if (readVarintBits(value))
+        data = zigZagDecode(value);
+
+    return *this;
+}
+
+
+////////////////////////////////////////////////////////////
+Packet& Packet::readVarint(Uint64& data)
+{
+    readVarintBits(data);
+    return *this;
+}
+
+
+////////////////////////////////////////////////////////////
+Packet& Packet::writeUtf8(const String& data)
+{
+    // The size in bytes is only known once the characters are encoded: encode them
+    // after room for the largest size, and move them back if the size is shorter.
+    // writeVarint makes room for its longest encoding, which must not reallocate
+    // the storage while it contains the encoded characters
+    const std::size_t maxSizeBytes = 5;
+    const std::size_t maxVarintBytes = 10;
+    std::size_t start = m_size;
+    reserve(start + maxVarintBytes + data.getSize() * 4);
+
+    char* begin = m_data + start + maxSizeBytes;
+    char* end = begin;
+    for (String::ConstIterator c = data.begin(); c != data.end(); ++c)
+        end = Utf8::encode(*c, end);
+
+    Uint32 size = static_cast<Uint32>(end - begin);
+    writeVarint(size);
+
+    std::memmove(m_data + m_size, begin, size);
+    m_size += size;
+
+    return *this;
+}
+
+
+////////////////////////////////////////////////////////////
+Packet& Packet::readUtf8(String& data)
+{
+    Uint32 size = 0;
+    data.clear();
+    if (readVarint(size) && checkSize(size))
+    {
+        data = String::fromUtf8(m_data + m_readPos, m_data + m_readPos + size);
+        m_readPos += size;
+    }
+
+    return *this;
+}
+
+
 ////////////////////////////////////////////////////////////
 bool Packet::checkSize(std::size_t size)
 {
-    m_isValid = m_isValid && (m_readPos + size <= m_data.size());
+    m_isValid = m_isValid && (size <= m_size - m_readPos);
 
     return m_isValid;
 }
 
 
+////////////////////////////////////////////////////////////
+char* Packet::extend(std::size_t size)
+{
+    // Grow geometrically, so that appending is linear overall
+    if (size > m_capacity - m_size)
+        reserve(std::max(m_capacity * 2, m_size + size));
+
+    char* data = m_data + m_size;
+    m_size += size;
+
+    return data;
+}
+
+
+////////////////////////////////////////////////////////////
+bool Packet::readVarintBits(Uint64& data)
+{
+    Uint64 value = 0;
+    for (unsigned int shift = 0; shift < 64; shift += 7)
+    {
+        if (!checkSize(1))
+            return false;
+
+        Uint8 byte = static_cast<Uint8>(m_data[m_readPos++]);
+        value |= static_cast<Uint64>(byte & 0x7F) << shift;
+
+        if ((byte & 0x80) == 0)
+        {
+            data = value;
+            return true;
+        }
+    }
+
+    // More than 10 bytes: this is not a valid encoding
+    m_isValid = false;
+    return false;
+}
+
+
 ////////////////////////////////////////////////////////////
 const void* Packet::onSend(std::size_t& size)
 {
@@ -0,0 +1,172 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2014 Laurent Gomila (laurent.gom@gmail.com)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Network/PacketPool.hpp>
+#include <SFML/Network/Packet.hpp>
+#include <SFML/System/Err.hpp>
+#include <SFML/System/Lock.hpp>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+PacketPool::PacketPool(std::size_t maxAvailable, std::size_t maxPacketCapacity) :
+m_maxAvailable     (maxAvailable),
+m_maxPacketCapacity(maxPacketCapacity)
+{
+
+}
+
+
+////////////////////////////////////////////////////////////
+PacketPool::~PacketPool()
+{
+    if (m_statistics.inUse > 0)
+        err() << "Packet pool destroyed while " << m_statistics.inUse << " of its packets are still in use" << std::endl;
+
+    shrink();
+}
+
+
+////////////////////////////////////////////////////////////
+void PacketPool::reserve(std::size_t count, std::size_t capacity)
+{
+    // Allocate the packets outside of the lock
+    std::size_t missing;
+    {
+        Lock lock(m_mutex);
+        missing = count > m_available.size() ? count - m_available.size() : 0;
+    }
+
+    std::vector<Packet*> packets(missing);
+    for (std::size_t i = 0; i < missing; ++i)
+    {
+        packets[i] = new Packet;
+        packets[i]->reserve(capacity);
+    }
+
+    Lock lock(m_mutex);
+    m_available.insert(m_available.end(), packets.begin(), packets.end());
+    m_statistics.allocated += missing;
+}
+
+
+////////////////////////////////////////////////////////////
+Packet* PacketPool::acquire()
+{
+    {
+        Lock lock(m_mutex);
+
+        m_statistics.acquired++;
+        m_statistics.inUse++;
+        if (m_statistics.inUse > m_statistics.peakInUse)
+            m_statistics.peakInUse = m_statistics.inUse;
+
+        if (!m_available.empty())
+        {
+            Packet* packet = m_available.back();
+            m_available.pop_back();
+            return packet;
+        }
+
+        m_statistics.allocated++;
+    }
+
+    // No packet available: create a new one, outside of the lock
+    return new Packet;
+}
+
+
+////////////////////////////////////////////////////////////
+void PacketPool::release(Packet* packet)
+{
+    if (!packet)
+        return;
+
+    packet->clear();
+
+    {
+        Lock lock(m_mutex);
+
+        m_statistics.released++;
+        if (m_statistics.inUse > 0)
+            m_statistics.inUse--;
+
+        // Keep the packet unless the pool is full or the packet holds too much memory
+        if ((m_available.size() < m_maxAvailable) && (packet->m_capacity <= m_maxPacketCapacity))
+        {
+            m_available.push_back(packet);
+            return;
+        }
+
+        m_statistics.discarded++;
+    }
+
+    delete packet;
+}
+
+
+////////////////////////////////////////////////////////////
+void PacketPool::shrink()
+{
+    std::vector<Packet*> packets;
+    {
+        Lock lock(m_mutex);
+        packets.swap(m_available);
+    }
+
+    for (std::vector<Packet*>::iterator it = packets.begin(); it != packets.end(); ++it)
+        delete *it;
+}
+
+
+////////////////////////////////////////////////////////////
+PacketPool::Statistics PacketPool::getStatistics() const
+{
+    Lock lock(m_mutex);
+
+    Statistics statistics = m_statistics;
+    statistics.available = m_available.size();
+
+    return statistics;
+}
+
+
+////////////////////////////////////////////////////////////
+PacketPool::Statistics::Statistics() :
+acquired (0),
+released (0),
+allocated(0),
+discarded(0),
+inUse    (0),
+peakInUse(0),
+available(0)
+{
+
+}
+
+} // namespace sf
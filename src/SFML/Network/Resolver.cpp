@@ -0,0 +1,283 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2014 Laurent Gomila (laurent.gom@gmail.com)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Network/Resolver.hpp>
+#include <SFML/System/Clock.hpp>
+#include <SFML/System/Lock.hpp>
+#include <SFML/System/Mutex.hpp>
+#include <SFML/System/Thread.hpp>
+#include <deque>
+#include <map>
+#include <vector>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+struct Resolver::ResolverImpl
+{
+    struct Worker
+    {
+        ResolverImpl* owner;  ///< Resolver that owns the worker
+        Thread*       thread; ///< Thread resolving the names
+        bool          busy;   ///< Is the thread running?
+    };
+
+    struct CacheEntry
+    {
+        IpAddress address;    ///< Resolved address (None if the resolution failed)
+        Time      expiration; ///< Time at which the entry becomes invalid
+    };
+
+    struct Result
+    {
+        std::string             host;     ///< Resolved host name
+        IpAddress               address;  ///< Resolved address
+        priv::ResolverCallback* callback; ///< Callback to invoke
+    };
+
+    typedef std::map<std::string, CacheEntry> Cache;
+    typedef std::map<std::string, std::vector<priv::ResolverCallback*> > RequestTable;
+
+    ////////////////////////////////////////////////////////////
+    static void run(Worker* worker)
+    {
+        ResolverImpl& owner = *worker->owner;
+
+        for (;;)
+        {
+            // Take the next host name to resolve, or stop if there's none
+            std::string host;
+            {
+                Lock lock(owner.mutex);
+                if (owner.queue.empty() || owner.stopping)
+                {
+                    worker->busy = false;
+                    return;
+                }
+                host = owner.queue.front();
+                owner.queue.pop_front();
+            }
+
+            // Resolve it (this is the part that blocks)
+            IpAddress address(host);
+
+            // Store the result and hand it to all the requests waiting for it
+            Lock lock(owner.mutex);
+            owner.store(host, address);
+            RequestTable::iterator it = owner.requests.find(host);
+            if (it != owner.requests.end())
+            {
+                for (std::vector<priv::ResolverCallback*>::iterator callback = it->second.begin(); callback != it->second.end(); ++callback)
+                    owner.complete(host, address, *callback);
+                owner.requests.erase(it);
+            }
+        }
+    }
+
+    ////////////////////////////////////////////////////////////
+    bool find(const std::string& host, IpAddress& address)
+    {
+        Cache::iterator it = entries.find(host);
+        if (it == entries.end())
+            return false;
+
+        // Remove the expired entries when they are requested
+        if (timeline.getElapsedTime() >= it->second.expiration)
+        {
+            entries.erase(it);
+            return false;
+        }
+
+        address = it->second.address;
+        return true;
+    }
+
+    ////////////////////////////////////////////////////////////
+    void store(const std::string& host, const IpAddress& address)
+    {
+        CacheEntry& entry = entries[host];
+        entry.address = address;
+        entry.expiration = timeline.getElapsedTime() + (address != IpAddress::None ? cacheDuration : failureCacheDuration);
+    }
+
+    ////////////////////////////////////////////////////////////
+    void complete(const std::string& host, const IpAddress& address, priv::ResolverCallback* callback)
+    {
+        Result result;
+        result.host = host;
+        result.address = address;
+        result.callback = callback;
+        results.push_back(result);
+    }
+
+    ////////////////////////////////////////////////////////////
+    void startWorker()
+    {
+        // Launch an idle worker, if any; otherwise the busy ones will take the request
+        for (std::vector<Worker>::iterator it = workers.begin(); it != workers.end(); ++it)
+        {
+            if (!it->busy)
+            {
+                it->busy = true;
+                it->thread->launch();
+                return;
+            }
+        }
+    }
+
+    Mutex                   mutex;                ///< Protects all the other members
+    std::vector<Worker>     workers;              ///< Threads resolving the names
+    std::deque<std::string> queue;                ///< Host names waiting for a worker
+    RequestTable            requests;             ///< Callbacks waiting for each queued or resolving name
+    std::vector<Result>     results;              ///< Results whose callback was not invoked yet
+    Cache                   entries;              ///< Cached addresses, by host name
+    Clock                   timeline;             ///< Time reference of the cache
+    Time                    cacheDuration;        ///< Lifetime of resolved addresses
+    Time                    failureCacheDuration; ///< Lifetime of failed resolutions
+    std::size_t             pendingCount;         ///< Number of callbacks not invoked yet
+    bool                    stopping;             ///< Must the workers stop?
+};
+
+
+////////////////////////////////////////////////////////////
+Resolver::Resolver(unsigned int threadCount, Time cacheDuration, Time failureCacheDuration) :
+m_impl(new ResolverImpl)
+{
+    m_impl->cacheDuration = cacheDuration;
+    m_impl->failureCacheDuration = failureCacheDuration;
+    m_impl->pendingCount = 0;
+    m_impl->stopping = false;
+
+    // The threads are launched only when there are names to resolve
+    m_impl->workers.resize(threadCount > 0 ? threadCount : 1);
+    for (std::vector<ResolverImpl::Worker>::iterator it = m_impl->workers.begin(); it != m_impl->workers.end(); ++it)
+    {
+        it->owner = m_impl;
+        it->thread = new Thread(&ResolverImpl::run, &*it);
+        it->busy = false;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+Resolver::~Resolver()
+{
+    // Tell the workers to stop after their current resolution
+    {
+        Lock lock(m_impl->mutex);
+        m_impl->stopping = true;
+    }
+
+    // Wait for them (the Thread destructor does it)
+    for (std::vector<ResolverImpl::Worker>::iterator it = m_impl->workers.begin(); it != m_impl->workers.end(); ++it)
+        delete it->thread;
+
+    // Discard the callbacks that were not invoked
+    for (ResolverImpl::RequestTable::iterator it = m_impl->requests.begin(); it != m_impl->requests.end(); ++it)
+    {
+        for (std::vector<priv::ResolverCallback*>::iterator callback = it->second.begin(); callback != it->second.end(); ++callback)
+            delete *callback;
+    }
+    for (std::vector<ResolverImpl::Result>::iterator it = m_impl->results.begin(); it != m_impl->results.end(); ++it)
+        delete it->callback;
+
+    delete m_impl;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t Resolver::update()
+{
+    std::vector<ResolverImpl::Result> results;
+    {
+        Lock lock(m_impl->mutex);
+        results.swap(m_impl->results);
+        m_impl->pendingCount -= results.size();
+    }
+
+    // Invoke the callbacks without the lock, so that they can start new requests
+    for (std::vector<ResolverImpl::Result>::iterator it = results.begin(); it != results.end(); ++it)
+    {
+        it->callback->call(it->host, it->address);
+        delete it->callback;
+    }
+
+    return results.size();
+}
+
+
+////////////////////////////////////////////////////////////
+bool Resolver::lookup(const std::string& host, IpAddress& address) const
+{
+    Lock lock(m_impl->mutex);
+    return m_impl->find(host, address);
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t Resolver::getPendingCount() const
+{
+    Lock lock(m_impl->mutex);
+    return m_impl->pendingCount;
+}
+
+
+////////////////////////////////////////////////////////////
+void Resolver::clearCache()
+{
+    Lock lock(m_impl->mutex);
+    m_impl->entries.clear();
+}
+
+
+////////////////////////////////////////////////////////////
+void Resolver::enqueue(const std::string& host, priv::ResolverCallback* callback)
+{
+    Lock lock(m_impl->mutex);
+    m_impl->pendingCount++;
+
+    // Answer directly from the cache, if possible
+    IpAddress address;
+    if (m_impl->find(host, address))
+    {
+        m_impl->complete(host, address, callback);
+        return;
+    }
+
+    // Wait for the resolution in progress, if there's one for this name
+    std::vector<priv::ResolverCallback*>& requests = m_impl->requests[host];
+    requests.push_back(callback);
+    if (requests.size() > 1)
+        return;
+
+    // Otherwise start a new one
+    m_impl->queue.push_back(host);
+    m_impl->startWorker();
+}
+
+} // namespace sf
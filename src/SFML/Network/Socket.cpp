@@ -28,15 +28,28 @@
 #include <SFML/Network/Socket.hpp>
 #include <SFML/Network/SocketImpl.hpp>
 #include <SFML/System/Err.hpp>
+#include <SFML/System/Lock.hpp>
+#include <SFML/System/Mutex.hpp>
+#include <set>
+
+
+namespace
+{
+    // Handles of the sockets that have buffered data, shared with the selectors
+    sf::Mutex                  pendingMutex;
+    std::set<sf::SocketHandle> pendingSockets;
+}
 
 
 namespace sf
 {
 ////////////////////////////////////////////////////////////
 Socket::Socket(Type type) :
-m_type      (type),
-m_socket    (priv::SocketImpl::invalidSocket()),
-m_isBlocking(true)
+m_type       (type),
+m_socket     (priv::SocketImpl::invalidSocket()),
+m_isBlocking (true),
+m_addressType(IpAddress::IPv4),
+m_isPending  (false)
 {
 
 }
@@ -76,12 +89,65 @@ SocketHandle Socket::getHandle() const
 
 
 ////////////////////////////////////////////////////////////
-void Socket::create()
+bool Socket::hasPendingPacket() const
+{
+    return false;
+}
+
+
+////////////////////////////////////////////////////////////
+void Socket::updatePendingState()
+{
+    // Only take the lock when the state changes, which is rare compared to receptions
+    bool pending = (m_socket != priv::SocketImpl::invalidSocket()) && hasPendingPacket();
+    if (pending != m_isPending)
+    {
+        Lock lock(pendingMutex);
+        if (pending)
+            pendingSockets.insert(m_socket);
+        else
+            pendingSockets.erase(m_socket);
+
+        m_isPending = pending;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void Socket::getPendingHandles(std::vector<SocketHandle>& handles)
+{
+    Lock lock(pendingMutex);
+    handles.assign(pendingSockets.begin(), pendingSockets.end());
+}
+
+
+////////////////////////////////////////////////////////////
+IpAddress::Type Socket::getAddressType() const
+{
+    return m_addressType;
+}
+
+
+////////////////////////////////////////////////////////////
+void Socket::create(IpAddress::Type addressType)
 {
     // Don't create the socket if it already exists
     if (m_socket == priv::SocketImpl::invalidSocket())
     {
-        SocketHandle handle = socket(PF_INET, m_type == Tcp ? SOCK_STREAM : SOCK_DGRAM, 0);
+        int family = addressType == IpAddress::IPv6 ? PF_INET6 : PF_INET;
+        SocketHandle handle = socket(family, m_type == Tcp ? SOCK_STREAM : SOCK_DGRAM, 0);
+
+#ifdef IPV6_V6ONLY
+        // Let IPv6 sockets reach IPv4 addresses too
+        if ((addressType == IpAddress::IPv6) && (handle != priv::SocketImpl::invalidSocket()))
+        {
+            int no = 0;
+            if (setsockopt(handle, IPPROTO_IPV6, IPV6_V6ONLY, reinterpret_cast<char*>(&no), sizeof(no)) == -1)
+                err() << "Failed to set socket option \"IPV6_V6ONLY\" ; the IPv6 socket won't reach IPv4 addresses" << std::endl;
+        }
+#endif
+
+        m_addressType = addressType;
         create(handle);
     }
 }
@@ -96,6 +162,12 @@ void Socket::create(SocketHandle handle)
         // Assign the new handle
         m_socket = handle;
 
+        // Find the type of addresses that it uses (for sockets created by the system, like accepted ones)
+        sockaddr_storage address;
+        priv::SocketImpl::AddrLength size = sizeof(address);
+        if (getsockname(m_socket, reinterpret_cast<sockaddr*>(&address), &size) != -1)
+            m_addressType = address.ss_family == AF_INET6 ? IpAddress::IPv6 : IpAddress::IPv4;
+
         // Set the current blocking state
         setBlocking(m_isBlocking);
 
@@ -136,6 +208,14 @@ void Socket::close()
     // Close the socket
     if (m_socket != priv::SocketImpl::invalidSocket())
     {
+        // Its handle may be reused by another socket: don't let it look pending
+        if (m_isPending)
+        {
+            Lock lock(pendingMutex);
+            pendingSockets.erase(m_socket);
+            m_isPending = false;
+        }
+
         priv::SocketImpl::close(m_socket);
         m_socket = priv::SocketImpl::invalidSocket();
     }
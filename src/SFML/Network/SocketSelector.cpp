@@ -29,7 +29,21 @@
 #include <SFML/Network/Socket.hpp>
 #include <SFML/Network/SocketImpl.hpp>
 #include <SFML/System/Err.hpp>
+#include <algorithm>
+#include <map>
 #include <utility>
+#include <vector>
+
+// Pick the most scalable backend available: epoll on Linux,
+// kqueue on BSD and Mac OS X, and select everywhere else
+#if defined(SFML_SYSTEM_LINUX)
+    #include <sys/epoll.h>
+    #define SFML_SELECTOR_EPOLL
+#elif defined(SFML_SYSTEM_FREEBSD) || defined(SFML_SYSTEM_MACOS)
+    #include <sys/event.h>
+    #include <sys/time.h>
+    #define SFML_SELECTOR_KQUEUE
+#endif
 
 #ifdef _MSC_VER
     #pragma warning(disable : 4127) // "conditional expression is constant" generated by the FD_SET macro
@@ -41,9 +55,301 @@ namespace sf
 ////////////////////////////////////////////////////////////
 struct SocketSelector::SocketSelectorImpl
 {
-    fd_set AllSockets;   ///< Set containing all the sockets handles
-    fd_set SocketsReady; ///< Set containing handles of the sockets that are ready
-    int    MaxSocket;    ///< Maximum socket handle
+    ////////////////////////////////////////////////////////////
+    struct Entry
+    {
+        Socket* socket; ///< Socket registered in the selector
+        bool    ready;  ///< Was the socket ready after the last wait?
+    };
+
+    typedef std::map<SocketHandle, Entry> SocketTable;
+
+    ////////////////////////////////////////////////////////////
+    SocketSelectorImpl()
+    {
+        open();
+    }
+
+    ////////////////////////////////////////////////////////////
+    SocketSelectorImpl(const SocketSelectorImpl& copy)
+    {
+        // The kernel object can't be shared: create a new one and register the sockets again
+        open();
+        for (SocketTable::const_iterator it = copy.sockets.begin(); it != copy.sockets.end(); ++it)
+            add(*it->second.socket, it->first);
+    }
+
+    ////////////////////////////////////////////////////////////
+    ~SocketSelectorImpl()
+    {
+        close();
+    }
+
+    ////////////////////////////////////////////////////////////
+    void add(Socket& socket, SocketHandle handle)
+    {
+        // Always register the handle again: if a closed socket was not removed,
+        // the kernel may have forgotten it while we still have it in the table
+        if (!watch(handle))
+            return;
+
+        SocketTable::iterator it = sockets.find(handle);
+        if (it == sockets.end())
+        {
+            Entry entry = {&socket, false};
+            sockets.insert(std::make_pair(handle, entry));
+        }
+        else
+        {
+            it->second.socket = &socket;
+        }
+    }
+
+    ////////////////////////////////////////////////////////////
+    void remove(SocketHandle handle)
+    {
+        SocketTable::iterator it = sockets.find(handle);
+        if (it == sockets.end())
+            return;
+
+        if (it->second.ready)
+            readyEntries.erase(std::find(readyEntries.begin(), readyEntries.end(), it));
+
+        unwatch(handle);
+        sockets.erase(it);
+    }
+
+    ////////////////////////////////////////////////////////////
+    void clear()
+    {
+        close();
+        open();
+
+        sockets.clear();
+        readyEntries.clear();
+    }
+
+    ////////////////////////////////////////////////////////////
+    void resetReady()
+    {
+        for (std::vector<SocketTable::iterator>::iterator it = readyEntries.begin(); it != readyEntries.end(); ++it)
+            (*it)->second.ready = false;
+        readyEntries.clear();
+    }
+
+    ////////////////////////////////////////////////////////////
+    void setReady(SocketHandle handle)
+    {
+        SocketTable::iterator it = sockets.find(handle);
+        if ((it != sockets.end()) && !it->second.ready)
+        {
+            it->second.ready = true;
+            readyEntries.push_back(it);
+        }
+    }
+
+#if defined(SFML_SELECTOR_EPOLL)
+
+    ////////////////////////////////////////////////////////////
+    void open()
+    {
+        queue = epoll_create(64);
+        if (queue < 0)
+            err() << "Failed to create the socket selector (epoll_create failed)" << std::endl;
+    }
+
+    ////////////////////////////////////////////////////////////
+    void close()
+    {
+        if (queue >= 0)
+            ::close(queue);
+    }
+
+    ////////////////////////////////////////////////////////////
+    bool watch(SocketHandle handle)
+    {
+        epoll_event event = epoll_event();
+        event.events  = EPOLLIN;
+        event.data.fd = handle;
+
+        // A closed socket that was not removed may have left its place to a new one with the same handle
+        if ((epoll_ctl(queue, EPOLL_CTL_ADD, handle, &event) < 0) && (epoll_ctl(queue, EPOLL_CTL_MOD, handle, &event) < 0))
+        {
+            err() << "Failed to add a socket to the selector (epoll_ctl failed)" << std::endl;
+            return false;
+        }
+
+        return true;
+    }
+
+    ////////////////////////////////////////////////////////////
+    void unwatch(SocketHandle handle)
+    {
+        epoll_event event = epoll_event();
+        epoll_ctl(queue, EPOLL_CTL_DEL, handle, &event);
+    }
+
+    ////////////////////////////////////////////////////////////
+    int poll(Int64 timeout)
+    {
+        // Make room for all the sockets, so that a single call reports all of them
+        readyEvents.resize(std::max<std::size_t>(sockets.size(), 1));
+
+        int milliseconds = timeout >= 0 ? static_cast<int>((timeout + 999) / 1000) : -1;
+        int count = epoll_wait(queue, &readyEvents[0], static_cast<int>(readyEvents.size()), milliseconds);
+
+        for (int i = 0; i < count; ++i)
+            setReady(readyEvents[i].data.fd);
+
+        return count;
+    }
+
+    int                      queue;       ///< epoll instance
+    std::vector<epoll_event> readyEvents; ///< Events returned by epoll_wait
+
+#elif defined(SFML_SELECTOR_KQUEUE)
+
+    ////////////////////////////////////////////////////////////
+    void open()
+    {
+        queue = kqueue();
+        if (queue < 0)
+            err() << "Failed to create the socket selector (kqueue failed)" << std::endl;
+    }
+
+    ////////////////////////////////////////////////////////////
+    void close()
+    {
+        if (queue >= 0)
+            ::close(queue);
+    }
+
+    ////////////////////////////////////////////////////////////
+    bool watch(SocketHandle handle)
+    {
+        struct kevent change;
+        EV_SET(&change, handle, EVFILT_READ, EV_ADD, 0, 0, NULL);
+        if (kevent(queue, &change, 1, NULL, 0, NULL) < 0)
+        {
+            err() << "Failed to add a socket to the selector (kevent failed)" << std::endl;
+            return false;
+        }
+
+        return true;
+    }
+
+    ////////////////////////////////////////////////////////////
+    void unwatch(SocketHandle handle)
+    {
+        struct kevent change;
+        EV_SET(&change, handle, EVFILT_READ, EV_DELETE, 0, 0, NULL);
+        kevent(queue, &change, 1, NULL, 0, NULL);
+    }
+
+    ////////////////////////////////////////////////////////////
+    int poll(Int64 timeout)
+    {
+        // Make room for all the sockets, so that a single call reports all of them
+        readyEvents.resize(std::max<std::size_t>(sockets.size(), 1));
+
+        timespec time;
+        time.tv_sec  = static_cast<time_t>(timeout / 1000000);
+        time.tv_nsec = static_cast<long>(timeout % 1000000) * 1000;
+
+        int count = kevent(queue, NULL, 0, &readyEvents[0], static_cast<int>(readyEvents.size()), timeout >= 0 ? &time : NULL);
+
+        for (int i = 0; i < count; ++i)
+            setReady(static_cast<SocketHandle>(readyEvents[i].ident));
+
+        return count;
+    }
+
+    int                        queue;       ///< kqueue instance
+    std::vector<struct kevent> readyEvents; ///< Events returned by kevent
+
+#else
+
+    ////////////////////////////////////////////////////////////
+    void open()
+    {
+        FD_ZERO(&allSockets);
+        FD_ZERO(&socketsReady);
+
+        maxSocket = 0;
+    }
+
+    ////////////////////////////////////////////////////////////
+    void close()
+    {
+    }
+
+    ////////////////////////////////////////////////////////////
+    bool watch(SocketHandle handle)
+    {
+    #if !defined(SFML_SYSTEM_WINDOWS)
+        // On Unix, fd_set is a bit field indexed by the handle
+        if (handle >= FD_SETSIZE)
+        {
+            err() << "The socket can't be added to the selector because its handle is too high (" << handle
+                  << ", the limit is " << FD_SETSIZE << ")" << std::endl;
+            return false;
+        }
+    #endif
+
+        FD_SET(handle, &allSockets);
+
+        int size = static_cast<int>(handle);
+        if (size > maxSocket)
+            maxSocket = size;
+
+        return true;
+    }
+
+    ////////////////////////////////////////////////////////////
+    void unwatch(SocketHandle handle)
+    {
+        FD_CLR(handle, &allSockets);
+    }
+
+    ////////////////////////////////////////////////////////////
+    int poll(Int64 timeout)
+    {
+        // Setup the timeout
+        timeval time;
+        time.tv_sec  = static_cast<long>(timeout / 1000000);
+        time.tv_usec = static_cast<long>(timeout % 1000000);
+
+        // Initialize the set that will contain the sockets that are ready
+        socketsReady = allSockets;
+
+        // Wait until one of the sockets is ready for reading, or timeout is reached
+        int count = select(maxSocket + 1, &socketsReady, NULL, NULL, timeout >= 0 ? &time : NULL);
+
+        if (count > 0)
+        {
+            for (SocketTable::const_iterator it = sockets.begin(); it != sockets.end(); ++it)
+            {
+                if (FD_ISSET(it->first, &socketsReady))
+                    setReady(it->first);
+            }
+        }
+
+        return count;
+    }
+
+    fd_set allSockets;   ///< Set containing all the sockets handles
+    fd_set socketsReady; ///< Set containing handles of the sockets that are ready
+    int    maxSocket;    ///< Maximum socket handle
+
+#endif
+
+    SocketTable                        sockets;      ///< Sockets registered in the selector, by handle
+    std::vector<SocketTable::iterator> readyEntries; ///< Sockets that were ready after the last wait
+    std::vector<SocketHandle>          pending;      ///< Sockets that still have received data to read
+
+private :
+
+    SocketSelectorImpl& operator =(const SocketSelectorImpl&);
 };
 
 
@@ -51,7 +357,7 @@ struct SocketSelector::SocketSelectorImpl
 SocketSelector::SocketSelector() :
 m_impl(new SocketSelectorImpl)
 {
-    clear();
+
 }
 
 
@@ -75,56 +381,67 @@ void SocketSelector::add(Socket& socket)
 {
     SocketHandle handle = socket.getHandle();
     if (handle != priv::SocketImpl::invalidSocket())
-    {
-        FD_SET(handle, &m_impl->AllSockets);
-
-        int size = static_cast<int>(handle);
-        if (size > m_impl->MaxSocket)
-            m_impl->MaxSocket = size;
-    }
+        m_impl->add(socket, handle);
 }
 
 
 ////////////////////////////////////////////////////////////
 void SocketSelector::remove(Socket& socket)
 {
-    FD_CLR(socket.getHandle(), &m_impl->AllSockets);
-    FD_CLR(socket.getHandle(), &m_impl->SocketsReady);
+    m_impl->remove(socket.getHandle());
 }
 
 
 ////////////////////////////////////////////////////////////
 void SocketSelector::clear()
 {
-    FD_ZERO(&m_impl->AllSockets);
-    FD_ZERO(&m_impl->SocketsReady);
-
-    m_impl->MaxSocket = 0;
+    m_impl->clear();
 }
 
 
 ////////////////////////////////////////////////////////////
 bool SocketSelector::wait(Time timeout)
 {
-    // Setup the timeout
-    timeval time;
-    time.tv_sec  = static_cast<long>(timeout.asMicroseconds() / 1000000);
-    time.tv_usec = static_cast<long>(timeout.asMicroseconds() % 1000000);
+    // Forget the result of the previous wait
+    m_impl->resetReady();
 
-    // Initialize the set that will contain the sockets that are ready
-    m_impl->SocketsReady = m_impl->AllSockets;
+    // Sockets may have buffered packets that the last receive didn't return: those
+    // of the selector are ready without waiting (only their handles are used, so
+    // that sockets destroyed without being removed are never accessed)
+    Socket::getPendingHandles(m_impl->pending);
+    for (std::vector<SocketHandle>::iterator it = m_impl->pending.begin(); it != m_impl->pending.end(); ++it)
+        m_impl->setReady(*it);
 
     // Wait until one of the sockets is ready for reading, or timeout is reached
-    int count = select(m_impl->MaxSocket + 1, &m_impl->SocketsReady, NULL, NULL, timeout != Time::Zero ? &time : NULL);
+    if (!m_impl->readyEntries.empty())
+        m_impl->poll(0);
+    else
+        m_impl->poll(timeout != Time::Zero ? timeout.asMicroseconds() : -1);
 
-    return count > 0;
+    return !m_impl->readyEntries.empty();
 }
 
 
 ////////////////////////////////////////////////////////////
 bool SocketSelector::isReady(Socket& socket) const
 {
-    return FD_ISSET(socket.getHandle(), &m_impl->SocketsReady) != 0;
+    SocketSelectorImpl::SocketTable::const_iterator it = m_impl->sockets.find(socket.getHandle());
+
+    return (it != m_impl->sockets.end()) && it->second.ready;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t SocketSelector::getReadyCount() const
+{
+    return m_impl->readyEntries.size();
+}
+
+
+////////////////////////////////////////////////////////////
+Socket& SocketSelector::getReadySocket(std::size_t index) const
+{
+    return *m_impl->readyEntries[index]->second.socket;
 }
 
 
@@ -47,11 +47,15 @@ unsigned short TcpListener::getLocalPort() const
     if (getHandle() != priv::SocketImpl::invalidSocket())
     {
         // Retrieve informations about the local end of the socket
-        sockaddr_in address;
+        sockaddr_storage address;
         priv::SocketImpl::AddrLength size = sizeof(address);
         if (getsockname(getHandle(), reinterpret_cast<sockaddr*>(&address), &size) != -1)
         {
-            return ntohs(address.sin_port);
+            IpAddress localAddress;
+            unsigned short localPort;
+            priv::SocketImpl::readAddress(address, localAddress, localPort);
+
+            return localPort;
         }
     }
 
@@ -61,22 +65,30 @@ unsigned short TcpListener::getLocalPort() const
 
 
 ////////////////////////////////////////////////////////////
-Socket::Status TcpListener::listen(unsigned short port)
+Socket::Status TcpListener::listen(unsigned short port, const IpAddress& address)
 {
-    // Create the internal socket if it doesn't exist
-    create();
+    if (address == IpAddress::None)
+    {
+        err() << "Failed to listen to port " << port << " (the address is invalid)" << std::endl;
+        return Error;
+    }
+
+    // Stop listening to the previous port, if any, and create the internal socket
+    close();
+    create(address.getType());
 
     // Bind the socket to the specified port
-    sockaddr_in address = priv::SocketImpl::createAddress(INADDR_ANY, port);
-    if (bind(getHandle(), reinterpret_cast<sockaddr*>(&address), sizeof(address)) == -1)
+    sockaddr_storage localAddress;
+    priv::SocketImpl::AddrLength size = priv::SocketImpl::createAddress(address, port, getAddressType(), localAddress);
+    if (bind(getHandle(), reinterpret_cast<sockaddr*>(&localAddress), size) == -1)
     {
         // Not likely to happen, but...
         err() << "Failed to bind listener socket to port " << port << std::endl;
         return Error;
     }
 
-    // Listen to the bound port
-    if (::listen(getHandle(), 0) == -1)
+    // Listen to the bound port, with the largest backlog so that bursts of connections are not refused
+    if (::listen(getHandle(), SOMAXCONN) == -1)
     {
         // Oops, socket is deaf
         err() << "Failed to listen to port " << port << std::endl;
@@ -106,7 +118,7 @@ Socket::Status TcpListener::accept(TcpSocket& socket)
     }
 
     // Accept a new connection
-    sockaddr_in address;
+    sockaddr_storage address;
     priv::SocketImpl::AddrLength length = sizeof(address);
     SocketHandle remote = ::accept(getHandle(), reinterpret_cast<sockaddr*>(&address), &length);
 
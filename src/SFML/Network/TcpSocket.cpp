@@ -28,6 +28,7 @@
 #include <SFML/Network/TcpSocket.hpp>
 #include <SFML/Network/IpAddress.hpp>
 #include <SFML/Network/Packet.hpp>
+#include <SFML/Network/PacketPool.hpp>
 #include <SFML/Network/SocketImpl.hpp>
 #include <SFML/System/Err.hpp>
 #include <algorithm>
@@ -46,6 +47,10 @@ namespace
     #else
         const int flags = 0;
     #endif
+
+    // Bounds of the size of the buffer that stores the received data, unless a bigger packet needs more
+    const std::size_t minReceiveBufferSize = 4096;
+    const std::size_t maxReceiveBufferSize = 65536;
 }
 
 namespace sf
@@ -64,11 +69,15 @@ unsigned short TcpSocket::getLocalPort() const
     if (getHandle() != priv::SocketImpl::invalidSocket())
     {
         // Retrieve informations about the local end of the socket
-        sockaddr_in address;
+        sockaddr_storage address;
         priv::SocketImpl::AddrLength size = sizeof(address);
         if (getsockname(getHandle(), reinterpret_cast<sockaddr*>(&address), &size) != -1)
         {
-            return ntohs(address.sin_port);
+            IpAddress localAddress;
+            unsigned short localPort;
+            priv::SocketImpl::readAddress(address, localAddress, localPort);
+
+            return localPort;
         }
     }
 
@@ -83,11 +92,15 @@ IpAddress TcpSocket::getRemoteAddress() const
     if (getHandle() != priv::SocketImpl::invalidSocket())
     {
         // Retrieve informations about the remote end of the socket
-        sockaddr_in address;
+        sockaddr_storage address;
         priv::SocketImpl::AddrLength size = sizeof(address);
         if (getpeername(getHandle(), reinterpret_cast<sockaddr*>(&address), &size) != -1)
         {
-            return IpAddress(ntohl(address.sin_addr.s_addr));
+            IpAddress remoteAddress;
+            unsigned short remotePort;
+            priv::SocketImpl::readAddress(address, remoteAddress, remotePort);
+
+            return remoteAddress;
         }
     }
 
@@ -102,11 +115,15 @@ unsigned short TcpSocket::getRemotePort() const
     if (getHandle() != priv::SocketImpl::invalidSocket())
     {
         // Retrieve informations about the remote end of the socket
-        sockaddr_in address;
+        sockaddr_storage address;
         priv::SocketImpl::AddrLength size = sizeof(address);
         if (getpeername(getHandle(), reinterpret_cast<sockaddr*>(&address), &size) != -1)
         {
-            return ntohs(address.sin_port);
+            IpAddress remoteAddress;
+            unsigned short remotePort;
+            priv::SocketImpl::readAddress(address, remoteAddress, remotePort);
+
+            return remotePort;
         }
     }
 
@@ -118,18 +135,28 @@ unsigned short TcpSocket::getRemotePort() const
 ////////////////////////////////////////////////////////////
 Socket::Status TcpSocket::connect(const IpAddress& remoteAddress, unsigned short remotePort, Time timeout)
 {
-    // Create the internal socket if it doesn't exist
-    create();
+    // Don't create a socket for an address that failed to resolve
+    if (remoteAddress == IpAddress::None)
+    {
+        err() << "Failed to connect socket (the remote address is invalid)" << std::endl;
+        return Error;
+    }
+
+    // Create the internal socket if it doesn't exist, or if it can't reach an IPv6 address
+    if ((remoteAddress.getType() == IpAddress::IPv6) && (getAddressType() != IpAddress::IPv6))
+        close();
+    create(remoteAddress.getType());
 
     // Create the remote address
-    sockaddr_in address = priv::SocketImpl::createAddress(remoteAddress.toInteger(), remotePort);
+    sockaddr_storage address;
+    priv::SocketImpl::AddrLength size = priv::SocketImpl::createAddress(remoteAddress, remotePort, getAddressType(), address);
 
     if (timeout <= Time::Zero)
     {
         // ----- We're not using a timeout: just try to connect -----
 
         // Connect the socket
-        if (::connect(getHandle(), reinterpret_cast<sockaddr*>(&address), sizeof(address)) == -1)
+        if (::connect(getHandle(), reinterpret_cast<sockaddr*>(&address), size) == -1)
             return priv::SocketImpl::getErrorStatus();
 
         // Connection succeeded
@@ -147,7 +174,7 @@ Socket::Status TcpSocket::connect(const IpAddress& remoteAddress, unsigned short
             setBlocking(false);
 
         // Try to connect to the remote address
-        if (::connect(getHandle(), reinterpret_cast<sockaddr*>(&address), sizeof(address)) >= 0)
+        if (::connect(getHandle(), reinterpret_cast<sockaddr*>(&address), size) >= 0)
         {
             // We got instantly connected! (it may no happen a lot...)
             setBlocking(blocking);
@@ -211,14 +238,26 @@ void TcpSocket::disconnect()
     // Close the socket
     close();
 
-    // Reset the pending packet data
-    m_pendingPacket = PendingPacket();
+    // Reset the received data
+    m_receiveBuffer = ReceiveBuffer();
 }
 
 
 ////////////////////////////////////////////////////////////
 Socket::Status TcpSocket::send(const void* data, std::size_t size)
 {
+    std::size_t sent;
+
+    return send(data, size, sent);
+}
+
+
+////////////////////////////////////////////////////////////
+Socket::Status TcpSocket::send(const void* data, std::size_t size, std::size_t& sent)
+{
+    // First clear the variables to fill
+    sent = 0;
+
     // Check the parameters
     if (!data || (size == 0))
     {
@@ -227,16 +266,23 @@ Socket::Status TcpSocket::send(const void* data, std::size_t size)
     }
 
     // Loop until every byte has been sent
-    int sent = 0;
-    int sizeToSend = static_cast<int>(size);
-    for (int length = 0; length < sizeToSend; length += sent)
+    int result = 0;
+    for (; sent < size; sent += result)
     {
         // Send a chunk of data
-        sent = ::send(getHandle(), static_cast<const char*>(data) + length, sizeToSend - length, flags);
+        result = ::send(getHandle(), static_cast<const char*>(data) + sent, static_cast<int>(size - sent), flags);
 
         // Check for errors
-        if (sent < 0)
-            return priv::SocketImpl::getErrorStatus();
+        if (result < 0)
+        {
+            Status status = priv::SocketImpl::getErrorStatus();
+
+            // A non-blocking socket may have sent a part of the data before its buffer got full
+            if ((status == NotReady) && (sent > 0))
+                return Partial;
+
+            return status;
+        }
     }
 
     return Done;
@@ -278,33 +324,111 @@ Socket::Status TcpSocket::receive(void* data, std::size_t size, std::size_t& rec
 
 ////////////////////////////////////////////////////////////
 Socket::Status TcpSocket::send(Packet& packet)
+{
+    return send(&packet, 1);
+}
+
+
+////////////////////////////////////////////////////////////
+Socket::Status TcpSocket::send(Packet* packets, std::size_t count)
 {
     // TCP is a stream protocol, it doesn't preserve messages boundaries.
     // This means that we have to send the packet size first, so that the
     // receiver knows the actual end of the packet in the data stream.
 
-    // We allocate an extra memory block so that the size can be sent
-    // together with the data in a single call. This may seem inefficient,
-    // but it is actually required to avoid partial send, which could cause
-    // data corruption on the receiving end.
-
-    // Get the data to send from the packet
-    std::size_t size = 0;
-    const void* data = packet.onSend(size);
-
-    // First convert the packet size to network byte order
-    Uint32 packetSize = htonl(static_cast<Uint32>(size));
- 
-    // Allocate memory for the data block to send
-    std::vector<char> blockToSend(sizeof(packetSize) + size);
- 
-    // Copy the packet size and data into the block to send
-    std::memcpy(&blockToSend[0], &packetSize, sizeof(packetSize));
-    if (size > 0)
-        std::memcpy(&blockToSend[0] + sizeof(packetSize), data, size);
-
-    // Send the data block
-    return send(&blockToSend[0], blockToSend.size());
+    // The sizes and the data of the packets are gathered in a single system
+    // call, so that nothing has to be copied. Each packet keeps track of
+    // how much of it has been sent, so that a partial send (non-blocking
+    // mode) can be continued by the next call instead of corrupting the
+    // data stream.
+
+    // The packets are sent by groups, whose buffers are stored on the stack
+    const std::size_t maxGroupSize = 32;
+    Uint32                   sizes[maxGroupSize];
+    const char*              parts[maxGroupSize * 2];
+    std::size_t              partSizes[maxGroupSize * 2];
+    Packet*                  owners[maxGroupSize * 2];
+    priv::SocketImpl::Buffer buffers[maxGroupSize * 2];
+
+    Status status = Done;
+    for (std::size_t first = 0; (first < count) && (status == Done); first += maxGroupSize)
+    {
+        std::size_t groupSize = std::min(count - first, maxGroupSize);
+
+        // Gather what remains to be sent of each packet: its size, then its data
+        std::size_t partCount = 0;
+        for (std::size_t i = 0; i < groupSize; ++i)
+        {
+            Packet& packet = packets[first + i];
+            std::size_t size = 0;
+            const char* data = static_cast<const char*>(packet.onSend(size));
+            sizes[i] = htonl(static_cast<Uint32>(size));
+
+            std::size_t sendPos = packet.m_sendPos;
+            if (sendPos < sizeof(sizes[i]))
+            {
+                parts[partCount] = reinterpret_cast<const char*>(&sizes[i]) + sendPos;
+                partSizes[partCount] = sizeof(sizes[i]) - sendPos;
+                owners[partCount++] = &packet;
+                sendPos = sizeof(sizes[i]);
+            }
+
+            std::size_t dataPos = sendPos - sizeof(sizes[i]);
+            if (dataPos < size)
+            {
+                parts[partCount] = data + dataPos;
+                partSizes[partCount] = size - dataPos;
+                owners[partCount++] = &packet;
+            }
+        }
+
+        // Send the parts, until they have all been sent
+        std::size_t current = 0;
+        while (current < partCount)
+        {
+            for (std::size_t i = current; i < partCount; ++i)
+                priv::SocketImpl::setBuffer(buffers[i - current], parts[i], partSizes[i]);
+
+            int result = priv::SocketImpl::send(getHandle(), buffers, partCount - current, flags);
+            if (result < 0)
+            {
+                status = priv::SocketImpl::getErrorStatus();
+                break;
+            }
+
+            // Skip the bytes that have been sent
+            std::size_t sent = static_cast<std::size_t>(result);
+            while (sent > 0)
+            {
+                std::size_t size = std::min(sent, partSizes[current]);
+                parts[current] += size;
+                partSizes[current] -= size;
+                owners[current]->m_sendPos += size;
+                sent -= size;
+
+                if (partSizes[current] == 0)
+                    ++current;
+            }
+        }
+    }
+
+    // A non-blocking socket may have sent a part of the packets before its buffer got full
+    if (status == NotReady)
+    {
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            if (packets[i].m_sendPos > 0)
+                return Partial;
+        }
+
+        return NotReady;
+    }
+
+    // The packets can be sent again from the beginning
+    for (std::size_t i = 0; i < count; ++i)
+        packets[i].m_sendPos = 0;
+
+    return status;
 }
 
 
@@ -314,67 +438,175 @@ Socket::Status TcpSocket::receive(Packet& packet)
     // First clear the variables to fill
     packet.clear();
 
-    // We start by getting the size of the incoming packet
-    Uint32 packetSize = 0;
     std::size_t received = 0;
-    if (m_pendingPacket.SizeReceived < sizeof(m_pendingPacket.Size))
-    {
-        // Loop until we've received the entire size of the packet
-        // (even a 4 byte variable may be received in more than one call)
-        while (m_pendingPacket.SizeReceived < sizeof(m_pendingPacket.Size))
-        {
-            char* data = reinterpret_cast<char*>(&m_pendingPacket.Size) + m_pendingPacket.SizeReceived;
-            Status status = receive(data, sizeof(m_pendingPacket.Size) - m_pendingPacket.SizeReceived, received);
-            m_pendingPacket.SizeReceived += received;
+    return receive(&packet, 1, received);
+}
 
-            if (status != Done)
-                return status;
-        }
 
-        // The packet size has been fully received
-        packetSize = ntohl(m_pendingPacket.Size);
+////////////////////////////////////////////////////////////
+Socket::Status TcpSocket::receive(Packet* packets, std::size_t maxCount, std::size_t& received)
+{
+    // First clear the variables to fill
+    received = 0;
+
+    // Check the destination packets
+    if (!packets || (maxCount == 0))
+    {
+        err() << "Cannot receive packets from the network (no packet to fill)" << std::endl;
+        return Error;
     }
-    else
+
+    Status status = Done;
+    for (;;)
     {
-        // The packet size has already been received in a previous call
-        packetSize = ntohl(m_pendingPacket.Size);
+        // Return the complete packets that have already been received
+        while ((received < maxCount) && extractPacket(packets[received]))
+            ++received;
+
+        if (received > 0)
+            break;
+
+        // Not a single complete packet: read more data
+        status = fillReceiveBuffer();
+        if (status != Done)
+            break;
     }
 
-    // Loop until we receive all the packet data
-    char buffer[1024];
-    while (m_pendingPacket.Data.size() < packetSize)
+    // Let the selectors know if there are packets left in the buffer
+    updatePendingState();
+
+    return status;
+}
+
+
+////////////////////////////////////////////////////////////
+Socket::Status TcpSocket::receive(PacketPool& pool, Packet*& packet)
+{
+    // First clear the variables to fill
+    packet = NULL;
+
+    // Wait for a complete packet before taking one from the pool
+    while (!hasPendingPacket())
     {
-        // Receive a chunk of data
-        std::size_t sizeToGet = std::min(static_cast<std::size_t>(packetSize - m_pendingPacket.Data.size()), sizeof(buffer));
-        Status status = receive(buffer, sizeToGet, received);
+        Status status = fillReceiveBuffer();
         if (status != Done)
+        {
+            updatePendingState();
             return status;
+        }
+    }
 
-        // Append it into the packet
-        if (received > 0)
+    packet = pool.acquire();
+    extractPacket(*packet);
+
+    // Let the selectors know if there are packets left in the buffer
+    updatePendingState();
+
+    return Done;
+}
+
+
+////////////////////////////////////////////////////////////
+bool TcpSocket::hasPendingPacket() const
+{
+    // TCP is a stream protocol, it doesn't preserve messages boundaries.
+    // This means that each packet is preceded by its size, so that the
+    // receiver knows the actual end of the packet in the data stream.
+    const ReceiveBuffer& buffer = m_receiveBuffer;
+    Uint32 packetSize = 0;
+    if (buffer.end - buffer.begin < sizeof(packetSize))
+        return false;
+
+    std::memcpy(&packetSize, &buffer.data[buffer.begin], sizeof(packetSize));
+
+    return buffer.end - buffer.begin - sizeof(packetSize) >= ntohl(packetSize);
+}
+
+
+////////////////////////////////////////////////////////////
+Socket::Status TcpSocket::fillReceiveBuffer()
+{
+    ReceiveBuffer& buffer = m_receiveBuffer;
+
+    // Move the beginning of the next packet to the front, to make room after it
+    if (buffer.begin > 0)
+    {
+        std::memmove(&buffer.data[0], &buffer.data[buffer.begin], buffer.end - buffer.begin);
+        buffer.end -= buffer.begin;
+        buffer.begin = 0;
+    }
+
+    // Reject the packets that are too big as soon as their size is known,
+    // the data that follows them can't be interpreted anymore
+    std::size_t packetEnd = 0;
+    if (buffer.end >= sizeof(Uint32))
+    {
+        Uint32 packetSize = 0;
+        std::memcpy(&packetSize, &buffer.data[0], sizeof(packetSize));
+        packetSize = ntohl(packetSize);
+        if (packetSize > MaxPacketSize)
         {
-            m_pendingPacket.Data.resize(m_pendingPacket.Data.size() + received);
-            char* begin = &m_pendingPacket.Data[0] + m_pendingPacket.Data.size() - received;
-            std::memcpy(begin, buffer, received);
+            err() << "Failed to receive a packet of " << packetSize << " bytes "
+                  << "(the maximum size is sf::TcpSocket::MaxPacketSize), disconnecting" << std::endl;
+            disconnect();
+            return Error;
         }
+
+        packetEnd = sizeof(packetSize) + packetSize;
     }
 
-    // We have received all the packet data: we can copy it to the user packet
-    if (!m_pendingPacket.Data.empty())
-        packet.onReceive(&m_pendingPacket.Data[0], m_pendingPacket.Data.size());
+    // If the buffer is full, double its size: so that busy sockets need fewer calls, up to
+    // maxReceiveBufferSize, and to make room for a bigger packet, whose memory is then only
+    // allocated as its data actually arrives
+    if (buffer.data.size() < minReceiveBufferSize)
+        buffer.data.resize(minReceiveBufferSize);
+    else if (buffer.end == buffer.data.size())
+        buffer.data.resize(std::min(buffer.data.size() * 2, std::max(packetEnd, maxReceiveBufferSize)));
 
-    // Clear the pending packet data
-    m_pendingPacket = PendingPacket();
+    // Read everything that's available, in a single call
+    std::size_t received = 0;
+    Status status = receive(&buffer.data[buffer.end], buffer.data.size() - buffer.end, received);
+    buffer.end += received;
 
-    return Done;
+    return status;
+}
+
+
+////////////////////////////////////////////////////////////
+bool TcpSocket::extractPacket(Packet& packet)
+{
+    if (!hasPendingPacket())
+        return false;
+
+    ReceiveBuffer& buffer = m_receiveBuffer;
+    Uint32 packetSize = 0;
+    std::memcpy(&packetSize, &buffer.data[buffer.begin], sizeof(packetSize));
+    packetSize = ntohl(packetSize);
+
+    // Give the data to the packet directly from the buffer
+    packet.clear();
+    if (packetSize > 0)
+        packet.onReceive(&buffer.data[buffer.begin + sizeof(packetSize)], packetSize);
+
+    buffer.begin += sizeof(packetSize) + packetSize;
+    if (buffer.begin == buffer.end)
+    {
+        buffer.begin = buffer.end = 0;
+
+        // Release the memory taken by a big packet once it's no longer needed
+        if (buffer.data.size() > maxReceiveBufferSize)
+            std::vector<char>(maxReceiveBufferSize).swap(buffer.data);
+    }
+
+    return true;
 }
 
 
 ////////////////////////////////////////////////////////////
-TcpSocket::PendingPacket::PendingPacket() :
-Size        (0),
-SizeReceived(0),
-Data        ()
+TcpSocket::ReceiveBuffer::ReceiveBuffer() :
+data (),
+begin(0),
+end  (0)
 {
 
 }
@@ -0,0 +1,1372 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2014 Laurent Gomila (laurent.gom@gmail.com)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Network/UdpHost.hpp>
+#include <SFML/Network/UdpSocket.hpp>
+#include <SFML/System/Clock.hpp>
+#include <SFML/System/Err.hpp>
+#include <algorithm>
+#include <cstring>
+#include <ctime>
+#include <deque>
+#include <map>
+#include <vector>
+
+
+namespace
+{
+    // Identifier written at the beginning of every datagram, to ignore foreign datagrams
+    const sf::Uint16 protocolId = 0x5346;
+
+    // Types of datagrams
+    enum DatagramType
+    {
+        ConnectRequest = 1,
+        ConnectAccept  = 2,
+        Data           = 3,
+        Close          = 4
+    };
+
+    // Flags of the messages (fragments of packets) contained in data datagrams
+    enum MessageFlag
+    {
+        Fragmented = 1
+    };
+
+    const std::size_t maxDatagramSize     = 1200;    // Stays below the MTU of most networks
+    const std::size_t receiveBufferSize   = 1500;    // Bigger datagrams than the ones sent are truncated
+    const std::size_t fragmentSize        = 1100;    // Leaves room for the headers in a datagram
+    const std::size_t maxFragments        = 1024;    // Maximum number of fragments of a packet
+    const std::size_t batchSize           = 64;      // Number of datagrams received or sent at once
+    const std::size_t historySize         = 1024;    // Number of sent datagrams remembered, to process their acknowledgement
+    const sf::Uint16  reliableWindow      = 8192;    // Maximum distance between the reliable packets waiting for acknowledgement
+    const std::size_t initialWindow       = 65536;   // Initial congestion window, in bytes
+    const std::size_t minWindow           = 4 * maxDatagramSize;
+    const std::size_t maxWindow           = 4194304;
+    const sf::Int64   connectInterval     = 200000;  // Delay between connection requests, in microseconds
+    const sf::Int64   keepAliveInterval   = 100000;  // Maximum delay between datagrams of an idle connection
+    const sf::Int64   fragmentLifetime    = 2000000; // Lifetime of incomplete packets of unreliable channels
+    const sf::Int64   initialResendDelay  = 200000;  // Resend delay before the round trip time is measured
+    const sf::Int64   minResendDelay      = 20000;
+    const sf::Int64   maxResendDelay      = 1000000;
+
+    // Compare sequence numbers, which wrap around
+    bool sequenceGreater(sf::Uint16 left, sf::Uint16 right)
+    {
+        return (left != right) && (static_cast<sf::Uint16>(left - right) < 32768);
+    }
+
+    // Append integers in network byte order
+    void write8(std::vector<char>& data, sf::Uint8 value)
+    {
+        data.push_back(static_cast<char>(value));
+    }
+
+    void write16(std::vector<char>& data, sf::Uint16 value)
+    {
+        write8(data, static_cast<sf::Uint8>(value >> 8));
+        write8(data, static_cast<sf::Uint8>(value & 0xFF));
+    }
+
+    void write32(std::vector<char>& data, sf::Uint32 value)
+    {
+        write16(data, static_cast<sf::Uint16>(value >> 16));
+        write16(data, static_cast<sf::Uint16>(value & 0xFFFF));
+    }
+
+    // Read integers in network byte order, and remember if the datagram was too short
+    struct Reader
+    {
+        Reader(const char* data, std::size_t size) :
+        data    (data),
+        size    (size),
+        position(0),
+        valid   (true)
+        {
+        }
+
+        sf::Uint8 read8()
+        {
+            if (position >= size)
+            {
+                valid = false;
+                return 0;
+            }
+
+            return static_cast<sf::Uint8>(data[position++]);
+        }
+
+        sf::Uint16 read16()
+        {
+            sf::Uint16 high = read8();
+            return static_cast<sf::Uint16>((high << 8) | read8());
+        }
+
+        sf::Uint32 read32()
+        {
+            sf::Uint32 high = read16();
+            return (high << 16) | read16();
+        }
+
+        const char* readBytes(std::size_t count)
+        {
+            if (size - position < count)
+            {
+                valid = false;
+                return NULL;
+            }
+
+            const char* bytes = data + position;
+            position += count;
+            return bytes;
+        }
+
+        const char* data;
+        std::size_t size;
+        std::size_t position;
+        bool        valid;
+    };
+}
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+struct UdpHost::UdpHostImpl
+{
+    ////////////////////////////////////////////////////////////
+    struct Fragment
+    {
+        Uint8             channel;  ///< Channel of the packet
+        Uint32            id;       ///< Identifier of the packet in its channel (sent modulo 65536)
+        Uint16            index;    ///< Index of the fragment in the packet
+        Uint16            count;    ///< Number of fragments of the packet
+        std::vector<char> data;     ///< Data of the fragment
+        Int64             lastSent; ///< Time of the last send
+    };
+
+    ////////////////////////////////////////////////////////////
+    struct SentDatagram
+    {
+        Uint16              sequence;     ///< Sequence number of the datagram
+        Int64               time;         ///< Time when the datagram was sent
+        bool                used;         ///< Was a datagram sent with this record?
+        bool                acknowledged; ///< Was the datagram acknowledged?
+        std::vector<Uint64> fragments;    ///< Keys of the reliable fragments that it contained
+    };
+
+    ////////////////////////////////////////////////////////////
+    struct Assembly
+    {
+        Uint16                          count;     ///< Number of fragments of the packet
+        Uint16                          received;  ///< Number of fragments received
+        std::vector<std::vector<char> > fragments; ///< Data of the fragments
+        std::vector<bool>               present;   ///< Has each fragment been received?
+        Int64                           started;   ///< Time when the first fragment was received
+    };
+
+    ////////////////////////////////////////////////////////////
+    struct OutgoingChannel
+    {
+        Uint32                          nextId;   ///< Identifier of the next packet
+        std::map<Uint32, unsigned int>  inFlight; ///< Number of fragments waiting for acknowledgement, by packet
+    };
+
+    ////////////////////////////////////////////////////////////
+    struct IncomingChannel
+    {
+        Uint16                    next;       ///< Identifier of the next packet to deliver (reliable) or of the last one delivered (sequenced)
+        bool                      delivered;  ///< Was a packet delivered yet? (sequenced)
+        std::map<Uint16, Assembly> assemblies; ///< Packets being received
+    };
+
+    ////////////////////////////////////////////////////////////
+    struct ConnectionData
+    {
+        Connection                   id;                 ///< Identifier of the connection
+        IpAddress                    address;            ///< Address of the peer
+        unsigned short               port;               ///< Port of the peer
+        Uint32                       token;              ///< Random value chosen by the connecting side, identifying the connection
+        bool                         established;        ///< Has the connection been accepted?
+        Int64                        lastReceived;       ///< Time of the last datagram received
+        Int64                        lastSent;           ///< Time of the last datagram sent
+        Uint16                       nextSequence;       ///< Sequence number of the next datagram
+        Uint16                       oldestUnchecked;    ///< Oldest datagram that may still be acknowledged
+        std::vector<SentDatagram>    history;            ///< Datagrams sent, by sequence number
+        std::deque<Fragment>         unreliableQueue;    ///< Unreliable fragments waiting to be sent
+        std::deque<Fragment>         reliableQueue;      ///< Reliable fragments waiting to be sent
+        std::map<Uint64, Fragment>   inFlight;           ///< Reliable fragments waiting for acknowledgement
+        std::vector<Uint64>          resends;            ///< Reliable fragments to send again
+        std::vector<OutgoingChannel> outgoing;           ///< Sending state of each channel
+        std::vector<IncomingChannel> incoming;           ///< Receiving state of each channel
+        std::size_t                  bytesInFlight;      ///< Size of the reliable fragments waiting for acknowledgement
+        std::size_t                  window;             ///< Congestion window
+        Int64                        lastWindowDecrease; ///< Time of the last decrease of the congestion window
+        bool                         receivedAny;        ///< Was a data datagram received yet?
+        Uint16                       remoteSequence;     ///< Last sequence number received
+        Uint32                       remoteBits;         ///< Which of the 32 datagrams before the last one were received
+        bool                         ackPending;         ///< Must the received datagrams be acknowledged?
+        bool                         rttMeasured;        ///< Was the round trip time measured yet?
+        Int64                        rtt;                ///< Smoothed round trip time
+        Int64                        rttVariation;       ///< Mean variation of the round trip time
+        Statistics                   statistics;         ///< Counters of the connection
+    };
+
+    ////////////////////////////////////////////////////////////
+    struct DelayedDatagram
+    {
+        Int64             time;    ///< Time when the datagram must be sent
+        IpAddress         address; ///< Address of the receiver
+        unsigned short    port;    ///< Port of the receiver
+        std::vector<char> data;    ///< Contents of the datagram
+    };
+
+    typedef std::map<Connection, ConnectionData*>                    ConnectionTable;
+    typedef std::map<std::pair<IpAddress, unsigned short>, Connection> EndpointTable;
+
+    ////////////////////////////////////////////////////////////
+    UdpHostImpl() :
+    bound         (false),
+    listening     (false),
+    nextConnection(1),
+    timeout       (10000000),
+    lossRate      (0.f),
+    latency       (0),
+    randomState   (static_cast<Uint32>(std::time(NULL)) ^ static_cast<Uint32>(reinterpret_cast<std::size_t>(this))),
+    outgoingCount (0),
+    incomingBatch (batchSize),
+    incomingData  (batchSize * receiveBufferSize),
+    outgoingBatch (batchSize),
+    outgoingData  (batchSize)
+    {
+        for (std::size_t i = 0; i < batchSize; ++i)
+        {
+            incomingBatch[i].data = &incomingData[i * receiveBufferSize];
+            incomingBatch[i].size = receiveBufferSize;
+        }
+
+        if (randomState == 0)
+            randomState = 1;
+    }
+
+    ////////////////////////////////////////////////////////////
+    ~UdpHostImpl()
+    {
+        for (ConnectionTable::iterator it = connections.begin(); it != connections.end(); ++it)
+            delete it->second;
+    }
+
+    ////////////////////////////////////////////////////////////
+    Int64 now() const
+    {
+        return timeline.getElapsedTime().asMicroseconds();
+    }
+
+    ////////////////////////////////////////////////////////////
+    Uint32 random()
+    {
+        // xorshift32
+        randomState ^= randomState << 13;
+        randomState ^= randomState >> 17;
+        randomState ^= randomState << 5;
+        return randomState;
+    }
+
+    ////////////////////////////////////////////////////////////
+    bool bind(unsigned short port, const IpAddress& address)
+    {
+        if (!bound)
+        {
+            if (socket.bind(port, address) != Socket::Done)
+                return false;
+
+            socket.setBlocking(false);
+            bound = true;
+        }
+
+        return true;
+    }
+
+    ////////////////////////////////////////////////////////////
+    ConnectionData* find(Connection connection) const
+    {
+        ConnectionTable::const_iterator it = connections.find(connection);
+        return it != connections.end() ? it->second : NULL;
+    }
+
+    ////////////////////////////////////////////////////////////
+    ConnectionData* create(const IpAddress& address, unsigned short port, Uint32 token, bool established)
+    {
+        ConnectionData* connection = new ConnectionData;
+        connection->id                 = nextConnection++;
+        connection->address            = address;
+        connection->port               = port;
+        connection->token              = token;
+        connection->established        = established;
+        connection->lastReceived       = now();
+        connection->lastSent           = 0;
+        connection->nextSequence       = 0;
+        connection->oldestUnchecked    = 0;
+        connection->history.resize(historySize);
+        connection->outgoing.resize(channels.size());
+        connection->incoming.resize(channels.size());
+        connection->bytesInFlight      = 0;
+        connection->window             = initialWindow;
+        connection->lastWindowDecrease = 0;
+        connection->receivedAny        = false;
+        connection->remoteSequence     = 0;
+        connection->remoteBits         = 0;
+        connection->ackPending         = false;
+        connection->rttMeasured        = false;
+        connection->rtt                = 0;
+        connection->rttVariation       = 0;
+
+        for (std::size_t i = 0; i < channels.size(); ++i)
+        {
+            connection->outgoing[i].nextId    = 0;
+            connection->incoming[i].next      = 0;
+            connection->incoming[i].delivered = false;
+        }
+
+        for (std::size_t i = 0; i < historySize; ++i)
+        {
+            connection->history[i].used         = false;
+            connection->history[i].acknowledged = false;
+        }
+
+        // Identifier 0 is reserved
+        if (nextConnection == 0)
+            nextConnection = 1;
+
+        connections[connection->id] = connection;
+        endpoints[std::make_pair(address, port)] = connection->id;
+
+        return connection;
+    }
+
+    ////////////////////////////////////////////////////////////
+    void remove(ConnectionData* connection, bool notify)
+    {
+        if (notify)
+            pushEvent(Event::Disconnected, connection->id);
+
+        endpoints.erase(std::make_pair(connection->address, connection->port));
+        connections.erase(connection->id);
+        delete connection;
+    }
+
+    ////////////////////////////////////////////////////////////
+    Event& pushEvent(Event::EventType type, Connection connection)
+    {
+        events.push_back(Event());
+        events.back().type       = type;
+        events.back().connection = connection;
+
+        return events.back();
+    }
+
+    ////////////////////////////////////////////////////////////
+    void startDatagram(DatagramType type, Uint32 token)
+    {
+        buffer.clear();
+        write16(buffer, protocolId);
+        write8(buffer, static_cast<Uint8>(type));
+        write32(buffer, token);
+    }
+
+    ////////////////////////////////////////////////////////////
+    void transmit(ConnectionData& connection)
+    {
+        connection.lastSent = now();
+        connection.statistics.datagramsSent++;
+        connection.statistics.bytesSent += buffer.size();
+
+        // Simulate a bad network, if requested
+        if ((lossRate > 0.f) && (random() % 1000000 < static_cast<Uint32>(lossRate * 1000000)))
+            return;
+
+        if (latency > 0)
+        {
+            DelayedDatagram datagram;
+            datagram.time    = now() + latency;
+            datagram.address = connection.address;
+            datagram.port    = connection.port;
+            datagram.data    = buffer;
+            delayed.push_back(datagram);
+        }
+        else
+        {
+            enqueue(connection.address, connection.port, buffer);
+        }
+    }
+
+    ////////////////////////////////////////////////////////////
+    void enqueue(const IpAddress& address, unsigned short port, const std::vector<char>& data)
+    {
+        // Datagrams are sent by batches
+        outgoingData[outgoingCount] = data;
+        outgoingBatch[outgoingCount].data    = &outgoingData[outgoingCount][0];
+        outgoingBatch[outgoingCount].size    = data.size();
+        outgoingBatch[outgoingCount].address = address;
+        outgoingBatch[outgoingCount].port    = port;
+
+        if (++outgoingCount == batchSize)
+            flushSocket();
+    }
+
+    ////////////////////////////////////////////////////////////
+    void flushSocket()
+    {
+        // Datagrams that the socket can't send now are lost, like on the network
+        if (outgoingCount > 0)
+        {
+            std::size_t sent = 0;
+            socket.send(&outgoingBatch[0], outgoingCount, sent);
+            outgoingCount = 0;
+        }
+    }
+
+    ////////////////////////////////////////////////////////////
+    void sendConnectRequest(ConnectionData& connection)
+    {
+        startDatagram(ConnectRequest, connection.token);
+        write8(buffer, static_cast<Uint8>(channels.size()));
+        transmit(connection);
+    }
+
+    ////////////////////////////////////////////////////////////
+    void sendClose(ConnectionData& connection)
+    {
+        // Closing is not acknowledged: send it several times, in case some are lost.
+        // It bypasses the simulated latency, since the host may not be updated anymore
+        startDatagram(Close, connection.token);
+        for (int i = 0; i < 3; ++i)
+            enqueue(connection.address, connection.port, buffer);
+    }
+
+    ////////////////////////////////////////////////////////////
+    static Uint64 getKey(const Fragment& fragment)
+    {
+        return (static_cast<Uint64>(fragment.channel) << 48) | (static_cast<Uint64>(fragment.id) << 16) | fragment.index;
+    }
+
+    ////////////////////////////////////////////////////////////
+    static std::size_t getMessageSize(const Fragment& fragment)
+    {
+        return (fragment.count > 1 ? 10 : 6) + fragment.data.size();
+    }
+
+    ////////////////////////////////////////////////////////////
+    Int64 getResendDelay(const ConnectionData& connection) const
+    {
+        if (!connection.rttMeasured)
+            return initialResendDelay;
+
+        return std::min(std::max(connection.rtt + 4 * connection.rttVariation, minResendDelay), maxResendDelay);
+    }
+
+    ////////////////////////////////////////////////////////////
+    void startDataDatagram(ConnectionData& connection)
+    {
+        startDatagram(Data, connection.token);
+        write16(buffer, connection.nextSequence);
+
+        // Acknowledge the last datagram received and the 32 before it
+        write8(buffer, connection.receivedAny ? 1 : 0);
+        write16(buffer, connection.remoteSequence);
+        write32(buffer, connection.remoteBits);
+
+        SentDatagram& record = connection.history[connection.nextSequence % historySize];
+        record.sequence     = connection.nextSequence;
+        record.time         = now();
+        record.used         = true;
+        record.acknowledged = false;
+        record.fragments.clear();
+
+        connection.nextSequence++;
+    }
+
+    ////////////////////////////////////////////////////////////
+    void finishDataDatagram(ConnectionData& connection)
+    {
+        connection.ackPending = false;
+        transmit(connection);
+    }
+
+    ////////////////////////////////////////////////////////////
+    void appendMessage(ConnectionData& connection, Fragment& fragment, bool reliable, bool& open)
+    {
+        // Start a new datagram when the current one is full
+        if (open && (buffer.size() + getMessageSize(fragment) > maxDatagramSize))
+        {
+            finishDataDatagram(connection);
+            open = false;
+        }
+
+        if (!open)
+        {
+            startDataDatagram(connection);
+            open = true;
+        }
+
+        write8(buffer, fragment.channel);
+        write8(buffer, fragment.count > 1 ? Fragmented : 0);
+        write16(buffer, static_cast<Uint16>(fragment.id));
+        if (fragment.count > 1)
+        {
+            write16(buffer, fragment.index);
+            write16(buffer, fragment.count);
+        }
+        write16(buffer, static_cast<Uint16>(fragment.data.size()));
+        buffer.insert(buffer.end(), fragment.data.begin(), fragment.data.end());
+
+        // Remember which reliable fragments the datagram contains, to process its acknowledgement
+        if (reliable)
+        {
+            connection.history[static_cast<Uint16>(connection.nextSequence - 1) % historySize].fragments.push_back(getKey(fragment));
+            fragment.lastSent = now();
+        }
+    }
+
+    ////////////////////////////////////////////////////////////
+    void flush(ConnectionData& connection)
+    {
+        bool open = false;
+
+        // Unreliable data first, since it is only useful if it arrives quickly
+        while (!connection.unreliableQueue.empty())
+        {
+            appendMessage(connection, connection.unreliableQueue.front(), false, open);
+            connection.unreliableQueue.pop_front();
+        }
+
+        // Then the reliable data that was lost
+        for (std::vector<Uint64>::iterator it = connection.resends.begin(); it != connection.resends.end(); ++it)
+        {
+            std::map<Uint64, Fragment>::iterator fragment = connection.inFlight.find(*it);
+            if (fragment != connection.inFlight.end())
+                appendMessage(connection, fragment->second, true, open);
+        }
+        connection.resends.clear();
+
+        // Then new reliable data, as long as the congestion window allows it
+        while (!connection.reliableQueue.empty())
+        {
+            Fragment& fragment = connection.reliableQueue.front();
+            OutgoingChannel& channel = connection.outgoing[fragment.channel];
+
+            if ((connection.bytesInFlight > 0) && (connection.bytesInFlight + fragment.data.size() > connection.window))
+                break;
+
+            // The receiver only accepts packets close enough to the next one that it expects
+            if (!channel.inFlight.empty() && (fragment.id - channel.inFlight.begin()->first >= reliableWindow))
+                break;
+
+            Uint64 key = getKey(fragment);
+            Fragment& inFlight = connection.inFlight[key];
+            inFlight = fragment;
+            connection.reliableQueue.pop_front();
+
+            connection.bytesInFlight += inFlight.data.size();
+            channel.inFlight[inFlight.id]++;
+
+            appendMessage(connection, inFlight, true, open);
+        }
+
+        // Acknowledge the received datagrams, and keep the connection alive
+        if (!open && (connection.ackPending || (now() - connection.lastSent >= keepAliveInterval)))
+        {
+            startDataDatagram(connection);
+            open = true;
+        }
+
+        if (open)
+            finishDataDatagram(connection);
+    }
+
+    ////////////////////////////////////////////////////////////
+    void onAcknowledged(ConnectionData& connection, SentDatagram& record)
+    {
+        record.acknowledged = true;
+
+        // Update the round trip time
+        Int64 sample = now() - record.time;
+        if (!connection.rttMeasured)
+        {
+            connection.rtt          = sample;
+            connection.rttVariation = sample / 2;
+            connection.rttMeasured  = true;
+        }
+        else
+        {
+            Int64 difference = connection.rtt > sample ? connection.rtt - sample : sample - connection.rtt;
+            connection.rttVariation = (3 * connection.rttVariation + difference) / 4;
+            connection.rtt          = (7 * connection.rtt + sample) / 8;
+        }
+
+        // The reliable fragments that the datagram contained are delivered
+        for (std::vector<Uint64>::iterator it = record.fragments.begin(); it != record.fragments.end(); ++it)
+        {
+            std::map<Uint64, Fragment>::iterator fragment = connection.inFlight.find(*it);
+            if (fragment == connection.inFlight.end())
+                continue;
+
+            std::size_t size = fragment->second.data.size();
+            connection.bytesInFlight -= size;
+
+            // Grow the congestion window by about one datagram per round trip
+            if (connection.window < maxWindow)
+                connection.window += std::max<std::size_t>(maxDatagramSize * size / connection.window, 1);
+
+            OutgoingChannel& channel = connection.outgoing[fragment->second.channel];
+            std::map<Uint32, unsigned int>::iterator packet = channel.inFlight.find(fragment->second.id);
+            if (--packet->second == 0)
+                channel.inFlight.erase(packet);
+
+            connection.inFlight.erase(fragment);
+        }
+        record.fragments.clear();
+    }
+
+    ////////////////////////////////////////////////////////////
+    void acknowledge(ConnectionData& connection, Uint16 ack, Uint32 bits)
+    {
+        // Ignore acknowledgements of datagrams that were not sent
+        if (sequenceGreater(ack, static_cast<Uint16>(connection.nextSequence - 1)) || (connection.nextSequence == connection.oldestUnchecked))
+            return;
+
+        for (Uint16 i = 0; i <= 32; ++i)
+        {
+            if ((i == 0) || (bits & (1u << (i - 1))))
+            {
+                Uint16 sequence = static_cast<Uint16>(ack - i);
+                SentDatagram& record = connection.history[sequence % historySize];
+                if (record.used && (record.sequence == sequence) && !record.acknowledged)
+                    onAcknowledged(connection, record);
+            }
+        }
+
+        // The datagrams that are too old to be acknowledged anymore were lost
+        Uint16 limit = static_cast<Uint16>(ack - 32);
+        while ((connection.oldestUnchecked != connection.nextSequence) && sequenceGreater(limit, connection.oldestUnchecked))
+        {
+            SentDatagram& record = connection.history[connection.oldestUnchecked % historySize];
+            if (record.used && (record.sequence == connection.oldestUnchecked) && !record.acknowledged)
+                connection.statistics.datagramsLost++;
+
+            connection.oldestUnchecked++;
+        }
+    }
+
+    ////////////////////////////////////////////////////////////
+    void deliver(ConnectionData& connection, Uint8 channel, const Assembly& assembly)
+    {
+        Event& event = pushEvent(Event::Received, connection.id);
+        event.channel = channel;
+        for (std::vector<std::vector<char> >::const_iterator it = assembly.fragments.begin(); it != assembly.fragments.end(); ++it)
+        {
+            if (!it->empty())
+                event.packet.append(&(*it)[0], it->size());
+        }
+
+        connection.statistics.packetsReceived++;
+    }
+
+    ////////////////////////////////////////////////////////////
+    void deliver(ConnectionData& connection, Uint8 channel, const char* data, std::size_t size)
+    {
+        Event& event = pushEvent(Event::Received, connection.id);
+        event.channel = channel;
+        if (size > 0)
+            event.packet.append(data, size);
+
+        connection.statistics.packetsReceived++;
+    }
+
+    ////////////////////////////////////////////////////////////
+    void deliverReliable(ConnectionData& connection, Uint8 channel)
+    {
+        // Deliver the complete packets that follow the last one delivered
+        IncomingChannel& incoming = connection.incoming[channel];
+        for (;;)
+        {
+            std::map<Uint16, Assembly>::iterator it = incoming.assemblies.find(incoming.next);
+            if ((it == incoming.assemblies.end()) || (it->second.received < it->second.count))
+                break;
+
+            deliver(connection, channel, it->second);
+            incoming.assemblies.erase(it);
+            incoming.next++;
+        }
+    }
+
+    ////////////////////////////////////////////////////////////
+    void dropSequenced(ConnectionData& connection, Uint8 channel)
+    {
+        // Forget the incomplete packets older than the last one delivered
+        IncomingChannel& incoming = connection.incoming[channel];
+        std::map<Uint16, Assembly>::iterator it = incoming.assemblies.begin();
+        while (it != incoming.assemblies.end())
+        {
+            if (!sequenceGreater(it->first, incoming.next))
+            {
+                connection.statistics.packetsDropped++;
+                incoming.assemblies.erase(it++);
+            }
+            else
+            {
+                ++it;
+            }
+        }
+    }
+
+    ////////////////////////////////////////////////////////////
+    void receiveFragment(ConnectionData& connection, Uint8 channel, Uint16 id, Uint16 index, Uint16 count, const char* data, std::size_t size)
+    {
+        IncomingChannel& incoming = connection.incoming[channel];
+        ChannelType type = channels[channel];
+
+        if (type == ReliableOrdered)
+        {
+            // Ignore packets that were already delivered
+            if (static_cast<Uint16>(id - incoming.next) >= reliableWindow)
+                return;
+
+            // Deliver the expected packet right away
+            if ((count == 1) && (id == incoming.next))
+            {
+                deliver(connection, channel, data, size);
+                incoming.next++;
+                deliverReliable(connection, channel);
+                return;
+            }
+        }
+        else if (type == UnreliableSequenced)
+        {
+            // Drop packets older than the last one delivered
+            if (incoming.delivered && !sequenceGreater(id, incoming.next))
+            {
+                if (index == 0)
+                    connection.statistics.packetsDropped++;
+                return;
+            }
+
+            if (count == 1)
+            {
+                deliver(connection, channel, data, size);
+                incoming.next      = id;
+                incoming.delivered = true;
+                dropSequenced(connection, channel);
+                return;
+            }
+        }
+        else if (count == 1)
+        {
+            deliver(connection, channel, data, size);
+            return;
+        }
+
+        // Put the packet back together
+        Assembly& assembly = incoming.assemblies[id];
+        if (assembly.fragments.empty())
+        {
+            assembly.count    = count;
+            assembly.received = 0;
+            assembly.started  = now();
+            assembly.fragments.resize(count);
+            assembly.present.resize(count, false);
+        }
+
+        if ((assembly.count != count) || assembly.present[index])
+            return;
+
+        assembly.fragments[index].assign(data, data + size);
+        assembly.present[index] = true;
+        if (++assembly.received < assembly.count)
+            return;
+
+        // The packet is complete
+        if (type == ReliableOrdered)
+        {
+            deliverReliable(connection, channel);
+        }
+        else
+        {
+            deliver(connection, channel, assembly);
+            incoming.assemblies.erase(id);
+
+            if (type == UnreliableSequenced)
+            {
+                incoming.next      = id;
+                incoming.delivered = true;
+                dropSequenced(connection, channel);
+            }
+        }
+    }
+
+    ////////////////////////////////////////////////////////////
+    void processData(ConnectionData& connection, Reader& reader)
+    {
+        Uint16 sequence = reader.read16();
+        bool   hasAck   = reader.read8() != 0;
+        Uint16 ack      = reader.read16();
+        Uint32 bits     = reader.read32();
+        if (!reader.valid)
+            return;
+
+        // Remember which datagrams were received, to acknowledge them; ignore duplicates
+        if (!connection.receivedAny)
+        {
+            connection.receivedAny    = true;
+            connection.remoteSequence = sequence;
+            connection.remoteBits     = 0;
+        }
+        else if (sequenceGreater(sequence, connection.remoteSequence))
+        {
+            Uint16 shift = static_cast<Uint16>(sequence - connection.remoteSequence);
+            if (shift < 32)
+                connection.remoteBits = (connection.remoteBits << shift) | (1u << (shift - 1));
+            else
+                connection.remoteBits = (shift == 32) ? (1u << 31) : 0;
+
+            connection.remoteSequence = sequence;
+        }
+        else
+        {
+            Uint16 distance = static_cast<Uint16>(connection.remoteSequence - sequence);
+            if (distance == 0)
+                return;
+
+            if (distance <= 32)
+            {
+                if (connection.remoteBits & (1u << (distance - 1)))
+                    return;
+
+                connection.remoteBits |= 1u << (distance - 1);
+            }
+        }
+
+        connection.ackPending = true;
+
+        if (hasAck)
+            acknowledge(connection, ack, bits);
+
+        // Read the messages
+        while (reader.position < reader.size)
+        {
+            Uint8  channel = reader.read8();
+            Uint8  flags   = reader.read8();
+            Uint16 id      = reader.read16();
+            Uint16 index   = 0;
+            Uint16 count   = 1;
+            if (flags & Fragmented)
+            {
+                index = reader.read16();
+                count = reader.read16();
+            }
+            Uint16 size = reader.read16();
+            const char* data = reader.readBytes(size);
+            if (!reader.valid)
+                break;
+
+            if ((channel < channels.size()) && (index < count) && (count <= maxFragments))
+                receiveFragment(connection, channel, id, index, count, data, size);
+        }
+    }
+
+    ////////////////////////////////////////////////////////////
+    void process(const char* data, std::size_t size, const IpAddress& address, unsigned short port)
+    {
+        Reader reader(data, size);
+        Uint16 protocol = reader.read16();
+        Uint8  type     = reader.read8();
+        Uint32 token    = reader.read32();
+        if (!reader.valid || (protocol != protocolId))
+            return;
+
+        EndpointTable::iterator it = endpoints.find(std::make_pair(address, port));
+        ConnectionData* connection = it != endpoints.end() ? connections[it->second] : NULL;
+
+        if (type == ConnectRequest)
+        {
+            Uint8 channelCount = reader.read8();
+            if (!reader.valid)
+                return;
+
+            // A new request from a known peer means that it restarted
+            if (connection && (connection->token != token) && connection->established && listening)
+            {
+                remove(connection, true);
+                connection = NULL;
+            }
+
+            // Accept the connection if the peer has the same channels
+            if (!connection)
+            {
+                if (!listening || (channelCount != channels.size()))
+                    return;
+
+                connection = create(address, port, token, true);
+                pushEvent(Event::Connected, connection->id);
+            }
+
+            // Confirm the connection (again, if the previous answer was lost)
+            if (connection->token == token)
+            {
+                startDatagram(ConnectAccept, token);
+                transmit(*connection);
+            }
+        }
+
+        if (!connection || (connection->token != token))
+            return;
+
+        connection->lastReceived = now();
+        connection->statistics.datagramsReceived++;
+        connection->statistics.bytesReceived += size;
+
+        // The connection is established when the peer accepts it, or sends data (if the answer was lost)
+        if (((type == ConnectAccept) || (type == Data)) && !connection->established)
+        {
+            connection->established = true;
+            pushEvent(Event::Connected, connection->id);
+        }
+
+        if (type == Data)
+            processData(*connection, reader);
+        else if (type == Close)
+            remove(connection, true);
+    }
+
+    ////////////////////////////////////////////////////////////
+    void update()
+    {
+        if (!bound)
+            return;
+
+        Int64 time = now();
+
+        // Send the datagrams whose simulated latency is over
+        while (!delayed.empty() && (delayed.front().time <= time))
+        {
+            enqueue(delayed.front().address, delayed.front().port, delayed.front().data);
+            delayed.pop_front();
+        }
+
+        // Receive all the available datagrams
+        for (;;)
+        {
+            std::size_t count = 0;
+            if (socket.receive(&incomingBatch[0], batchSize, count) != Socket::Done)
+                break;
+
+            for (std::size_t i = 0; i < count; ++i)
+                process(static_cast<const char*>(incomingBatch[i].data), incomingBatch[i].received, incomingBatch[i].address, incomingBatch[i].port);
+
+            if (count < batchSize)
+                break;
+        }
+
+        ConnectionTable::iterator it = connections.begin();
+        while (it != connections.end())
+        {
+            ConnectionData& connection = *(it++)->second;
+
+            // Close the connections that are silent for too long
+            if (time - connection.lastReceived > timeout)
+            {
+                remove(&connection, true);
+                continue;
+            }
+
+            // Repeat the connection request until it is answered
+            if (!connection.established)
+            {
+                if (time - connection.lastSent >= connectInterval)
+                    sendConnectRequest(connection);
+                continue;
+            }
+
+            // Find the reliable fragments that must be sent again
+            Int64 resendDelay = getResendDelay(connection);
+            for (std::map<Uint64, Fragment>::iterator fragment = connection.inFlight.begin(); fragment != connection.inFlight.end(); ++fragment)
+            {
+                if (time - fragment->second.lastSent >= resendDelay)
+                {
+                    connection.resends.push_back(fragment->first);
+                    connection.statistics.fragmentsResent++;
+
+                    // Shrink the congestion window, at most once per round trip
+                    if (time - connection.lastWindowDecrease >= std::max(connection.rtt, minResendDelay))
+                    {
+                        connection.window = std::max(connection.window / 2, minWindow);
+                        connection.lastWindowDecrease = time;
+                    }
+                }
+            }
+
+            // Forget the incomplete unreliable packets that are too old
+            for (std::size_t i = 0; i < channels.size(); ++i)
+            {
+                if (channels[i] == ReliableOrdered)
+                    continue;
+
+                std::map<Uint16, Assembly>& assemblies = connection.incoming[i].assemblies;
+                std::map<Uint16, Assembly>::iterator assembly = assemblies.begin();
+                while (assembly != assemblies.end())
+                {
+                    if (time - assembly->second.started > fragmentLifetime)
+                    {
+                        connection.statistics.packetsDropped++;
+                        assemblies.erase(assembly++);
+                    }
+                    else
+                    {
+                        ++assembly;
+                    }
+                }
+            }
+
+            flush(connection);
+        }
+
+        flushSocket();
+    }
+
+    UdpSocket                        socket;         ///< Socket exchanging the datagrams
+    bool                             bound;          ///< Is the socket bound?
+    bool                             listening;      ///< Are incoming connections accepted?
+    std::vector<ChannelType>         channels;       ///< Type of each channel
+    ConnectionTable                  connections;    ///< Connections, by identifier
+    EndpointTable                    endpoints;      ///< Connections, by address and port of the peer
+    Connection                       nextConnection; ///< Identifier of the next connection
+    std::deque<Event>                events;         ///< Events waiting to be polled
+    Clock                            timeline;       ///< Time reference of the host
+    Int64                            timeout;        ///< Timeout of the connections, in microseconds
+    float                            lossRate;       ///< Proportion of outgoing datagrams to drop (simulation)
+    Int64                            latency;        ///< Delay to add to outgoing datagrams, in microseconds (simulation)
+    Uint32                           randomState;    ///< State of the random number generator
+    std::deque<DelayedDatagram>      delayed;        ///< Outgoing datagrams waiting for their simulated latency
+    std::vector<char>                buffer;         ///< Datagram being written
+    std::size_t                      outgoingCount;  ///< Number of datagrams waiting to be sent
+    std::vector<UdpSocket::Datagram> incomingBatch;  ///< Batch of received datagrams
+    std::vector<char>                incomingData;   ///< Storage of the received datagrams
+    std::vector<UdpSocket::Datagram> outgoingBatch;  ///< Batch of datagrams to send
+    std::vector<std::vector<char> >  outgoingData;   ///< Storage of the datagrams to send
+};
+
+
+////////////////////////////////////////////////////////////
+UdpHost::UdpHost() :
+m_impl(new UdpHostImpl)
+{
+
+}
+
+
+////////////////////////////////////////////////////////////
+UdpHost::~UdpHost()
+{
+    delete m_impl;
+}
+
+
+////////////////////////////////////////////////////////////
+unsigned int UdpHost::addChannel(ChannelType type)
+{
+    if (m_impl->channels.size() >= MaxChannels)
+    {
+        err() << "Failed to add a channel to the UDP host (the maximum number of channels is reached)" << std::endl;
+        return MaxChannels - 1;
+    }
+
+    m_impl->channels.push_back(type);
+
+    // Existing connections get the new channel too
+    for (UdpHostImpl::ConnectionTable::iterator it = m_impl->connections.begin(); it != m_impl->connections.end(); ++it)
+    {
+        it->second->outgoing.resize(m_impl->channels.size());
+        it->second->outgoing.back().nextId = 0;
+        it->second->incoming.resize(m_impl->channels.size());
+        it->second->incoming.back().next = 0;
+        it->second->incoming.back().delivered = false;
+    }
+
+    return static_cast<unsigned int>(m_impl->channels.size() - 1);
+}
+
+
+////////////////////////////////////////////////////////////
+unsigned int UdpHost::getChannelCount() const
+{
+    return static_cast<unsigned int>(m_impl->channels.size());
+}
+
+
+////////////////////////////////////////////////////////////
+Socket::Status UdpHost::listen(unsigned short port, const IpAddress& address)
+{
+    if (m_impl->bound && (port != Socket::AnyPort) && (port != getLocalPort()))
+    {
+        err() << "Failed to listen to port " << port << " (the UDP host is already bound to another port)" << std::endl;
+        return Socket::Error;
+    }
+
+    if (!m_impl->bind(port, address))
+        return Socket::Error;
+
+    m_impl->listening = true;
+
+    return Socket::Done;
+}
+
+
+////////////////////////////////////////////////////////////
+unsigned short UdpHost::getLocalPort() const
+{
+    return m_impl->bound ? m_impl->socket.getLocalPort() : 0;
+}
+
+
+////////////////////////////////////////////////////////////
+UdpHost::Connection UdpHost::connect(const IpAddress& remoteAddress, unsigned short remotePort)
+{
+    if (remoteAddress == IpAddress::None)
+    {
+        err() << "Failed to connect to the remote host (the address is invalid)" << std::endl;
+        return 0;
+    }
+
+    // Make sure that the socket can receive the answer
+    IpAddress localAddress = (remoteAddress.getType() == IpAddress::IPv6) ? IpAddress::AnyIPv6 : IpAddress::Any;
+    if (!m_impl->bind(Socket::AnyPort, localAddress))
+        return 0;
+
+    // Reuse the existing connection to the same peer, if any
+    UdpHostImpl::EndpointTable::iterator it = m_impl->endpoints.find(std::make_pair(remoteAddress, remotePort));
+    if (it != m_impl->endpoints.end())
+        return it->second;
+
+    Uint32 token = m_impl->random();
+    UdpHostImpl::ConnectionData* connection = m_impl->create(remoteAddress, remotePort, token, false);
+
+    m_impl->sendConnectRequest(*connection);
+    m_impl->flushSocket();
+
+    return connection->id;
+}
+
+
+////////////////////////////////////////////////////////////
+void UdpHost::disconnect(Connection connection)
+{
+    UdpHostImpl::ConnectionData* data = m_impl->find(connection);
+    if (data)
+    {
+        m_impl->sendClose(*data);
+        m_impl->flushSocket();
+        m_impl->remove(data, false);
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void UdpHost::close()
+{
+    while (!m_impl->connections.empty())
+        disconnect(m_impl->connections.begin()->first);
+
+    // Send the last datagrams that were delayed by the simulation
+    while (!m_impl->delayed.empty())
+    {
+        m_impl->enqueue(m_impl->delayed.front().address, m_impl->delayed.front().port, m_impl->delayed.front().data);
+        m_impl->delayed.pop_front();
+    }
+    m_impl->flushSocket();
+
+    m_impl->socket.unbind();
+    m_impl->bound     = false;
+    m_impl->listening = false;
+    m_impl->events.clear();
+}
+
+
+////////////////////////////////////////////////////////////
+bool UdpHost::isConnected(Connection connection) const
+{
+    UdpHostImpl::ConnectionData* data = m_impl->find(connection);
+
+    return data && data->established;
+}
+
+
+////////////////////////////////////////////////////////////
+IpAddress UdpHost::getRemoteAddress(Connection connection) const
+{
+    UdpHostImpl::ConnectionData* data = m_impl->find(connection);
+
+    return data ? data->address : IpAddress::None;
+}
+
+
+////////////////////////////////////////////////////////////
+unsigned short UdpHost::getRemotePort(Connection connection) const
+{
+    UdpHostImpl::ConnectionData* data = m_impl->find(connection);
+
+    return data ? data->port : 0;
+}
+
+
+////////////////////////////////////////////////////////////
+UdpHost::Statistics UdpHost::getStatistics(Connection connection) const
+{
+    UdpHostImpl::ConnectionData* data = m_impl->find(connection);
+    if (!data)
+        return Statistics();
+
+    Statistics statistics = data->statistics;
+    statistics.roundTripTime      = microseconds(data->rtt);
+    statistics.roundTripVariation = microseconds(data->rttVariation);
+    statistics.bytesInFlight      = data->bytesInFlight;
+    statistics.congestionWindow   = data->window;
+
+    return statistics;
+}
+
+
+////////////////////////////////////////////////////////////
+Socket::Status UdpHost::send(Connection connection, unsigned int channel, Packet& packet)
+{
+    UdpHostImpl::ConnectionData* data = m_impl->find(connection);
+    if (!data || (channel >= m_impl->channels.size()))
+    {
+        err() << "Failed to send a packet through the UDP host (invalid connection or channel)" << std::endl;
+        return Socket::Error;
+    }
+
+    // Get the data to send from the packet
+    std::size_t size = 0;
+    const char* bytes = static_cast<const char*>(packet.onSend(size));
+    if (size > MaxPacketSize)
+    {
+        err() << "Failed to send a packet through the UDP host "
+              << "(the packet is bigger than sf::UdpHost::MaxPacketSize)" << std::endl;
+        return Socket::Error;
+    }
+
+    // Split it in fragments that fit in a datagram
+    UdpHostImpl::Fragment fragment;
+    fragment.channel  = static_cast<Uint8>(channel);
+    fragment.id       = data->outgoing[channel].nextId++;
+    fragment.count    = static_cast<Uint16>(size > 0 ? (size + fragmentSize - 1) / fragmentSize : 1);
+    fragment.lastSent = 0;
+
+    std::deque<UdpHostImpl::Fragment>& queue = m_impl->channels[channel] == ReliableOrdered ? data->reliableQueue : data->unreliableQueue;
+    for (fragment.index = 0; fragment.index < fragment.count; ++fragment.index)
+    {
+        std::size_t begin = fragment.index * fragmentSize;
+        std::size_t end = std::min(begin + fragmentSize, size);
+        fragment.data.assign(bytes + begin, bytes + end);
+        queue.push_back(fragment);
+    }
+
+    data->statistics.packetsSent++;
+
+    return Socket::Done;
+}
+
+
+////////////////////////////////////////////////////////////
+void UdpHost::update()
+{
+    m_impl->update();
+}
+
+
+////////////////////////////////////////////////////////////
+bool UdpHost::pollEvent(Event& event)
+{
+    if (m_impl->events.empty())
+        m_impl->update();
+
+    if (m_impl->events.empty())
+        return false;
+
+    event = m_impl->events.front();
+    m_impl->events.pop_front();
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+void UdpHost::setTimeout(Time timeout)
+{
+    m_impl->timeout = timeout.asMicroseconds();
+}
+
+
+////////////////////////////////////////////////////////////
+void UdpHost::simulateNetwork(float lossRate, Time latency)
+{
+    m_impl->lossRate = std::min(std::max(lossRate, 0.f), 1.f);
+    m_impl->latency  = std::max<Int64>(latency.asMicroseconds(), 0);
+}
+
+
+////////////////////////////////////////////////////////////
+UdpHost::Event::Event() :
+type      (Connected),
+connection(0),
+channel   (0),
+packet    ()
+{
+
+}
+
+
+////////////////////////////////////////////////////////////
+UdpHost::Statistics::Statistics() :
+roundTripTime     (),
+roundTripVariation(),
+packetsSent       (0),
+packetsReceived   (0),
+packetsDropped    (0),
+fragmentsResent   (0),
+datagramsSent     (0),
+datagramsReceived (0),
+datagramsLost     (0),
+bytesSent         (0),
+bytesReceived     (0),
+bytesInFlight     (0),
+congestionWindow  (0)
+{
+
+}
+
+} // namespace sf
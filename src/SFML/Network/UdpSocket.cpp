@@ -28,17 +28,47 @@
 #include <SFML/Network/UdpSocket.hpp>
 #include <SFML/Network/IpAddress.hpp>
 #include <SFML/Network/Packet.hpp>
+#include <SFML/Network/PacketPool.hpp>
 #include <SFML/Network/SocketImpl.hpp>
 #include <SFML/System/Err.hpp>
 #include <algorithm>
+#include <cstring>
+
+#if defined(SFML_SYSTEM_LINUX)
+    #include <netinet/udp.h>
+    #ifndef SOL_UDP
+        #define SOL_UDP 17
+    #endif
+    #ifndef UDP_SEGMENT
+        #define UDP_SEGMENT 103
+    #endif
+    #ifndef UDP_GRO
+        #define UDP_GRO 104
+    #endif
+#endif
+
+
+namespace
+{
+    // Number of datagrams passed to the system in a single call
+    const std::size_t batchSize = 64;
+
+    // Maximum number of datagrams that the system splits from a single buffer
+    const std::size_t maxSegments = 64;
+
+    // Size of the buffer receiving coalesced datagrams
+    const std::size_t coalescedBufferSize = 65536;
+}
 
 
 namespace sf
 {
 ////////////////////////////////////////////////////////////
 UdpSocket::UdpSocket() :
-Socket  (Udp),
-m_buffer(MaxDatagramSize)
+Socket     (Udp),
+m_buffer   (MaxDatagramSize),
+m_offload  (false),
+m_coalesced()
 {
 
 }
@@ -50,11 +80,15 @@ unsigned short UdpSocket::getLocalPort() const
     if (getHandle() != priv::SocketImpl::invalidSocket())
     {
         // Retrieve informations about the local end of the socket
-        sockaddr_in address;
+        sockaddr_storage address;
         priv::SocketImpl::AddrLength size = sizeof(address);
         if (getsockname(getHandle(), reinterpret_cast<sockaddr*>(&address), &size) != -1)
         {
-            return ntohs(address.sin_port);
+            IpAddress localAddress;
+            unsigned short localPort;
+            priv::SocketImpl::readAddress(address, localAddress, localPort);
+
+            return localPort;
         }
     }
 
@@ -64,14 +98,27 @@ unsigned short UdpSocket::getLocalPort() const
 
 
 ////////////////////////////////////////////////////////////
-Socket::Status UdpSocket::bind(unsigned short port)
+Socket::Status UdpSocket::bind(unsigned short port, const IpAddress& address)
 {
-    // Create the internal socket if it doesn't exist
-    create();
+    if (address == IpAddress::None)
+    {
+        err() << "Failed to bind socket to port " << port << " (the address is invalid)" << std::endl;
+        return Error;
+    }
+
+    // Create the internal socket if it doesn't exist, or if it uses another type of addresses
+    if (getAddressType() != address.getType())
+        unbind();
+    create(address.getType());
+
+    // A new socket must be configured again
+    if (m_offload)
+        setSegmentationOffload(true);
 
     // Bind the socket
-    sockaddr_in address = priv::SocketImpl::createAddress(INADDR_ANY, port);
-    if (::bind(getHandle(), reinterpret_cast<sockaddr*>(&address), sizeof(address)) == -1)
+    sockaddr_storage localAddress;
+    priv::SocketImpl::AddrLength size = priv::SocketImpl::createAddress(address, port, getAddressType(), localAddress);
+    if (::bind(getHandle(), reinterpret_cast<sockaddr*>(&localAddress), size) == -1)
     {
         err() << "Failed to bind socket to port " << port << std::endl;
         return Error;
@@ -84,16 +131,23 @@ Socket::Status UdpSocket::bind(unsigned short port)
 ////////////////////////////////////////////////////////////
 void UdpSocket::unbind()
 {
-    // Simply close the socket
+    // Close the socket and forget the received data
     close();
+    m_coalesced.begin = m_coalesced.end = 0;
 }
 
 
 ////////////////////////////////////////////////////////////
 Socket::Status UdpSocket::send(const void* data, std::size_t size, const IpAddress& remoteAddress, unsigned short remotePort)
 {
+    if (remoteAddress == IpAddress::None)
+    {
+        err() << "Cannot send data over the network (the remote address is invalid)" << std::endl;
+        return Error;
+    }
+
     // Create the internal socket if it doesn't exist
-    create();
+    create(remoteAddress.getType());
 
     // Make sure that all the data will fit in one datagram
     if (size > MaxDatagramSize)
@@ -104,10 +158,16 @@ Socket::Status UdpSocket::send(const void* data, std::size_t size, const IpAddre
     }
 
     // Build the target address
-    sockaddr_in address = priv::SocketImpl::createAddress(remoteAddress.toInteger(), remotePort);
+    sockaddr_storage address;
+    priv::SocketImpl::AddrLength addressSize = priv::SocketImpl::createAddress(remoteAddress, remotePort, getAddressType(), address);
+    if (addressSize == 0)
+    {
+        err() << "Cannot send data to an IPv6 address with a socket bound to an IPv4 address" << std::endl;
+        return Error;
+    }
 
     // Send the data (unlike TCP, all the data is always sent in one call)
-    int sent = sendto(getHandle(), static_cast<const char*>(data), static_cast<int>(size), 0, reinterpret_cast<sockaddr*>(&address), sizeof(address));
+    int sent = sendto(getHandle(), static_cast<const char*>(data), static_cast<int>(size), 0, reinterpret_cast<sockaddr*>(&address), addressSize);
 
     // Check for errors
     if (sent < 0)
@@ -132,8 +192,28 @@ Socket::Status UdpSocket::receive(void* data, std::size_t size, std::size_t& rec
         return Error;
     }
 
+    // Received datagrams may have to be split
+    if (m_offload || (m_coalesced.begin < m_coalesced.end))
+    {
+        Datagram datagram;
+        datagram.data = data;
+        datagram.size = size;
+
+        std::size_t count = 0;
+        Status status = receiveCoalesced(&datagram, 1, count);
+        if (status == Done)
+        {
+            received      = datagram.received;
+            remoteAddress = datagram.address;
+            remotePort    = datagram.port;
+        }
+
+        return status;
+    }
+
     // Data that will be filled with the other computer's address
-    sockaddr_in address = priv::SocketImpl::createAddress(INADDR_ANY, 0);
+    sockaddr_storage address;
+    std::memset(&address, 0, sizeof(address));
 
     // Receive a chunk of bytes
     priv::SocketImpl::AddrLength addressSize = sizeof(address);
@@ -144,9 +224,8 @@ Socket::Status UdpSocket::receive(void* data, std::size_t size, std::size_t& rec
         return priv::SocketImpl::getErrorStatus();
 
     // Fill the sender informations
-    received      = static_cast<std::size_t>(sizeReceived);
-    remoteAddress = IpAddress(ntohl(address.sin_addr.s_addr));
-    remotePort    = ntohs(address.sin_port);
+    received = static_cast<std::size_t>(sizeReceived);
+    priv::SocketImpl::readAddress(address, remoteAddress, remotePort);
 
     return Done;
 }
@@ -190,4 +269,396 @@ Socket::Status UdpSocket::receive(Packet& packet, IpAddress& remoteAddress, unsi
 }
 
 
+////////////////////////////////////////////////////////////
+Socket::Status UdpSocket::receive(PacketPool& pool, Packet*& packet, IpAddress& remoteAddress, unsigned short& remotePort)
+{
+    // First clear the variables to fill
+    packet = NULL;
+
+    // Receive the datagram
+    std::size_t received = 0;
+    Status status = receive(&m_buffer[0], m_buffer.size(), received, remoteAddress, remotePort);
+
+    // Only take a packet from the pool if something was received
+    if (status == Done)
+    {
+        packet = pool.acquire();
+        if (received > 0)
+            packet->onReceive(&m_buffer[0], received);
+    }
+
+    return status;
+}
+
+
+
+////////////////////////////////////////////////////////////
+Socket::Status UdpSocket::send(const Datagram* datagrams, std::size_t count, std::size_t& sent)
+{
+    // First clear the variables to fill
+    sent = 0;
+
+    // Create the internal socket if it doesn't exist
+    create(count > 0 ? datagrams[0].address.getType() : IpAddress::IPv4);
+
+    // Make sure that all the data will fit in datagrams, and that they can be delivered
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        if (datagrams[i].address == IpAddress::None)
+        {
+            err() << "Cannot send data over the network (the remote address is invalid)" << std::endl;
+            return Error;
+        }
+
+        if (datagrams[i].size > MaxDatagramSize)
+        {
+            err() << "Cannot send data over the network "
+                  << "(the number of bytes to send is greater than sf::UdpSocket::MaxDatagramSize)" << std::endl;
+            return Error;
+        }
+    }
+
+#if defined(SFML_SYSTEM_LINUX)
+
+    mmsghdr          messages[batchSize];
+    iovec            buffers[batchSize];
+    sockaddr_storage addresses[batchSize];
+    char             controls[batchSize][CMSG_SPACE(sizeof(Uint16))];
+    std::size_t      segments[batchSize];
+
+    while (sent < count)
+    {
+        // Fill a message for each of the next datagrams
+        unsigned int messageCount = 0;
+        std::size_t bufferCount = 0;
+        for (std::size_t i = sent; (i < count) && (bufferCount < batchSize); ++messageCount)
+        {
+            const Datagram& first = datagrams[i];
+            priv::SocketImpl::AddrLength addressSize = priv::SocketImpl::createAddress(first.address, first.port, getAddressType(), addresses[messageCount]);
+            if (addressSize == 0)
+            {
+                err() << "Cannot send data to an IPv6 address with a socket bound to an IPv4 address" << std::endl;
+                return sent > 0 ? Partial : Error;
+            }
+
+            msghdr& message = messages[messageCount].msg_hdr;
+            std::memset(&messages[messageCount], 0, sizeof(mmsghdr));
+            message.msg_name    = &addresses[messageCount];
+            message.msg_namelen = addressSize;
+            message.msg_iov     = &buffers[bufferCount];
+
+            // With segmentation offload, the following datagrams that have the same size and receiver
+            // (the last one may be smaller) go to the same message, which the system splits
+            std::size_t total = 0;
+            segments[messageCount] = 0;
+            do
+            {
+                buffers[bufferCount].iov_base = datagrams[i].data;
+                buffers[bufferCount].iov_len  = datagrams[i].size;
+                total += datagrams[i].size;
+                ++bufferCount;
+                ++segments[messageCount];
+                ++i;
+            }
+            while (m_offload && (i < count) && (bufferCount < batchSize) && (segments[messageCount] < maxSegments) &&
+                   (datagrams[i - 1].size == first.size) && (datagrams[i].size > 0) && (datagrams[i].size <= first.size) &&
+                   (total + datagrams[i].size <= MaxDatagramSize) &&
+                   (datagrams[i].address == first.address) && (datagrams[i].port == first.port));
+
+            message.msg_iovlen = segments[messageCount];
+
+            // Tell the system the size of the datagrams to split
+            if (segments[messageCount] > 1)
+            {
+                message.msg_control    = controls[messageCount];
+                message.msg_controllen = sizeof(controls[messageCount]);
+
+                Uint16 segmentSize = static_cast<Uint16>(first.size);
+                cmsghdr* control = CMSG_FIRSTHDR(&message);
+                control->cmsg_level = SOL_UDP;
+                control->cmsg_type  = UDP_SEGMENT;
+                control->cmsg_len   = CMSG_LEN(sizeof(segmentSize));
+                std::memcpy(CMSG_DATA(control), &segmentSize, sizeof(segmentSize));
+            }
+        }
+
+        // Send the messages
+        int result = sendmmsg(getHandle(), messages, messageCount, 0);
+        if (result < 0)
+        {
+            Status status = priv::SocketImpl::getErrorStatus();
+            return ((status == NotReady) && (sent > 0)) ? Partial : status;
+        }
+
+        for (int i = 0; i < result; ++i)
+            sent += segments[i];
+    }
+
+#else
+
+    // Send the datagrams one by one
+    for (; sent < count; ++sent)
+    {
+        const Datagram& datagram = datagrams[sent];
+        Status status = send(datagram.data, datagram.size, datagram.address, datagram.port);
+        if (status != Done)
+            return ((status == NotReady) && (sent > 0)) ? Partial : status;
+    }
+
+#endif
+
+    return Done;
+}
+
+
+////////////////////////////////////////////////////////////
+Socket::Status UdpSocket::receive(Datagram* datagrams, std::size_t count, std::size_t& received)
+{
+    // First clear the variables to fill
+    received = 0;
+
+    // Check the destination datagrams
+    if (!datagrams || (count == 0))
+    {
+        err() << "Cannot receive data from the network (no datagram to fill)" << std::endl;
+        return Error;
+    }
+
+    // Received datagrams may have to be split
+    if (m_offload || (m_coalesced.begin < m_coalesced.end))
+        return receiveCoalesced(datagrams, count, received);
+
+#if defined(SFML_SYSTEM_LINUX)
+
+    mmsghdr          messages[batchSize];
+    iovec            buffers[batchSize];
+    sockaddr_storage addresses[batchSize];
+
+    while (received < count)
+    {
+        // Fill a message for each of the next datagrams
+        unsigned int messageCount = static_cast<unsigned int>(std::min(count - received, batchSize));
+        for (unsigned int i = 0; i < messageCount; ++i)
+        {
+            buffers[i].iov_base = datagrams[received + i].data;
+            buffers[i].iov_len  = datagrams[received + i].size;
+
+            std::memset(&messages[i], 0, sizeof(mmsghdr));
+            messages[i].msg_hdr.msg_name    = &addresses[i];
+            messages[i].msg_hdr.msg_namelen = sizeof(sockaddr_storage);
+            messages[i].msg_hdr.msg_iov     = &buffers[i];
+            messages[i].msg_hdr.msg_iovlen  = 1;
+        }
+
+        // Wait for the first datagram only (in blocking mode), then take the ones that are available
+        int result = recvmmsg(getHandle(), messages, messageCount, received == 0 ? MSG_WAITFORONE : MSG_DONTWAIT, NULL);
+        if (result < 0)
+        {
+            Status status = priv::SocketImpl::getErrorStatus();
+            return received > 0 ? Done : status;
+        }
+
+        // Fill the sender informations
+        for (int i = 0; i < result; ++i)
+        {
+            Datagram& datagram = datagrams[received + i];
+            datagram.received = messages[i].msg_len;
+            priv::SocketImpl::readAddress(addresses[i], datagram.address, datagram.port);
+        }
+
+        received += result;
+        if (static_cast<unsigned int>(result) < messageCount)
+            break;
+    }
+
+    return Done;
+
+#else
+
+    // Receive the datagrams one by one; wait for the first one only (in blocking mode)
+    bool blocking = isBlocking();
+    Status status = Done;
+    for (; received < count; ++received)
+    {
+        Datagram& datagram = datagrams[received];
+        status = receive(datagram.data, datagram.size, datagram.received, datagram.address, datagram.port);
+        if (status != Done)
+            break;
+
+        if (blocking && (received == 0))
+            setBlocking(false);
+    }
+
+    if (blocking)
+        setBlocking(true);
+
+    return received > 0 ? Done : status;
+
+#endif
+}
+
+
+////////////////////////////////////////////////////////////
+bool UdpSocket::setSegmentationOffload(bool enabled)
+{
+#if defined(SFML_SYSTEM_LINUX)
+
+    // Create the internal socket if it doesn't exist
+    create();
+
+    // Sending doesn't need any setup, but receiving coalesced datagrams must be enabled
+    int value = enabled ? 1 : 0;
+    if (setsockopt(getHandle(), SOL_UDP, UDP_GRO, &value, sizeof(value)) == -1)
+    {
+        err() << "Failed to " << (enabled ? "enable" : "disable") << " segmentation offload (it requires Linux 5.0 or later)" << std::endl;
+        return false;
+    }
+
+    if (enabled && m_coalesced.data.empty())
+        m_coalesced.data.resize(coalescedBufferSize);
+
+    m_offload = enabled;
+    return true;
+
+#else
+
+    if (enabled)
+    {
+        err() << "Segmentation offload is not supported on this system" << std::endl;
+        return false;
+    }
+
+    return true;
+
+#endif
+}
+
+
+////////////////////////////////////////////////////////////
+bool UdpSocket::isSegmentationOffloadEnabled() const
+{
+    return m_offload;
+}
+
+
+////////////////////////////////////////////////////////////
+bool UdpSocket::hasPendingPacket() const
+{
+    return m_coalesced.begin < m_coalesced.end;
+}
+
+
+////////////////////////////////////////////////////////////
+Socket::Status UdpSocket::receiveCoalesced(Datagram* datagrams, std::size_t count, std::size_t& received)
+{
+    CoalescedData& coalesced = m_coalesced;
+    Status status = Done;
+
+    while (received < count)
+    {
+        // Split the next datagram out of the coalesced ones
+        if (coalesced.begin < coalesced.end)
+        {
+            Datagram& datagram = datagrams[received++];
+            std::size_t size = std::min(coalesced.segmentSize, coalesced.end - coalesced.begin);
+            datagram.received = std::min(size, datagram.size);
+            datagram.address  = coalesced.address;
+            datagram.port     = coalesced.port;
+            std::memcpy(datagram.data, &coalesced.data[coalesced.begin], datagram.received);
+
+            coalesced.begin += size;
+            continue;
+        }
+
+        // Segmentation offload may have been disabled after the last datagrams were split
+        if (!m_offload)
+            break;
+
+#if defined(SFML_SYSTEM_LINUX)
+
+        // Receive the next datagrams, as a single buffer if the system coalesced them
+        sockaddr_storage address;
+        std::memset(&address, 0, sizeof(address));
+        iovec buffer;
+        buffer.iov_base = &coalesced.data[0];
+        buffer.iov_len  = coalesced.data.size();
+        char control[CMSG_SPACE(sizeof(int))];
+
+        msghdr message;
+        std::memset(&message, 0, sizeof(message));
+        message.msg_name       = &address;
+        message.msg_namelen    = sizeof(address);
+        message.msg_iov        = &buffer;
+        message.msg_iovlen     = 1;
+        message.msg_control    = control;
+        message.msg_controllen = sizeof(control);
+
+        // Wait for the first datagram only (in blocking mode), then take the ones that are available
+        int result = recvmsg(getHandle(), &message, received == 0 ? 0 : MSG_DONTWAIT);
+        if (result < 0)
+        {
+            status = priv::SocketImpl::getErrorStatus();
+            break;
+        }
+
+        coalesced.begin       = 0;
+        coalesced.end         = static_cast<std::size_t>(result);
+        coalesced.segmentSize = coalesced.end;
+        priv::SocketImpl::readAddress(address, coalesced.address, coalesced.port);
+
+        // The system gives the size of the datagrams if it coalesced several of them
+        for (cmsghdr* header = CMSG_FIRSTHDR(&message); header != NULL; header = CMSG_NXTHDR(&message, header))
+        {
+            if ((header->cmsg_level == SOL_UDP) && (header->cmsg_type == UDP_GRO))
+            {
+                int segmentSize = 0;
+                std::memcpy(&segmentSize, CMSG_DATA(header), sizeof(segmentSize));
+                if (segmentSize > 0)
+                    coalesced.segmentSize = static_cast<std::size_t>(segmentSize);
+            }
+        }
+
+        // An empty datagram can't be split
+        if (result == 0)
+        {
+            Datagram& datagram = datagrams[received++];
+            datagram.received = 0;
+            datagram.address  = coalesced.address;
+            datagram.port     = coalesced.port;
+        }
+
+#endif
+    }
+
+    // Let the selectors know if there are datagrams left in the buffer
+    updatePendingState();
+
+    return received > 0 ? Done : status;
+}
+
+
+////////////////////////////////////////////////////////////
+UdpSocket::Datagram::Datagram() :
+data    (NULL),
+size    (0),
+received(0),
+address (),
+port    (0)
+{
+
+}
+
+
+////////////////////////////////////////////////////////////
+UdpSocket::CoalescedData::CoalescedData() :
+data       (),
+begin      (0),
+end        (0),
+segmentSize(0),
+address    (),
+port       (0)
+{
+
+}
+
 } // namespace sf
@@ -52,6 +52,55 @@ sockaddr_in SocketImpl::createAddress(Uint32 address, unsigned short port)
 }
 
 
+////////////////////////////////////////////////////////////
+SocketImpl::AddrLength SocketImpl::createAddress(const IpAddress& address, unsigned short port, IpAddress::Type addressType, sockaddr_storage& result)
+{
+    std::memset(&result, 0, sizeof(result));
+
+    if (addressType == IpAddress::IPv4)
+    {
+        // IPv4 sockets can't reach IPv6 addresses
+        if (address.getType() != IpAddress::IPv4)
+            return 0;
+
+        sockaddr_in& addr = reinterpret_cast<sockaddr_in&>(result);
+        addr = createAddress(address.toInteger(), port);
+
+        return sizeof(sockaddr_in);
+    }
+
+    // IPv6 sockets reach IPv4 addresses through their IPv4-mapped form
+    sockaddr_in6& addr = reinterpret_cast<sockaddr_in6&>(result);
+    address.toBytes(reinterpret_cast<Uint8*>(&addr.sin6_addr));
+    addr.sin6_family = AF_INET6;
+    addr.sin6_port   = htons(port);
+
+#if defined(SFML_SYSTEM_MACOS)
+    addr.sin6_len = sizeof(addr);
+#endif
+
+    return sizeof(sockaddr_in6);
+}
+
+
+////////////////////////////////////////////////////////////
+void SocketImpl::readAddress(const sockaddr_storage& address, IpAddress& ipAddress, unsigned short& port)
+{
+    if (address.ss_family == AF_INET6)
+    {
+        const sockaddr_in6& addr = reinterpret_cast<const sockaddr_in6&>(address);
+        ipAddress = IpAddress(reinterpret_cast<const Uint8*>(&addr.sin6_addr));
+        port      = ntohs(addr.sin6_port);
+    }
+    else
+    {
+        const sockaddr_in& addr = reinterpret_cast<const sockaddr_in&>(address);
+        ipAddress = IpAddress(ntohl(addr.sin_addr.s_addr));
+        port      = ntohs(addr.sin_port);
+    }
+}
+
+
 ////////////////////////////////////////////////////////////
 SocketHandle SocketImpl::invalidSocket()
 {
@@ -77,6 +126,26 @@ void SocketImpl::setBlocking(SocketHandle sock, bool block)
 }
 
 
+////////////////////////////////////////////////////////////
+void SocketImpl::setBuffer(Buffer& buffer, const void* data, std::size_t size)
+{
+    buffer.iov_base = const_cast<void*>(data);
+    buffer.iov_len  = size;
+}
+
+
+////////////////////////////////////////////////////////////
+int SocketImpl::send(SocketHandle sock, Buffer* buffers, std::size_t count, int flags)
+{
+    msghdr message;
+    std::memset(&message, 0, sizeof(message));
+    message.msg_iov    = buffers;
+    message.msg_iovlen = count;
+
+    return static_cast<int>(sendmsg(sock, &message, flags));
+}
+
+
 ////////////////////////////////////////////////////////////
 Socket::Status SocketImpl::getErrorStatus()
 {
@@ -46,6 +46,51 @@ sockaddr_in SocketImpl::createAddress(Uint32 address, unsigned short port)
 }
 
 
+////////////////////////////////////////////////////////////
+SocketImpl::AddrLength SocketImpl::createAddress(const IpAddress& address, unsigned short port, IpAddress::Type addressType, sockaddr_storage& result)
+{
+    std::memset(&result, 0, sizeof(result));
+
+    if (addressType == IpAddress::IPv4)
+    {
+        // IPv4 sockets can't reach IPv6 addresses
+        if (address.getType() != IpAddress::IPv4)
+            return 0;
+
+        sockaddr_in& addr = reinterpret_cast<sockaddr_in&>(result);
+        addr = createAddress(address.toInteger(), port);
+
+        return sizeof(sockaddr_in);
+    }
+
+    // IPv6 sockets reach IPv4 addresses through their IPv4-mapped form
+    sockaddr_in6& addr = reinterpret_cast<sockaddr_in6&>(result);
+    address.toBytes(reinterpret_cast<Uint8*>(&addr.sin6_addr));
+    addr.sin6_family = AF_INET6;
+    addr.sin6_port   = htons(port);
+
+    return sizeof(sockaddr_in6);
+}
+
+
+////////////////////////////////////////////////////////////
+void SocketImpl::readAddress(const sockaddr_storage& address, IpAddress& ipAddress, unsigned short& port)
+{
+    if (address.ss_family == AF_INET6)
+    {
+        const sockaddr_in6& addr = reinterpret_cast<const sockaddr_in6&>(address);
+        ipAddress = IpAddress(reinterpret_cast<const Uint8*>(&addr.sin6_addr));
+        port      = ntohs(addr.sin6_port);
+    }
+    else
+    {
+        const sockaddr_in& addr = reinterpret_cast<const sockaddr_in&>(address);
+        ipAddress = IpAddress(ntohl(addr.sin_addr.s_addr));
+        port      = ntohs(addr.sin_port);
+    }
+}
+
+
 ////////////////////////////////////////////////////////////
 SocketHandle SocketImpl::invalidSocket()
 {
@@ -68,6 +113,25 @@ void SocketImpl::setBlocking(SocketHandle sock, bool block)
 }
 
 
+////////////////////////////////////////////////////////////
+void SocketImpl::setBuffer(Buffer& buffer, const void* data, std::size_t size)
+{
+    buffer.buf = static_cast<char*>(const_cast<void*>(data));
+    buffer.len = static_cast<u_long>(size);
+}
+
+
+////////////////////////////////////////////////////////////
+int SocketImpl::send(SocketHandle sock, Buffer* buffers, std::size_t count, int flags)
+{
+    DWORD sent = 0;
+    if (WSASend(sock, buffers, static_cast<DWORD>(count), &sent, static_cast<DWORD>(flags), NULL, NULL) == SOCKET_ERROR)
+        return -1;
+
+    return static_cast<int>(sent);
+}
+
+
 ////////////////////////////////////////////////////////////
 Socket::Status SocketImpl::getErrorStatus()
 {
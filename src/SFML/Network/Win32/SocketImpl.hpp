@@ -36,6 +36,7 @@
 #endif
 #define _WIN32_WINDOWS 0x0501
 #define _WIN32_WINNT   0x0501
+#include <SFML/Network/IpAddress.hpp>
 #include <SFML/Network/Socket.hpp>
 #include <winsock2.h>
 #include <ws2tcpip.h>
@@ -58,6 +59,7 @@ public :
     // Types
     ////////////////////////////////////////////////////////////
     typedef int AddrLength;
+    typedef WSABUF Buffer;
 
     ////////////////////////////////////////////////////////////
     /// \brief Create an internal sockaddr_in address
@@ -70,6 +72,31 @@ public :
     ////////////////////////////////////////////////////////////
     static sockaddr_in createAddress(Uint32 address, unsigned short port);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Create an internal address for an IPv4 or IPv6 socket
+    ///
+    /// IPv4 addresses are mapped to IPv6 for IPv6 sockets.
+    ///
+    /// \param address     Target address
+    /// \param port        Target port
+    /// \param addressType Type of the addresses used by the socket
+    /// \param result      Filled with the internal address
+    ///
+    /// \return Size of the internal address, or 0 if the socket can't use the address
+    ///
+    ////////////////////////////////////////////////////////////
+    static AddrLength createAddress(const IpAddress& address, unsigned short port, IpAddress::Type addressType, sockaddr_storage& result);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Read an internal address filled by a socket function
+    ///
+    /// \param address   Internal address (sockaddr_in or sockaddr_in6)
+    /// \param ipAddress Filled with the IP address
+    /// \param port      Filled with the port
+    ///
+    ////////////////////////////////////////////////////////////
+    static void readAddress(const sockaddr_storage& address, IpAddress& ipAddress, unsigned short& port);
+
     ////////////////////////////////////////////////////////////
     /// \brief Return the value of the invalid socket
     ///
@@ -95,6 +122,29 @@ public :
     ////////////////////////////////////////////////////////////
     static void setBlocking(SocketHandle sock, bool block);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the memory described by a buffer of a gathered send
+    ///
+    /// \param buffer Buffer to set
+    /// \param data   Pointer to the bytes to send
+    /// \param size   Number of bytes to send
+    ///
+    ////////////////////////////////////////////////////////////
+    static void setBuffer(Buffer& buffer, const void* data, std::size_t size);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Send the contents of several buffers in a single call
+    ///
+    /// \param sock    Handle of the socket
+    /// \param buffers Pointer to the array of buffers to send, in order
+    /// \param count   Number of buffers in the array
+    /// \param flags   Low-level send flags
+    ///
+    /// \return Number of bytes sent, or -1 on error
+    ///
+    ////////////////////////////////////////////////////////////
+    static int send(SocketHandle sock, Buffer* buffers, std::size_t count, int flags);
+
     ////////////////////////////////////////////////////////////
     /// Get the last socket error status
     ///
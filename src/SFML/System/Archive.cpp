@@ -0,0 +1,218 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2014 Laurent Gomila (laurent.gom@gmail.com)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/System/Archive.hpp>
+#include <SFML/System/ArchiveFormat.hpp>
+#include <SFML/System/Lz4.hpp>
+#include <SFML/System/Err.hpp>
+#include <algorithm>
+#include <cstring>
+#include <limits>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+Archive::Archive()
+{
+
+}
+
+
+////////////////////////////////////////////////////////////
+bool Archive::open(const std::string& filename)
+{
+    m_entries.clear();
+
+    // Map the whole archive into memory
+    if (!m_file.open(filename))
+    {
+        err() << "Failed to open archive \"" << filename << "\" (failed to map the file)" << std::endl;
+        return false;
+    }
+
+    const char* data = static_cast<const char*>(m_file.getData());
+    Uint64 fileSize = m_file.getSize();
+
+    // Check the header
+    if ((fileSize < priv::ArchiveHeaderSize) || (std::memcmp(data, priv::ArchiveMagic, sizeof(priv::ArchiveMagic)) != 0))
+    {
+        err() << "Failed to open archive \"" << filename << "\" (not an archive file)" << std::endl;
+        m_file.close();
+        return false;
+    }
+    Uint32 version = priv::archiveRead<Uint32>(data + 4);
+    if (version != priv::ArchiveVersion)
+    {
+        err() << "Failed to open archive \"" << filename << "\" (unsupported version " << version << ")" << std::endl;
+        m_file.close();
+        return false;
+    }
+    Uint64 entryCount = priv::archiveRead<Uint32>(data + 8);
+    Uint64 namesSize  = priv::archiveRead<Uint32>(data + 12);
+
+    // Make sure that the table of contents and the names fit in the file
+    Uint64 namesOffset = priv::ArchiveHeaderSize + entryCount * priv::ArchiveEntrySize;
+    if (namesOffset + namesSize > fileSize)
+    {
+        err() << "Failed to open archive \"" << filename << "\" (truncated table of contents)" << std::endl;
+        m_file.close();
+        return false;
+    }
+
+    // Read the table of contents
+    m_entries.resize(static_cast<std::size_t>(entryCount));
+    const char* names = data + namesOffset;
+    for (std::size_t i = 0; i < m_entries.size(); ++i)
+    {
+        const char* source = data + priv::ArchiveHeaderSize + i * priv::ArchiveEntrySize;
+        Entry& entry = m_entries[i];
+
+        Uint32 nameOffset = priv::archiveRead<Uint32>(source + 4);
+        Uint32 nameLength = priv::archiveRead<Uint32>(source + 8);
+        entry.hash        = priv::archiveRead<Uint32>(source);
+        entry.compression = priv::archiveRead<Uint32>(source + 12);
+        entry.offset      = priv::archiveRead<Uint64>(source + 16);
+        entry.size        = priv::archiveRead<Uint64>(source + 24);
+        entry.storedSize  = priv::archiveRead<Uint64>(source + 32);
+
+        // The decompressed size is checked too, so that a corrupted entry can't make us allocate an absurd buffer
+        bool valid = (static_cast<Uint64>(nameOffset) + nameLength <= namesSize) &&
+                     (entry.offset <= fileSize) && (entry.storedSize <= fileSize - entry.offset) &&
+                     (entry.size <= std::numeric_limits<std::size_t>::max()) &&
+                     (((entry.compression == priv::ArchiveLz4) && (entry.size <= entry.storedSize * priv::ArchiveLz4Ratio)) ||
+                      ((entry.compression == priv::ArchiveStored) && (entry.size == entry.storedSize)));
+        if (!valid)
+        {
+            err() << "Failed to open archive \"" << filename << "\" (invalid entry " << i << ")" << std::endl;
+            m_entries.clear();
+            m_file.close();
+            return false;
+        }
+
+        entry.name.assign(names + nameOffset, nameLength);
+    }
+
+    // The packer writes the table already sorted, but we don't want to rely on it for lookups
+    std::sort(m_entries.begin(), m_entries.end());
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t Archive::getEntryCount() const
+{
+    return m_entries.size();
+}
+
+
+////////////////////////////////////////////////////////////
+const std::string& Archive::getEntryName(std::size_t index) const
+{
+    return m_entries[index].name;
+}
+
+
+////////////////////////////////////////////////////////////
+bool Archive::contains(const std::string& name) const
+{
+    return findEntry(name) != NULL;
+}
+
+
+////////////////////////////////////////////////////////////
+Int64 Archive::getEntrySize(const std::string& name) const
+{
+    const Entry* entry = findEntry(name);
+
+    return entry ? static_cast<Int64>(entry->size) : -1;
+}
+
+
+////////////////////////////////////////////////////////////
+bool Archive::openEntry(const std::string& name, ArchiveInputStream& stream) const
+{
+    const Entry* entry = findEntry(name);
+    if (!entry)
+    {
+        err() << "Failed to open archive entry \"" << name << "\" (no such entry)" << std::endl;
+        return false;
+    }
+
+    const char* data = static_cast<const char*>(m_file.getData()) + entry->offset;
+    std::size_t size = static_cast<std::size_t>(entry->size); // checked in open()
+
+    if (entry->compression == priv::ArchiveStored)
+    {
+        // Stored entries are read directly from the mapped file
+        std::vector<char>().swap(stream.m_buffer);
+        stream.m_memory.open(data, size);
+    }
+    else
+    {
+        // Compressed entries are decompressed once into the stream's own buffer
+        stream.m_buffer.resize(size);
+        char* buffer = size > 0 ? &stream.m_buffer[0] : NULL;
+        if (!priv::lz4Decompress(data, static_cast<std::size_t>(entry->storedSize), buffer, size))
+        {
+            err() << "Failed to open archive entry \"" << name << "\" (corrupted data)" << std::endl;
+            stream.m_memory.open(NULL, 0);
+            return false;
+        }
+        stream.m_memory.open(size > 0 ? buffer : data, size);
+    }
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+bool Archive::Entry::operator <(const Entry& right) const
+{
+    if (hash != right.hash)
+        return hash < right.hash;
+    else
+        return name < right.name;
+}
+
+
+////////////////////////////////////////////////////////////
+const Archive::Entry* Archive::findEntry(const std::string& name) const
+{
+    Entry key;
+    key.hash = priv::archiveHash(name.c_str(), name.size());
+    key.name = name;
+
+    std::vector<Entry>::const_iterator it = std::lower_bound(m_entries.begin(), m_entries.end(), key);
+    if ((it != m_entries.end()) && (it->hash == key.hash) && (it->name == name))
+        return &*it;
+    else
+        return NULL;
+}
+
+} // namespace sf
@@ -0,0 +1,121 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2014 Laurent Gomila (laurent.gom@gmail.com)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_ARCHIVEFORMAT_HPP
+#define SFML_ARCHIVEFORMAT_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Config.hpp>
+#include <string>
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+// Layout of SFML archive files (all integers are little-endian):
+//
+// Header (16 bytes)
+//     char[4] magic          "SFPK"
+//     Uint32  version        ArchiveVersion
+//     Uint32  entryCount     Number of entries in the table of contents
+//     Uint32  namesSize      Size of the names block, in bytes
+//
+// Table of contents (entryCount * 40 bytes), sorted by hash then by name
+//     Uint32  hash           archiveHash() of the entry name
+//     Uint32  nameOffset     Offset of the name in the names block
+//     Uint32  nameLength     Length of the name, in bytes
+//     Uint32  compression    ArchiveCompression value
+//     Uint64  offset         Offset of the data from the beginning of the file
+//     Uint64  size           Size of the uncompressed data
+//     Uint64  storedSize     Size of the data as stored in the file
+//
+// Names block (namesSize bytes): entry names in UTF-8, '/' separated
+//
+// Entries data
+////////////////////////////////////////////////////////////
+const char        ArchiveMagic[4]   = {'S', 'F', 'P', 'K'};
+const Uint32      ArchiveVersion    = 1;
+const std::size_t ArchiveHeaderSize = 16;
+const std::size_t ArchiveEntrySize  = 40;
+const Uint64      ArchiveLz4Ratio   = 255; // An LZ4 block can't decompress to more than 255 times its size
+
+////////////////////////////////////////////////////////////
+/// \brief Compression methods of archive entries
+///
+////////////////////////////////////////////////////////////
+enum ArchiveCompression
+{
+    ArchiveStored = 0, ///< Data is stored as is
+    ArchiveLz4    = 1  ///< Data is a single LZ4 block
+};
+
+////////////////////////////////////////////////////////////
+/// \brief Compute the hash of an entry name (32-bits FNV-1a)
+///
+////////////////////////////////////////////////////////////
+inline Uint32 archiveHash(const char* name, std::size_t length)
+{
+    Uint32 hash = 2166136261U;
+    for (std::size_t i = 0; i < length; ++i)
+    {
+        hash ^= static_cast<unsigned char>(name[i]);
+        hash *= 16777619U;
+    }
+    return hash;
+}
+
+////////////////////////////////////////////////////////////
+/// \brief Read a little-endian integer from a byte buffer
+///
+////////////////////////////////////////////////////////////
+template <typename T>
+inline T archiveRead(const char* data)
+{
+    T value = 0;
+    for (std::size_t i = 0; i < sizeof(T); ++i)
+        value |= static_cast<T>(static_cast<unsigned char>(data[i])) << (i * 8);
+    return value;
+}
+
+////////////////////////////////////////////////////////////
+/// \brief Append a little-endian integer to a byte buffer
+///
+////////////////////////////////////////////////////////////
+template <typename T>
+inline void archiveWrite(std::string& buffer, T value)
+{
+    for (std::size_t i = 0; i < sizeof(T); ++i)
+        buffer.push_back(static_cast<char>((value >> (i * 8)) & 0xFF));
+}
+
+} // namespace priv
+
+} // namespace sf
+
+
+#endif // SFML_ARCHIVEFORMAT_HPP
@@ -0,0 +1,74 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2014 Laurent Gomila (laurent.gom@gmail.com)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/System/ArchiveInputStream.hpp>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+ArchiveInputStream::ArchiveInputStream()
+{
+
+}
+
+
+////////////////////////////////////////////////////////////
+Int64 ArchiveInputStream::read(void* data, Int64 size)
+{
+    return m_memory.read(data, size);
+}
+
+
+////////////////////////////////////////////////////////////
+Int64 ArchiveInputStream::seek(Int64 position)
+{
+    return m_memory.seek(position);
+}
+
+
+////////////////////////////////////////////////////////////
+Int64 ArchiveInputStream::tell()
+{
+    return m_memory.tell();
+}
+
+
+////////////////////////////////////////////////////////////
+Int64 ArchiveInputStream::getSize()
+{
+    return m_memory.getSize();
+}
+
+
+////////////////////////////////////////////////////////////
+const void* ArchiveInputStream::getData() const
+{
+    return m_memory.getData();
+}
+
+} // namespace sf
@@ -0,0 +1,147 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2014 Laurent Gomila (laurent.gom@gmail.com)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/System/FileInputStream.hpp>
+#if !defined(SFML_SYSTEM_WINDOWS)
+    #include <sys/types.h>
+#endif
+
+
+namespace
+{
+    // fseek and ftell use a long, which can't hold the offsets beyond 2 GB on
+    // Windows and on 32-bit Unix systems: use their 64-bit versions instead
+    bool seekFile(std::FILE* file, sf::Int64 offset, int origin)
+    {
+    #if defined(SFML_SYSTEM_WINDOWS)
+        return _fseeki64(file, offset, origin) == 0;
+    #else
+        // off_t may still be 32 bits if the program isn't built with large file support
+        if (static_cast<off_t>(offset) != offset)
+            return false;
+
+        return fseeko(file, static_cast<off_t>(offset), origin) == 0;
+    #endif
+    }
+
+    sf::Int64 tellFile(std::FILE* file)
+    {
+    #if defined(SFML_SYSTEM_WINDOWS)
+        return _ftelli64(file);
+    #else
+        return ftello(file);
+    #endif
+    }
+}
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+FileInputStream::FileInputStream() :
+m_file(NULL)
+{
+
+}
+
+
+////////////////////////////////////////////////////////////
+FileInputStream::~FileInputStream()
+{
+    if (m_file)
+        std::fclose(m_file);
+}
+
+
+////////////////////////////////////////////////////////////
+bool FileInputStream::open(const std::string& filename)
+{
+    if (m_file)
+        std::fclose(m_file);
+
+    m_file = std::fopen(filename.c_str(), "rb");
+
+    return m_file != NULL;
+}
+
+
+////////////////////////////////////////////////////////////
+Int64 FileInputStream::read(void* data, Int64 size)
+{
+    if (m_file)
+        return std::fread(data, 1, static_cast<std::size_t>(size), m_file);
+    else
+        return -1;
+}
+
+
+////////////////////////////////////////////////////////////
+Int64 FileInputStream::seek(Int64 position)
+{
+    if (m_file)
+    {
+        if (!seekFile(m_file, position, SEEK_SET))
+            return -1;
+
+        return tell();
+    }
+    else
+    {
+        return -1;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+Int64 FileInputStream::tell()
+{
+    if (m_file)
+        return tellFile(m_file);
+    else
+        return -1;
+}
+
+
+////////////////////////////////////////////////////////////
+Int64 FileInputStream::getSize()
+{
+    if (m_file)
+    {
+        Int64 position = tellFile(m_file);
+        seekFile(m_file, 0, SEEK_END);
+        Int64 size = tellFile(m_file);
+        seekFile(m_file, position, SEEK_SET);
+
+        return size;
+    }
+    else
+    {
+        return -1;
+    }
+}
+
+} // namespace sf
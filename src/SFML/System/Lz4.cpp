@@ -0,0 +1,240 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2014 Laurent Gomila (laurent.gom@gmail.com)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/System/Lz4.hpp>
+#include <cstring>
+#include <vector>
+
+
+namespace
+{
+    // Constraints of the LZ4 block format
+    const std::size_t minMatch     = 4;  // Minimum length of a match
+    const std::size_t lastLiterals = 5;  // The last bytes of a block are always literals
+    const std::size_t matchLimit   = 12; // No match can start in the last bytes of a block
+    const std::size_t maxOffset    = 65535;
+    const unsigned int hashLog     = 12;
+
+    // Read 4 bytes at an unaligned address
+    sf::Uint32 read32(const unsigned char* data)
+    {
+        sf::Uint32 value;
+        std::memcpy(&value, data, sizeof(value));
+        return value;
+    }
+
+    // Hash 4 bytes into the index of the match finder table
+    std::size_t hash(sf::Uint32 sequence)
+    {
+        return (sequence * 2654435761U) >> (32 - hashLog);
+    }
+
+    // Write a length extension (sequence of 255 bytes terminated by a smaller one)
+    unsigned char* writeLength(unsigned char* output, std::size_t length)
+    {
+        while (length >= 255)
+        {
+            *output++ = 255;
+            length -= 255;
+        }
+        *output++ = static_cast<unsigned char>(length);
+        return output;
+    }
+
+    // Read a length extension
+    bool readLength(const unsigned char*& input, const unsigned char* end, std::size_t& length)
+    {
+        unsigned char byte;
+        do
+        {
+            if (input >= end)
+                return false;
+            byte = *input++;
+            length += byte;
+        }
+        while (byte == 255);
+
+        return true;
+    }
+
+    // Write a complete sequence (literals + match); returns NULL if it doesn't fit
+    unsigned char* writeSequence(unsigned char* output, unsigned char* outputEnd,
+                                 const unsigned char* literals, std::size_t literalLength,
+                                 std::size_t offset, std::size_t matchLength)
+    {
+        // Check the worst case size of the sequence
+        std::size_t required = 1 + literalLength / 255 + 1 + literalLength + 2 + matchLength / 255 + 1;
+        if (static_cast<std::size_t>(outputEnd - output) < required)
+            return NULL;
+
+        // Token
+        unsigned char* token = output++;
+        *token = static_cast<unsigned char>((literalLength < 15 ? literalLength : 15) << 4);
+
+        // Literals
+        if (literalLength >= 15)
+            output = writeLength(output, literalLength - 15);
+        std::memcpy(output, literals, literalLength);
+        output += literalLength;
+
+        // The last sequence has no match
+        if (matchLength == 0)
+            return output;
+
+        // Match
+        *output++ = static_cast<unsigned char>(offset & 0xFF);
+        *output++ = static_cast<unsigned char>(offset >> 8);
+        matchLength -= minMatch;
+        *token |= static_cast<unsigned char>(matchLength < 15 ? matchLength : 15);
+        if (matchLength >= 15)
+            output = writeLength(output, matchLength - 15);
+
+        return output;
+    }
+}
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+std::size_t lz4CompressBound(std::size_t size)
+{
+    return size + size / 255 + 16;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t lz4Compress(const char* source, std::size_t sourceSize, char* destination, std::size_t destinationSize)
+{
+    const unsigned char* begin  = reinterpret_cast<const unsigned char*>(source);
+    const unsigned char* end    = begin + sourceSize;
+    const unsigned char* input  = begin;
+    const unsigned char* anchor = begin;
+    unsigned char* output    = reinterpret_cast<unsigned char*>(destination);
+    unsigned char* outputEnd = output + destinationSize;
+
+    // Blocks too small to contain a match are stored as literals only
+    if (sourceSize > matchLimit)
+    {
+        // Positions of the last occurrence of each hashed sequence (offset by one, 0 means none)
+        std::vector<std::size_t> table(1 << hashLog, 0);
+
+        const unsigned char* inputLimit = end - matchLimit;
+        const unsigned char* matchEnd   = end - lastLiterals;
+        while (input <= inputLimit)
+        {
+            Uint32 sequence = read32(input);
+            std::size_t& slot = table[hash(sequence)];
+            const unsigned char* reference = slot ? begin + slot - 1 : NULL;
+            slot = input - begin + 1;
+
+            if (reference && (static_cast<std::size_t>(input - reference) <= maxOffset) && (read32(reference) == sequence))
+            {
+                // Extend the match as far as possible
+                std::size_t length = minMatch;
+                while ((input + length < matchEnd) && (reference[length] == input[length]))
+                    length++;
+
+                output = writeSequence(output, outputEnd, anchor, input - anchor, input - reference, length);
+                if (!output)
+                    return 0;
+
+                input += length;
+                anchor = input;
+            }
+            else
+            {
+                input++;
+            }
+        }
+    }
+
+    // Write the remaining literals
+    output = writeSequence(output, outputEnd, anchor, end - anchor, 0, 0);
+    if (!output)
+        return 0;
+
+    return output - reinterpret_cast<unsigned char*>(destination);
+}
+
+
+////////////////////////////////////////////////////////////
+bool lz4Decompress(const char* source, std::size_t sourceSize, char* destination, std::size_t destinationSize)
+{
+    const unsigned char* input    = reinterpret_cast<const unsigned char*>(source);
+    const unsigned char* inputEnd = input + sourceSize;
+    unsigned char* begin     = reinterpret_cast<unsigned char*>(destination);
+    unsigned char* output    = begin;
+    unsigned char* outputEnd = begin + destinationSize;
+
+    while (input < inputEnd)
+    {
+        unsigned char token = *input++;
+
+        // Copy the literals
+        std::size_t literalLength = token >> 4;
+        if ((literalLength == 15) && !readLength(input, inputEnd, literalLength))
+            return false;
+        if ((literalLength > static_cast<std::size_t>(inputEnd - input)) || (literalLength > static_cast<std::size_t>(outputEnd - output)))
+            return false;
+        std::memcpy(output, input, literalLength);
+        input += literalLength;
+        output += literalLength;
+
+        // The last sequence contains only literals
+        if (input == inputEnd)
+            break;
+
+        // Read the match offset
+        if (inputEnd - input < 2)
+            return false;
+        std::size_t offset = input[0] | (input[1] << 8);
+        input += 2;
+        if ((offset == 0) || (offset > static_cast<std::size_t>(output - begin)))
+            return false;
+
+        // Copy the match (byte per byte, since it can overlap the output)
+        std::size_t matchLength = token & 0x0F;
+        if ((matchLength == 15) && !readLength(input, inputEnd, matchLength))
+            return false;
+        matchLength += minMatch;
+        if (matchLength > static_cast<std::size_t>(outputEnd - output))
+            return false;
+        const unsigned char* reference = output - offset;
+        for (std::size_t i = 0; i < matchLength; ++i)
+            output[i] = reference[i];
+        output += matchLength;
+    }
+
+    return output == outputEnd;
+}
+
+} // namespace priv
+
+} // namespace sf
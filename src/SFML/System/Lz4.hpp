@@ -0,0 +1,86 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2014 Laurent Gomila (laurent.gom@gmail.com)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_LZ4_HPP
+#define SFML_LZ4_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Config.hpp>
+#include <cstddef>
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+/// \brief Get the maximum compressed size of a block
+///
+/// \param size Size of the uncompressed data, in bytes
+///
+/// \return Size that the destination buffer of lz4Compress
+///         needs to be guaranteed to succeed
+///
+////////////////////////////////////////////////////////////
+std::size_t lz4CompressBound(std::size_t size);
+
+////////////////////////////////////////////////////////////
+/// \brief Compress a block of data using the LZ4 block format
+///
+/// \param source          Data to compress
+/// \param sourceSize      Size of the data to compress, in bytes
+/// \param destination     Buffer where to write the compressed data
+/// \param destinationSize Capacity of the destination buffer, in bytes
+///
+/// \return Size of the compressed data, or 0 if it doesn't fit
+///         into the destination buffer
+///
+////////////////////////////////////////////////////////////
+std::size_t lz4Compress(const char* source, std::size_t sourceSize, char* destination, std::size_t destinationSize);
+
+////////////////////////////////////////////////////////////
+/// \brief Decompress a block of data in the LZ4 block format
+///
+/// The size of the decompressed data must be known in advance;
+/// the function fails if the block is malformed or doesn't
+/// decompress to exactly \a destinationSize bytes.
+///
+/// \param source          Compressed data
+/// \param sourceSize      Size of the compressed data, in bytes
+/// \param destination     Buffer where to write the decompressed data
+/// \param destinationSize Expected size of the decompressed data, in bytes
+///
+/// \return True if the block was successfully decompressed
+///
+////////////////////////////////////////////////////////////
+bool lz4Decompress(const char* source, std::size_t sourceSize, char* destination, std::size_t destinationSize);
+
+} // namespace priv
+
+} // namespace sf
+
+
+#endif // SFML_LZ4_HPP
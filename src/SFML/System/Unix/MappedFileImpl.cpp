@@ -0,0 +1,114 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2014 Laurent Gomila (laurent.gom@gmail.com)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/System/Unix/MappedFileImpl.hpp>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+MappedFileImpl::MappedFileImpl() :
+m_data(NULL),
+m_size(0)
+{
+
+}
+
+
+////////////////////////////////////////////////////////////
+MappedFileImpl::~MappedFileImpl()
+{
+    close();
+}
+
+
+////////////////////////////////////////////////////////////
+bool MappedFileImpl::open(const std::string& filename)
+{
+    close();
+
+    int descriptor = ::open(filename.c_str(), O_RDONLY);
+    if (descriptor == -1)
+        return false;
+
+    // Empty files can't be mapped, and anything else than a regular file is not supported
+    struct stat status;
+    if ((fstat(descriptor, &status) == -1) || !S_ISREG(status.st_mode) || (status.st_size <= 0))
+    {
+        ::close(descriptor);
+        return false;
+    }
+
+    std::size_t size = static_cast<std::size_t>(status.st_size);
+    void* data = mmap(NULL, size, PROT_READ, MAP_PRIVATE, descriptor, 0);
+
+    // The mapping keeps its own reference to the file, the descriptor is no longer needed
+    ::close(descriptor);
+
+    if (data == MAP_FAILED)
+        return false;
+
+    m_data = data;
+    m_size = size;
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+void MappedFileImpl::close()
+{
+    if (m_data)
+        munmap(m_data, m_size);
+
+    m_data = NULL;
+    m_size = 0;
+}
+
+
+////////////////////////////////////////////////////////////
+const void* MappedFileImpl::getData() const
+{
+    return m_data;
+}
+
+
+////////////////////////////////////////////////////////////
+Int64 MappedFileImpl::getSize() const
+{
+    return static_cast<Int64>(m_size);
+}
+
+} // namespace priv
+
+} // namespace sf
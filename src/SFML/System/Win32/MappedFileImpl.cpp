@@ -0,0 +1,119 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2014 Laurent Gomila (laurent.gom@gmail.com)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/System/Win32/MappedFileImpl.hpp>
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+MappedFileImpl::MappedFileImpl() :
+m_mapping(NULL),
+m_data   (NULL),
+m_size   (0)
+{
+
+}
+
+
+////////////////////////////////////////////////////////////
+MappedFileImpl::~MappedFileImpl()
+{
+    close();
+}
+
+
+////////////////////////////////////////////////////////////
+bool MappedFileImpl::open(const std::string& filename)
+{
+    close();
+
+    HANDLE file = CreateFileA(filename.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (file == INVALID_HANDLE_VALUE)
+        return false;
+
+    // Empty files can't be mapped
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(file, &size) || (size.QuadPart <= 0))
+    {
+        CloseHandle(file);
+        return false;
+    }
+
+    // The mapping object keeps its own reference to the file, the file handle is no longer needed
+    m_mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+    CloseHandle(file);
+    if (!m_mapping)
+        return false;
+
+    m_data = MapViewOfFile(m_mapping, FILE_MAP_READ, 0, 0, 0);
+    if (!m_data)
+    {
+        CloseHandle(m_mapping);
+        m_mapping = NULL;
+        return false;
+    }
+
+    m_size = static_cast<std::size_t>(size.QuadPart);
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+void MappedFileImpl::close()
+{
+    if (m_data)
+        UnmapViewOfFile(m_data);
+
+    if (m_mapping)
+        CloseHandle(m_mapping);
+
+    m_mapping = NULL;
+    m_data    = NULL;
+    m_size    = 0;
+}
+
+
+////////////////////////////////////////////////////////////
+const void* MappedFileImpl::getData() const
+{
+    return m_data;
+}
+
+
+////////////////////////////////////////////////////////////
+Int64 MappedFileImpl::getSize() const
+{
+    return static_cast<Int64>(m_size);
+}
+
+} // namespace priv
+
+} // namespace sf
@@ -0,0 +1,221 @@
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/System.hpp>
+#include <SFML/System/ArchiveFormat.hpp>
+#include <SFML/System/Lz4.hpp>
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+
+////////////////////////////////////////////////////////////
+/// Entry to be written to an archive
+///
+////////////////////////////////////////////////////////////
+struct PackEntry
+{
+    sf::Uint32  hash;
+    std::string name;
+    sf::Uint32  compression;
+    sf::Uint64  size;
+    std::string data;
+
+    bool operator <(const PackEntry& right) const
+    {
+        return hash != right.hash ? hash < right.hash : name < right.name;
+    }
+};
+
+
+////////////////////////////////////////////////////////////
+/// Print the command line usage
+///
+////////////////////////////////////////////////////////////
+void printUsage()
+{
+    std::cout << "Usage: sfml-pack [-z] [-C directory] archive file..." << std::endl;
+    std::cout << "       sfml-pack -l archive" << std::endl;
+    std::cout << std::endl;
+    std::cout << "  -z            Compress entries with LZ4 (entries that don't shrink are stored)" << std::endl;
+    std::cout << "  -C directory  Read the files relatively to directory; entry names don't include it" << std::endl;
+    std::cout << "  -l            List the entries of an existing archive" << std::endl;
+}
+
+
+////////////////////////////////////////////////////////////
+/// Read a whole file into a string
+///
+////////////////////////////////////////////////////////////
+bool readFile(const std::string& filename, std::string& data)
+{
+    std::ifstream file(filename.c_str(), std::ios_base::binary);
+    if (!file)
+        return false;
+
+    file.seekg(0, std::ios_base::end);
+    std::streamoff size = file.tellg();
+    file.seekg(0, std::ios_base::beg);
+
+    data.resize(static_cast<std::size_t>(size));
+    if (size > 0)
+        file.read(&data[0], size);
+
+    return !file.fail();
+}
+
+
+////////////////////////////////////////////////////////////
+/// List the entries of an archive
+///
+////////////////////////////////////////////////////////////
+int list(const std::string& filename)
+{
+    sf::Archive archive;
+    if (!archive.open(filename))
+        return EXIT_FAILURE;
+
+    for (std::size_t i = 0; i < archive.getEntryCount(); ++i)
+    {
+        const std::string& name = archive.getEntryName(i);
+        std::cout << name << " (" << archive.getEntrySize(name) << " bytes)" << std::endl;
+    }
+
+    return EXIT_SUCCESS;
+}
+
+
+////////////////////////////////////////////////////////////
+/// Entry point of application
+///
+/// \return Application exit code
+///
+////////////////////////////////////////////////////////////
+int main(int argc, char** argv)
+{
+    // Parse the command line
+    bool compress = false;
+    std::string root;
+    int arg = 1;
+    for (; arg < argc && argv[arg][0] == '-'; ++arg)
+    {
+        if (std::strcmp(argv[arg], "-z") == 0)
+        {
+            compress = true;
+        }
+        else if ((std::strcmp(argv[arg], "-C") == 0) && (arg + 1 < argc))
+        {
+            root = argv[++arg];
+            if (!root.empty() && (root[root.size() - 1] != '/') && (root[root.size() - 1] != '\\'))
+                root += '/';
+        }
+        else if ((std::strcmp(argv[arg], "-l") == 0) && (arg + 1 < argc))
+        {
+            return list(argv[arg + 1]);
+        }
+        else
+        {
+            printUsage();
+            return EXIT_FAILURE;
+        }
+    }
+    if (argc - arg < 2)
+    {
+        printUsage();
+        return EXIT_FAILURE;
+    }
+    std::string output = argv[arg++];
+
+    // Load all the entries
+    std::vector<PackEntry> entries;
+    for (; arg < argc; ++arg)
+    {
+        PackEntry entry;
+
+        // Entry names always use '/' as separator
+        entry.name = argv[arg];
+        std::replace(entry.name.begin(), entry.name.end(), '\\', '/');
+        entry.hash = sf::priv::archiveHash(entry.name.c_str(), entry.name.size());
+
+        if (!readFile(root + argv[arg], entry.data))
+        {
+            std::cerr << "Failed to read \"" << root + argv[arg] << "\"" << std::endl;
+            return EXIT_FAILURE;
+        }
+        entry.size = entry.data.size();
+        entry.compression = sf::priv::ArchiveStored;
+
+        // Compress the entry, but keep it only if it's worth it
+        if (compress && !entry.data.empty())
+        {
+            std::string compressed(sf::priv::lz4CompressBound(entry.data.size()), '\0');
+            std::size_t size = sf::priv::lz4Compress(entry.data.data(), entry.data.size(), &compressed[0], compressed.size());
+            if ((size > 0) && (size < entry.data.size()))
+            {
+                compressed.resize(size);
+                entry.data.swap(compressed);
+                entry.compression = sf::priv::ArchiveLz4;
+            }
+        }
+
+        entries.push_back(entry);
+    }
+
+    // Sort the table of contents so that the reader can use a binary search
+    std::sort(entries.begin(), entries.end());
+    for (std::size_t i = 1; i < entries.size(); ++i)
+    {
+        if (entries[i].name == entries[i - 1].name)
+        {
+            std::cerr << "Duplicate entry \"" << entries[i].name << "\"" << std::endl;
+            return EXIT_FAILURE;
+        }
+    }
+
+    // Build the names block
+    std::string names;
+    for (std::vector<PackEntry>::const_iterator it = entries.begin(); it != entries.end(); ++it)
+        names += it->name;
+
+    // Build the header and the table of contents
+    std::string header(sf::priv::ArchiveMagic, sizeof(sf::priv::ArchiveMagic));
+    sf::priv::archiveWrite<sf::Uint32>(header, sf::priv::ArchiveVersion);
+    sf::priv::archiveWrite<sf::Uint32>(header, static_cast<sf::Uint32>(entries.size()));
+    sf::priv::archiveWrite<sf::Uint32>(header, static_cast<sf::Uint32>(names.size()));
+
+    sf::Uint64 offset = sf::priv::ArchiveHeaderSize + entries.size() * sf::priv::ArchiveEntrySize + names.size();
+    sf::Uint32 nameOffset = 0;
+    for (std::vector<PackEntry>::const_iterator it = entries.begin(); it != entries.end(); ++it)
+    {
+        sf::priv::archiveWrite<sf::Uint32>(header, it->hash);
+        sf::priv::archiveWrite<sf::Uint32>(header, nameOffset);
+        sf::priv::archiveWrite<sf::Uint32>(header, static_cast<sf::Uint32>(it->name.size()));
+        sf::priv::archiveWrite<sf::Uint32>(header, it->compression);
+        sf::priv::archiveWrite<sf::Uint64>(header, offset);
+        sf::priv::archiveWrite<sf::Uint64>(header, it->size);
+        sf::priv::archiveWrite<sf::Uint64>(header, it->data.size());
+
+        nameOffset += static_cast<sf::Uint32>(it->name.size());
+        offset += it->data.size();
+    }
+
+    // Write the archive
+    std::ofstream file(output.c_str(), std::ios_base::binary);
+    file.write(header.data(), header.size());
+    file.write(names.data(), names.size());
+    for (std::vector<PackEntry>::const_iterator it = entries.begin(); it != entries.end(); ++it)
+        file.write(it->data.data(), it->data.size());
+    if (!file)
+    {
+        std::cerr << "Failed to write \"" << output << "\"" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    std::cout << "Packed " << entries.size() << " entries into \"" << output << "\" (" << offset << " bytes)" << std::endl;
+
+    return EXIT_SUCCESS;
+}